@@ -18,6 +18,7 @@
 #include <Startup.h>
 #include <Util/Utils.h>
 #include <framework/Framework.h>
+#include <framework/QueryDaemon.h>
 
 #include <ff/logging.h>
 
@@ -35,7 +36,8 @@ void printHelp() {
       "  safrnffnet --orgid {ORG ID} --port {portnum} [ --role {ROLE} "
       "] [ --study {study.json} ] [ --peers {peers.json} ] [ --query "
       "{query.json} ] [ --data {data.csv} ] [ --lookups {lookupsdir/} "
-      "]\n\n");
+      "] [ --randomness {randomnessdir/} ] [ --pregenerate {N} ] [ "
+      "--daemon [ --spool {spooldir/} ] [ --max-queries {N} ] ]\n\n");
   fprintf(stderr, "OPTIONS:\n");
   fprintf(
       stderr,
@@ -73,6 +75,42 @@ void printHelp() {
       stderr,
       "--query        (default \"./query.json\") the query definition "
       "file.\n");
+  fprintf(
+      stderr,
+      "--randomness   (optional) directory of pre-generated "
+      "randomness.\n");
+  fprintf(
+      stderr,
+      "          the dealer writes it, dataowners read their own shard "
+      "of it.\n");
+  fprintf(
+      stderr,
+      "--pregenerate  (dealer only) generate randomness for N queries "
+      "into\n");
+  fprintf(
+      stderr,
+      "          the --randomness directory and exit, rather than run "
+      "the query.\n");
+  fprintf(
+      stderr,
+      "--daemon       keep running and serve queries as they are "
+      "submitted,\n");
+  fprintf(
+      stderr,
+      "          rather than run --query once. Every party of the "
+      "study runs one.\n");
+  fprintf(
+      stderr,
+      "--spool        (daemon recipient only) directory of query files "
+      "to run.\n");
+  fprintf(
+      stderr,
+      "          each *.json file is run once, a file named \"stop\" "
+      "shuts down\n");
+  fprintf(stderr, "          every daemon.\n");
+  fprintf(
+      stderr,
+      "--max-queries  (default 8) queries the daemon runs at once.\n");
   fprintf(stderr, "--help         prints the help text.\n");
 }
 
@@ -86,6 +124,11 @@ std::string peers = "peers.json";
 std::string data = "data.csv";
 std::string lookups = "lookups/";
 std::string query = "query.json";
+std::string randomness = "";
+size_t pregenerateCount = 0;
+bool daemonMode = false;
+std::string spool = "";
+size_t maxQueries = 8;
 
 void argsParse(size_t const argc, char const * const argv[]) {
   bool invalid = false;
@@ -160,6 +203,46 @@ void argsParse(size_t const argc, char const * const argv[]) {
         break;
       }
       query = std::string(argv[++i]);
+    } else if (arg == "--randomness") {
+      if (i + 1 == argc) {
+        fprintf(stderr, "Missing randomness directory\n");
+        invalid = true;
+        break;
+      }
+      randomness = std::string(argv[++i]);
+    } else if (arg == "--pregenerate") {
+      if (i + 1 == argc) {
+        fprintf(stderr, "Missing pregenerate count\n");
+        invalid = true;
+        break;
+      }
+      try {
+        pregenerateCount = (size_t)stoul(std::string(argv[++i]));
+      } catch (std::logic_error le) {
+        fprintf(stderr, "Invalid pregenerate count, %s\n", le.what());
+        invalid = true;
+      }
+    } else if (arg == "--daemon") {
+      daemonMode = true;
+    } else if (arg == "--spool") {
+      if (i + 1 == argc) {
+        fprintf(stderr, "Missing spool directory\n");
+        invalid = true;
+        break;
+      }
+      spool = std::string(argv[++i]);
+    } else if (arg == "--max-queries") {
+      if (i + 1 == argc) {
+        fprintf(stderr, "Missing max queries count\n");
+        invalid = true;
+        break;
+      }
+      try {
+        maxQueries = (size_t)stoul(std::string(argv[++i]));
+      } catch (std::logic_error le) {
+        fprintf(stderr, "Invalid max queries count, %s\n", le.what());
+        invalid = true;
+      }
     } else if (arg == "--help") {
       printHelp();
       exit(0);
@@ -182,11 +265,32 @@ void argsParse(size_t const argc, char const * const argv[]) {
     }
   }
 
-  if (!has_port) {
+  if (!has_port && pregenerateCount == 0) {
     fprintf(stderr, "missing port number\n");
     invalid = true;
   }
 
+  if (pregenerateCount > 0 && (role != "dealer" || randomness == "")) {
+    fprintf(
+        stderr,
+        "--pregenerate requires --role dealer and --randomness\n");
+    invalid = true;
+  }
+
+  if (spool != "" && (!daemonMode || role == "dataowner" ||
+                      role == "dealer")) {
+    fprintf(stderr, "--spool requires --daemon and a recipient\n");
+    invalid = true;
+  }
+
+  if (daemonMode && (pregenerateCount > 0 || maxQueries == 0)) {
+    fprintf(
+        stderr,
+        "--daemon requires a positive --max-queries and no "
+        "--pregenerate\n");
+    invalid = true;
+  }
+
   if (invalid) {
     printHelp();
     exit(1);
@@ -292,6 +396,36 @@ int main(int argc, char const * const argv[]) {
     }
     nlohmann::json peers_json = nlohmann::json::parse(peers_stream);
 
+    const StudyConfig scfg = readStudyFromJson(study_json, peers_json);
+
+    Identity my_id = chooseMyId(scfg);
+    LOG_ORGANIZATION =
+        scfg.peers.find(my_id.orgId)->second.organizationName;
+
+    if (daemonMode) {
+      if (spool != "" && my_id.role != ROLE_RECIPIENT) {
+        log_error("Only a recipient may coordinate daemons");
+        return 1;
+      }
+
+      DaemonConfig dcfg;
+      dcfg.dataFile = data;
+      dcfg.lookupTableDirectory = lookups;
+      dcfg.randomnessDirectory = randomness;
+      dcfg.spoolDirectory = spool;
+      dcfg.maxConcurrentQueries = maxQueries;
+
+      PeerSet ps;
+      findStudyPeers(scfg, ps);
+      std::vector<ff::posixnet::PeerInfo<Identity>> peers_info;
+      setupPeersInfo(peers_info, scfg, my_id, ps);
+      ff::posixnet::runFortissimoPosixNet(
+          std::unique_ptr<Fronctocol>(new QueryDaemon(scfg, dcfg)),
+          peers_info,
+          my_id);
+      return 0;
+    }
+
     std::ifstream query_stream(query);
     if (!query_stream.is_open()) {
       log_error("Could not open file \"%s\"", query.c_str());
@@ -299,17 +433,23 @@ int main(int argc, char const * const argv[]) {
     }
     nlohmann::json query_json = nlohmann::json::parse(query_stream);
 
-    const StudyConfig scfg = readStudyFromJson(study_json, peers_json);
-
     const Query the_query(scfg, query_json);
 
-    Identity my_id = chooseMyId(scfg);
-    LOG_ORGANIZATION =
-        scfg.peers.find(my_id.orgId)->second.organizationName;
+    if (pregenerateCount > 0) {
+      return pregenerate(
+                 lookups,
+                 randomness,
+                 the_query,
+                 scfg,
+                 my_id,
+                 pregenerateCount) ?
+          0 :
+          1;
+    }
 
     PeerSet ps;
-    std::unique_ptr<Fronctocol> fronctocol =
-        startup(data, lookups, the_query, scfg, my_id, ps);
+    std::unique_ptr<Fronctocol> fronctocol = startup(
+        data, lookups, the_query, scfg, my_id, ps, randomness);
     std::vector<ff::posixnet::PeerInfo<Identity>> peers_info;
     setupPeersInfo(peers_info, scfg, my_id, ps);
     ff::posixnet::runFortissimoPosixNet(
@@ -57,29 +57,15 @@ static inline bool findKeyCols(
   return true;
 }
 
-std::unique_ptr<Fronctocol> startup(
-    std::string const & csvFile,
-    std::string const & lookupTableDirectory,
-    Query const & q,
+/**
+ * Adds the recipients, the dealers and the dataowners of the two joined
+ * verticals to the peer set.
+ */
+static inline void findPeers(
+    size_t leftVert,
+    size_t rightVert,
     StudyConfig const & scfg,
-    Identity const & id,
     PeerSet & peers) {
-  std::vector<size_t> left_keys;
-  std::vector<size_t> right_keys;
-
-  size_t leftVert;
-  size_t rightVert;
-
-  if (!findKeyCols(
-          *q.joinStatement,
-          left_keys,
-          right_keys,
-          &leftVert,
-          &rightVert,
-          scfg)) {
-    return nullptr;
-  }
-
   for (std::pair<dbuid_t, Peer> const & pair : scfg.peers) {
     dbuid_t dbuid = pair.first;
     Peer const & peer = pair.second;
@@ -101,6 +87,128 @@ std::unique_ptr<Fronctocol> startup(
       }
     }
   }
+}
+
+void findStudyPeers(StudyConfig const & scfg, PeerSet & peers) {
+  for (std::pair<dbuid_t, Peer> const & pair : scfg.peers) {
+    Peer const & peer = pair.second;
+
+    if (peer.isRecipient()) {
+      peers.add(Identity(pair.first, ROLE_RECIPIENT, SIZE_MAX));
+    }
+    if (peer.isDealer()) {
+      peers.add(Identity(pair.first, ROLE_DEALER, SIZE_MAX));
+    }
+    if (peer.isDataowner()) {
+      peers.add(Identity(
+          pair.first, ROLE_DATAOWNER, peer.dataowner.verticalIdx));
+    }
+  }
+}
+
+// Determine if Count (Moment 0) should be revealed to Analyst.
+// This is determined via study config.
+// For now, just look through all functions of study config,
+// and see if any of them turn this on.
+// TODO: Later, as our whitelist/blacklist/rules for allowing/disallowing
+// queries is implemented, this logic will need to be updated.
+static inline bool revealsCount(StudyConfig const & scfg) {
+  for (const auto & f : scfg.allowedQueries) {
+    if (f->type == FunctionType::MOMENT) {
+      const MomentFunction & func = *((MomentFunction *)f.get());
+      if (func.revealCount) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/**
+ * Finds the moments functions batched into a regression query. They
+ * share the regression's join, so each must be of a joined vertical.
+ */
+static inline bool findBatchedMoments(
+    Query const & q,
+    size_t leftVert,
+    size_t rightVert,
+    StudyConfig const & scfg,
+    std::vector<dataowner::BatchedMoments> & batchedMoments) {
+  for (std::unique_ptr<SafrnFunction> const & f : q.batchedFunctions) {
+    if (f->type != FunctionType::MOMENT) {
+      log_error("only moments may be batched with a regression");
+      return false;
+    }
+
+    std::vector<size_t> left_payloads;
+    std::vector<size_t> right_payloads;
+    dataowner::BatchedMoments moments;
+    MomentFunction const & function =
+        static_cast<MomentFunction const &>(*f);
+    if (!findPayloadMoment(
+            function,
+            left_payloads,
+            right_payloads,
+            leftVert,
+            rightVert,
+            &moments.dataVertical,
+            scfg)) {
+      return false;
+    }
+
+    moments.dataColumn = function.col.column;
+    moments.highestMoment =
+        static_cast<size_t>(function.momentType.value);
+    if (moments.highestMoment > 3) {
+      log_error("moments above the skew are not supported");
+      return false;
+    }
+    moments.includeCount = revealsCount(scfg);
+    batchedMoments.push_back(moments);
+  }
+  return true;
+}
+
+static inline std::string F_tableFile(
+    std::string const & lookupTableDirectory,
+    std::vector<size_t> const & left_payloads,
+    std::vector<size_t> const & right_payloads) {
+  size_t num_true_ivs =
+      left_payloads.size() + right_payloads.size() - 1;
+  return lookupTableDirectory + "f_table_num_ivs_" +
+      std::to_string(num_true_ivs) + ".csv";
+}
+
+static inline std::string
+t_tableFile(std::string const & lookupTableDirectory) {
+  return lookupTableDirectory + "t_table.csv";
+}
+
+std::unique_ptr<Fronctocol> startup(
+    std::string const & csvFile,
+    std::string const & lookupTableDirectory,
+    Query const & q,
+    StudyConfig const & scfg,
+    Identity const & id,
+    PeerSet & peers,
+    std::string const & randomnessDirectory) {
+  std::vector<size_t> left_keys;
+  std::vector<size_t> right_keys;
+
+  size_t leftVert;
+  size_t rightVert;
+
+  if (!findKeyCols(
+          *q.joinStatement,
+          left_keys,
+          right_keys,
+          &leftVert,
+          &rightVert,
+          scfg)) {
+    return nullptr;
+  }
+
+  findPeers(leftVert, rightVert, scfg, peers);
 
   if (!peers.hasPeer(id)) {
     return nullptr;
@@ -116,6 +224,12 @@ std::unique_ptr<Fronctocol> startup(
   std::vector<size_t> left_payloads;
   std::vector<size_t> right_payloads;
 
+  if (!q.batchedFunctions.empty() &&
+      q.function->type != FunctionType::LIN_REGRESSION) {
+    log_error("only a regression may lead a batch of functions");
+    return nullptr;
+  }
+
   if (q.function->type == FunctionType::LIN_REGRESSION) {
     size_t dep_vert;
     if (!findPayloadRegression(
@@ -129,17 +243,17 @@ std::unique_ptr<Fronctocol> startup(
       return nullptr;
     }
 
+    std::vector<dataowner::BatchedMoments> batched_moments;
+    if (!findBatchedMoments(
+            q, leftVert, rightVert, scfg, batched_moments)) {
+      return nullptr;
+    }
+
     bool fit_intercept =
         static_cast<LinearRegressionFunction &>(*q.function)
             .fit_intercept;
 
     if (id.role == ROLE_DATAOWNER) {
-
-      size_t num_true_ivs =
-          left_payloads.size() + right_payloads.size() - 1;
-      std::string F_table_file = lookupTableDirectory +
-          "f_table_num_ivs_" + std::to_string(num_true_ivs) + ".csv";
-      std::string t_table_file = lookupTableDirectory + "t_table.csv";
       return setupRegression(
           global_info_pointer,
           (id.vertical == leftVert ? left_keys : right_keys),
@@ -148,12 +262,15 @@ std::unique_ptr<Fronctocol> startup(
           dep_vert,
           leftVert,
           fit_intercept,
+          batched_moments,
           id,
           scfg,
           peers,
           csvFile,
-          F_table_file,
-          t_table_file);
+          F_tableFile(
+              lookupTableDirectory, left_payloads, right_payloads),
+          t_tableFile(lookupTableDirectory),
+          randomnessDirectory);
     } else if (id.role == ROLE_DEALER) {
       std::unique_ptr<dataowner::RegressionInfo const> rinfo(
           setupRegressionInfo(
@@ -163,6 +280,7 @@ std::unique_ptr<Fronctocol> startup(
               dep_vert,
               leftVert,
               fit_intercept,
+              batched_moments,
               peers,
               id));
 
@@ -179,6 +297,7 @@ std::unique_ptr<Fronctocol> startup(
               dep_vert,
               leftVert,
               fit_intercept,
+              batched_moments,
               peers,
               id));
 
@@ -208,22 +327,7 @@ std::unique_ptr<Fronctocol> startup(
     const MomentFunction & function =
         *((MomentFunction *)q.function.get());
     size_t moment = static_cast<size_t>(function.momentType.value);
-    // Determine if Count (Moment 0) should be revealed to Analyst.
-    // This is determined via study config.
-    // For now, just look through all functions of study config,
-    // and see if any of them turn this on.
-    // TODO: Later, as our whitelist/blacklist/rules for allowing/disallowing
-    // queries is implemented, this logic will need to be updated.
-    bool include_count = false;
-    for (const auto & f : scfg.allowedQueries) {
-      if (f->type == FunctionType::MOMENT) {
-        const MomentFunction & func = *((MomentFunction *)f.get());
-        if (func.revealCount) {
-          include_count = true;
-          break;
-        }
-      }
-    }
+    bool include_count = revealsCount(scfg);
 
     if (id.role == ROLE_DATAOWNER) {
       return setupMoments(
@@ -284,4 +388,80 @@ std::unique_ptr<Fronctocol> startup(
   return nullptr;
 }
 
+bool pregenerate(
+    std::string const & lookupTableDirectory,
+    std::string const & randomnessDirectory,
+    Query const & q,
+    StudyConfig const & scfg,
+    Identity const & id,
+    size_t const count) {
+  std::vector<size_t> left_keys;
+  std::vector<size_t> right_keys;
+
+  size_t leftVert;
+  size_t rightVert;
+
+  if (!findKeyCols(
+          *q.joinStatement,
+          left_keys,
+          right_keys,
+          &leftVert,
+          &rightVert,
+          scfg)) {
+    return false;
+  }
+
+  PeerSet peers;
+  findPeers(leftVert, rightVert, scfg, peers);
+
+  if (id.role != ROLE_DEALER || !peers.hasPeer(id)) {
+    log_error("only the query's dealer may pregenerate randomness");
+    return false;
+  }
+
+  safrn::dataowner::GlobalInfo global_info =
+      safrn::dataowner::generateGlobals(q, scfg);
+
+  std::vector<size_t> left_payloads;
+  std::vector<size_t> right_payloads;
+
+  if (q.function->type == FunctionType::LIN_REGRESSION) {
+    size_t dep_vert;
+    if (!findPayloadRegression(
+            static_cast<LinearRegressionFunction &>(*q.function),
+            left_payloads,
+            right_payloads,
+            leftVert,
+            rightVert,
+            &dep_vert,
+            scfg)) {
+      return false;
+    }
+
+    return pregenerateRegression(
+        &global_info,
+        left_payloads,
+        right_payloads,
+        dep_vert,
+        leftVert,
+        static_cast<LinearRegressionFunction &>(*q.function)
+            .fit_intercept,
+        id,
+        scfg,
+        peers,
+        F_tableFile(
+            lookupTableDirectory, left_payloads, right_payloads),
+        t_tableFile(lookupTableDirectory),
+        randomnessDirectory,
+        count);
+  } else if (q.function->type == FunctionType::MOMENT) {
+    /** Moments only uses fortissimo's randomness, none is stored. */
+    log_info("moments has no randomness to pregenerate");
+    return true;
+  }
+
+  log_error("unsupported function");
+  return false;
+}
+
 } // namespace safrn
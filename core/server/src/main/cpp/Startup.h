@@ -26,6 +26,8 @@ namespace safrn {
  * @param the StudyConfig object
  * @param the Identity of this party
  * @param (return by reference) the peers participating in the query
+ * @param the dataowner's store of pre-generated randomness (empty to
+ *        take all randomness from the dealer)
  * @return a fronctocol to run (nullptr if not a participant, or invalid query)
  */
 std::unique_ptr<Fronctocol> startup(
@@ -34,7 +36,37 @@ std::unique_ptr<Fronctocol> startup(
     Query const & q,
     StudyConfig const & scfg,
     Identity const & id,
-    PeerSet & peers);
+    PeerSet & peers,
+    std::string const & randomnessDirectory = std::string(""));
+
+/**
+ * Adds every participant of the study, in each of its roles, to the
+ * peer set.
+ *
+ * @param the StudyConfig object
+ * @param (return by reference) the study's peers
+ */
+void findStudyPeers(StudyConfig const & scfg, PeerSet & peers);
+
+/**
+ * Pre-generates the dealer's randomness for count runs of a query,
+ * writing one shard for each dataowner into the randomness directory.
+ *
+ * @param the directory of lookup tables
+ * @param the directory to write randomness into
+ * @param the Query object
+ * @param the StudyConfig object
+ * @param the Identity of this party (must be the dealer)
+ * @param the number of queries to generate randomness for
+ * @return true on success
+ */
+bool pregenerate(
+    std::string const & lookupTableDirectory,
+    std::string const & randomnessDirectory,
+    Query const & q,
+    StudyConfig const & scfg,
+    Identity const & id,
+    size_t const count);
 
 } // namespace safrn
 
@@ -123,7 +123,9 @@ std::unique_ptr<Fronctocol> setupMoments(
           scfg,
           id,
           rinfo->startModulus,
-          global_info->bitsOfPrecision)) {
+          global_info->bitsOfPrecision,
+          global_info->key_max,
+          global_info->keySigned)) {
     return nullptr;
   }
 
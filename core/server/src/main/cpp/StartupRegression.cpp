@@ -2,13 +2,19 @@
  * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
  */
 
+#include <algorithm>
+
 #include <StartupRegression.h>
 #include <StartupUtils.h>
 
+#include <dataowner/LookupTable.h>
+#include <dataowner/ObservationStore.h>
 #include <dataowner/Regression.h>
 #include <dataowner/RegressionInfo.h>
 #include <dataowner/fortissimo.h>
+#include <dealer/RandomTableLookup.h>
 #include <dealer/RegressionHouse.h>
+#include <util/RandomnessStore.h>
 
 /* Logging Config */
 #include <ff/logging.h>
@@ -77,6 +83,7 @@ dataowner::RegressionInfo const * setupRegressionInfo(
     size_t dependentVertical,
     size_t leftVertical,
     const bool fit_intercept,
+    std::vector<dataowner::BatchedMoments> const & batched_moments,
     PeerSet const & peers,
     Identity const & id) {
   size_t vertDV_len;
@@ -130,7 +137,8 @@ dataowner::RegressionInfo const * setupRegressionInfo(
       numCrossParties,
       fit_intercept,
       revealer,
-      dealer);
+      dealer,
+      batched_moments);
 }
 
 std::unique_ptr<Fronctocol> setupRegression(
@@ -141,12 +149,14 @@ std::unique_ptr<Fronctocol> setupRegression(
     size_t dependentVertical,
     size_t leftVertical,
     const bool fit_intercept,
+    std::vector<dataowner::BatchedMoments> const & batched_moments,
     Identity const & id,
     StudyConfig const & scfg,
     PeerSet const & peers,
     std::string const & csvFile,
     std::string const & F_table_file,
-    std::string const & t_table_file) {
+    std::string const & t_table_file,
+    std::string const & randomnessDirectory) {
   std::unique_ptr<dataowner::RegressionInfo const> rinfo(
       setupRegressionInfo(
           global_info_pointer,
@@ -155,10 +165,14 @@ std::unique_ptr<Fronctocol> setupRegression(
           dependentVertical,
           leftVertical,
           fit_intercept,
+          batched_moments,
           peers,
           id));
+  if (rinfo == nullptr) {
+    return nullptr;
+  }
 
-  ff::mpc::ObservationList<dataowner::LargeNum> oList;
+  dataowner::ObservationStore ownStore;
 
   size_t extra_precis_col = SIZE_MAX;
   if (id.vertical == dependentVertical) {
@@ -167,9 +181,9 @@ std::unique_ptr<Fronctocol> setupRegression(
             .back();
   }
 
-  if (!readCSV(
+  if (!readCSVColumns(
           csvFile,
-          oList,
+          ownStore,
           keys,
           (leftVertical == id.vertical) ? left_payloads :
                                           right_payloads,
@@ -177,28 +191,179 @@ std::unique_ptr<Fronctocol> setupRegression(
           scfg,
           id,
           rinfo->startModulus,
-          global_info_pointer->bitsOfPrecision)) {
+          global_info_pointer->bitsOfPrecision,
+          global_info_pointer->key_max,
+          global_info_pointer->keySigned)) {
     return nullptr;
   }
 
   if (fit_intercept && id.vertical == dependentVertical) {
-    for (size_t i = 0; i < oList.elements.size(); i++) {
-      dataowner::LargeNum dv =
-          oList.elements[i].arithmeticPayloadCols.back();
-      oList.elements[i].arithmeticPayloadCols.back() =
-          (dataowner::LargeNum(1)
-           << global_info_pointer->bitsOfPrecision);
-      oList.elements[i].arithmeticPayloadCols.push_back(dv);
+    /* insert a column of ones before the dependent variable */
+    std::vector<std::vector<dataowner::LargeNum>> & cols =
+        ownStore.arithmeticPayloadCols;
+    cols.emplace(
+        cols.end() - 1,
+        ownStore.numRows(),
+        dataowner::LargeNum(
+            dataowner::LargeNum(1)
+            << global_info_pointer->bitsOfPrecision));
+  }
+
+  /* The batched moments' data columns, read at single precision. */
+  std::vector<size_t> moments_cols;
+  for (dataowner::BatchedMoments const & moments : batched_moments) {
+    if (moments.dataVertical == id.vertical &&
+        std::find(
+            moments_cols.begin(),
+            moments_cols.end(),
+            moments.dataColumn) == moments_cols.end()) {
+      moments_cols.push_back(moments.dataColumn);
     }
   }
 
+  std::vector<std::vector<dataowner::LargeNum>> moments_data;
+  if (!moments_cols.empty()) {
+    dataowner::ObservationStore moments_store;
+    if (!readCSVColumns(
+            csvFile,
+            moments_store,
+            std::vector<size_t>(),
+            moments_cols,
+            SIZE_MAX,
+            scfg,
+            id,
+            rinfo->startModulus,
+            global_info_pointer->bitsOfPrecision)) {
+      return nullptr;
+    }
+
+    for (dataowner::BatchedMoments const & moments : batched_moments) {
+      if (moments.dataVertical == id.vertical) {
+        size_t const place = static_cast<size_t>(
+            std::find(
+                moments_cols.begin(),
+                moments_cols.end(),
+                moments.dataColumn) -
+            moments_cols.begin());
+        moments_data.push_back(
+            moments_store.arithmeticPayloadCols[place]);
+      }
+    }
+  }
+
+  std::unique_ptr<RandomnessStore const> store;
+  if (!randomnessDirectory.empty()) {
+    store.reset(new RandomnessStore(
+        randomnessDirectory,
+        dbuidToStr(scfg.studyId),
+        dbuidToStr(id.orgId)));
+  }
+
   std::unique_ptr<Fronctocol> ret(new dataowner::Regression(
-      std::move(oList),
+      std::move(ownStore),
       F_table_file,
       t_table_file,
       global_info_pointer,
-      std::move(rinfo)));
+      std::move(rinfo),
+      std::move(store),
+      std::move(moments_data)));
   return ret;
 }
 
+bool pregenerateRegression(
+    safrn::dataowner::GlobalInfo const * const global_info_pointer,
+    std::vector<size_t> const & left_payloads,
+    std::vector<size_t> const & right_payloads,
+    size_t dependentVertical,
+    size_t leftVertical,
+    const bool fit_intercept,
+    Identity const & id,
+    StudyConfig const & scfg,
+    PeerSet const & peers,
+    std::string const & F_table_file,
+    std::string const & t_table_file,
+    std::string const & randomnessDirectory,
+    size_t const count) {
+  std::unique_ptr<dataowner::RegressionInfo const> rinfo(
+      setupRegressionInfo(
+          global_info_pointer,
+          left_payloads,
+          right_payloads,
+          dependentVertical,
+          leftVertical,
+          fit_intercept,
+          std::vector<dataowner::BatchedMoments>(),
+          peers,
+          id));
+  if (rinfo == nullptr) {
+    return false;
+  }
+
+  /** The table sizes are only known from the tables themselves. */
+  std::vector<size_t> row_ids;
+  dataowner::LookupTable F_table;
+  dataowner::LookupTable t_table;
+  dataowner::LargeNum num_cols;
+  size_t bits_of_precision;
+  dataowner::LargeNum step_size;
+  if (!dataowner::loadLookupTable(
+          F_table_file,
+          row_ids,
+          F_table,
+          num_cols,
+          bits_of_precision,
+          step_size,
+          rinfo->max_F_t_table_num_rows,
+          rinfo->bytesInLookupTableCells) ||
+      !dataowner::loadLookupTable(
+          t_table_file,
+          row_ids,
+          t_table,
+          num_cols,
+          bits_of_precision,
+          step_size,
+          rinfo->max_F_t_table_num_rows,
+          rinfo->bytesInLookupTableCells)) {
+    return false;
+  }
+  dealer::RandomTableLookupInfo const F_info(
+      rinfo->endModulus,
+      static_cast<dataowner::SmallNum>(F_table.size()));
+  dealer::RandomTableLookupInfo const t_info(
+      rinfo->endModulus,
+      static_cast<dataowner::SmallNum>(t_table.size()));
+
+  std::vector<RandomnessStore> shards;
+  peers.forEachDataowner([&](Identity const & other) {
+    shards.emplace_back(
+        randomnessDirectory,
+        dbuidToStr(scfg.studyId),
+        dbuidToStr(other.orgId));
+  });
+  if (shards.empty()) {
+    log_error("no dataowners to generate randomness for");
+    return false;
+  }
+
+  std::string const key = dataowner::RegressionStoredRandomness::key(
+      shards.front(), rinfo.get(), F_info, t_info);
+  uint64_t batch = 0;
+  for (RandomnessStore const & shard : shards) {
+    batch = std::max(batch, shard.endBatch(key));
+  }
+
+  for (size_t i = 0; i < count; i++, batch++) {
+    if (!dataowner::RegressionStoredRandomness::pregenerate(
+            shards, key, batch, rinfo.get(), F_info, t_info)) {
+      log_error("failed to write randomness batch %zu", (size_t)batch);
+      return false;
+    }
+  }
+  log_info(
+      "generated %zu batches of regression randomness under %s",
+      count,
+      key.c_str());
+  return true;
+}
+
 } // namespace safrn
@@ -47,6 +47,7 @@ extern dataowner::RegressionInfo const * setupRegressionInfo(
     size_t dependentVertical,
     size_t leftVertical,
     const bool fit_intercept,
+    std::vector<dataowner::BatchedMoments> const & batched_moments,
     PeerSet const & peers,
     Identity const & id);
 
@@ -58,12 +59,34 @@ extern std::unique_ptr<Fronctocol> setupRegression(
     size_t dependentVertical,
     size_t leftVertical,
     const bool fit_intercept,
+    std::vector<dataowner::BatchedMoments> const & batched_moments,
     Identity const & id,
     StudyConfig const & scfg,
     PeerSet const & peers,
     std::string const & csvFile,
     std::string const & F_table_file,
-    std::string const & t_table_file);
+    std::string const & t_table_file,
+    std::string const & randomnessDirectory);
+
+/**
+ * Generates count batches of the regression's stored randomness (see
+ * RegressionStoredRandomness) into randomnessDirectory, sharded for
+ * each of the dataowners.
+ */
+extern bool pregenerateRegression(
+    safrn::dataowner::GlobalInfo const * const global_info_pointer,
+    std::vector<size_t> const & left_payloads,
+    std::vector<size_t> const & right_payloads,
+    size_t dependentVertical,
+    size_t leftVertical,
+    const bool fit_intercept,
+    Identity const & id,
+    StudyConfig const & scfg,
+    PeerSet const & peers,
+    std::string const & F_table_file,
+    std::string const & t_table_file,
+    std::string const & randomnessDirectory,
+    size_t const count);
 
 } // namespace safrn
 
@@ -2,16 +2,32 @@
  * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
  */
 
+/* C and POSIX Headers */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* C++ Headers */
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+
+#include <JSON/Columns/IntegerColumn.h>
 #include <StartupUtils.h>
 
-#include <Util/read_file_utils.h> // Paul's stuff, if we decide it's worth it
-#include <Util/string_utils.h> // Paul's string stuff
-
 /* Logging Config */
 #include <ff/logging.h>
 
 namespace safrn {
 
+/**
+ * Bits of the fraction shifted into the result by each multiply. A
+ * double's fraction fits in 53 bits, so one multiply usually suffices.
+ */
+static size_t const FIXED_POINT_CHUNK_BITS = 63;
+
 dataowner::LargeNum convertDoubleToLargeNum(
     double val, size_t bitsOfPrecision, dataowner::LargeNum modulus) {
   if (val < 0) {
@@ -19,171 +35,418 @@ dataowner::LargeNum convertDoubleToLargeNum(
         convertDoubleToLargeNum(-1 * val, bitsOfPrecision, modulus);
   }
 
-  log_debug("Double value %lf", val);
-
   /** to round the last bit instead of truncating */
-  val += pow(0.5, 1 + bitsOfPrecision);
+  val += std::ldexp(0.5, -static_cast<int>(bitsOfPrecision));
 
-  dataowner::LargeNum ret = static_cast<dataowner::LargeNum>(
-      static_cast<uint64_t>(floor(val)));
+  double const whole = std::floor(val);
+  double frac = val - whole;
 
-  val -= floor(val);
+  dataowner::LargeNum ret =
+      static_cast<dataowner::LargeNum>(static_cast<uint64_t>(whole));
 
-  log_debug("Double value %lf", val);
-  log_debug("Return value %s", ff::mpc::dec(ret).c_str());
+  /** scaling by a power of two is exact, so no bits are lost here. */
+  size_t remaining = bitsOfPrecision;
+  while (remaining > 0) {
+    size_t const chunk = std::min(remaining, FIXED_POINT_CHUNK_BITS);
+    frac = std::ldexp(frac, static_cast<int>(chunk));
+    double const bits = std::floor(frac);
+    frac -= bits;
 
-  for (size_t i = 0; i < bitsOfPrecision; i++) {
-    ret *= 2;
-    val *= 2;
-    log_debug("Double value %lf", val);
-    log_debug("Return value %s", ff::mpc::dec(ret).c_str());
-    ret += static_cast<uint64_t>(floor(val));
-    val -= floor(val);
-    log_debug("Double value %lf", val);
-    log_debug("Return value %s", ff::mpc::dec(ret).c_str());
+    ret = (ret << chunk) +
+        static_cast<dataowner::LargeNum>(static_cast<uint64_t>(bits));
+    remaining -= chunk;
   }
   return ret;
 }
 
-bool readCSV(
+namespace {
+
+/**
+ * Read-only mapping of an entire file, unmapped on destruction.
+ */
+class MappedCsvFile {
+public:
+  char const * begin = nullptr;
+  char const * end = nullptr;
+
+  MappedCsvFile() = default;
+  MappedCsvFile(MappedCsvFile const &) = delete;
+  MappedCsvFile & operator=(MappedCsvFile const &) = delete;
+
+  ~MappedCsvFile() {
+    if (this->map != MAP_FAILED) {
+      munmap(this->map, this->size);
+    }
+  }
+
+  bool open(std::string const & file) {
+    int const fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+      close(fd);
+      return false;
+    }
+    this->size = static_cast<size_t>(st.st_size);
+
+    /* mmap refuses empty files, which are left as empty ranges. */
+    if (this->size > 0) {
+      this->map =
+          mmap(nullptr, this->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    }
+    close(fd);
+
+    if (this->size > 0 && this->map == MAP_FAILED) {
+      return false;
+    }
+    if (this->map != MAP_FAILED) {
+      madvise(this->map, this->size, MADV_SEQUENTIAL);
+      this->begin = static_cast<char const *>(this->map);
+      this->end = this->begin + this->size;
+    }
+    return true;
+  }
+
+private:
+  void * map = MAP_FAILED;
+  size_t size = 0;
+};
+
+bool isCsvSpace(char const c) {
+  return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+}
+
+/**
+ * Returns the end of the line beginning at p, not including the '\n'.
+ */
+char const * csvLineEnd(char const * p, char const * end) {
+  void const * nl = memchr(p, '\n', static_cast<size_t>(end - p));
+  return nl == nullptr ? end : static_cast<char const *>(nl);
+}
+
+/**
+ * Trims whitespace, including a Windows '\r', from both ends of a
+ * field or line.
+ */
+void csvTrim(char const *& b, char const *& e) {
+  while (b < e && isCsvSpace(*b)) {
+    b++;
+  }
+  while (e > b && isCsvSpace(*(e - 1))) {
+    e--;
+  }
+}
+
+/**
+ * Blank lines and comment lines (beginning with '#') hold no data.
+ */
+bool isCsvDataLine(char const * b, char const * e) {
+  csvTrim(b, e);
+  return b < e && *b != '#';
+}
+
+/**
+ * Parses a whole field as a double. strtod needs a C string, and the
+ * mapped file is not null terminated, so the field is copied: to the
+ * stack when short, as nearly all are, and to the heap otherwise.
+ */
+bool parseCsvDouble(char const * b, char const * e, double & val) {
+  size_t const len = static_cast<size_t>(e - b);
+  if (len == 0) {
+    return false;
+  }
+  char short_buf[64];
+  std::string long_buf;
+  char * buf = short_buf;
+  if (len < sizeof(short_buf)) {
+    memcpy(short_buf, b, len);
+    short_buf[len] = '\0';
+  } else {
+    long_buf.assign(b, e);
+    buf = &long_buf[0];
+  }
+  char * parsed_end = nullptr;
+  val = strtod(buf, &parsed_end);
+  return parsed_end == buf + len;
+}
+
+/**
+ * Parses a whole field of decimal digits as a key's magnitude. Any
+ * other character fails the field, rather than reaching the LargeNum
+ * conversion, which throws on malformed input.
+ */
+bool parseCsvKey(
+    char const * b, char const * e, dataowner::LargeNum & val) {
+  if (e - b <= 0) {
+    return false;
+  }
+  uint64_t acc = 0;
+  for (char const * p = b; p < e; p++) {
+    if (*p < '0' || *p > '9') {
+      return false;
+    }
+    acc = 10 * acc + static_cast<uint64_t>(*p - '0');
+  }
+
+  /* The common case, a key small enough to accumulate in a word. */
+  if (e - b < 20) {
+    val = static_cast<dataowner::LargeNum>(acc);
+    return true;
+  }
+  std::string const s(b, e);
+  val = static_cast<dataowner::LargeNum>(s.c_str());
+  return true;
+}
+
+/**
+ * Checks a key's magnitude and sign against its column's declared
+ * integer width, if any, then shifts it by keyOffset and checks that
+ * it lands in [0, keyMax].
+ */
+bool placeCsvKey(
+    dataowner::LargeNum const & magnitude,
+    bool const negative,
+    ColumnBase const & column,
+    dataowner::LargeNum const & keyOffset,
+    dataowner::LargeNum const & keyMax,
+    dataowner::LargeNum & val) {
+  bool is_signed = false;
+  if (column.type == ColumnDatatype::INTEGER ||
+      column.type == ColumnDatatype::BOOL) {
+    IntegerColumn const & col =
+        static_cast<IntegerColumn const &>(column);
+    is_signed = col.isSigned;
+    if (col.bits > 0) {
+      size_t const bits =
+          static_cast<size_t>(col.isSigned ? col.bits - 1 : col.bits);
+      dataowner::LargeNum const limit = dataowner::LargeNum(1) << bits;
+      if (negative ? magnitude > limit : magnitude >= limit) {
+        return false;
+      }
+    }
+  }
+
+  if (negative) {
+    if (!is_signed || magnitude > keyOffset) {
+      return false;
+    }
+    val = keyOffset - magnitude;
+  } else {
+    val = keyOffset + magnitude;
+  }
+  return val <= keyMax;
+}
+
+} // namespace
+
+bool readCSVColumns(
     std::string const & file,
-    ff::mpc::ObservationList<dataowner::LargeNum> & oList,
+    dataowner::ObservationStore & store,
     std::vector<size_t> const & keyCols,
     std::vector<size_t> const & payloadCols,
     size_t extra_precis_col,
     StudyConfig const & scfg,
     Identity const & id,
     dataowner::LargeNum const mod,
-    size_t bitsOfPrecision) {
-  log_debug("Calling readCSV");
+    size_t bitsOfPrecision,
+    dataowner::LargeNum const & keyMax,
+    bool const keySigned) {
+  log_debug("Calling readCSVColumns");
   log_assert(id.role == ROLE_DATAOWNER);
 
   // Issue #220
-  oList.numKeyCols = keyCols.size() + 1;
-  oList.numArithmeticPayloadCols = payloadCols.size();
-  oList.numXORPayloadCols = 0;
-
-  oList.elements.clear();
+  store = dataowner::ObservationStore();
 
-  std::ifstream input_stream(file);
-  if (!input_stream.is_open()) {
+  MappedCsvFile input;
+  if (!input.open(file)) {
     log_error("Error opening file %s", file.c_str());
     return false;
   }
 
-  std::string line;
-  std::vector<std::string> split_line;
+  char const * p = input.begin;
+  char const * const end = input.end;
+  if (p == end) {
+    log_error("could not read header line");
+    return false;
+  }
 
-  std::vector<std::string> headlines;
   std::vector<size_t> key_places;
   std::vector<size_t> payload_places;
-
-  size_t adjust_extra_precis_col = SIZE_MAX;
-
-  if (getline(input_stream, line)) {
-    file_reader_utils::RemoveWindowsTrailingCharacters(&line);
-    line = string_utils::RemoveAllWhitespace(line);
-
-    split_line.clear();
-    string_utils::Split(line, ",", &split_line);
-
-    key_places.resize(split_line.size(), SIZE_MAX);
-    payload_places.resize(split_line.size(), SIZE_MAX);
-
-    for (size_t k = 0; k < split_line.size(); k++) {
-      std::string & split = split_line[k];
-      bool col_found = false;
-      for (size_t i = 0; i < scfg.lexicon[id.vertical].columns.size();
-           i++) {
-        std::unique_ptr<ColumnBase> const & col =
-            scfg.lexicon[id.vertical].columns[i];
-        if (split == col->name) {
-          headlines.push_back(split);
-          col_found = true;
-
-          for (size_t j = 0; j < payloadCols.size(); j++) {
-            if (payloadCols[j] == i) {
-              payload_places[k] = j;
-            }
-            if (extra_precis_col == i) {
-              adjust_extra_precis_col = k;
-            }
+  std::vector<size_t> precision_bits;
+
+  char const * line_end = csvLineEnd(p, end);
+  while (true) {
+    char const * comma = static_cast<char const *>(
+        memchr(p, ',', static_cast<size_t>(line_end - p)));
+    char const * field_end = comma == nullptr ? line_end : comma;
+    char const * b = p;
+    char const * e = field_end;
+    csvTrim(b, e);
+
+    size_t const k = key_places.size();
+    key_places.push_back(SIZE_MAX);
+    payload_places.push_back(SIZE_MAX);
+    precision_bits.push_back(bitsOfPrecision);
+
+    bool col_found = false;
+    for (size_t i = 0; i < scfg.lexicon[id.vertical].columns.size();
+         i++) {
+      std::string const & name =
+          scfg.lexicon[id.vertical].columns[i]->name;
+      if (name.size() == static_cast<size_t>(e - b) &&
+          name.compare(0, name.size(), b, name.size()) == 0) {
+        col_found = true;
+
+        for (size_t j = 0; j < payloadCols.size(); j++) {
+          if (payloadCols[j] == i) {
+            payload_places[k] = j;
           }
+          if (extra_precis_col == i) {
+            precision_bits[k] = 2 * bitsOfPrecision;
+          }
+        }
 
-          for (size_t j = 0; j < keyCols.size(); j++) {
-            if (keyCols[j] == i) {
-              key_places[k] = j;
-            }
+        for (size_t j = 0; j < keyCols.size(); j++) {
+          if (keyCols[j] == i) {
+            key_places[k] = j;
           }
-          break;
         }
-      }
-      if (!col_found) {
-        log_error("Unknown Column \"%s\"", split.c_str());
-        return false;
+        break;
       }
     }
-  } else {
-    log_error("could not read header line");
-    return false;
-  }
-
-  log_debug("about to read");
-
-  while (getline(input_stream, line)) {
-    log_debug("Hi, line is %s", line.c_str());
-    file_reader_utils::RemoveWindowsTrailingCharacters(&line);
-    line = string_utils::RemoveAllWhitespace(line);
-    if (string_utils::HasPrefixString(line, "#")) {
-      continue;
+    if (!col_found) {
+      log_error("Unknown Column \"%s\"", std::string(b, e).c_str());
+      return false;
     }
-    split_line.clear();
-    string_utils::Split(line, ",", &split_line);
 
-    if (split_line.size() != headlines.size()) {
-      log_error("data line mismatches head line length");
-      return false;
+    if (comma == nullptr) {
+      break;
     }
+    p = comma + 1;
+  }
+  size_t const num_fields = key_places.size();
 
-    std::vector<dataowner::LargeNum> keys;
-    keys.resize(keyCols.size() + 1);
-    keys[keyCols.size()] = id.vertical;
-    std::vector<dataowner::LargeNum> payloads;
-    payloads.resize(payloadCols.size());
+  std::vector<ColumnBase const *> key_columns;
+  for (size_t const col : keyCols) {
+    key_columns.push_back(scfg.lexicon[id.vertical].columns[col].get());
+  }
+  dataowner::LargeNum const key_offset(
+      keySigned ? (keyMax + 1) / 2 : dataowner::LargeNum(0));
+
+  /* Count the data rows, so that the columns are allocated once. */
+  char const * const data_begin =
+      line_end == end ? line_end : line_end + 1;
+  size_t num_rows = 0;
+  for (p = data_begin; p < end;) {
+    line_end = csvLineEnd(p, end);
+    if (isCsvDataLine(p, line_end)) {
+      num_rows++;
+    }
+    p = line_end == end ? end : line_end + 1;
+  }
 
-    for (size_t i = 0; i < split_line.size(); i++) {
-      std::string & s = split_line[i];
-      if (payload_places[i] != SIZE_MAX) {
-        log_debug("Let's start here: %f", atof(s.c_str()));
+  log_debug("about to read %zu rows", num_rows);
 
-        size_t adjust_bits_of_precis = bitsOfPrecision;
-        if (i == adjust_extra_precis_col) {
-          adjust_bits_of_precis *= 2;
-        }
+  store = dataowner::ObservationStore(
+      num_rows, keyCols.size(), payloadCols.size(), 0);
 
-        dataowner::LargeNum ln = convertDoubleToLargeNum(
-            atof(s.c_str()), adjust_bits_of_precis, mod);
+  size_t row = 0;
+  for (p = data_begin; p < end;) {
+    line_end = csvLineEnd(p, end);
+    char const * const next = line_end == end ? end : line_end + 1;
+    if (!isCsvDataLine(p, line_end)) {
+      p = next;
+      continue;
+    }
 
-        log_debug("place %zu", payload_places[i]);
-        payloads[payload_places[i]] = ln;
+    for (size_t k = 0; k < num_fields; k++) {
+      char const * comma = static_cast<char const *>(
+          memchr(p, ',', static_cast<size_t>(line_end - p)));
+      if ((comma == nullptr) != (k + 1 == num_fields)) {
+        log_error("data line mismatches head line length");
+        return false;
+      }
+      char const * b = p;
+      char const * e = comma == nullptr ? line_end : comma;
+      csvTrim(b, e);
+
+      if (payload_places[k] != SIZE_MAX) {
+        double val;
+        if (!parseCsvDouble(b, e, val)) {
+          log_error(
+              "could not parse payload \"%s\"",
+              std::string(b, e).c_str());
+          return false;
+        }
+        store.arithmeticPayloadCols[payload_places[k]][row] =
+            convertDoubleToLargeNum(val, precision_bits[k], mod);
       }
-      if (key_places[i] != SIZE_MAX) {
-        log_debug("Here instead");
-        keys[key_places[i]] =
-            static_cast<dataowner::LargeNum>(s.c_str());
+      if (key_places[k] != SIZE_MAX) {
+        bool const negative = b < e && *b == '-';
+        dataowner::LargeNum magnitude;
+        if (!parseCsvKey(negative ? b + 1 : b, e, magnitude)) {
+          log_error(
+              "could not parse key \"%s\"", std::string(b, e).c_str());
+          return false;
+        }
+        if (!placeCsvKey(
+                magnitude,
+                negative,
+                *key_columns[key_places[k]],
+                key_offset,
+                keyMax,
+                store.keyCols[key_places[k]][row])) {
+          log_error(
+              "key \"%s\" is outside its column's declared range",
+              std::string(b, e).c_str());
+          return false;
+        }
       }
+
+      p = comma == nullptr ? line_end : comma + 1;
     }
 
-    std::vector<Boolean_t> XOR_payloads; // empty
-    oList.elements.emplace_back();
-    ff::mpc::Observation<dataowner::LargeNum> & o =
-        oList.elements.back();
+    row++;
+    p = next;
+  }
 
-    o.keyCols = std::move(keys);
-    o.arithmeticPayloadCols = std::move(payloads);
-    o.XORPayloadCols = std::move(XOR_payloads);
+  return true;
+}
+
+bool readCSV(
+    std::string const & file,
+    ff::mpc::ObservationList<dataowner::LargeNum> & oList,
+    std::vector<size_t> const & keyCols,
+    std::vector<size_t> const & payloadCols,
+    size_t extra_precis_col,
+    StudyConfig const & scfg,
+    Identity const & id,
+    dataowner::LargeNum const mod,
+    size_t bitsOfPrecision,
+    dataowner::LargeNum const & keyMax,
+    bool const keySigned) {
+  log_debug("Calling readCSV");
+
+  dataowner::ObservationStore store;
+  if (!readCSVColumns(
+          file,
+          store,
+          keyCols,
+          payloadCols,
+          extra_precis_col,
+          scfg,
+          id,
+          mod,
+          bitsOfPrecision,
+          keyMax,
+          keySigned)) {
+    return false;
   }
 
+  store.toObservationList(oList);
   return true;
 }
 
@@ -24,16 +24,45 @@
 #include <Identity.h>
 #include <PeerSet.h>
 
+#include <dataowner/GlobalInfo.h>
 #include <dataowner/Regression.h>
 #include <dataowner/RegressionInfo.h>
+#include <dataowner/ObservationStore.h>
 #include <dataowner/fortissimo.h>
 #include <dealer/RegressionHouse.h>
 
 namespace safrn {
 
+/**
+ * Converts a double to fixed point with the given bits of precision,
+ * rounding the last bit. Negative values wrap around the modulus.
+ */
 dataowner::LargeNum convertDoubleToLargeNum(
     double val, size_t bitsOfPrecision, dataowner::LargeNum modulus);
 
+/**
+ * Reads a CSV file into an observation store. The file is memory
+ * mapped and its fields are parsed in place; the columns are allocated
+ * once, after counting the data rows.
+ *
+ * Parameters are as for readCSV, below.
+ *
+ * @return true for success, false otherwise.
+ */
+bool readCSVColumns(
+    std::string const & file,
+    dataowner::ObservationStore & store,
+    std::vector<size_t> const & keyCols,
+    std::vector<size_t> const & payloadCols,
+    size_t extra_precis_col,
+    StudyConfig const & scfg,
+    Identity const & id,
+    dataowner::LargeNum const mod,
+    size_t bitsOfPrecision,
+    dataowner::LargeNum const & keyMax =
+        dataowner::LargeNum(dataowner::GlobalInfo::KEY_MAX_DEFAULT_VALUE),
+    bool const keySigned = false);
+
 /**
  * Reads a CSV file.
  *
@@ -46,6 +75,9 @@ dataowner::LargeNum convertDoubleToLargeNum(
  * @param the identity of this participant.
  * @param the modulus
  * @param bits of precision when converting inputs (double) to modulus field
+ * @param the largest key (see GlobalInfo::key_max). Keys outside it, or
+ *        outside their column's declared integer width, are rejected.
+ * @param whether keys are signed, and so shifted up by (keyMax + 1) / 2
  *
  * @return true for success, false otherwise.
  */
@@ -58,7 +90,10 @@ bool readCSV(
     StudyConfig const & scfg,
     Identity const & id,
     dataowner::LargeNum const mod,
-    size_t bitsOfPrecision);
+    size_t bitsOfPrecision,
+    dataowner::LargeNum const & keyMax =
+        dataowner::LargeNum(dataowner::GlobalInfo::KEY_MAX_DEFAULT_VALUE),
+    bool const keySigned = false);
 
 } // namespace safrn
 
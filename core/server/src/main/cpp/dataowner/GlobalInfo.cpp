@@ -2,11 +2,17 @@
  * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
  */
 
+#include <JSON/Columns/IntegerColumn.h>
 #include <JSON/Query/LinearRegressionFunction.h>
 #include <JSON/Query/MomentFunction.h>
 #include <JSON/Query/SafrnFunction.h>
 #include <dataowner/GlobalInfo.h>
 
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
 #include <ff/logging.h>
 
 namespace safrn {
@@ -14,6 +20,63 @@ namespace dataowner {
 
 static size_t kNumDataowners = 100;
 
+/**
+ * Sizes the keys by the join columns' declared integer widths, so that
+ * the key modulus (and with it every comparison in the merge) is no
+ * wider than the study needs. A signed column needs the full width of
+ * its type, and an unsigned one a bit more when joined against a
+ * signed one. Warns and leaves the default key_max unless both columns
+ * are integers and at least one declares its width.
+ */
+static void joinKeyDomain(
+    StudyConfig const & cfg,
+    ColumnSpec const & first_col,
+    ColumnSpec const & second_col,
+    LargeNum & key_max,
+    bool & key_signed) {
+  IntegerColumn const * cols[2] = {nullptr, nullptr};
+  ColumnSpec const * specs[2] = {&first_col, &second_col};
+  for (size_t i = 0; i < 2; i++) {
+    if (specs[i]->vertical >= cfg.lexicon.size() ||
+        specs[i]->column >=
+            cfg.lexicon[specs[i]->vertical].columns.size()) {
+      log_warn(
+          "join column is not in the lexicon, keys limited to %zu",
+          GlobalInfo::KEY_MAX_DEFAULT_VALUE);
+      return;
+    }
+    ColumnBase const & col =
+        *cfg.lexicon[specs[i]->vertical].columns[specs[i]->column];
+    if (col.type != ColumnDatatype::INTEGER &&
+        col.type != ColumnDatatype::BOOL) {
+      log_warn(
+          "join columns are not both integers, keys limited to %zu",
+          GlobalInfo::KEY_MAX_DEFAULT_VALUE);
+      return;
+    }
+    cols[i] = static_cast<IntegerColumn const *>(&col);
+  }
+
+  key_signed = cols[0]->isSigned || cols[1]->isSigned;
+  size_t bits = 0;
+  for (IntegerColumn const * col : cols) {
+    /* A width of 0 is undeclared, and does not bound the keys. */
+    if (col->bits == 0) {
+      continue;
+    }
+    size_t const col_bits = static_cast<size_t>(col->bits) +
+        ((key_signed && !col->isSigned) ? 1 : 0);
+    bits = std::max(bits, col_bits);
+  }
+  if (bits == 0) {
+    log_warn(
+        "join columns declare no width, keys limited to %zu",
+        GlobalInfo::KEY_MAX_DEFAULT_VALUE);
+    return;
+  }
+  key_max = (LargeNum(1) << bits) - 1;
+}
+
 GlobalInfo generateGlobals(Query const & q, StudyConfig const & cfg) {
   size_t max_list_size = cfg.maxListSize;
 
@@ -30,13 +93,33 @@ GlobalInfo generateGlobals(Query const & q, StudyConfig const & cfg) {
   const VerticalIndex_t first_vert = first_col.vertical;
   const VerticalIndex_t second_vert = second_col.vertical;
 
+  LargeNum key_max(GlobalInfo::KEY_MAX_DEFAULT_VALUE);
+  bool key_signed = false;
+  joinKeyDomain(cfg, first_col, second_col, key_max, key_signed);
+
+  // Each vertical's dataowners are bounded by its own list size, where
+  // the lexicon gives one below the study's.
+  std::vector<size_t> vertical_list_sizes(cfg.lexicon.size());
+  for (size_t v = 0; v < cfg.lexicon.size(); v++) {
+    size_t const size = cfg.lexicon[v].maxListSize;
+    vertical_list_sizes[v] =
+        (size == 0 || size > max_list_size) ? max_list_size : size;
+  }
+  auto list_size = [&](VerticalIndex_t const vert) {
+    return vert < vertical_list_sizes.size() ?
+        vertical_list_sizes[vert] :
+        max_list_size;
+  };
+
   size_t num_dataowners = 0;
+  size_t max_intersection_size = 0;
   for (auto it = cfg.peers.begin(); it != cfg.peers.end(); ++it) {
     const Peer & other = it->second;
     if (other.isDataowner() &&
         (other.dataowner.verticalIdx == first_vert ||
          other.dataowner.verticalIdx == second_vert)) {
       num_dataowners++;
+      max_intersection_size += list_size(other.dataowner.verticalIdx);
     }
   }
 
@@ -73,10 +156,15 @@ GlobalInfo generateGlobals(Query const & q, StudyConfig const & cfg) {
   return GlobalInfo(
       max_list_size,
       num_dataowners,
-      max_list_size * num_dataowners,
+      max_intersection_size,
       bits_of_precision,
       bytes_per_table_cell,
-      max_table_rows);
+      max_table_rows,
+      key_max,
+      key_signed,
+      std::move(vertical_list_sizes),
+      list_size(first_vert) + list_size(second_vert),
+      cfg.workingSetRows);
 }
 
 } // namespace dataowner
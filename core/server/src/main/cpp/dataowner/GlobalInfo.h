@@ -9,8 +9,12 @@
 #ifndef SAFRN_DATAOWNER_GLOBAL_INFO_H
 #define SAFRN_DATAOWNER_GLOBAL_INFO_H
 
+#include <utility>
+#include <vector>
+
 #include <JSON/Config/StudyConfig.h>
 #include <JSON/Query/Query.h>
+#include <dataowner/fortissimo.h>
 #include <framework/Framework.h>
 
 namespace safrn {
@@ -24,6 +28,19 @@ struct GlobalInfo {
       maxListSize; // 100 for now. Much larger, like 10**5 or 10**6 so in practice
   const size_t maxIntersectionSize;
 
+  /**
+   * Bounds on the rows of one dataowner, by the lexicon index of its
+   * vertical, each at most maxListSize. Verticals not listed are
+   * bounded by maxListSize.
+   */
+  const std::vector<size_t> verticalListSizes;
+
+  /**
+   * Rows of a list shared across the join, holding one dataowner's list
+   * from each of the two verticals, so the sum of their bounds.
+   */
+  const size_t joinedListSize;
+
   static const size_t BITS_OF_PRECISION_DEFAULT_VALUE =
       5; // alpha in wiki; 64 usually
   static const size_t BYTES_IN_LOOKUP_TABLE_CELLS_DEFAULT_VALUE = 4;
@@ -32,7 +49,20 @@ struct GlobalInfo {
   const size_t bitsOfPrecision;
   const size_t bytesInLookupTableCells;
   const size_t max_F_t_table_num_rows;
-  const size_t key_max;
+  /**
+   * Keys are read into [0, key_max]. Signed keys are shifted up by
+   * (key_max + 1) / 2 on reading, so that both verticals agree. This
+   * is a LargeNum, since a signed 64-bit column joined to an unsigned
+   * one needs 65 bits.
+   */
+  const LargeNum key_max;
+  const bool keySigned;
+
+  /**
+   * Rows a dataowner works on at a time, where it can, to bound its
+   * memory. Zero works on whole lists at once.
+   */
+  const size_t workingSetRows;
 
   /** function to use for general testing purposes */
   GlobalInfo(
@@ -42,14 +72,23 @@ struct GlobalInfo {
       const size_t bits_ = BITS_OF_PRECISION_DEFAULT_VALUE,
       const size_t bytes_ = BYTES_IN_LOOKUP_TABLE_CELLS_DEFAULT_VALUE,
       const size_t max_ = MAX_F_T_TABLE_NUM_ROWS_DEFAULT_VALUE,
-      const size_t key_max_ = KEY_MAX_DEFAULT_VALUE) :
+      const LargeNum key_max_ = LargeNum(KEY_MAX_DEFAULT_VALUE),
+      const bool keySigned_ = false,
+      std::vector<size_t> verticalListSizes_ = std::vector<size_t>(),
+      const size_t joinedListSize_ = 0,
+      const size_t workingSetRows_ = 0) :
       numDataowners(nDataowners),
       maxListSize(maxSize),
       maxIntersectionSize(maxIntersectionSize),
+      verticalListSizes(std::move(verticalListSizes_)),
+      joinedListSize(
+          joinedListSize_ == 0 ? 2 * maxSize : joinedListSize_),
       bitsOfPrecision(bits_),
       bytesInLookupTableCells(bytes_),
       max_F_t_table_num_rows(max_),
-      key_max(key_max_) {
+      key_max(key_max_),
+      keySigned(keySigned_),
+      workingSetRows(workingSetRows_) {
   }
 
   /** function to use when parsing actual queries */
@@ -57,11 +96,14 @@ struct GlobalInfo {
       numDataowners(nDataowners),
       maxListSize(maxSize),
       maxIntersectionSize(maxSize * numDataowners),
+      joinedListSize(2 * maxSize),
       bitsOfPrecision(BITS_OF_PRECISION_DEFAULT_VALUE),
       bytesInLookupTableCells(
           BYTES_IN_LOOKUP_TABLE_CELLS_DEFAULT_VALUE),
       max_F_t_table_num_rows(MAX_F_T_TABLE_NUM_ROWS_DEFAULT_VALUE),
-      key_max(KEY_MAX_DEFAULT_VALUE) {
+      key_max(KEY_MAX_DEFAULT_VALUE),
+      keySigned(false),
+      workingSetRows(0) {
   }
 
   /** Default barebones for 2 party tests */
@@ -69,11 +111,28 @@ struct GlobalInfo {
       numDataowners(2),
       maxListSize(100),
       maxIntersectionSize(26),
+      joinedListSize(2 * 100),
       bitsOfPrecision(BITS_OF_PRECISION_DEFAULT_VALUE),
       bytesInLookupTableCells(
           BYTES_IN_LOOKUP_TABLE_CELLS_DEFAULT_VALUE),
       max_F_t_table_num_rows(MAX_F_T_TABLE_NUM_ROWS_DEFAULT_VALUE),
-      key_max(KEY_MAX_DEFAULT_VALUE) {
+      key_max(KEY_MAX_DEFAULT_VALUE),
+      keySigned(false),
+      workingSetRows(0) {
+  }
+
+  /** The bound on the rows of a dataowner of the given vertical. */
+  size_t listSize(const size_t vertical) const {
+    return vertical < this->verticalListSizes.size() ?
+        this->verticalListSizes[vertical] :
+        this->maxListSize;
+  }
+
+  /** Rows to work on at a time, out of a list of the given rows. */
+  size_t chunkRows(const size_t rows) const {
+    return (this->workingSetRows == 0 || this->workingSetRows > rows) ?
+        rows :
+        this->workingSetRows;
   }
 };
 
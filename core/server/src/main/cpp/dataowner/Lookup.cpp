@@ -3,6 +3,8 @@
  */
 
 #include <dataowner/Lookup.h>
+#include <util/LargeNumArray.h>
+#include <util/ModColumns.h>
 
 /* logging configuration */
 #include <ff/logging.h>
@@ -13,17 +15,15 @@ namespace dataowner {
 Lookup::Lookup(
     LargeNum const locationShare,
     std::vector<Boolean_t> & output_p_value_shares,
-    std::vector<std::vector<Boolean_t>> const & tableData,
+    LookupTable const & table,
     LookupRandomness && randomness,
     dealer::RandomTableLookupInfo const * const info,
-    size_t const tableValueByteLength,
     const safrn::Identity * revealer) :
     output_p_value_shares(output_p_value_shares),
     locationShare(locationShare),
-    tableData(tableData),
+    table(table),
     randomness(std::move(randomness)),
     info(info),
-    tableValueByteLength(tableValueByteLength),
     revealer(revealer),
     compareInfo(info->r_modulus_, revealer) {
   this->randomTable =
@@ -158,18 +158,203 @@ void Lookup::sendIndexShare(LargeNum val) {
 void Lookup::computeFinalShare() {
   this->revealedValueDownsized =
       static_cast<size_t>(this->revealedValue);
-  this->output_p_value_shares.resize(this->tableValueByteLength);
-  for (size_t i = 0; i < this->randomTable.u_.size(); i++) {
-    // A[x-r+i] * u[i]
-    if (this->randomTable.u_[i] == 0x01) {
-      for (size_t j = 0; j < this->tableValueByteLength; j++) {
-        output_p_value_shares[j] ^=
-            this->tableData
-                [(this->revealedValueDownsized + i) %
-                 this->info->table_size_][j];
+  // XOR of A[x-r+i] * u[i]
+  this->table.rotatedInnerProduct(
+      this->randomTable.u_,
+      this->revealedValueDownsized,
+      this->output_p_value_shares);
+  this->complete();
+}
+
+MultiLookup::MultiLookup(
+    std::vector<LargeNum> && locationShares,
+    std::vector<std::vector<Boolean_t>> & outputs,
+    LookupTable const & table,
+    std::vector<LookupRandomness> && randomness,
+    dealer::RandomTableLookupInfo const * const info,
+    const safrn::Identity * revealer) :
+    locationShares(std::move(locationShares)),
+    outputs(outputs),
+    table(table),
+    randomness(std::move(randomness)),
+    info(info),
+    revealer(revealer),
+    compareInfo(info->r_modulus_, revealer) {
+  log_assert(this->randomness.size() == this->locationShares.size());
+  this->randomTables.reserve(this->randomness.size());
+  for (LookupRandomness & r : this->randomness) {
+    this->randomTables.emplace_back(
+        r.randomTableLookupDispenser->get());
+  }
+  this->rotations.assign(this->locationShares.size(), LargeNum(0));
+}
+
+void MultiLookup::init() {
+  log_debug("Calling init");
+  if (this->locationShares.empty()) {
+    this->outputs.clear();
+    this->complete();
+    return;
+  }
+
+  if (this->getSelf() == *this->revealer) {
+    this->getPeers().forEachDataowner([this](const Identity & other) {
+      if (other != this->getSelf()) {
+        this->numPeersAwaiting++;
       }
-    }
+    });
+  } else {
+    this->numPeersAwaiting = 1;
+  }
+
+  std::unique_ptr<Batch> compares(new Batch());
+  for (size_t m = 0; m < this->locationShares.size(); m++) {
+    compares->children.emplace_back(
+        new ff::mpc::Compare<SAFRN_TYPES, LargeNum, SmallNum>(
+            0,
+            ff::mpc::modSub(
+                this->locationShares[m],
+                this->randomTables[m].r_,
+                this->info->r_modulus_),
+            &this->compareInfo,
+            this->randomness[m].compareDispenser->get()));
+  }
+  this->invoke(std::move(compares), this->getPeers());
+}
+
+void MultiLookup::handleReceive(IncomingMessage & imsg) {
+  size_t const n = this->rotations.size();
+  std::vector<LargeNum> received(n);
+  if (!readLargeNumArray(
+          imsg,
+          received.data(),
+          n,
+          fixedWidthBytes(this->info->r_modulus_))) {
+    log_error("MultiLookup could not read rotations");
+    this->abort();
+    return;
+  }
+
+  if (this->getSelf() == *this->revealer) {
+    modAddColumn(
+        this->rotations.data(),
+        received.data(),
+        this->rotations.data(),
+        n,
+        this->info->r_modulus_);
+  } else {
+    this->rotations = std::move(received);
+  }
+
+  this->numPeersAwaiting--;
+  if (this->numPeersAwaiting == 0 &&
+      this->state == awaitingRotations) {
+    this->finish();
+  }
+}
+
+void MultiLookup::handleComplete(Fronctocol & f) {
+  auto & batch = static_cast<Batch &>(f);
+  switch (this->state) {
+    case awaitingCompare: {
+      log_debug("awaitingCompare");
+      std::unique_ptr<Batch> typeCasts(new Batch());
+      for (size_t m = 0; m < batch.children.size(); m++) {
+        typeCasts->children.emplace_back(
+            new ff::mpc::TypeCastFromBit<SAFRN_TYPES, LargeNum>(
+                static_cast<
+                    ff::mpc::
+                        Compare<SAFRN_TYPES, LargeNum, SmallNum> &>(
+                    *batch.children[m])
+                    .outputShare,
+                this->info->r_modulus_,
+                this->revealer,
+                this->randomness[m].typeCastFromBitDispenser->get()));
+      }
+      this->invoke(std::move(typeCasts), this->getPeers());
+      this->state = awaitingTypeCastFromBit;
+    } break;
+    case awaitingTypeCastFromBit: {
+      log_debug("awaitingTypeCastFromBit");
+      size_t const n = this->locationShares.size();
+
+      /* Shares of location - r, brought back into [0, table size). */
+      std::vector<LargeNum> shares(n);
+      for (size_t m = 0; m < n; m++) {
+        LargeNum const wrapped =
+            static_cast<
+                ff::mpc::TypeCastFromBit<SAFRN_TYPES, LargeNum> &>(
+                *batch.children[m])
+                .outputBitShare;
+        shares[m] = ((this->info->r_modulus_ + this->locationShares[m] -
+                      this->randomTables[m].r_) +
+                     wrapped * this->info->table_size_) %
+            this->info->r_modulus_;
+      }
+
+      if (this->getSelf() == *this->revealer) {
+        modAddColumn(
+            this->rotations.data(),
+            shares.data(),
+            this->rotations.data(),
+            n,
+            this->info->r_modulus_);
+      } else {
+        std::unique_ptr<OutgoingMessage> omsg(
+            new OutgoingMessage(*this->revealer));
+        writeLargeNumArray(
+            *omsg,
+            shares.data(),
+            n,
+            fixedWidthBytes(this->info->r_modulus_));
+        this->send(std::move(omsg));
+      }
+
+      this->state = awaitingRotations;
+      if (this->numPeersAwaiting == 0) {
+        this->finish();
+      }
+    } break;
+    default:
+      log_error("MultiLookup state machine in unexpected state");
+      this->abort();
+  }
+}
+
+void MultiLookup::handlePromise(Fronctocol &) {
+  log_error("Unexpected handlePromise in MultiLookup");
+  this->abort();
+}
+
+std::string MultiLookup::name() {
+  return std::string("Multi Lookup");
+}
+
+void MultiLookup::finish() {
+  size_t const n = this->rotations.size();
+  if (this->getSelf() == *this->revealer) {
+    this->getPeers().forEachDataowner(
+        [&, this](const Identity & other) {
+          if (other != this->getSelf()) {
+            std::unique_ptr<OutgoingMessage> omsg(
+                new OutgoingMessage(other));
+            writeLargeNumArray(
+                *omsg,
+                this->rotations.data(),
+                n,
+                fixedWidthBytes(this->info->r_modulus_));
+            this->send(std::move(omsg));
+          }
+        });
+  }
+
+  std::vector<std::vector<uint64_t> const *> us(n);
+  std::vector<size_t> offsets(n);
+  for (size_t m = 0; m < n; m++) {
+    us[m] = &this->randomTables[m].u_;
+    offsets[m] = static_cast<size_t>(this->rotations[m]);
   }
+  this->table.rotatedInnerProducts(us, offsets, this->outputs);
   this->complete();
 }
 
@@ -30,6 +30,7 @@
 #include <mpc/Randomness.h>
 #include <mpc/RandomnessDealer.h>
 
+#include <dataowner/LookupTable.h>
 #include <dataowner/fortissimo.h>
 #include <framework/Framework.h>
 
@@ -88,10 +89,9 @@ public:
   Lookup(
       LargeNum const locationShare,
       std::vector<Boolean_t> & output_p_value_shares,
-      std::vector<std::vector<Boolean_t>> const & tableData,
+      LookupTable const & table,
       LookupRandomness && randomess,
       dealer::RandomTableLookupInfo const * const info,
-      size_t const tableValueByteLength,
       const safrn::Identity * revealer);
 
   void init() override;
@@ -116,7 +116,6 @@ private:
   const std::string csvFileOfPublicTable;
   LookupRandomness randomness;
   dealer::RandomTableLookupInfo const * const info;
-  size_t tableValueByteLength;
 
   LargeNum revealedValue;
   size_t revealedValueDownsized;
@@ -128,7 +127,60 @@ private:
 
   size_t numPartiesAwaiting = 0;
 
-  std::vector<std::vector<Boolean_t>> const & tableData;
+  LookupTable const & table;
+};
+
+/**
+ * Many Lookups into the same table, as a Batch of Lookup would do, but
+ * with one message to open all of their rotations and a single pass
+ * over the table (see LookupTable::rotatedInnerProducts).
+ *
+ * Each lookup still draws its own LookupRandomness: the rotations are
+ * opened, so sharing one among lookups would open the differences of
+ * their locations.
+ */
+class MultiLookup : public Fronctocol {
+public:
+  /** outputs[m] is the result of looking up locationShares[m]. */
+  MultiLookup(
+      std::vector<LargeNum> && locationShares,
+      std::vector<std::vector<Boolean_t>> & outputs,
+      LookupTable const & table,
+      std::vector<LookupRandomness> && randomness,
+      dealer::RandomTableLookupInfo const * const info,
+      const safrn::Identity * revealer);
+
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+private:
+  enum MultiLookupState {
+    awaitingCompare,
+    awaitingTypeCastFromBit,
+    awaitingRotations
+  };
+  MultiLookupState state = awaitingCompare;
+
+  void finish();
+
+  std::vector<LargeNum> const locationShares;
+  std::vector<std::vector<Boolean_t>> & outputs;
+  LookupTable const & table;
+  std::vector<LookupRandomness> randomness;
+  std::vector<dealer::RandomTableLookup> randomTables;
+  dealer::RandomTableLookupInfo const * const info;
+  const safrn::Identity * revealer;
+  ff::mpc::CompareInfo<safrn::Identity, LargeNum, SmallNum> compareInfo;
+
+  /**
+   * The revealer sums the rotations' shares as they arrive, and the
+   * others await the opened rotations from the revealer.
+   */
+  std::vector<LargeNum> rotations;
+  size_t numPeersAwaiting = 0;
 };
 
 } // namespace dataowner
@@ -26,7 +26,10 @@ LookupRandomnessPatron::LookupRandomnessPatron(
         CompareInfo<safrn::Identity, LargeNum, SmallNum> const * const
             compareInfo,
     const safrn::Identity * dealerIdentity,
-    const size_t dispenserSize) :
+    const size_t dispenserSize,
+    std::unique_ptr<ff::mpc::RandomnessDispenser<
+        dealer::RandomTableLookup,
+        dealer::RandomTableLookupInfo>> storedTableLookups) :
     lookupDispenser(
         new ff::mpc::RandomnessDispenser<
             LookupRandomness,
@@ -37,22 +40,52 @@ LookupRandomnessPatron::LookupRandomnessPatron(
     dispenserSize(dispenserSize),
     numCompareNeeded(1),
     numTypeCastFromBitNeeded(1),
-    numTableLookupNeeded(
-        1) { // dispenserSize = num Lookups we're going to need
+    numTableLookupNeeded(1),
+    randomTableLookupDispenser(std::move(storedTableLookups)) {
+  // dispenserSize = num Lookups we're going to need
   log_debug("Constructor");
 }
 
 void LookupRandomnessPatron::init() {
   log_debug("Calling init on LookupPatron");
 
-  std::unique_ptr<Fronctocol> patron(
+  /** Same order as the LookupRandomnessHouse invokes its houses. */
+  std::unique_ptr<Fronctocol> comparePatron(
       new ff::mpc::
           CompareRandomnessPatron<SAFRN_TYPES, LargeNum, SmallNum>(
               this->compareInfo,
               dealerIdentity,
               this->numCompareNeeded * this->dispenserSize));
+  this->invokePatron(std::move(comparePatron), awaitingCompare);
+
+  std::unique_ptr<Fronctocol> typeCastFromBitPatron(
+      new ff::mpc::RandomnessPatron<
+          SAFRN_TYPES,
+          ff::mpc::TypeCastTriple<LargeNum>,
+          ff::mpc::TypeCastFromBitInfo<LargeNum>>(
+          *dealerIdentity,
+          this->numTypeCastFromBitNeeded * this->dispenserSize,
+          ff::mpc::TypeCastFromBitInfo<LargeNum>(
+              this->info->r_modulus_)));
+  this->invokePatron(
+      std::move(typeCastFromBitPatron), awaitingTypeCastFromBit);
+
+  if (this->randomTableLookupDispenser == nullptr) {
+    ::std::unique_ptr<Fronctocol> lookupPatron(
+        new SeededRandomnessPatron<
+            dealer::RandomTableLookup,
+            dealer::RandomTableLookupInfo>(
+            *dealerIdentity,
+            this->numTableLookupNeeded * this->dispenserSize,
+            *this->info));
+    this->invokePatron(::std::move(lookupPatron), awaitingLookup);
+  }
+}
+
+void LookupRandomnessPatron::invokePatron(
+    std::unique_ptr<Fronctocol> patron, LookupPatronPromiseState kind) {
+  this->awaitingPatrons.emplace(patron.get(), kind);
   this->invoke(std::move(patron), this->getPeers());
-  this->state = awaitingCompare;
 }
 
 void LookupRandomnessPatron::handleReceive(IncomingMessage & imsg) {
@@ -63,26 +96,23 @@ void LookupRandomnessPatron::handleReceive(IncomingMessage & imsg) {
 
 void LookupRandomnessPatron::handleComplete(Fronctocol & f) {
   log_debug("LookupPatron received handle complete");
-  switch (this->state) {
+  auto const awaiting = this->awaitingPatrons.find(&f);
+  if (awaiting == this->awaitingPatrons.end()) {
+    log_error("LookupPatron received completion from unknown patron");
+    return;
+  }
+  LookupPatronPromiseState const kind = awaiting->second;
+  this->awaitingPatrons.erase(awaiting);
+
+  switch (kind) {
     case awaitingCompare: {
+      log_debug("awaitingCompare");
       this->compareDispenser =
           std::move(static_cast<ff::mpc::CompareRandomnessPatron<
                         SAFRN_TYPES,
                         LargeNum,
                         SmallNum> &>(f)
                         .compareDispenser);
-
-      std::unique_ptr<Fronctocol> patron(
-          new ff::mpc::RandomnessPatron<
-              SAFRN_TYPES,
-              ff::mpc::TypeCastTriple<LargeNum>,
-              ff::mpc::TypeCastFromBitInfo<LargeNum>>(
-              *dealerIdentity,
-              this->numTypeCastFromBitNeeded * this->dispenserSize,
-              ff::mpc::TypeCastFromBitInfo<LargeNum>(
-                  this->info->r_modulus_)));
-      this->invoke(std::move(patron), this->getPeers());
-      this->state = awaitingTypeCastFromBit;
     } break;
     case awaitingTypeCastFromBit: {
       log_debug("awaitingTypeCastFromBit");
@@ -91,17 +121,6 @@ void LookupRandomnessPatron::handleComplete(Fronctocol & f) {
               ff::mpc::TypeCastTriple<LargeNum>,
               ff::mpc::TypeCastFromBitInfo<LargeNum>>> &>(f)
               .result);
-
-      ::std::unique_ptr<Fronctocol> patron(
-          new ::ff::mpc::RandomnessPatron<
-              SAFRN_TYPES,
-              dealer::RandomTableLookup,
-              dealer::RandomTableLookupInfo>(
-              *dealerIdentity,
-              this->numTableLookupNeeded * this->dispenserSize,
-              *this->info));
-      this->invoke(::std::move(patron), this->getPeers());
-      this->state = awaitingLookup;
     } break;
     case awaitingLookup: {
       log_debug("case awaitingLookup");
@@ -110,12 +129,14 @@ void LookupRandomnessPatron::handleComplete(Fronctocol & f) {
               dealer::RandomTableLookup,
               dealer::RandomTableLookupInfo>> &>(f)
               .result);
-
-      this->generateOutputDispenser();
     } break;
     default:
       log_error("State machine in unexpected state");
   }
+
+  if (this->awaitingPatrons.empty()) {
+    this->generateOutputDispenser();
+  }
 }
 
 void LookupRandomnessPatron::handlePromise(Fronctocol &) {
@@ -30,6 +30,7 @@
 #include <dataowner/fortissimo.h>
 #include <dealer/RandomTableLookup.h>
 #include <framework/Framework.h>
+#include <util/RandomnessDealer.h>
 
 /* logging configuration */
 #include <ff/logging.h>
@@ -56,17 +57,29 @@ public:
           CompareInfo<safrn::Identity, LargeNum, SmallNum> const * const
               compareInfo,
       safrn::Identity const * const dealerIdentity,
-      const size_t dispenserSize);
+      const size_t dispenserSize,
+      std::unique_ptr<ff::mpc::RandomnessDispenser<
+          dealer::RandomTableLookup,
+          dealer::RandomTableLookupInfo>> storedTableLookups = nullptr);
 
 private:
   void generateOutputDispenser();
 
+  /**
+   * All three patrons are invoked by init(), each outstanding child is
+   * tagged with the kind of randomness it is fetching. The table lookup
+   * patron is skipped when stored table lookups were given.
+   */
   enum LookupPatronPromiseState {
     awaitingCompare,
     awaitingTypeCastFromBit,
     awaitingLookup
   };
-  LookupPatronPromiseState state = awaitingCompare;
+  std::map<Fronctocol const *, LookupPatronPromiseState> awaitingPatrons;
+
+  void invokePatron(
+      std::unique_ptr<Fronctocol> patron,
+      LookupPatronPromiseState kind);
 
   dealer::RandomTableLookupInfo const * const info;
   ff::mpc::
@@ -79,8 +92,6 @@ private:
   const size_t numTypeCastFromBitNeeded;
   const size_t numTableLookupNeeded;
 
-  size_t numPartiesAwaiting;
-
   std::unique_ptr<ff::mpc::RandomnessDispenser<
       ff::mpc::CompareRandomness<LargeNum, SmallNum>,
       ff::mpc::DoNotGenerateInfo>>
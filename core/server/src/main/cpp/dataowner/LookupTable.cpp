@@ -0,0 +1,260 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <algorithm>
+#include <cstring>
+
+/* Safrn Headers */
+#include <dataowner/LookupTable.h>
+#include <dealer/RandomTableLookup.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+/**
+ * Maps each byte b to a word whose k-th byte in memory is 0xFF if bit
+ * k of b is set, and 0x00 otherwise.
+ */
+static std::vector<uint64_t> makeByteMasks() {
+  std::vector<uint64_t> masks(256);
+  for (size_t b = 0; b < 256; b++) {
+    uint8_t spread[sizeof(uint64_t)];
+    for (size_t k = 0; k < sizeof(uint64_t); k++) {
+      spread[k] = ((b >> k) & 0x01) ? 0xFF : 0x00;
+    }
+    memcpy(&masks[b], spread, sizeof(uint64_t));
+  }
+  return masks;
+}
+
+static std::vector<uint64_t> const BYTE_MASKS = makeByteMasks();
+
+/**
+ * Returns the 8 bits of u starting at bit i.
+ */
+static uint8_t bitsAt(std::vector<uint64_t> const & u, size_t const i) {
+  size_t const word = i / 64;
+  size_t const shift = i % 64;
+  uint64_t bits = u[word] >> shift;
+  if (shift > 56 && word + 1 < u.size()) {
+    bits |= u[word + 1] << (64 - shift);
+  }
+  return static_cast<uint8_t>(bits & 0xFF);
+}
+
+/**
+ * Returns the 8 bits of u starting at bit i, wrapping around at bit n,
+ * for u with no bits set past n.
+ */
+static uint8_t wrappedBitsAt(
+    std::vector<uint64_t> const & u, size_t const i, size_t const n) {
+  if (i + 8 <= n) {
+    return bitsAt(u, i);
+  }
+  return static_cast<uint8_t>(bitsAt(u, i) | (bitsAt(u, 0) << (n - i)));
+}
+
+/**
+ * Folds the bytes of a word spread by maskedXor into one.
+ */
+static Boolean_t foldWord(uint64_t const acc) {
+  uint8_t folded[sizeof(uint64_t)];
+  memcpy(folded, &acc, sizeof(uint64_t));
+  Boolean_t out = 0x00;
+  for (size_t k = 0; k < sizeof(uint64_t); k++) {
+    out ^= folded[k];
+  }
+  return out;
+}
+
+/**
+ * XORs together bytes[i] for each i < len where bit start + i of u is
+ * set. The result is spread across the bytes of the returned word.
+ */
+static uint64_t maskedXor(
+    std::vector<uint64_t> const & u,
+    size_t const start,
+    Boolean_t const * bytes,
+    size_t const len) {
+  uint64_t acc = 0;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t chunk;
+    memcpy(&chunk, bytes + i, sizeof(uint64_t));
+    acc ^= chunk & BYTE_MASKS[bitsAt(u, start + i)];
+  }
+  for (; i < len; i++) {
+    size_t const bit = start + i;
+    if ((u[bit / 64] >> (bit % 64)) & 0x01) {
+      acc ^= bytes[i];
+    }
+  }
+  return acc;
+}
+
+LookupTable::LookupTable(
+    std::vector<std::vector<Boolean_t>> const & entries,
+    size_t const valueByteLength) :
+    numEntries(entries.size()),
+    numBytes(valueByteLength),
+    columns(entries.size() * valueByteLength) {
+  for (size_t i = 0; i < this->numEntries; i++) {
+    for (size_t j = 0; j < this->numBytes; j++) {
+      this->columns[j * this->numEntries + i] = entries[i][j];
+    }
+  }
+}
+
+LookupTable::LookupTable(
+    std::shared_ptr<MappedLookupTable const> mapping) :
+    numEntries(static_cast<size_t>(mapping->header().numCells())),
+    numBytes(static_cast<size_t>(mapping->header().cell_bytes)),
+    mapping(std::move(mapping)) {
+}
+
+void LookupTable::rotatedInnerProduct(
+    std::vector<uint64_t> const & u,
+    size_t const offset,
+    std::vector<Boolean_t> & output) const {
+  output.assign(this->numBytes, 0x00);
+  if (this->numEntries == 0) {
+    return;
+  }
+
+  /* bits [0, wrap) of u line up with entries [offset, size), and
+   * bits [wrap, size) with entries [0, offset). */
+  size_t const start = offset % this->numEntries;
+  size_t const wrap = this->numEntries - start;
+  for (size_t j = 0; j < this->numBytes; j++) {
+    Boolean_t const * column =
+        this->columnData() + j * this->numEntries;
+    uint64_t const acc = maskedXor(u, 0, column + start, wrap) ^
+        maskedXor(u, wrap, column, start);
+    output[j] = foldWord(acc);
+  }
+}
+
+void LookupTable::rotatedInnerProducts(
+    std::vector<std::vector<uint64_t> const *> const & us,
+    std::vector<size_t> const & offsets,
+    std::vector<std::vector<Boolean_t>> & outputs) const {
+  size_t const num_vectors = us.size();
+  log_assert(offsets.size() == num_vectors);
+  outputs.assign(
+      num_vectors, std::vector<Boolean_t>(this->numBytes, 0x00));
+  if (this->numEntries == 0) {
+    return;
+  }
+
+  /* Entry i lines up with bit (i - offsets[m]) % size() of us[m]. */
+  size_t const n = this->numEntries;
+  std::vector<size_t> shifts(num_vectors);
+  for (size_t m = 0; m < num_vectors; m++) {
+    shifts[m] = n - offsets[m] % n;
+  }
+
+  std::vector<uint64_t> accs(num_vectors);
+  for (size_t j = 0; j < this->numBytes; j++) {
+    Boolean_t const * column = this->columnData() + j * n;
+    std::fill(accs.begin(), accs.end(), 0);
+
+    /* Each word of the column is loaded once for every vector. */
+    size_t i = 0;
+    for (; i + sizeof(uint64_t) <= n; i += sizeof(uint64_t)) {
+      uint64_t chunk;
+      memcpy(&chunk, column + i, sizeof(uint64_t));
+      for (size_t m = 0; m < num_vectors; m++) {
+        size_t const bit = (i + shifts[m]) % n;
+        accs[m] ^= chunk & BYTE_MASKS[wrappedBitsAt(*us[m], bit, n)];
+      }
+    }
+    for (; i < n; i++) {
+      for (size_t m = 0; m < num_vectors; m++) {
+        size_t const bit = (i + shifts[m]) % n;
+        if (((*us[m])[bit / 64] >> (bit % 64)) & 0x01) {
+          accs[m] ^= column[i];
+        }
+      }
+    }
+
+    for (size_t m = 0; m < num_vectors; m++) {
+      outputs[m][j] = foldWord(accs[m]);
+    }
+  }
+}
+
+bool loadLookupTable(
+    std::string const & csvFile,
+    std::vector<size_t> & rowIds,
+    LookupTable & table,
+    LargeNum & numCols,
+    size_t & bitsOfPrecision,
+    LargeNum & stepSize,
+    size_t const maxNumRows,
+    size_t const valueByteLength) {
+  std::shared_ptr<MappedLookupTable const> mapping =
+      MappedLookupTable::openShared(lookupTableBinaryFile(csvFile));
+  if (mapping != nullptr &&
+      mapping->header().cell_bytes == valueByteLength) {
+    LookupTableHeader const & header = mapping->header();
+    size_t const num_rows =
+        std::min(static_cast<size_t>(header.num_rows), maxNumRows);
+    rowIds.clear();
+    rowIds.reserve(num_rows);
+    for (size_t i = 0; i < num_rows; i++) {
+      rowIds.push_back(static_cast<size_t>(mapping->rowId(i)));
+    }
+    numCols = LargeNum(header.num_cols);
+    bitsOfPrecision = static_cast<size_t>(header.bits_of_precision);
+    stepSize = LargeNum(header.step_size);
+    if (num_rows == header.num_rows) {
+      table = LookupTable(std::move(mapping));
+      return true;
+    }
+
+    /* Leading rows are not contiguous column-major, so copy them. */
+    LookupTable const full(std::move(mapping));
+    std::vector<std::vector<Boolean_t>> entries(
+        num_rows * static_cast<size_t>(header.num_cols),
+        std::vector<Boolean_t>(valueByteLength));
+    for (size_t i = 0; i < entries.size(); i++) {
+      for (size_t j = 0; j < valueByteLength; j++) {
+        entries[i][j] = full.at(i, j);
+      }
+    }
+    table = LookupTable(entries, valueByteLength);
+    return true;
+  }
+
+  std::vector<std::vector<Boolean_t>> tableData;
+  if (!dealer::read_table_csv_file(
+          csvFile,
+          rowIds,
+          tableData,
+          numCols,
+          bitsOfPrecision,
+          stepSize,
+          maxNumRows,
+          valueByteLength)) {
+    return false;
+  }
+
+  /* read_table_csv_file reads every row, keep only the leading ones. */
+  if (rowIds.size() > maxNumRows) {
+    size_t const cols = tableData.size() / rowIds.size();
+    rowIds.resize(maxNumRows);
+    tableData.resize(maxNumRows * cols);
+  }
+  table = LookupTable(tableData, valueByteLength);
+  return true;
+}
+
+} // namespace dataowner
+} // namespace safrn
@@ -0,0 +1,124 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_DATAOWNER_LOOKUP_TABLE_H_
+#define SAFRN_DATAOWNER_LOOKUP_TABLE_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <mpc/templates.h>
+
+/* Safrn Headers */
+#include <Util/LookupTableFile.h>
+#include <dataowner/fortissimo.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+/**
+ * A public F or t table, as used by Lookup.
+ *
+ * Entries are held column-major: byte j of every entry is stored
+ * contiguously, so that the rotated inner product with a bit-packed
+ * one-hot vector (see RandomTableLookup) can run 8 entries to a word.
+ */
+class LookupTable {
+public:
+  LookupTable() = default;
+
+  /**
+   * Converts a table as read by read_table_csv_file, with entries of
+   * valueByteLength bytes each.
+   */
+  LookupTable(
+      std::vector<std::vector<Boolean_t>> const & entries,
+      size_t const valueByteLength);
+
+  /**
+   * Uses the cells of a mapped binary table in place, without copying.
+   */
+  explicit LookupTable(
+      std::shared_ptr<MappedLookupTable const> mapping);
+
+  size_t size() const {
+    return this->numEntries;
+  }
+
+  size_t valueByteLength() const {
+    return this->numBytes;
+  }
+
+  Boolean_t at(size_t const entry, size_t const byte) const {
+    return this->columnData()[byte * this->numEntries + entry];
+  }
+
+  /**
+   * XORs together every entry (offset + i) % size() for which bit i of
+   * the packed vector u is set, giving one byte of output per byte of
+   * an entry.
+   */
+  void rotatedInnerProduct(
+      std::vector<uint64_t> const & u,
+      size_t const offset,
+      std::vector<Boolean_t> & output) const;
+
+  /**
+   * The rotated inner products of many packed vectors at once, as by
+   * rotatedInnerProduct(*us[m], offsets[m], outputs[m]) for each m, in
+   * a single pass over the table.
+   */
+  void rotatedInnerProducts(
+      std::vector<std::vector<uint64_t> const *> const & us,
+      std::vector<size_t> const & offsets,
+      std::vector<std::vector<Boolean_t>> & outputs) const;
+
+private:
+  size_t numEntries = 0;
+  size_t numBytes = 0;
+
+  /* byte j of entry i is at columns[j * numEntries + i] */
+  std::vector<Boolean_t> columns;
+  std::shared_ptr<MappedLookupTable const> mapping;
+
+  Boolean_t const * columnData() const {
+    return this->mapping != nullptr ? this->mapping->cells()
+                                    : this->columns.data();
+  }
+};
+
+/**
+ * Loads an F or t table. The binary table next to the CSV file (see
+ * LookupTableFile.h) is mapped and shared with other queries when it
+ * exists and has valueByteLength byte cells, and otherwise the CSV is
+ * parsed with dealer::read_table_csv_file. Either way only the first
+ * maxNumRows rows are kept, and a mapped table cut short is copied.
+ */
+bool loadLookupTable(
+    std::string const & csvFile,
+    std::vector<size_t> & rowIds,
+    LookupTable & table,
+    LargeNum & numCols,
+    size_t & bitsOfPrecision,
+    LargeNum & stepSize,
+    size_t const maxNumRows,
+    size_t const valueByteLength);
+
+} // namespace dataowner
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_DATAOWNER_LOOKUP_TABLE_H_
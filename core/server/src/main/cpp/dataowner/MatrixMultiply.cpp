@@ -0,0 +1,176 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <memory>
+#include <utility>
+
+/* 3rd Party Headers */
+
+/* SAFRN Headers */
+#include <dataowner/MatrixMultiply.h>
+#include <util/LargeNumArray.h>
+#include <util/ModColumns.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+MatrixMultiply::MatrixMultiply(
+    ff::mpc::Matrix<LargeNum> const & x,
+    ff::mpc::Matrix<LargeNum> const & y,
+    dealer::MatrixBeaverTriple<LargeNum> && triple,
+    LargeNum const & modulus,
+    Identity const & revealer) :
+    output(triple.rows_, triple.cols_),
+    modulus(modulus),
+    revealer(revealer),
+    triple(std::move(triple)) {
+  size_t const rows = this->triple.rows_;
+  size_t const inner = this->triple.inner_;
+  size_t const cols = this->triple.cols_;
+
+  this->openedE.resize(rows * inner);
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t k = 0; k < inner; k++) {
+      this->openedE[i * inner + k] = x.at(i, k) % this->modulus;
+    }
+  }
+  this->openedF.resize(inner * cols);
+  for (size_t k = 0; k < inner; k++) {
+    for (size_t j = 0; j < cols; j++) {
+      this->openedF[k * cols + j] = y.at(k, j) % this->modulus;
+    }
+  }
+}
+
+void MatrixMultiply::init() {
+  size_t const rows = this->triple.rows_;
+  size_t const inner = this->triple.inner_;
+  size_t const cols = this->triple.cols_;
+
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t k = 0; k < inner; k++) {
+      this->openedE[i * inner + k] = ff::mpc::modSub(
+          this->openedE[i * inner + k],
+          this->triple.u_.at(i, k),
+          this->modulus);
+    }
+  }
+  for (size_t k = 0; k < inner; k++) {
+    for (size_t j = 0; j < cols; j++) {
+      this->openedF[k * cols + j] = ff::mpc::modSub(
+          this->openedF[k * cols + j],
+          this->triple.v_.at(k, j),
+          this->modulus);
+    }
+  }
+
+  size_t const width = fixedWidthBytes(this->modulus);
+  this->getPeers().forEach([&, this](Identity const & other) {
+    if (other == this->getSelf()) {
+      return;
+    }
+    std::unique_ptr<OutgoingMessage> omsg(new OutgoingMessage(other));
+    writeLargeNumArray(
+        *omsg, this->openedE.data(), this->openedE.size(), width);
+    writeLargeNumArray(
+        *omsg, this->openedF.data(), this->openedF.size(), width);
+    this->send(std::move(omsg));
+    this->numPeersAwaiting++;
+  });
+
+  if (this->numPeersAwaiting == 0) {
+    this->finish();
+  }
+}
+
+void MatrixMultiply::handleReceive(IncomingMessage & imsg) {
+  size_t const width = fixedWidthBytes(this->modulus);
+  std::vector<LargeNum> opened_e(this->openedE.size());
+  std::vector<LargeNum> opened_f(this->openedF.size());
+
+  bool success =
+      readLargeNumArray(imsg, opened_e.data(), opened_e.size(), width);
+  success = success &&
+      readLargeNumArray(imsg, opened_f.data(), opened_f.size(), width);
+  if (!success) {
+    log_error("MatrixMultiply could not read opened shares");
+    this->abort();
+    return;
+  }
+
+  modAddColumn(
+      this->openedE.data(),
+      opened_e.data(),
+      this->openedE.data(),
+      this->openedE.size(),
+      this->modulus);
+  modAddColumn(
+      this->openedF.data(),
+      opened_f.data(),
+      this->openedF.data(),
+      this->openedF.size(),
+      this->modulus);
+
+  this->numPeersAwaiting--;
+  if (this->numPeersAwaiting == 0) {
+    this->finish();
+  }
+}
+
+void MatrixMultiply::handleComplete(Fronctocol &) {
+  log_error("Unexpected handleComplete in MatrixMultiply");
+  this->abort();
+}
+
+void MatrixMultiply::handlePromise(Fronctocol &) {
+  log_error("Unexpected handlePromise in MatrixMultiply");
+  this->abort();
+}
+
+std::string MatrixMultiply::name() {
+  return std::string("Matrix Multiply");
+}
+
+void MatrixMultiply::finish() {
+  size_t const rows = this->triple.rows_;
+  size_t const inner = this->triple.inner_;
+  size_t const cols = this->triple.cols_;
+
+  ff::mpc::Matrix<LargeNum> e(std::move(this->openedE), rows, inner);
+  ff::mpc::Matrix<LargeNum> f(std::move(this->openedF), inner, cols);
+
+  /* XY = W + EV + UF, plus EF once. */
+  this->output = std::move(this->triple.w_);
+  dealer::modMatrixProductAdd(
+      e,
+      this->triple.v_,
+      this->output,
+      rows,
+      inner,
+      cols,
+      this->modulus);
+  dealer::modMatrixProductAdd(
+      this->triple.u_,
+      f,
+      this->output,
+      rows,
+      inner,
+      cols,
+      this->modulus);
+  if (this->revealer == this->getSelf()) {
+    dealer::modMatrixProductAdd(
+        e, f, this->output, rows, inner, cols, this->modulus);
+  }
+
+  this->complete();
+}
+
+} // namespace dataowner
+} // namespace safrn
@@ -0,0 +1,82 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_DATAOWNER_MATRIX_MULTIPLY_H_
+#define SAFRN_DATAOWNER_MATRIX_MULTIPLY_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* Fortissimo Headers */
+#include <ff/Fronctocol.h>
+#include <ff/Message.h>
+
+#include <mpc/MatrixMult.h> // For Matrix.
+
+#include <dataowner/fortissimo.h>
+#include <dealer/MatrixBeaverTriple.h>
+#include <framework/Framework.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+/**
+ * Multiplies an arithmetically shared (rows x inner) matrix X by a
+ * shared (inner x cols) matrix Y, using a single MatrixBeaverTriple
+ * (U, V, W = UV) where ff::mpc::MatrixMult would use a scalar Beaver
+ * triple for each of the rows * inner * cols terms.
+ *
+ * E = X - U and F = Y - V are opened together, in a single message to
+ * each peer, and then XY = W + EV + UF + EF, with EF added only by
+ * the revealer.
+ */
+class MatrixMultiply : public Fronctocol {
+public:
+  /** Shares of X and Y need not be reduced modulo the modulus. */
+  MatrixMultiply(
+      ff::mpc::Matrix<LargeNum> const & x,
+      ff::mpc::Matrix<LargeNum> const & y,
+      dealer::MatrixBeaverTriple<LargeNum> && triple,
+      LargeNum const & modulus,
+      Identity const & revealer);
+
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+  /** Shares of XY, once complete. */
+  ff::mpc::Matrix<LargeNum> output;
+
+private:
+  LargeNum const modulus;
+  Identity const revealer;
+  dealer::MatrixBeaverTriple<LargeNum> triple;
+
+  /* Row-major shares of X and Y, then opened E and F. */
+  std::vector<LargeNum> openedE;
+  std::vector<LargeNum> openedF;
+
+  size_t numPeersAwaiting = 0;
+
+  void finish();
+};
+
+} // namespace dataowner
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_DATAOWNER_MATRIX_MULTIPLY_H_
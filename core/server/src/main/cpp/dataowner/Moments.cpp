@@ -2,12 +2,18 @@
  * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
  */
 
+/* C++ Headers */
+#include <algorithm>
+
 #include <Util/read_file_utils.h> // Paul's stuff, if we ff::mpc::decide it's worth it
 #include <Util/string_utils.h> // Paul's string stuff
 #include <dataowner/Moments.h>
 
 #include <mpc/ObservationList.h>
 
+#include <util/LargeNumArray.h>
+#include <util/SeedPrg.h>
+
 /* logging configuration */
 #include <ff/logging.h>
 
@@ -113,16 +119,14 @@ void Moments::readInputFile() {
 void Moments::computePayloadVectorAndPadList() {
   log_debug("Calling computePayloadVectorAndPadList");
   // Issue #220
+  size_t const list_size =
+      this->globals->listSize(this->info->selfVertical);
   log_debug(
-      "This->ownList.elements.size() %zu, maxListSize %zu",
+      "This->ownList.elements.size() %zu, listSize %zu",
       this->ownList.elements.size(),
-      this->globals->maxListSize);
+      list_size);
   log_debug("this->info->payloadLength %zu", this->info->payloadLength);
 
-  log_debug(
-      "This->ownList.elements.size() %zu, maxListSize %zu",
-      this->ownList.elements.size(),
-      this->globals->maxListSize);
   /** These are already set above, but we re-set them to follow
     * the pattern laid out in Regression::computePayloadVectorAndPadlist
     * and to remind the reader what the values *should* be, since
@@ -132,19 +136,41 @@ void Moments::computePayloadVectorAndPadList() {
   this->ownList.numKeyCols = this->info->numKeyCols;
   this->ownList.numXORPayloadCols = 0;
 
-  while (this->ownList.elements.size() < this->globals->maxListSize) {
+  /* Pad past every real key, with zero payloads. */
+  while (this->ownList.elements.size() < list_size) {
     ff::mpc::Observation<LargeNum> o;
     o.arithmeticPayloadCols =
         std::vector<LargeNum>(this->ownList.numArithmeticPayloadCols);
-    o.keyCols = std::vector<LargeNum>(this->ownList.numKeyCols);
-    for (size_t i = 0; i < this->ownList.numKeyCols; i++) {
-      o.keyCols[i] =
-          ff::mpc::randomModP<LargeNum>(this->info->keyModulus);
-    }
+    o.keyCols = std::vector<LargeNum>(
+        this->ownList.numKeyCols, this->globals->key_max + 1);
     o.XORPayloadCols =
         std::vector<Boolean_t>(this->ownList.numXORPayloadCols);
     this->ownList.elements.push_back(o);
   }
+
+  /* Pack the vertical into the low bit, 2 * key + [not the data
+   * vertical], so the data vertical's row sorts first among equal
+   * keys. */
+  bool const is_data_vertical =
+      this->info->selfVertical == this->info->dataVertical;
+  LargeNum const tag(is_data_vertical ? 0 : 1);
+  for (ff::mpc::Observation<LargeNum> & o : this->ownList.elements) {
+    o.keyCols.resize(this->ownList.numKeyCols);
+    o.keyCols[1] = o.keyCols[0];
+    o.keyCols[0] = 2 * o.keyCols[0] + tag;
+  }
+
+  /* The data vertical's rows come first in each shared list,
+   * descending, so that the list is bitonic for ObliviousMerge. */
+  std::stable_sort(
+      this->ownList.elements.begin(),
+      this->ownList.elements.end(),
+      [is_data_vertical](
+          ff::mpc::Observation<LargeNum> const & a,
+          ff::mpc::Observation<LargeNum> const & b) {
+        return is_data_vertical ? b.keyCols[0] < a.keyCols[0] :
+                                  a.keyCols[0] < b.keyCols[0];
+      });
 }
 
 void Moments::setupCrossParties() {
@@ -164,70 +190,20 @@ void Moments::setupCrossParties() {
 
 void Moments::setupCrossVerticalShares() {
   log_debug("Calling setupCrossVerticalShares");
+  /* Shares are split and sent a column at a time. */
+  this->ownStore = ObservationStore::fromObservationList(this->ownList);
+  this->ownList = ff::mpc::ObservationList<LargeNum>();
+
+  this->sharedStores.reserve(this->info->numCrossParties);
   for (size_t i = 0; i < this->info->numCrossParties; i++) {
-    this->outgoingListShares.emplace_back();
-    this->outgoingListShares.back().elements.reserve(
-        this->globals->maxListSize); // just theirs
-    this->outgoingListShares.back().numKeyCols =
-        this->ownList.numKeyCols;
-    this->outgoingListShares.back().numArithmeticPayloadCols =
-        this->ownList.numArithmeticPayloadCols;
-    this->outgoingListShares.back().numXORPayloadCols =
-        this->ownList.numXORPayloadCols;
-
-    this->sharedLists.emplace_back();
-    this->sharedLists.back().elements.resize(
-        this->globals->maxListSize *
-        2); // twice as long to hold my shares and theirs
-    this->sharedLists.back().numKeyCols = this->ownList.numKeyCols;
-    this->sharedLists.back().numArithmeticPayloadCols =
-        this->ownList.numArithmeticPayloadCols;
-    this->sharedLists.back().numXORPayloadCols =
-        this->ownList.numXORPayloadCols;
-
-    for (size_t j = 0; j < this->globals->maxListSize; j++) {
-      ff::mpc::Observation<LargeNum> o;
-      ff::mpc::Observation<LargeNum> o_my_share;
-      for (size_t k = 0; k < this->ownList.numKeyCols; k++) {
-        auto rand_val =
-            ff::mpc::randomModP<LargeNum>(this->info->startModulus);
-        o.keyCols.push_back(rand_val);
-        o_my_share.keyCols.push_back(ff::mpc::modSub(
-            this->ownList.elements[j].keyCols[k],
-            rand_val,
-            this->info->keyModulus));
-      }
-      for (size_t k = 0; k < this->ownList.numArithmeticPayloadCols;
-           k++) {
-        auto rand_val =
-            ff::mpc::randomModP<LargeNum>(this->info->startModulus);
-        o.arithmeticPayloadCols.push_back(rand_val);
-        o_my_share.arithmeticPayloadCols.push_back(ff::mpc::modSub(
-            this->ownList.elements[j].arithmeticPayloadCols[k],
-            rand_val,
-            this->info->startModulus));
-      }
-      for (size_t k = 0; k < this->ownList.numXORPayloadCols; k++) {
-        auto rand_val = ff::mpc::randomByte();
-        o.XORPayloadCols.push_back(rand_val);
-        o_my_share.XORPayloadCols.push_back(
-            this->ownList.elements[j].XORPayloadCols[k] ^ rand_val);
-      }
-      this->sharedLists.back().elements
-          [j +
-           this->globals->maxListSize *
-               ((this->info->selfVertical != this->info->dataVertical) ?
-                    1 :
-                    0)] = std::move(o_my_share);
-      this->outgoingListShares.back().elements.push_back(o);
-    }
-  }
-  for (size_t i = 0; i < this->info->numCrossParties; i++) {
-    log_debug(
-        "shared list size %zu and outgoing list size %zu ",
-        this->sharedLists[i].elements.size(),
-        this->outgoingListShares[i].elements.size());
+    this->sharedStores.emplace_back(
+        this->info->listSizeData +
+            this->info->listSizeNonData, // my shares and theirs
+        this->ownStore.numKeyCols(),
+        this->ownStore.numArithmeticPayloadCols(),
+        this->ownStore.numXORPayloadCols());
   }
+  this->rowsReceived.assign(this->info->numCrossParties, 0);
   log_debug("Done setupCrossVerticalShares");
 }
 
@@ -244,7 +220,7 @@ void Moments::init() {
 
   log_debug("maxListSize? %zu", this->globals->maxListSize);
 
-  this->state = awaitingRandomnessAndSISOSort;
+  this->state = awaitingRandomnessAndMerge;
   this->setupCrossParties();
 
   this->shareWithCrossVerticalParties();
@@ -254,41 +230,53 @@ void Moments::init() {
 void Moments::shareWithCrossVerticalParties() {
   log_debug("Calling shareWithCrossVerticalParties");
 
-  log_debug("maxListSize? %zu", this->globals->maxListSize);
-
-  for (size_t i = 0; i < this->info->numCrossParties; i++) {
-    log_debug(
-        "shared list size %zu and outgoing list size %zu ",
-        this->sharedLists[i].elements.size(),
-        this->outgoingListShares[i].elements.size());
-  }
+  /* The data vertical's rows, then the other's, in each shared list. */
+  size_t const n = this->ownStore.numRows();
+  size_t const offset =
+      (this->info->selfVertical != this->info->dataVertical) ?
+      this->info->listSizeData :
+      0;
+  size_t const chunk = this->globals->chunkRows(n);
+  log_debug("listSize? %zu, chunk %zu", n, chunk);
+  SeedPrg prg(SeedPrg::newSeed());
+
+  /* Their shares are made and sent a chunk of rows at a time, so only
+   * one chunk of them is ever held. */
+  ObservationStore theirs(
+      chunk,
+      this->ownStore.numKeyCols(),
+      this->ownStore.numArithmeticPayloadCols(),
+      this->ownStore.numXORPayloadCols());
   size_t i = 0;
-
   this->getPeers().forEachDataowner([&, this](const Identity & other) {
     if (other.vertical != this->getSelf().vertical) {
-      std::unique_ptr<OutgoingMessage> omsg(new OutgoingMessage(other));
-      for (size_t j = 0; j < this->globals->maxListSize; j++) {
-        for (size_t k = 0; k < this->ownList.numKeyCols; k++) {
-          omsg->write<LargeNum>(
-              this->outgoingListShares[i].elements[j].keyCols[k]);
-        }
-        for (size_t k = 0; k < this->ownList.numArithmeticPayloadCols;
-             k++) {
-          omsg->write<LargeNum>(this->outgoingListShares[i]
-                                    .elements[j]
-                                    .arithmeticPayloadCols[k]);
-        }
-        for (size_t k = 0; k < this->ownList.numXORPayloadCols; k++) {
-          omsg->write<Boolean_t>(this->outgoingListShares[i]
-                                     .elements[j]
-                                     .XORPayloadCols[k]);
-        }
-      }
-      this->send(std::move(omsg));
+      size_t begin = 0;
+      do {
+        theirs.resizeRows(std::min(chunk, n - begin));
+        this->ownStore.shareRows(
+            prg,
+            this->info->keyModulus,
+            this->info->startModulus,
+            begin,
+            theirs,
+            this->sharedStores[i],
+            offset);
+        begin += theirs.numRows();
 
+        std::unique_ptr<OutgoingMessage> omsg(
+            new OutgoingMessage(other));
+        theirs.writeColumns(
+            *omsg,
+            fixedWidthBytes(this->info->keyModulus),
+            fixedWidthBytes(this->info->startModulus));
+        this->send(std::move(omsg));
+      } while (begin < n);
       i++;
     }
   });
+
+  /* Our rows are no longer needed once shared. */
+  this->ownStore = ObservationStore();
 }
 
 void Moments::invokeRandomnessPatron() {
@@ -310,50 +298,45 @@ void Moments::handleReceive(IncomingMessage & msg) {
       "Calling handleReceive with %zu parties remaining",
       this->numPartiesAwaiting);
   // Issue #220
-  /** TO-DO: Read in msg to sharedLists[crossPartyIndex][ind1..ind2] */
-
-  for (size_t i = 0; i < this->info->numCrossParties; i++) {
-    log_debug(
-        "shared list size %zu and outgoing list size %zu ",
-        this->sharedLists[i].elements.size(),
-        this->outgoingListShares[i].elements.size());
-  }
-
-  log_debug("maxListSize? %zu", this->globals->maxListSize);
-
-  for (size_t j = 0; j < this->globals->maxListSize; j++) {
-    ff::mpc::Observation<LargeNum> o;
-    for (size_t k = 0; k < this->ownList.numKeyCols; k++) {
-      LargeNum rand_val;
-      msg.read<LargeNum>(rand_val);
-
-      o.keyCols.push_back(rand_val);
-    }
-    for (size_t k = 0; k < this->ownList.numArithmeticPayloadCols;
-         k++) {
-      LargeNum rand_val;
-      msg.read<LargeNum>(rand_val);
-
-      o.arithmeticPayloadCols.push_back(rand_val);
-    }
-    for (size_t k = 0; k < this->ownList.numXORPayloadCols; k++) {
-      Boolean_t rand_val;
-      msg.read<Boolean_t>(rand_val);
-
-      o.XORPayloadCols.push_back(rand_val);
-    }
-    this->sharedLists[indexOfCrossParties[msg.sender]].elements
-        [j +
-         this->globals->maxListSize *
-             ((this->info->selfVertical == this->info->dataVertical) ?
-                  1 :
-                  0)] = std::move(o);
+  /* Shares arrive a chunk of rows at a time, in order. */
+  bool const is_data =
+      this->info->selfVertical == this->info->dataVertical;
+  size_t const rows =
+      is_data ? this->info->listSizeNonData : this->info->listSizeData;
+  size_t const index = indexOfCrossParties[msg.sender];
+  size_t const received = this->rowsReceived[index];
+  size_t const n =
+      std::min(this->globals->chunkRows(rows), rows - received);
+  size_t const offset =
+      (is_data ? this->info->listSizeData : 0) + received;
+  log_debug("listSize? %zu, rows %zu", rows, n);
+  ObservationStore & shared = this->sharedStores[index];
+  if (!shared.readColumns(
+          msg,
+          offset,
+          n,
+          fixedWidthBytes(this->info->keyModulus),
+          fixedWidthBytes(this->info->startModulus))) {
+    log_error("Could not read shares from cross-vertical party");
+    this->abort();
+    return;
   }
 
   log_debug("Did we get here?");
 
+  this->rowsReceived[index] += n;
+  if (this->rowsReceived[index] < rows) {
+    return;
+  }
   this->numPartiesAwaiting--;
   if (this->numPartiesAwaiting == 0) {
+    /* ObliviousMerge works on fortissimo's lists, so convert here. */
+    this->sharedLists.resize(this->sharedStores.size());
+    for (size_t j = 0; j < this->sharedStores.size(); j++) {
+      this->sharedStores[j].toObservationList(this->sharedLists[j]);
+      this->sharedStores[j] = ObservationStore();
+    }
+
     size_t i = 0;
     this->getPeers().forEachDataowner([&,
                                        this](const Identity & other) {
@@ -369,7 +352,7 @@ void Moments::handleReceive(IncomingMessage & msg) {
           temp_revealer = &other;
         }
 
-        std::unique_ptr<Fronctocol> siso_sort(new SISOSort(
+        std::unique_ptr<Fronctocol> merge(new ObliviousMerge(
             this->sharedLists[i],
             this->info->startModulus,
             this->info->keyModulus,
@@ -381,12 +364,12 @@ void Moments::handleReceive(IncomingMessage & msg) {
         ps.add(other);
         this->getPeers().forEachDealer(
             [&ps](const Identity & other2) { ps.add(other2); });
-        this->invoke(std::move(siso_sort), ps);
+        this->invoke(std::move(merge), ps);
         i++;
       }
     });
     this->numPartiesAwaiting = this->info->numCrossParties;
-    this->state = awaitingSISOSort;
+    this->state = awaitingMerge;
   }
 }
 
@@ -397,7 +380,7 @@ void Moments::handleComplete(Fronctocol & f) {
     auto * patron = dynamic_cast<MomentsRandomnessPatron *>(&f);
     if (patron == nullptr) {
       log_debug("no");
-      // i.e. fronctocol returned = SISOSORT
+      // i.e. fronctocol returned = ObliviousMerge
       this->numPartiesAwaiting--;
       if (this->numPartiesAwaiting == 0) {
         this->state = awaitingRandomnessOnly;
@@ -406,27 +389,31 @@ void Moments::handleComplete(Fronctocol & f) {
     } else {
       log_debug("yes");
       randomness = std::move(patron->MomentsDispenser->get());
-      log_debug("Move onto awaitingSISOSort");
+      log_debug("Move onto awaitingMerge");
       this->randomnessDone = true;
       if (this->state == awaitingRandomnessOnly) {
         this->numPartiesAwaiting =
             1; // so that we move on to zipAdjacent below
-        this->state = awaitingSISOSort;
+        this->state = awaitingMerge;
       } else {
-        this->state = awaitingSISOSort;
+        this->state = awaitingMerge;
         return;
       }
     }
   }
   switch (this->state) {
-    case (awaitingSISOSort): {
-      log_debug("awaitingSISOSort");
+    case (awaitingMerge): {
+      log_debug("awaitingMerge");
 
       //Issue #221
       this->numPartiesAwaiting--;
       if (this->numPartiesAwaiting == 0) {
 
         log_debug("and onto zipAdjacent");
+        for (ff::mpc::ObservationList<LargeNum> & list :
+             this->sharedLists) {
+          ObliviousMerge::dropPackedKey(list);
+        }
         size_t i = 0;
         this->zipAdjacentInfo.reserve(this->info->numCrossParties);
 
@@ -443,11 +430,11 @@ void Moments::handleComplete(Fronctocol & f) {
             log_assert(this->info != nullptr);
 
             /**
-              * The * 2 here is because the list doubles in
-              * length after sharing with one cross-vertical party
+              * The list holds both verticals' rows after sharing
+              * with one cross-vertical party
               */
             zipAdjacentInfo.emplace_back(
-                2 * this->globals->maxListSize,
+                this->info->zipAdjacentInfo.batchSize,
                 this->info->payloadLength,
                 0,
                 this->info->startModulus,
@@ -472,7 +459,7 @@ void Moments::handleComplete(Fronctocol & f) {
         log_debug("Done invoking batchedPayloadCompute");
         this->numPartiesAwaiting = this->info->numCrossParties;
 
-        vectorZippedAdjacent.resize(this->info->numCrossParties);
+        this->powerSumsStartModulus.resize(this->info->payloadLength);
         this->state = awaitingZipAdjacent;
       }
 
@@ -490,12 +477,24 @@ void Moments::handleComplete(Fronctocol & f) {
         }
       });
 
+      /* The zipped lists are only summed, so are summed in place as
+       * each arrives and are not kept, nor is the merged list. */
       //Issue #221
-      this->vectorZippedAdjacent[indexOfCrossParties[cross_party]] =
+      ff::mpc::ObservationList<LargeNum> const & zipped =
           static_cast<
               ff::mpc::ZipAdjacent<SAFRN_TYPES, LargeNum, SmallNum> &>(
               f)
               .zippedAdjacentPairs;
+      for (ff::mpc::Observation<LargeNum> const & o : zipped.elements) {
+        for (size_t i = 0; i < this->info->payloadLength; i++) {
+          this->powerSumsStartModulus[i] = ff::mpc::modAdd(
+              this->powerSumsStartModulus[i],
+              o.arithmeticPayloadCols[i],
+              this->info->startModulus);
+        }
+      }
+      this->sharedLists[indexOfCrossParties[cross_party]] =
+          ff::mpc::ObservationList<LargeNum>();
 
       //Issue #221
       this->numPartiesAwaiting--;
@@ -503,19 +502,6 @@ void Moments::handleComplete(Fronctocol & f) {
 
         log_debug("and onto modconvup");
 
-        this->powerSumsStartModulus.resize(this->info->payloadLength);
-        for (ff::mpc::ObservationList<LargeNum> o_list :
-             this->vectorZippedAdjacent) {
-          for (ff::mpc::Observation<LargeNum> o : o_list.elements) {
-            for (size_t i = 0; i < this->info->payloadLength; i++) {
-              this->powerSumsStartModulus[i] = ff::mpc::modAdd(
-                  this->powerSumsStartModulus[i],
-                  o.arithmeticPayloadCols[i],
-                  this->info->startModulus);
-            }
-          }
-        }
-
         /** Issue #223 */
         std::unique_ptr<ff::mpc::Batch<SAFRN_TYPES>> batchedModConv(
             new ff::mpc::Batch<SAFRN_TYPES>());
@@ -557,32 +543,40 @@ void Moments::handleComplete(Fronctocol & f) {
                 .outputShare;
       }
 
-      log_debug("and onto batchedDivide");
+      log_debug("and onto sharedDivide");
 
-      std::unique_ptr<Batch> batchedDivision(new Batch());
-
-      this->expectationOfNthPow.resize(this->powerSums.size());
-      this->expectationOfNthPow.front() = this->powerSums.front();
+      /* Every power sum is divided by the count, powerSums.front(). */
+      std::vector<LargeNum> numerators;
       for (size_t i = 1; i < this->powerSums.size(); i++) {
-        batchedDivision->children.emplace_back(
-            new ff::mpc::Divide<SAFRN_TYPES, LargeNum, SmallNum>(
-                this->powerSums[i] *
-                    LargeNum(1 << this->globals->bitsOfPrecision),
-                this->powerSums.front(),
-                &this->expectationOfNthPow[i],
-                &this->info->divideInfo,
-                std::move(this->randomness.divideDispenser->get())));
+        numerators.push_back(
+            this->powerSums[i] *
+            LargeNum(1 << this->globals->bitsOfPrecision));
       }
+      std::unique_ptr<Fronctocol> sharedDivide(new SharedDivide(
+          std::move(numerators),
+          this->powerSums.front(),
+          &this->info->sharedDivideInfo,
+          std::move(this->randomness.divideDispenser->get()),
+          *this->randomness.divideBeaverDispenser,
+          *this->randomness.truncationPairDispenser));
 
       PeerSet ps(this->getPeers());
       ps.removeDealer();
       ps.removeRecipients();
-      /** batched division constructor goes here, Issue # 163 */
-      this->invoke(std::move(batchedDivision), ps);
+      this->invoke(std::move(sharedDivide), ps);
       this->state = awaitingDivision;
     } break;
     case (awaitingDivision): {
       log_debug("awaitingDivision");
+      std::vector<LargeNum> const & quotients =
+          static_cast<SharedDivide &>(f).outputs;
+
+      this->expectationOfNthPow.resize(this->powerSums.size());
+      this->expectationOfNthPow.front() = this->powerSums.front();
+      std::copy(
+          quotients.begin(),
+          quotients.end(),
+          this->expectationOfNthPow.begin() + 1);
 
       /** Send to recipients */
 
@@ -30,12 +30,14 @@
 #include <mpc/ObservationList.h>
 #include <mpc/Randomness.h>
 #include <mpc/RandomnessDealer.h>
-#include <mpc/SISOSort.h>
 #include <mpc/ZipAdjacent.h>
 
 #include <dataowner/GlobalInfo.h>
 #include <dataowner/MomentsInfo.h>
 #include <dataowner/MomentsPatron.h>
+#include <dataowner/ObliviousMerge.h>
+#include <dataowner/ObservationStore.h>
+#include <dataowner/SharedDivide.h>
 #include <dataowner/fortissimo.h>
 #include <framework/Framework.h>
 
@@ -70,15 +72,15 @@ public:
 
 private:
   enum MomentsState {
-    awaitingRandomnessAndSISOSort,
+    awaitingRandomnessAndMerge,
     awaitingRandomnessOnly,
-    awaitingSISOSort,
+    awaitingMerge,
     awaitingZipAdjacent,
     awaitingBatchedModConvUp,
     awaitingDivision
   };
 
-  MomentsState state = awaitingRandomnessAndSISOSort;
+  MomentsState state = awaitingRandomnessAndMerge;
 
   MomentsRandomness randomness;
 
@@ -98,12 +100,17 @@ private:
 
   ff::mpc::ObservationList<LargeNum> ownList;
 
-  std::vector<ff::mpc::ObservationList<LargeNum>>
-      outgoingListShares; // one for each cross-vertical party.
-  std::vector<ff::mpc::ObservationList<LargeNum>>
-      sharedLists; // one for each cross-vertical party.
+  /** ownList, by column, from padding until it is shared. */
+  ObservationStore ownStore;
 
-  std::vector<ff::mpc::ObservationList<LargeNum>> vectorZippedAdjacent;
+  std::vector<ObservationStore>
+      sharedStores; // one for each cross-vertical party.
+
+  /** Rows of each cross-vertical party's shares received so far. */
+  std::vector<size_t> rowsReceived;
+
+  /** sharedStores, as lists for ObliviousMerge once all are in. */
+  std::vector<ff::mpc::ObservationList<LargeNum>> sharedLists;
 
   std::vector<LargeNum> powerSumsStartModulus;
   std::vector<LargeNum> powerSums;
@@ -6,15 +6,25 @@
 
 #include <algorithm>
 
+#include <util/PrimeCatalogue.h>
+
 #include <ff/logging.h>
 
 namespace safrn {
 namespace dataowner {
 
 static inline LargeNum computeModulus(size_t numBits) {
-  log_info("Finding a prime with %zu bits", numBits);
-  return ff::mpc::nextPrime(
-      static_cast<LargeNum>(LargeNum(1) << numBits));
+  log_info("Using a prime modulus above 2^%zu", numBits);
+  return nextPrimeAbovePowerOfTwo(numBits);
+}
+
+/**
+ * Width of the power sums, from the start modulus, once scaled up by
+ * the bits of precision for division.
+ */
+static inline size_t numeratorBits(GlobalInfo const * const globals) {
+  return 2 + 4 * globals->bitsOfPrecision +
+      static_cast<size_t>(ceil(log2(globals->maxIntersectionSize)));
 }
 
 MomentsInfo::MomentsInfo(
@@ -29,19 +39,22 @@ MomentsInfo::MomentsInfo(
     numCrossParties(numCrossParties),
     selfVertical(selfVertical),
     dataVertical(dataVertical),
+    listSizeData(globals->listSize(dataVertical)),
+    listSizeNonData(globals->joinedListSize - this->listSizeData),
     includeZerothMoment(includeZerothMoment),
     highest_moment(highest_moment),
     dealer(dealer),
     revealer(revealer),
     payloadLength(highest_moment + 1),
-    keyModulus(
-        ff::mpc::nextPrime(static_cast<LargeNum>(globals->key_max))),
+    /* Packed keys, 2 * key + 1 with padding at key_max + 1, must stay
+     * below half the modulus for ObliviousMerge's comparisons. */
+    keyModulus(cachedNextPrime(4 * (globals->key_max + 2))),
     startModulus(computeModulus(
         2 + 3 * globals->bitsOfPrecision +
         static_cast<size_t>(ceil(log2(globals->maxIntersectionSize))))),
+    /* Room for SharedDivide's products of power sums and reciprocal. */
     endModulus(computeModulus(
-        2 + 4 * globals->bitsOfPrecision +
-        static_cast<size_t>(ceil(log2(globals->maxIntersectionSize))))),
+        SharedDivideInfo::modulusBits(numeratorBits(globals)))),
     compareInfo(this->startModulus, revealer),
     compareInfoEndModulus(this->endModulus, revealer),
     startModulusMultiplyInfo(
@@ -58,9 +71,14 @@ MomentsInfo::MomentsInfo(
         this->compareInfoEndModulus
             .lagrangePolynomialSet, // this is wrong but also we don't use it anymore, fix in next ff MR
         &this->compareInfoEndModulus),
+    sharedDivideInfo(
+        revealer,
+        this->endModulus,
+        numeratorBits(globals),
+        &this->divideInfo),
     modConvUpInfo(this->endModulus, this->startModulus, revealer),
     zipAdjacentInfo(
-        2 * globals->maxListSize,
+        this->listSizeData + this->listSizeNonData,
         this->payloadLength,
         0,
         this->startModulus,
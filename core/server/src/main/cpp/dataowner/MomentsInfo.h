@@ -20,6 +20,7 @@
 
 /* Safrn Headers */
 #include <dataowner/GlobalInfo.h>
+#include <dataowner/SharedDivide.h>
 #include <dataowner/fortissimo.h>
 #include <dealer/RandomSquareMatrix.h>
 #include <ff/Fronctocol.h>
@@ -47,6 +48,12 @@ struct MomentsInfo {
   size_t selfVertical; // 0 or 1
   size_t dataVertical; // 0 or 1
 
+  /** Rows of the data vertical's and the other vertical's lists, which
+    * each shared list holds in that order.
+    */
+  size_t listSizeData;
+  size_t listSizeNonData;
+
   /** TODO: read from study config */
   const bool includeZerothMoment = true; // i.e. do we reveal count?
   /** TODO: read from query, max of 3 */
@@ -54,9 +61,10 @@ struct MomentsInfo {
       3; // 0, 1, 2, 3, count, mean, variance, skew
 
   /** We currently support joins via an equality constraint
-    * on a single column only. Here the second column
-    * represents the vertical, and is used to ensure keys are
-    * lexicographically distinct during the sorting.
+    * on a single column only. The vertical is packed into the
+    * low bit of the first key column, 2 * key + tag, so that keys
+    * are distinct between the verticals during the merge. The
+    * second holds the plain key, for ZipAdjacent to match.
     */
   const size_t numKeyCols = 2;
 
@@ -82,6 +90,8 @@ struct MomentsInfo {
   ff::mpc::MultiplyInfo<safrn::Identity, ff::mpc::BooleanBeaverInfo>
       booleanMultiplyInfo;
   ff::mpc::DivideInfo<safrn::Identity, LargeNum, SmallNum> divideInfo;
+  /** Every power sum is divided by the same count. */
+  SharedDivideInfo sharedDivideInfo;
   ff::mpc::ModConvUpInfo<safrn::Identity, SmallNum, LargeNum, LargeNum>
       modConvUpInfo;
   ff::mpc::ZipAdjacentInfo<safrn::Identity, LargeNum, SmallNum>
@@ -116,6 +126,11 @@ struct MomentsRandomness {
       ff::mpc::DoNotGenerateInfo>>
       divideDispenser;
 
+  std::unique_ptr<SharedDivide::BeaverDispenser> divideBeaverDispenser;
+
+  std::unique_ptr<SharedDivide::TruncationDispenser>
+      truncationPairDispenser;
+
   std::vector<std::unique_ptr<ff::mpc::RandomnessDispenser<
       ff::mpc::ZipAdjacentRandomness<LargeNum, SmallNum>,
       ff::mpc::DoNotGenerateInfo>>>
@@ -128,16 +143,25 @@ struct MomentsRandomness {
       std::unique_ptr<ff::mpc::RandomnessDispenser<
           ff::mpc::DivideRandomness<LargeNum, SmallNum>,
           ff::mpc::DoNotGenerateInfo>> divideDispenser,
+      std::unique_ptr<SharedDivide::BeaverDispenser>
+          divideBeaverDispenser,
+      std::unique_ptr<SharedDivide::TruncationDispenser>
+          truncationPairDispenser,
       std::vector<std::unique_ptr<ff::mpc::RandomnessDispenser<
           ff::mpc::ZipAdjacentRandomness<LargeNum, SmallNum>,
           ff::mpc::DoNotGenerateInfo>>> && zipAdjacentDispensers) :
       modConvUpDispenser(std::move(modConvUpDispenser)),
       divideDispenser(std::move(divideDispenser)),
+      divideBeaverDispenser(std::move(divideBeaverDispenser)),
+      truncationPairDispenser(std::move(truncationPairDispenser)),
       zipAdjacentDispensers(std::move(zipAdjacentDispensers)) {
   }
 
   MomentsRandomness() :
-      modConvUpDispenser(nullptr), divideDispenser(nullptr) {
+      modConvUpDispenser(nullptr),
+      divideDispenser(nullptr),
+      divideBeaverDispenser(nullptr),
+      truncationPairDispenser(nullptr) {
   }
 };
 
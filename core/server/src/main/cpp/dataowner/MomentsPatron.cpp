@@ -22,9 +22,9 @@ MomentsRandomnessPatron::MomentsRandomnessPatron(
     dispenserSize(dispenserSize),
     numConditionalEvaluateNeeded(1),
     numModConvUpNeeded(this->info->payloadLength),
-    numDivideNeeded(
-        this->info
-            ->payloadLength) { // 2 for R^2 and Standard Error { // dispenserSize = num Moments we're going to need
+    numDivideNeeded(1), // one reciprocal of the count, see SharedDivide
+    numDivideBeaverTripleNeeded(this->info->payloadLength - 1),
+    numTruncationPairNeeded(this->info->payloadLength - 1) {
   log_debug("Constructor");
 }
 
@@ -42,7 +42,13 @@ void MomentsRandomnessPatron::init() {
       i++;
     }
   });
-  std::unique_ptr<Fronctocol> patron(
+  this->zipAdjacentDispensers.resize(this->numCrossParties);
+
+  /**
+   * Invoke every patron at once, in the same order as the dealer's
+   * MomentsRandomnessBasement invokes its houses.
+   */
+  std::unique_ptr<Fronctocol> modConvUpPatron(
       new ff::mpc::ModConvUpRandomnessPatron<
           SAFRN_TYPES,
           SmallNum,
@@ -51,10 +57,74 @@ void MomentsRandomnessPatron::init() {
           &this->info->modConvUpInfo,
           dealerIdentity,
           this->numModConvUpNeeded * this->dispenserSize));
+  this->invokePatron(
+      std::move(modConvUpPatron), this->getPeers(), awaitingModConvUp);
+
+  log_debug(
+      "this->numDivideNeeded * this->dispenserSize %zu",
+      this->numDivideNeeded * this->dispenserSize);
+  std::unique_ptr<Fronctocol> dividePatron(
+      new ff::mpc::
+          DivideRandomnessPatron<SAFRN_TYPES, LargeNum, SmallNum>(
+              &this->info->divideInfo,
+              dealerIdentity,
+              this->numDivideNeeded * this->dispenserSize));
+  this->invokePatron(
+      std::move(dividePatron), this->getPeers(), awaitingDivide);
+
+  std::unique_ptr<Fronctocol> divideBeaverPatron(
+      new ff::mpc::RandomnessPatron<
+          SAFRN_TYPES,
+          ff::mpc::BeaverTriple<LargeNum>,
+          ff::mpc::BeaverInfo<LargeNum>>(
+          *dealerIdentity,
+          this->numDivideBeaverTripleNeeded * this->dispenserSize,
+          ff::mpc::BeaverInfo<LargeNum>(this->info->endModulus)));
+  this->invokePatron(
+      std::move(divideBeaverPatron),
+      this->getPeers(),
+      awaitingDivideBeaverTriple);
+
+  std::unique_ptr<Fronctocol> truncationPairPatron(
+      new SeededRandomnessPatron<
+          dealer::TruncationPair<LargeNum>,
+          dealer::TruncationPairInfo<LargeNum, LargeNum>>(
+          *dealerIdentity,
+          this->numTruncationPairNeeded * this->dispenserSize,
+          this->info->sharedDivideInfo.truncationInfo));
+  this->invokePatron(
+      std::move(truncationPairPatron),
+      this->getPeers(),
+      awaitingTruncationPair);
 
-  this->invoke(std::move(patron), this->getPeers());
+  this->getPeers().forEachDataowner([&, this](const Identity & other) {
+    if (other.vertical != this->getSelf().vertical) {
+      std::unique_ptr<Fronctocol> patron(
+          new ff::mpc::ZipAdjacentRandomnessPatron<
+              SAFRN_TYPES,
+              LargeNum,
+              SmallNum>(
+              &this->info->zipAdjacentInfo,
+              dealerIdentity,
+              this->numConditionalEvaluateNeeded * this->dispenserSize));
+
+      PeerSet ps = PeerSet();
+      ps.add(this->getSelf());
+      ps.add(other);
+      ps.add(*dealerIdentity);
+
+      this->invokePatron(
+          std::move(patron), ps, awaitingConditionalEvaluate);
+    }
+  });
+}
 
-  this->state = awaitingModConvUp;
+void MomentsRandomnessPatron::invokePatron(
+    std::unique_ptr<Fronctocol> patron,
+    PeerSet const & ps,
+    MomentsPatronPromiseState kind) {
+  this->awaitingPatrons.emplace(patron.get(), kind);
+  this->invoke(std::move(patron), ps);
 }
 
 void MomentsRandomnessPatron::handleReceive(IncomingMessage & imsg) {
@@ -65,9 +135,16 @@ void MomentsRandomnessPatron::handleReceive(IncomingMessage & imsg) {
 
 void MomentsRandomnessPatron::handleComplete(Fronctocol & f) {
   log_debug("MomentsPatron received handle complete");
-  switch (this->state) {
-    case awaitingModConvUp: {
+  auto const awaiting = this->awaitingPatrons.find(&f);
+  if (awaiting == this->awaitingPatrons.end()) {
+    log_error("MomentsPatron received completion from unknown patron");
+    return;
+  }
+  MomentsPatronPromiseState const kind = awaiting->second;
+  this->awaitingPatrons.erase(awaiting);
 
+  switch (kind) {
+    case awaitingModConvUp: {
       log_debug("awaitingModConvUp");
       this->modConvUpDispenser =
           std::move(static_cast<ff::mpc::ModConvUpRandomnessPatron<
@@ -76,18 +153,6 @@ void MomentsRandomnessPatron::handleComplete(Fronctocol & f) {
                         LargeNum,
                         LargeNum> &>(f)
                         .modConvUpDispenser);
-
-      log_debug(
-          "this->numDivideNeeded * this->dispenserSize %zu",
-          this->numDivideNeeded * this->dispenserSize);
-      std::unique_ptr<Fronctocol> patron(
-          new ff::mpc::
-              DivideRandomnessPatron<SAFRN_TYPES, LargeNum, SmallNum>(
-                  &this->info->divideInfo,
-                  dealerIdentity,
-                  this->numDivideNeeded * this->dispenserSize));
-      this->invoke(std::move(patron), this->getPeers());
-      this->state = awaitingDivide;
     } break;
     case awaitingDivide: {
       log_debug("awaitingDivide");
@@ -97,32 +162,20 @@ void MomentsRandomnessPatron::handleComplete(Fronctocol & f) {
                         LargeNum,
                         SmallNum> &>(f)
                         .divideDispenser);
-
-      this->getPeers().forEachDataowner(
-          [&, this](const Identity & other) {
-            if (other.vertical != this->getSelf().vertical) {
-              zipAdjacentDispensers.emplace_back(nullptr);
-
-              std::unique_ptr<Fronctocol> patron(
-                  new ff::mpc::ZipAdjacentRandomnessPatron<
-                      SAFRN_TYPES,
-                      LargeNum,
-                      SmallNum>(
-                      &this->info->zipAdjacentInfo,
-                      dealerIdentity,
-                      this->numConditionalEvaluateNeeded *
-                          this->dispenserSize));
-
-              PeerSet ps = PeerSet();
-              ps.add(this->getSelf());
-              ps.add(other);
-              ps.add(*dealerIdentity);
-
-              this->invoke(std::move(patron), ps);
-            }
-          });
-      this->numPartiesAwaiting = this->numCrossParties;
-      this->state = awaitingConditionalEvaluate;
+    } break;
+    case awaitingDivideBeaverTriple: {
+      log_debug("awaitingDivideBeaverTriple");
+      this->divideBeaverDispenser = std::move(
+          static_cast<
+              PromiseFronctocol<SharedDivide::BeaverDispenser> &>(f)
+              .result);
+    } break;
+    case awaitingTruncationPair: {
+      log_debug("awaitingTruncationPair");
+      this->truncationPairDispenser = std::move(
+          static_cast<
+              PromiseFronctocol<SharedDivide::TruncationDispenser> &>(f)
+              .result);
     } break;
     case awaitingConditionalEvaluate: {
       log_debug("awaitingConditionalEvaluate");
@@ -138,15 +191,14 @@ void MomentsRandomnessPatron::handleComplete(Fronctocol & f) {
                       .zipAdjacentDispenser);
         }
       });
-
-      this->numPartiesAwaiting--;
-      if (this->numPartiesAwaiting == 0) {
-        this->generateOutputDispenser();
-      }
     } break;
     default:
       log_error("State machine in unexpected state");
   }
+
+  if (this->awaitingPatrons.empty()) {
+    this->generateOutputDispenser();
+  }
 }
 
 void MomentsRandomnessPatron::handlePromise(Fronctocol &) {
@@ -173,6 +225,10 @@ void MomentsRandomnessPatron::generateOutputDispenser() {
             this->numModConvUpNeeded)),
         std::move(this->divideDispenser->littleDispenser(
             this->numDivideNeeded)),
+        std::move(this->divideBeaverDispenser->littleDispenser(
+            this->numDivideBeaverTripleNeeded)),
+        std::move(this->truncationPairDispenser->littleDispenser(
+            this->numTruncationPairNeeded)),
         std::move(littleZipAdjacentDispensers)));
   }
   log_debug("calling this->complete");
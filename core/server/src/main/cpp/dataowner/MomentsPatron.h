@@ -30,8 +30,11 @@
 #include <mpc/ModConvUpDealer.h>
 #include <mpc/ZipAdjacentDealer.h>
 
+#include <dataowner/SharedDivide.h>
 #include <dataowner/fortissimo.h>
+#include <dealer/TruncationPair.h>
 #include <framework/Framework.h>
+#include <util/RandomnessDealer.h>
 
 /* logging configuration */
 #include <ff/logging.h>
@@ -60,12 +63,25 @@ public:
 private:
   void generateOutputDispenser();
 
+  /**
+   * Every randomness patron is invoked up front by init(), and each
+   * outstanding child is tagged with the kind of randomness it is
+   * fetching, so that completions may arrive in any order.
+   */
   enum MomentsPatronPromiseState {
     awaitingModConvUp,
     awaitingDivide,
+    awaitingDivideBeaverTriple,
+    awaitingTruncationPair,
     awaitingConditionalEvaluate
   };
-  MomentsPatronPromiseState state = awaitingModConvUp;
+  std::map<Fronctocol const *, MomentsPatronPromiseState>
+      awaitingPatrons;
+
+  void invokePatron(
+      std::unique_ptr<Fronctocol> patron,
+      PeerSet const & ps,
+      MomentsPatronPromiseState kind);
 
   MomentsInfo const * const info;
   const safrn::Identity * dealerIdentity;
@@ -73,9 +89,10 @@ private:
 
   const size_t numModConvUpNeeded;
   const size_t numDivideNeeded;
+  const size_t numDivideBeaverTripleNeeded;
+  const size_t numTruncationPairNeeded;
   const size_t numConditionalEvaluateNeeded;
 
-  size_t numPartiesAwaiting;
   size_t numCrossParties;
   std::map<safrn::Identity, size_t> indexOfCrossParties;
 
@@ -87,6 +104,9 @@ private:
       ff::mpc::DivideRandomness<LargeNum, SmallNum>,
       ff::mpc::DoNotGenerateInfo>>
       divideDispenser;
+  std::unique_ptr<SharedDivide::BeaverDispenser> divideBeaverDispenser;
+  std::unique_ptr<SharedDivide::TruncationDispenser>
+      truncationPairDispenser;
   std::vector<std::unique_ptr<ff::mpc::RandomnessDispenser<
       ff::mpc::ZipAdjacentRandomness<LargeNum, SmallNum>,
       ff::mpc::DoNotGenerateInfo>>>
@@ -0,0 +1,404 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <memory>
+#include <utility>
+
+/* 3rd Party Headers */
+#include <mpc/ModUtils.h>
+
+/* SAFRN Headers */
+#include <dataowner/ObliviousMerge.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+using TypeCastFromBit = ff::mpc::TypeCastFromBit<SAFRN_TYPES, LargeNum>;
+
+ObliviousMerge::ObliviousMerge(
+    ff::mpc::ObservationList<LargeNum> & list,
+    LargeNum const & payloadModulus,
+    LargeNum const & keyModulus,
+    Identity const * const revealer,
+    Identity const * const dealer) :
+    list(list),
+    payloadModulus(payloadModulus),
+    keyModulus(keyModulus),
+    revealer(revealer),
+    dealer(dealer),
+    compareInfo(keyModulus, revealer) {
+}
+
+/**
+ * Splits the bitonic list [lo, lo + n) at the greatest power of two m
+ * below n, compare-exchanges across the split, and recurses on both
+ * sides, which are again bitonic. For n a power of two this is
+ * Batcher's bitonic merger.
+ */
+static void mergeNetworkLayers(
+    size_t const lo,
+    size_t const n,
+    size_t const depth,
+    std::vector<std::vector<ObliviousMerge::Comparator>> & layers) {
+  if (n <= 1) {
+    return;
+  }
+  size_t m = 1;
+  while (2 * m < n) {
+    m *= 2;
+  }
+  if (layers.size() <= depth) {
+    layers.resize(depth + 1);
+  }
+  for (size_t i = lo; i < lo + n - m; i++) {
+    layers[depth].emplace_back(i, i + m);
+  }
+  mergeNetworkLayers(lo, m, depth + 1, layers);
+  mergeNetworkLayers(lo + m, n - m, depth + 1, layers);
+}
+
+std::vector<std::vector<ObliviousMerge::Comparator>>
+ObliviousMerge::mergeNetwork(size_t const length) {
+  std::vector<std::vector<Comparator>> layers;
+  mergeNetworkLayers(0, length, 0, layers);
+  return layers;
+}
+
+void ObliviousMerge::dropPackedKey(
+    ff::mpc::ObservationList<LargeNum> & list) {
+  log_assert(list.numKeyCols > 0);
+  for (ff::mpc::Observation<LargeNum> & o : list.elements) {
+    o.keyCols.erase(o.keyCols.begin());
+  }
+  list.numKeyCols--;
+}
+
+void ObliviousMerge::init() {
+  log_debug("Calling init on ObliviousMerge");
+  if (this->list.numKeyCols == 0 || this->list.numXORPayloadCols != 0) {
+    log_error("ObliviousMerge needs a packed key column and only "
+              "arithmetic payloads");
+    this->abort();
+    return;
+  }
+
+  this->layers = mergeNetwork(this->list.elements.size());
+  size_t num_comparators = 0;
+  for (std::vector<Comparator> const & layer : this->layers) {
+    num_comparators += layer.size();
+  }
+
+  /** Same order as the MergeRandomnessHouse invokes its houses. */
+  std::unique_ptr<Fronctocol> comparePatron(
+      new ff::mpc::
+          CompareRandomnessPatron<SAFRN_TYPES, LargeNum, SmallNum>(
+              &this->compareInfo, this->dealer, num_comparators));
+  this->invokePatron(std::move(comparePatron), compareRandomness);
+
+  std::unique_ptr<Fronctocol> keyTypeCastPatron(
+      new ff::mpc::RandomnessPatron<
+          SAFRN_TYPES,
+          ff::mpc::TypeCastTriple<LargeNum>,
+          ff::mpc::TypeCastFromBitInfo<LargeNum>>(
+          *this->dealer,
+          num_comparators,
+          ff::mpc::TypeCastFromBitInfo<LargeNum>(this->keyModulus)));
+  this->invokePatron(
+      std::move(keyTypeCastPatron), keyTypeCastRandomness);
+
+  std::unique_ptr<Fronctocol> payloadTypeCastPatron(
+      new ff::mpc::RandomnessPatron<
+          SAFRN_TYPES,
+          ff::mpc::TypeCastTriple<LargeNum>,
+          ff::mpc::TypeCastFromBitInfo<LargeNum>>(
+          *this->dealer,
+          num_comparators,
+          ff::mpc::TypeCastFromBitInfo<LargeNum>(
+              this->payloadModulus)));
+  this->invokePatron(
+      std::move(payloadTypeCastPatron), payloadTypeCastRandomness);
+
+  std::unique_ptr<Fronctocol> keyBeaverPatron(
+      new ff::mpc::RandomnessPatron<
+          SAFRN_TYPES,
+          ff::mpc::BeaverTriple<LargeNum>,
+          ff::mpc::BeaverInfo<LargeNum>>(
+          *this->dealer,
+          num_comparators * this->list.numKeyCols,
+          ff::mpc::BeaverInfo<LargeNum>(this->keyModulus)));
+  this->invokePatron(std::move(keyBeaverPatron), keyBeaverRandomness);
+
+  std::unique_ptr<Fronctocol> payloadBeaverPatron(
+      new ff::mpc::RandomnessPatron<
+          SAFRN_TYPES,
+          ff::mpc::BeaverTriple<LargeNum>,
+          ff::mpc::BeaverInfo<LargeNum>>(
+          *this->dealer,
+          num_comparators * this->list.numArithmeticPayloadCols,
+          ff::mpc::BeaverInfo<LargeNum>(this->payloadModulus)));
+  this->invokePatron(
+      std::move(payloadBeaverPatron), payloadBeaverRandomness);
+}
+
+void ObliviousMerge::invokePatron(
+    std::unique_ptr<Fronctocol> patron, MergePatronKind kind) {
+  this->awaitingPatrons.emplace(patron.get(), kind);
+  this->invoke(std::move(patron), this->getPeers());
+}
+
+void ObliviousMerge::invokeOnDataowners(std::unique_ptr<Fronctocol> f) {
+  PeerSet ps(this->getPeers());
+  ps.removeDealer();
+  this->invoke(std::move(f), ps);
+}
+
+void ObliviousMerge::compareLayer() {
+  if (this->nextLayer == this->layers.size()) {
+    log_debug("ObliviousMerge done");
+    this->complete();
+    return;
+  }
+
+  std::unique_ptr<Batch> batchedCompare(new Batch());
+  for (Comparator const & c : this->layers[this->nextLayer]) {
+    batchedCompare->children.emplace_back(
+        new ff::mpc::Compare<SAFRN_TYPES, LargeNum, SmallNum>(
+            this->list.elements[c.first].keyCols[0],
+            this->list.elements[c.second].keyCols[0],
+            &this->compareInfo,
+            this->compareDispenser->get()));
+  }
+  this->state = awaitingCompare;
+  this->invokeOnDataowners(std::move(batchedCompare));
+}
+
+void ObliviousMerge::swapLayer(Batch & typeCasts) {
+  std::vector<Comparator> const & layer = this->layers[this->nextLayer];
+  size_t const num_key_cols = this->list.numKeyCols;
+  size_t const num_payload_cols = this->list.numArithmeticPayloadCols;
+
+  /* [first > second] * (second - first), column by column. */
+  std::vector<LargeNum> key_bits;
+  std::vector<LargeNum> key_diffs;
+  key_bits.reserve(layer.size() * num_key_cols);
+  key_diffs.reserve(layer.size() * num_key_cols);
+  std::vector<LargeNum> payload_bits;
+  std::vector<LargeNum> payload_diffs;
+  payload_bits.reserve(layer.size() * num_payload_cols);
+  payload_diffs.reserve(layer.size() * num_payload_cols);
+
+  for (size_t k = 0; k < num_key_cols; k++) {
+    for (size_t c = 0; c < layer.size(); c++) {
+      key_bits.push_back(
+          static_cast<TypeCastFromBit &>(*typeCasts.children[2 * c])
+              .outputBitShare);
+      key_diffs.push_back(ff::mpc::modSub(
+          this->list.elements[layer[c].second].keyCols[k] %
+              this->keyModulus,
+          this->list.elements[layer[c].first].keyCols[k] %
+              this->keyModulus,
+          this->keyModulus));
+    }
+  }
+  for (size_t k = 0; k < num_payload_cols; k++) {
+    for (size_t c = 0; c < layer.size(); c++) {
+      payload_bits.push_back(
+          static_cast<TypeCastFromBit &>(*typeCasts.children[2 * c + 1])
+              .outputBitShare);
+      payload_diffs.push_back(ff::mpc::modSub(
+          this->list.elements[layer[c].second]
+                  .arithmeticPayloadCols[k] %
+              this->payloadModulus,
+          this->list.elements[layer[c].first].arithmeticPayloadCols[k] %
+              this->payloadModulus,
+          this->payloadModulus));
+    }
+  }
+
+  this->state = awaitingSwap;
+  this->numSwapsAwaiting = 0;
+  this->keySwap = nullptr;
+  this->payloadSwap = nullptr;
+  if (!key_bits.empty()) {
+    std::unique_ptr<Fronctocol> swap(new VectorMultiply(
+        std::move(key_bits),
+        std::move(key_diffs),
+        *this->keyBeaverDispenser,
+        this->keyModulus,
+        *this->revealer));
+    this->keySwap = swap.get();
+    this->numSwapsAwaiting++;
+    this->invokeOnDataowners(std::move(swap));
+  }
+  if (!payload_bits.empty()) {
+    std::unique_ptr<Fronctocol> swap(new VectorMultiply(
+        std::move(payload_bits),
+        std::move(payload_diffs),
+        *this->payloadBeaverDispenser,
+        this->payloadModulus,
+        *this->revealer));
+    this->payloadSwap = swap.get();
+    this->numSwapsAwaiting++;
+    this->invokeOnDataowners(std::move(swap));
+  }
+}
+
+void ObliviousMerge::applySwap(
+    std::vector<LargeNum> const & deltas,
+    bool const keys,
+    LargeNum const & modulus) {
+  std::vector<Comparator> const & layer = this->layers[this->nextLayer];
+  size_t const num_cols = keys ? this->list.numKeyCols :
+                                 this->list.numArithmeticPayloadCols;
+  log_assert(deltas.size() == num_cols * layer.size());
+
+  for (size_t k = 0; k < num_cols; k++) {
+    for (size_t c = 0; c < layer.size(); c++) {
+      LargeNum const & d = deltas[k * layer.size() + c];
+      LargeNum & first = keys ?
+          this->list.elements[layer[c].first].keyCols[k] :
+          this->list.elements[layer[c].first].arithmeticPayloadCols[k];
+      LargeNum & second = keys ?
+          this->list.elements[layer[c].second].keyCols[k] :
+          this->list.elements[layer[c].second].arithmeticPayloadCols[k];
+      first = ff::mpc::modAdd(first % modulus, d, modulus);
+      second = ff::mpc::modSub(second % modulus, d, modulus);
+    }
+  }
+}
+
+void ObliviousMerge::handleReceive(IncomingMessage &) {
+  log_error("Unexpected handleReceive in ObliviousMerge");
+  this->abort();
+}
+
+void ObliviousMerge::handleComplete(Fronctocol & f) {
+  switch (this->state) {
+    case awaitingRandomness: {
+      auto const awaiting = this->awaitingPatrons.find(&f);
+      if (awaiting == this->awaitingPatrons.end()) {
+        log_error("ObliviousMerge received completion from unknown "
+                  "patron");
+        this->abort();
+        return;
+      }
+      MergePatronKind const kind = awaiting->second;
+      this->awaitingPatrons.erase(awaiting);
+
+      switch (kind) {
+        case compareRandomness: {
+          this->compareDispenser =
+              std::move(static_cast<ff::mpc::CompareRandomnessPatron<
+                            SAFRN_TYPES,
+                            LargeNum,
+                            SmallNum> &>(f)
+                            .compareDispenser);
+        } break;
+        case keyTypeCastRandomness:
+        case payloadTypeCastRandomness: {
+          std::unique_ptr<TypeCastDispenser> & dispenser =
+              kind == keyTypeCastRandomness ?
+              this->keyTypeCastDispenser :
+              this->payloadTypeCastDispenser;
+          dispenser = std::move(
+              static_cast<PromiseFronctocol<TypeCastDispenser> &>(f)
+                  .result);
+        } break;
+        case keyBeaverRandomness:
+        case payloadBeaverRandomness: {
+          std::unique_ptr<BeaverDispenser> & dispenser =
+              kind == keyBeaverRandomness ?
+              this->keyBeaverDispenser :
+              this->payloadBeaverDispenser;
+          dispenser = std::move(
+              static_cast<PromiseFronctocol<BeaverDispenser> &>(f)
+                  .result);
+        } break;
+      }
+
+      if (this->awaitingPatrons.empty()) {
+        this->compareLayer();
+      }
+    } break;
+    case awaitingCompare: {
+      auto & batch = static_cast<Batch &>(f);
+
+      /* One cast to each modulus per comparator. */
+      std::unique_ptr<Batch> batchedTypeCast(new Batch());
+      for (std::unique_ptr<Fronctocol> const & child : batch.children) {
+        Boolean_t const bit =
+            static_cast<
+                ff::mpc::Compare<SAFRN_TYPES, LargeNum, SmallNum> &>(
+                *child)
+                .outputShare %
+            2;
+        batchedTypeCast->children.emplace_back(
+            new TypeCastFromBit(
+                bit,
+                this->keyModulus,
+                this->revealer,
+                this->keyTypeCastDispenser->get()));
+        batchedTypeCast->children.emplace_back(
+            new TypeCastFromBit(
+                bit,
+                this->payloadModulus,
+                this->revealer,
+                this->payloadTypeCastDispenser->get()));
+      }
+      this->state = awaitingTypeCastFromBit;
+      this->invokeOnDataowners(std::move(batchedTypeCast));
+    } break;
+    case awaitingTypeCastFromBit: {
+      this->swapLayer(static_cast<Batch &>(f));
+      if (this->numSwapsAwaiting == 0) {
+        this->nextLayer++;
+        this->compareLayer();
+      }
+    } break;
+    case awaitingSwap: {
+      if (&f == this->keySwap) {
+        this->applySwap(
+            static_cast<VectorMultiply &>(f).outputs,
+            true,
+            this->keyModulus);
+      } else if (&f == this->payloadSwap) {
+        this->applySwap(
+            static_cast<VectorMultiply &>(f).outputs,
+            false,
+            this->payloadModulus);
+      } else {
+        log_error("ObliviousMerge received completion from unknown "
+                  "swap");
+        this->abort();
+        return;
+      }
+
+      this->numSwapsAwaiting--;
+      if (this->numSwapsAwaiting == 0) {
+        this->nextLayer++;
+        this->compareLayer();
+      }
+    } break;
+    default:
+      log_error("ObliviousMerge state machine in unexpected state");
+  }
+}
+
+void ObliviousMerge::handlePromise(Fronctocol &) {
+  log_error("Unexpected handlePromise in ObliviousMerge");
+  this->abort();
+}
+
+std::string ObliviousMerge::name() {
+  return std::string("Oblivious Merge");
+}
+
+} // namespace dataowner
+} // namespace safrn
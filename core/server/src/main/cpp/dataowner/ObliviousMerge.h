@@ -0,0 +1,165 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_DATAOWNER_OBLIVIOUS_MERGE_H_
+#define SAFRN_DATAOWNER_OBLIVIOUS_MERGE_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* Fortissimo Headers */
+#include <ff/Fronctocol.h>
+#include <ff/Message.h>
+
+#include <mpc/Batch.h>
+#include <mpc/Compare.h>
+#include <mpc/CompareDealer.h>
+#include <mpc/ModConvUp.h>
+#include <mpc/ObservationList.h>
+#include <mpc/Randomness.h>
+#include <mpc/RandomnessDealer.h>
+
+#include <dataowner/VectorMultiply.h>
+#include <dataowner/fortissimo.h>
+#include <framework/Framework.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+/**
+ * Sorts a shared list whose first half is sorted descending and whose
+ * second half is sorted ascending, as the two cross-vertical parties
+ * can arrange by sorting their own rows before sharing them.
+ *
+ * Where SISOSort shuffles and sorts the whole list, this runs a fixed
+ * bitonic merging network of about N log N / 2 compare-exchanges, in
+ * log N rounds, one Batch of Compare per round. The swaps of a round
+ * are done by two VectorMultiplys, one for the key columns and one for
+ * the payload columns.
+ *
+ * Rows are ordered by their first key column, which packs the row's
+ * vertical into its low bit, 2 * key + tag. Keys must stay below half
+ * the key modulus, so that Compare can order them from a share of
+ * their difference. Any further key columns are swapped along with
+ * the rows. Only arithmetic payloads are supported.
+ *
+ * The list must be shared between exactly two dataowners, and the
+ * dealer must be among the peers to supply MergeRandomnessHouse.
+ */
+class ObliviousMerge : public Fronctocol {
+public:
+  /** The list is merged in place. */
+  ObliviousMerge(
+      ff::mpc::ObservationList<LargeNum> & list,
+      LargeNum const & payloadModulus,
+      LargeNum const & keyModulus,
+      Identity const * const revealer,
+      Identity const * const dealer);
+
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+  using Comparator = std::pair<size_t, size_t>;
+
+  /**
+   * Layers of the merging network for a list of the given length. The
+   * comparators within a layer touch disjoint rows, and each one puts
+   * the smaller row first.
+   */
+  static std::vector<std::vector<Comparator>>
+  mergeNetwork(size_t const length);
+
+  /**
+   * Drops the packed key column of a merged list, leaving the key
+   * columns after it (e.g. the plain keys that ZipAdjacent matches).
+   */
+  static void dropPackedKey(ff::mpc::ObservationList<LargeNum> & list);
+
+private:
+  ff::mpc::ObservationList<LargeNum> & list;
+  LargeNum const payloadModulus;
+  LargeNum const keyModulus;
+  Identity const * const revealer;
+  Identity const * const dealer;
+
+  ff::mpc::CompareInfo<safrn::Identity, LargeNum, SmallNum> compareInfo;
+
+  std::vector<std::vector<Comparator>> layers;
+  size_t nextLayer = 0;
+
+  enum MergeState {
+    awaitingRandomness,
+    awaitingCompare,
+    awaitingTypeCastFromBit,
+    awaitingSwap
+  };
+  MergeState state = awaitingRandomness;
+
+  /**
+   * All patrons are invoked by init(), each outstanding child is tagged
+   * with the kind of randomness it is fetching.
+   */
+  enum MergePatronKind {
+    compareRandomness,
+    keyTypeCastRandomness,
+    payloadTypeCastRandomness,
+    keyBeaverRandomness,
+    payloadBeaverRandomness
+  };
+  std::map<Fronctocol const *, MergePatronKind> awaitingPatrons;
+
+  std::unique_ptr<ff::mpc::RandomnessDispenser<
+      ff::mpc::CompareRandomness<LargeNum, SmallNum>,
+      ff::mpc::DoNotGenerateInfo>>
+      compareDispenser;
+  using TypeCastDispenser = ff::mpc::RandomnessDispenser<
+      ff::mpc::TypeCastTriple<LargeNum>,
+      ff::mpc::TypeCastFromBitInfo<LargeNum>>;
+  using BeaverDispenser = ff::mpc::RandomnessDispenser<
+      ff::mpc::BeaverTriple<LargeNum>,
+      ff::mpc::BeaverInfo<LargeNum>>;
+  std::unique_ptr<TypeCastDispenser> keyTypeCastDispenser;
+  std::unique_ptr<TypeCastDispenser> payloadTypeCastDispenser;
+  std::unique_ptr<BeaverDispenser> keyBeaverDispenser;
+  std::unique_ptr<BeaverDispenser> payloadBeaverDispenser;
+
+  /* The two swaps of the current layer, until they complete. */
+  Fronctocol const * keySwap = nullptr;
+  Fronctocol const * payloadSwap = nullptr;
+  size_t numSwapsAwaiting = 0;
+
+  void invokePatron(
+      std::unique_ptr<Fronctocol> patron, MergePatronKind kind);
+  void invokeOnDataowners(std::unique_ptr<Fronctocol> f);
+
+  void compareLayer();
+  void swapLayer(Batch & typeCasts);
+  void applySwap(
+      std::vector<LargeNum> const & deltas,
+      bool const keys,
+      LargeNum const & modulus);
+};
+
+} // namespace dataowner
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_DATAOWNER_OBLIVIOUS_MERGE_H_
@@ -0,0 +1,234 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C++ Headers */
+#include <algorithm>
+#include <utility>
+
+#include <dataowner/ObservationStore.h>
+#include <util/LargeNumArray.h>
+#include <util/ModColumns.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+ObservationStore::ObservationStore(
+    size_t const numRows,
+    size_t const numKeyCols,
+    size_t const numArithmeticPayloadCols,
+    size_t const numXORPayloadCols) :
+    keyCols(numKeyCols, std::vector<LargeNum>(numRows)),
+    arithmeticPayloadCols(
+        numArithmeticPayloadCols, std::vector<LargeNum>(numRows)),
+    XORPayloadCols(numXORPayloadCols, std::vector<Boolean_t>(numRows)),
+    rows(numRows) {
+}
+
+void ObservationStore::resizeRows(size_t const numRows) {
+  for (std::vector<LargeNum> & col : this->keyCols) {
+    col.resize(numRows);
+  }
+  for (std::vector<LargeNum> & col : this->arithmeticPayloadCols) {
+    col.resize(numRows);
+  }
+  for (std::vector<Boolean_t> & col : this->XORPayloadCols) {
+    col.resize(numRows);
+  }
+  this->rows = numRows;
+}
+
+void ObservationStore::resizeArithmeticPayloadCols(
+    size_t const numCols) {
+  this->arithmeticPayloadCols.resize(
+      numCols, std::vector<LargeNum>(this->rows));
+}
+
+template<typename Value_T>
+static void permuteColumn(
+    std::vector<Value_T> & col, std::vector<size_t> const & order) {
+  std::vector<Value_T> permuted;
+  permuted.reserve(col.size());
+  for (size_t const r : order) {
+    permuted.push_back(col[r]);
+  }
+  col = std::move(permuted);
+}
+
+void ObservationStore::sortRows(
+    size_t const keyCol, bool const descending) {
+  log_assert(keyCol < this->numKeyCols());
+  std::vector<LargeNum> const & keys = this->keyCols[keyCol];
+
+  std::vector<size_t> order(this->rows);
+  for (size_t r = 0; r < this->rows; r++) {
+    order[r] = r;
+  }
+  std::stable_sort(
+      order.begin(), order.end(), [&](size_t const a, size_t const b) {
+        return descending ? keys[b] < keys[a] : keys[a] < keys[b];
+      });
+
+  for (std::vector<LargeNum> & col : this->keyCols) {
+    permuteColumn(col, order);
+  }
+  for (std::vector<LargeNum> & col : this->arithmeticPayloadCols) {
+    permuteColumn(col, order);
+  }
+  for (std::vector<Boolean_t> & col : this->XORPayloadCols) {
+    permuteColumn(col, order);
+  }
+}
+
+void ObservationStore::share(
+    SeedPrg & prg,
+    LargeNum const & keyModulus,
+    LargeNum const & payloadModulus,
+    ObservationStore & theirs,
+    ObservationStore & mine,
+    size_t const offset) const {
+  log_assert(theirs.rows == this->rows);
+  this->shareRows(
+      prg, keyModulus, payloadModulus, 0, theirs, mine, offset);
+}
+
+void ObservationStore::shareRows(
+    SeedPrg & prg,
+    LargeNum const & keyModulus,
+    LargeNum const & payloadModulus,
+    size_t const begin,
+    ObservationStore & theirs,
+    ObservationStore & mine,
+    size_t const offset) const {
+  size_t const n = theirs.rows;
+  log_assert(begin + n <= this->rows);
+  log_assert(mine.rows >= offset + begin + n);
+
+  for (size_t k = 0; k < this->numKeyCols(); k++) {
+    randomModPColumn(prg, keyModulus, theirs.keyCols[k].data(), n);
+    modSubColumn(
+        this->keyCols[k].data() + begin,
+        theirs.keyCols[k].data(),
+        mine.keyCols[k].data() + offset + begin,
+        n,
+        keyModulus);
+  }
+  for (size_t k = 0; k < this->numArithmeticPayloadCols(); k++) {
+    randomModPColumn(
+        prg, payloadModulus, theirs.arithmeticPayloadCols[k].data(), n);
+    modSubColumn(
+        this->arithmeticPayloadCols[k].data() + begin,
+        theirs.arithmeticPayloadCols[k].data(),
+        mine.arithmeticPayloadCols[k].data() + offset + begin,
+        n,
+        payloadModulus);
+  }
+  for (size_t k = 0; k < this->numXORPayloadCols(); k++) {
+    std::vector<Boolean_t> const & own = this->XORPayloadCols[k];
+    std::vector<Boolean_t> & other = theirs.XORPayloadCols[k];
+    prg.bytes(other.data(), n);
+    for (size_t r = 0; r < n; r++) {
+      mine.XORPayloadCols[k][offset + begin + r] =
+          own[begin + r] ^ other[r];
+    }
+  }
+}
+
+bool ObservationStore::writeColumns(
+    OutgoingMessage & omsg,
+    size_t const keyBytes,
+    size_t const payloadBytes) const {
+  bool success = true;
+  for (std::vector<LargeNum> const & col : this->keyCols) {
+    success = success &&
+        writeLargeNumArray(omsg, col.data(), this->rows, keyBytes);
+  }
+  for (std::vector<LargeNum> const & col :
+       this->arithmeticPayloadCols) {
+    success = success &&
+        writeLargeNumArray(omsg, col.data(), this->rows, payloadBytes);
+  }
+  for (std::vector<Boolean_t> const & col : this->XORPayloadCols) {
+    success = success && omsg.add(col.data(), this->rows);
+  }
+  return success;
+}
+
+bool ObservationStore::readColumns(
+    IncomingMessage & imsg,
+    size_t const offset,
+    size_t const n,
+    size_t const keyBytes,
+    size_t const payloadBytes) {
+  log_assert(offset + n <= this->rows);
+
+  bool success = true;
+  for (std::vector<LargeNum> & col : this->keyCols) {
+    success = success &&
+        readLargeNumArray(imsg, col.data() + offset, n, keyBytes);
+  }
+  for (std::vector<LargeNum> & col : this->arithmeticPayloadCols) {
+    success = success &&
+        readLargeNumArray(imsg, col.data() + offset, n, payloadBytes);
+  }
+  for (std::vector<Boolean_t> & col : this->XORPayloadCols) {
+    success = success && imsg.remove(col.data() + offset, n);
+  }
+  return success;
+}
+
+ObservationStore ObservationStore::fromObservationList(
+    ff::mpc::ObservationList<LargeNum> const & list) {
+  ObservationStore store(
+      list.elements.size(),
+      list.numKeyCols,
+      list.numArithmeticPayloadCols,
+      list.numXORPayloadCols);
+
+  for (size_t r = 0; r < store.rows; r++) {
+    ff::mpc::Observation<LargeNum> const & o = list.elements[r];
+    for (size_t c = 0; c < store.numKeyCols(); c++) {
+      store.keyCols[c][r] = o.keyCols[c];
+    }
+    for (size_t c = 0; c < store.numArithmeticPayloadCols(); c++) {
+      store.arithmeticPayloadCols[c][r] = o.arithmeticPayloadCols[c];
+    }
+    for (size_t c = 0; c < store.numXORPayloadCols(); c++) {
+      store.XORPayloadCols[c][r] = o.XORPayloadCols[c];
+    }
+  }
+  return store;
+}
+
+void ObservationStore::toObservationList(
+    ff::mpc::ObservationList<LargeNum> & list) const {
+  list.numKeyCols = this->numKeyCols();
+  list.numArithmeticPayloadCols = this->numArithmeticPayloadCols();
+  list.numXORPayloadCols = this->numXORPayloadCols();
+
+  list.elements.clear();
+  list.elements.resize(this->rows);
+  for (size_t r = 0; r < this->rows; r++) {
+    ff::mpc::Observation<LargeNum> & o = list.elements[r];
+
+    o.keyCols.reserve(this->numKeyCols());
+    for (std::vector<LargeNum> const & col : this->keyCols) {
+      o.keyCols.push_back(col[r]);
+    }
+    o.arithmeticPayloadCols.reserve(this->numArithmeticPayloadCols());
+    for (std::vector<LargeNum> const & col :
+         this->arithmeticPayloadCols) {
+      o.arithmeticPayloadCols.push_back(col[r]);
+    }
+    o.XORPayloadCols.reserve(this->numXORPayloadCols());
+    for (std::vector<Boolean_t> const & col : this->XORPayloadCols) {
+      o.XORPayloadCols.push_back(col[r]);
+    }
+  }
+}
+
+} // namespace dataowner
+} // namespace safrn
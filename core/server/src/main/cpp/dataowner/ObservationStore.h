@@ -0,0 +1,157 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_DATAOWNER_OBSERVATION_STORE_H_
+#define SAFRN_DATAOWNER_OBSERVATION_STORE_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <mpc/ObservationList.h>
+#include <mpc/templates.h>
+
+/* Safrn Headers */
+#include <dataowner/fortissimo.h>
+#include <framework/Framework.h>
+#include <util/SeedPrg.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+/**
+ * A dataowner's observations, held column by column.
+ *
+ * Where an ObservationList gives every observation its own key and
+ * payload vectors, this holds one contiguous array per column, so that
+ * loops over a column touch consecutive memory. Conversion to and from
+ * an ObservationList is only needed where fortissimo takes over (e.g.
+ * ObliviousMerge and ZipAdjacent).
+ */
+class ObservationStore {
+public:
+  std::vector<std::vector<LargeNum>> keyCols;
+  std::vector<std::vector<LargeNum>> arithmeticPayloadCols;
+  std::vector<std::vector<Boolean_t>> XORPayloadCols;
+
+  ObservationStore() = default;
+
+  /**
+   * Makes a store of numRows rows with every value zero.
+   */
+  ObservationStore(
+      size_t const numRows,
+      size_t const numKeyCols,
+      size_t const numArithmeticPayloadCols,
+      size_t const numXORPayloadCols);
+
+  size_t numRows() const {
+    return this->rows;
+  }
+
+  size_t numKeyCols() const {
+    return this->keyCols.size();
+  }
+
+  size_t numArithmeticPayloadCols() const {
+    return this->arithmeticPayloadCols.size();
+  }
+
+  size_t numXORPayloadCols() const {
+    return this->XORPayloadCols.size();
+  }
+
+  /**
+   * Grows or shrinks every column to numRows, zero filling new rows.
+   */
+  void resizeRows(size_t const numRows);
+
+  /**
+   * Grows or shrinks the number of arithmetic payload columns, adding
+   * zero columns.
+   */
+  void resizeArithmeticPayloadCols(size_t const numCols);
+
+  /**
+   * Reorders the rows by the (plaintext) key column keyCol, keeping
+   * rows with equal keys in their original order.
+   */
+  void sortRows(size_t const keyCol, bool const descending);
+
+  /**
+   * Splits every row into two additive shares. The other party's
+   * random shares are written into theirs, which has numRows() rows,
+   * and this party's into rows [offset, offset + numRows()) of mine.
+   */
+  void share(
+      SeedPrg & prg,
+      LargeNum const & keyModulus,
+      LargeNum const & payloadModulus,
+      ObservationStore & theirs,
+      ObservationStore & mine,
+      size_t const offset) const;
+
+  /**
+   * Splits rows [begin, begin + theirs.numRows()) only, as share does,
+   * into rows [offset + begin, offset + begin + theirs.numRows()) of
+   * mine, so that theirs may hold a chunk of the rows at a time.
+   */
+  void shareRows(
+      SeedPrg & prg,
+      LargeNum const & keyModulus,
+      LargeNum const & payloadModulus,
+      size_t const begin,
+      ObservationStore & theirs,
+      ObservationStore & mine,
+      size_t const offset) const;
+
+  /**
+   * Writes every column, one after another. Keys are keyBytes wide and
+   * arithmetic payloads payloadBytes wide (see fixedWidthBytes).
+   */
+  bool writeColumns(
+      OutgoingMessage & omsg,
+      size_t const keyBytes,
+      size_t const payloadBytes) const;
+
+  /**
+   * Reads rows [offset, offset + n) of every column, as written by
+   * writeColumns.
+   */
+  bool readColumns(
+      IncomingMessage & imsg,
+      size_t const offset,
+      size_t const n,
+      size_t const keyBytes,
+      size_t const payloadBytes);
+
+  /**
+   * Converts from fortissimo, using the list's column counts.
+   */
+  static ObservationStore
+  fromObservationList(ff::mpc::ObservationList<LargeNum> const & list);
+
+  /**
+   * Converts to fortissimo, replacing the list's contents.
+   */
+  void
+  toObservationList(ff::mpc::ObservationList<LargeNum> & list) const;
+
+private:
+  size_t rows = 0;
+};
+
+} // namespace dataowner
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_DATAOWNER_OBSERVATION_STORE_H_
@@ -7,6 +7,10 @@
 
 #include <mpc/ObservationList.h>
 
+#include <util/LargeNumArray.h>
+#include <util/ModColumns.h>
+#include <util/SeedPrg.h>
+
 /* logging configuration */
 #include <ff/logging.h>
 
@@ -14,29 +18,33 @@ namespace safrn {
 namespace dataowner {
 
 Regression::Regression(
-    ff::mpc::ObservationList<LargeNum> && olist,
+    ObservationStore && ownStore,
     std::string F_tableFile,
     std::string t_tableFile,
     GlobalInfo const * const globals,
-    std::unique_ptr<RegressionInfo const> i) :
-    ownList(std::move(olist)),
+    std::unique_ptr<RegressionInfo const> i,
+    std::unique_ptr<RandomnessStore const> store,
+    std::vector<std::vector<LargeNum>> && momentsData) :
+    ownStore(std::move(ownStore)),
     F_tableFile(std::move(F_tableFile)),
     t_tableFile(std::move(t_tableFile)),
     globals(globals),
     info(std::move(i)),
-    startModulusPayloadVector(
-        this->info->num_IVs * this->info->num_IVs +
-        this->info->num_IVs + 3),
+    store(std::move(store)),
+    momentsData(std::move(momentsData)),
+    momentsPowerSums(this->info->numMomentsPayloads),
+    momentsExpectations(this->info->numMomentsPayloads),
+    startModulusPayloadVector(this->info->payloadSumsLength),
     matrixShare(this->info->num_IVs * this->info->num_IVs),
     vectorShare(this->info->num_IVs),
     matMultiplyOutput(this->info->num_IVs, this->info->num_IVs + 1),
     F_info(),
     t_info() {
   /** these two calls will populate F/t row_ids, col_ids, table_data */
-  if (!dealer::read_table_csv_file(
+  if (!loadLookupTable(
           this->F_tableFile,
           this->F_row_ids,
-          this->F_table_data,
+          this->F_table,
           this->num_F_cols,
           this->F_cols_bits_of_precision,
           this->F_cols_step_size,
@@ -44,10 +52,10 @@ Regression::Regression(
           this->info->bytesInLookupTableCells)) {
     this->abortFlag = true;
   }
-  if (!dealer::read_table_csv_file(
+  if (!loadLookupTable(
           this->t_tableFile,
           this->t_row_ids,
-          this->t_table_data,
+          this->t_table,
           this->num_t_cols,
           this->t_cols_bits_of_precision,
           this->t_cols_step_size,
@@ -65,15 +73,14 @@ Regression::Regression(
         "start mod %s, end mod %s",
         ff::mpc::dec(this->info->startModulus).c_str(),
         ff::mpc::dec(this->info->endModulus).c_str());
-    for (size_t i = 0; i < this->ownList.elements.size(); i++) {
-      for (size_t j = 0; j < this->ownList.numArithmeticPayloadCols;
-           j++) {
+    for (size_t j = 0; j < this->ownStore.numArithmeticPayloadCols();
+         j++) {
+      for (size_t i = 0; i < this->ownStore.numRows(); i++) {
         log_debug(
             "payload[%zu][%zu] = %s",
             i,
             j,
-            ff::mpc::dec(
-                this->ownList.elements[i].arithmeticPayloadCols[j])
+            ff::mpc::dec(this->ownStore.arithmeticPayloadCols[j][i])
                 .c_str());
       }
     }
@@ -84,85 +91,119 @@ Regression::Regression(
   this->setupCrossVerticalShares();
 }
 
+/**
+ * Appends the column of products of two existing columns.
+ */
+static void appendProductColumn(
+    std::vector<std::vector<LargeNum>> & cols,
+    size_t const a,
+    size_t const b,
+    LargeNum const & modulus) {
+  std::vector<LargeNum> product(cols[a].size());
+  modMulColumn(
+      cols[a].data(),
+      cols[b].data(),
+      product.data(),
+      product.size(),
+      modulus);
+  cols.push_back(std::move(product));
+}
+
 void Regression::computePayloadVectorAndPadList() {
   log_debug("Calling computePayloadVectorAndPadList");
   // Issue #220
   log_debug(
-      "This->ownList.elements.size() %zu, maxListSize %zu",
-      this->ownList.elements.size(),
-      this->globals->maxListSize);
+      "This->ownStore.numRows() %zu, listSize %zu",
+      this->ownStore.numRows(),
+      this->globals->listSize(this->info->selfVertical));
   log_debug("this->info->payloadLength %zu", this->info->payloadLength);
-  if (this->info->selfVertical == this->info->verticalDV) {
-    for (auto & o : this->ownList.elements) {
-      o.arithmeticPayloadCols.reserve(this->info->payloadLength);
-      // xi*xj
-      for (size_t i = 0; i < this->info->verticalDV_numIVs; i++) {
-        for (size_t j = i; j < this->info->verticalDV_numIVs; j++) {
-          o.arithmeticPayloadCols.push_back(ff::mpc::modMul(
-              o.arithmeticPayloadCols[i],
-              o.arithmeticPayloadCols[j],
-              this->info->startModulus));
-        }
-      }
 
-      // xi*y
-      for (size_t i = 0; i < this->info->verticalDV_numIVs; i++) {
+  std::vector<std::vector<LargeNum>> & cols =
+      this->ownStore.arithmeticPayloadCols;
+  cols.reserve(std::max(cols.size(), this->info->payloadLength));
+  if (this->info->selfVertical == this->info->verticalDV) {
+    size_t const y = this->info->verticalDV_numIVs;
 
-        o.arithmeticPayloadCols.push_back(ff::mpc::modMul(
-            o.arithmeticPayloadCols[i],
-            o.arithmeticPayloadCols[this->info->verticalDV_numIVs],
-            this->info->startModulus));
+    // xi*xj
+    for (size_t i = 0; i < this->info->verticalDV_numIVs; i++) {
+      for (size_t j = i; j < this->info->verticalDV_numIVs; j++) {
+        appendProductColumn(cols, i, j, this->info->startModulus);
       }
+    }
 
-      //y2
-      o.arithmeticPayloadCols.push_back(ff::mpc::modMul(
-          o.arithmeticPayloadCols[this->info->verticalDV_numIVs],
-          o.arithmeticPayloadCols[this->info->verticalDV_numIVs],
-          this->info->startModulus));
+    // xi*y
+    for (size_t i = 0; i < this->info->verticalDV_numIVs; i++) {
+      appendProductColumn(cols, i, y, this->info->startModulus);
+    }
 
-      // y
-      o.arithmeticPayloadCols.push_back(
-          o.arithmeticPayloadCols[this->info->verticalDV_numIVs]);
+    //y2
+    appendProductColumn(cols, y, y, this->info->startModulus);
 
-      // 1
-      o.arithmeticPayloadCols.push_back(1U);
-      o.arithmeticPayloadCols.resize(this->info->payloadLength);
-    }
+    // y
+    std::vector<LargeNum> y_copy(cols[y]);
+    cols.push_back(std::move(y_copy));
+
+    // 1
+    cols.emplace_back(this->ownStore.numRows(), LargeNum(1U));
   } else {
-    for (auto & o : this->ownList.elements) {
-      o.arithmeticPayloadCols.reserve(this->info->payloadLength);
-      for (size_t i = 0; i < this->info->verticalNonDV_numIVs; i++) {
-        for (size_t j = i; j < this->info->verticalNonDV_numIVs; j++) {
-          o.arithmeticPayloadCols.push_back(ff::mpc::modMul(
-              o.arithmeticPayloadCols[i],
-              o.arithmeticPayloadCols[j],
-              this->info->startModulus));
-        }
+    for (size_t i = 0; i < this->info->verticalNonDV_numIVs; i++) {
+      for (size_t j = i; j < this->info->verticalNonDV_numIVs; j++) {
+        appendProductColumn(cols, i, j, this->info->startModulus);
       }
-      o.arithmeticPayloadCols.resize(this->info->payloadLength);
     }
   }
-
-  log_debug(
-      "This->ownList.elements.size() %zu, maxListSize %zu",
-      this->ownList.elements.size(),
-      this->globals->maxListSize);
-  this->ownList.numArithmeticPayloadCols = this->info->payloadLength;
-  this->ownList.numKeyCols = 2;
-
-  while (this->ownList.elements.size() < this->globals->maxListSize) {
-    ff::mpc::Observation<LargeNum> o;
-    o.arithmeticPayloadCols =
-        std::vector<LargeNum>(this->ownList.numArithmeticPayloadCols);
-    o.keyCols = std::vector<LargeNum>(this->ownList.numKeyCols);
-    for (size_t i = 0; i < this->ownList.numKeyCols; i++) {
-      o.keyCols[i] =
-          ff::mpc::randomModP<LargeNum>(this->info->keyModulus);
+  this->ownStore.resizeArithmeticPayloadCols(
+      this->info->momentsPayloadOffset);
+
+  /* x, x^2, ... of each batched moment, zero off its vertical. */
+  size_t next_data = 0;
+  for (BatchedMoments const & moments : this->info->batchedMoments) {
+    if (moments.dataVertical != this->info->selfVertical) {
+      this->ownStore.resizeArithmeticPayloadCols(
+          cols.size() + moments.highestMoment);
+      continue;
     }
-    o.XORPayloadCols =
-        std::vector<Boolean_t>(this->ownList.numXORPayloadCols);
-    this->ownList.elements.push_back(o);
+    std::vector<LargeNum> & data = this->momentsData[next_data++];
+    if (moments.highestMoment == 0) {
+      continue;
+    }
+    size_t const x = cols.size();
+    cols.push_back(std::move(data));
+    for (size_t i = 1; i < moments.highestMoment; i++) {
+      appendProductColumn(
+          cols, cols.size() - 1, x, this->info->startModulus);
+    }
+  }
+  this->momentsData = std::vector<std::vector<LargeNum>>();
+  log_assert(cols.size() == this->info->payloadLength);
+  this->ownStore.keyCols.resize(
+      1, std::vector<LargeNum>(this->ownStore.numRows()));
+
+  /* Pad past every real key, with zero payloads. */
+  size_t const num_real_rows = this->ownStore.numRows();
+  this->ownStore.resizeRows(
+      this->globals->listSize(this->info->selfVertical));
+  std::fill(
+      this->ownStore.keyCols[0].begin() + num_real_rows,
+      this->ownStore.keyCols[0].end(),
+      this->globals->key_max + 1);
+
+  /* ZipAdjacent matches rows by the plain key, carried after the
+   * packed one, which only orders the merge. */
+  this->ownStore.keyCols.push_back(this->ownStore.keyCols[0]);
+
+  /* Pack the vertical into the low bit, 2 * key + [the DV], so the
+   * non-DV's row sorts first among equal keys, as
+   * RegressionPayloadCompute reads each pair. */
+  bool const is_DV = this->info->selfVertical == this->info->verticalDV;
+  LargeNum const tag(is_DV ? 1 : 0);
+  for (LargeNum & key : this->ownStore.keyCols[0]) {
+    key = 2 * key + tag;
   }
+
+  /* The DV's rows come first in each shared list, descending, so that
+   * the list is bitonic for ObliviousMerge. */
+  this->ownStore.sortRows(0, is_DV);
 }
 
 void Regression::setupCrossParties() {
@@ -182,69 +223,16 @@ void Regression::setupCrossParties() {
 
 void Regression::setupCrossVerticalShares() {
   log_debug("Calling setupCrossVerticalShares");
+  this->sharedStores.reserve(this->info->numCrossParties);
   for (size_t i = 0; i < this->info->numCrossParties; i++) {
-    this->outgoingListShares.emplace_back();
-    this->outgoingListShares.back().elements.reserve(
-        this->globals->maxListSize); // just theirs
-    this->outgoingListShares.back().numKeyCols =
-        this->ownList.numKeyCols;
-    this->outgoingListShares.back().numArithmeticPayloadCols =
-        this->ownList.numArithmeticPayloadCols;
-    this->outgoingListShares.back().numXORPayloadCols =
-        this->ownList.numXORPayloadCols;
-
-    this->sharedLists.emplace_back();
-    this->sharedLists.back().elements.resize(
-        this->globals->maxListSize * 2); // my shares and theirs
-    this->sharedLists.back().numKeyCols = this->ownList.numKeyCols;
-    this->sharedLists.back().numArithmeticPayloadCols =
-        this->ownList.numArithmeticPayloadCols;
-    this->sharedLists.back().numXORPayloadCols =
-        this->ownList.numXORPayloadCols;
-
-    for (size_t j = 0; j < this->globals->maxListSize; j++) {
-      ff::mpc::Observation<LargeNum> o;
-      ff::mpc::Observation<LargeNum> o_my_share;
-      for (size_t k = 0; k < this->ownList.numKeyCols; k++) {
-        auto rand_val =
-            ff::mpc::randomModP<LargeNum>(this->info->keyModulus);
-        o.keyCols.push_back(rand_val);
-        o_my_share.keyCols.push_back(ff::mpc::modSub(
-            this->ownList.elements[j].keyCols[k],
-            rand_val,
-            this->info->keyModulus));
-      }
-      for (size_t k = 0; k < this->ownList.numArithmeticPayloadCols;
-           k++) {
-        auto rand_val =
-            ff::mpc::randomModP<LargeNum>(this->info->startModulus);
-        o.arithmeticPayloadCols.push_back(rand_val);
-        o_my_share.arithmeticPayloadCols.push_back(ff::mpc::modSub(
-            this->ownList.elements[j].arithmeticPayloadCols[k],
-            rand_val,
-            this->info->startModulus));
-      }
-      for (size_t k = 0; k < this->ownList.numXORPayloadCols; k++) {
-        auto rand_val = ff::mpc::randomByte();
-        o.XORPayloadCols.push_back(rand_val);
-        o_my_share.XORPayloadCols.push_back(
-            this->ownList.elements[j].XORPayloadCols[k] ^ rand_val);
-      }
-      this->sharedLists.back().elements
-          [j +
-           this->globals->maxListSize *
-               ((this->info->selfVertical != this->info->verticalDV) ?
-                    1 :
-                    0)] = std::move(o_my_share);
-      this->outgoingListShares.back().elements.push_back(o);
-    }
-  }
-  for (size_t i = 0; i < this->info->numCrossParties; i++) {
-    log_debug(
-        "shared list size %zu and outgoing list size %zu ",
-        this->sharedLists[i].elements.size(),
-        this->outgoingListShares[i].elements.size());
+    this->sharedStores.emplace_back(
+        this->info->listSizeDV +
+            this->info->listSizeNonDV, // my shares and theirs
+        this->ownStore.numKeyCols(),
+        this->ownStore.numArithmeticPayloadCols(),
+        this->ownStore.numXORPayloadCols());
   }
+  this->rowsReceived.assign(this->info->numCrossParties, 0);
   log_debug("Done setupCrossVerticalShares");
 }
 
@@ -262,15 +250,15 @@ void Regression::init() {
       this->t_cols_bits_of_precision,
       ff::mpc::dec(this->t_cols_step_size).c_str());
 
-  this->state = awaitingRandomnessAndSISOSort;
+  this->state = awaitingRandomnessAndMerge;
   this->setupCrossParties();
 
   this->shareWithCrossVerticalParties();
 
   this->F_info.r_modulus_ = this->info->endModulus;
-  this->F_info.table_size_ = this->F_table_data.size();
+  this->F_info.table_size_ = this->F_table.size();
   this->t_info.r_modulus_ = this->info->endModulus;
-  this->t_info.table_size_ = this->t_table_data.size();
+  this->t_info.table_size_ = this->t_table.size();
 
   this->invokeRandomnessPatron();
 }
@@ -278,40 +266,52 @@ void Regression::init() {
 void Regression::shareWithCrossVerticalParties() {
   log_debug("Calling shareWithCrossVerticalParties");
   // Issue #220
-
-  for (size_t i = 0; i < this->info->numCrossParties; i++) {
-    log_debug(
-        "shared list size %zu and outgoing list size %zu ",
-        this->sharedLists[i].elements.size(),
-        this->outgoingListShares[i].elements.size());
-  }
+  /* The DV's rows, then the other vertical's, in each shared list. */
+  size_t const n = this->ownStore.numRows();
+  size_t const offset =
+      (this->info->selfVertical != this->info->verticalDV) ?
+      this->info->listSizeDV :
+      0;
+  size_t const chunk = this->globals->chunkRows(n);
+  SeedPrg prg(SeedPrg::newSeed());
+
+  /* Their shares are made and sent a chunk of rows at a time, so only
+   * one chunk of them is ever held. */
+  ObservationStore theirs(
+      chunk,
+      this->ownStore.numKeyCols(),
+      this->ownStore.numArithmeticPayloadCols(),
+      this->ownStore.numXORPayloadCols());
   size_t i = 0;
-
   this->getPeers().forEachDataowner([&, this](const Identity & other) {
     if (other.vertical != this->getSelf().vertical) {
-      std::unique_ptr<OutgoingMessage> omsg(new OutgoingMessage(other));
-      for (size_t j = 0; j < this->globals->maxListSize; j++) {
-        for (size_t k = 0; k < this->ownList.numKeyCols; k++) {
-          omsg->write<LargeNum>(
-              this->outgoingListShares[i].elements[j].keyCols[k]);
-        }
-        for (size_t k = 0; k < this->ownList.numArithmeticPayloadCols;
-             k++) {
-          omsg->write<LargeNum>(this->outgoingListShares[i]
-                                    .elements[j]
-                                    .arithmeticPayloadCols[k]);
-        }
-        for (size_t k = 0; k < this->ownList.numXORPayloadCols; k++) {
-          omsg->write<Boolean_t>(this->outgoingListShares[i]
-                                     .elements[j]
-                                     .XORPayloadCols[k]);
-        }
-      }
-      this->send(std::move(omsg));
+      size_t begin = 0;
+      do {
+        theirs.resizeRows(std::min(chunk, n - begin));
+        this->ownStore.shareRows(
+            prg,
+            this->info->keyModulus,
+            this->info->startModulus,
+            begin,
+            theirs,
+            this->sharedStores[i],
+            offset);
+        begin += theirs.numRows();
 
+        std::unique_ptr<OutgoingMessage> omsg(
+            new OutgoingMessage(other));
+        theirs.writeColumns(
+            *omsg,
+            fixedWidthBytes(this->info->keyModulus),
+            fixedWidthBytes(this->info->startModulus));
+        this->send(std::move(omsg));
+      } while (begin < n);
       i++;
     }
   });
+
+  /* Our rows are no longer needed once shared. */
+  this->ownStore = ObservationStore();
 }
 
 void Regression::invokeRandomnessPatron() {
@@ -335,12 +335,28 @@ void Regression::invokeRandomnessPatron() {
               .size(), // this isn't in the info object because it depends on the t_table input file
           &this->F_info,
           &this->t_info,
-          1UL));
+          1UL,
+          this->store.get()));
   PeerSet ps(this->getPeers());
   ps.removeRecipients();
   this->invoke(std::move(patron), ps);
 }
 
+void Regression::invokeFinalMultiply(
+    std::vector<LargeNum> && xs, std::vector<LargeNum> && ys) {
+  std::unique_ptr<Fronctocol> multiply(new VectorMultiply(
+      std::move(xs),
+      std::move(ys),
+      *this->randomness.beaverTripleForFinalMultiplyDispenser,
+      this->info->endModulus,
+      *this->info->revealer));
+
+  PeerSet ps(this->getPeers());
+  ps.removeDealer();
+  ps.removeRecipients();
+  this->invoke(std::move(multiply), ps);
+}
+
 void Regression::handlePromise(Fronctocol &) {
   log_error("Unexpected handle promise received in Regression");
 }
@@ -350,46 +366,40 @@ void Regression::handleReceive(IncomingMessage & msg) {
       "Calling handleReceive with %zu parties remaining",
       this->numPartiesAwaiting);
   // Issue #220
-  /** TO-DO: Read in msg to sharedLists[crossPartyIndex][ind1..ind2] */
-
-  for (size_t i = 0; i < this->info->numCrossParties; i++) {
-    log_debug(
-        "shared list size %zu and outgoing list size %zu ",
-        this->sharedLists[i].elements.size(),
-        this->outgoingListShares[i].elements.size());
+  /* Shares arrive a chunk of rows at a time, in order. */
+  bool const is_DV = this->info->selfVertical == this->info->verticalDV;
+  size_t const rows =
+      is_DV ? this->info->listSizeNonDV : this->info->listSizeDV;
+  size_t const index = indexOfCrossParties[msg.sender];
+  size_t const received = this->rowsReceived[index];
+  size_t const n =
+      std::min(this->globals->chunkRows(rows), rows - received);
+  size_t const offset = (is_DV ? this->info->listSizeDV : 0) + received;
+  ObservationStore & shared = this->sharedStores[index];
+  if (!shared.readColumns(
+          msg,
+          offset,
+          n,
+          fixedWidthBytes(this->info->keyModulus),
+          fixedWidthBytes(this->info->startModulus))) {
+    log_error("Could not read shares from cross-vertical party");
+    this->abort();
+    return;
   }
 
-  for (size_t j = 0; j < this->globals->maxListSize; j++) {
-    ff::mpc::Observation<LargeNum> o;
-    for (size_t k = 0; k < this->ownList.numKeyCols; k++) {
-      LargeNum rand_val;
-      msg.read<LargeNum>(rand_val);
-
-      o.keyCols.push_back(rand_val);
-    }
-    for (size_t k = 0; k < this->ownList.numArithmeticPayloadCols;
-         k++) {
-      LargeNum rand_val;
-      msg.read<LargeNum>(rand_val);
-
-      o.arithmeticPayloadCols.push_back(rand_val);
-    }
-    for (size_t k = 0; k < this->ownList.numXORPayloadCols; k++) {
-      Boolean_t rand_val;
-      msg.read<Boolean_t>(rand_val);
-
-      o.XORPayloadCols.push_back(rand_val);
-    }
-    this->sharedLists[indexOfCrossParties[msg.sender]].elements
-        [j +
-         this->globals->maxListSize *
-             ((this->info->selfVertical == this->info->verticalDV) ?
-                  1 :
-                  0)] = std::move(o);
+  this->rowsReceived[index] += n;
+  if (this->rowsReceived[index] < rows) {
+    return;
   }
-
   this->numPartiesAwaiting--;
   if (this->numPartiesAwaiting == 0) {
+    /* ObliviousMerge works on fortissimo's lists, so convert here. */
+    this->sharedLists.resize(this->sharedStores.size());
+    for (size_t j = 0; j < this->sharedStores.size(); j++) {
+      this->sharedStores[j].toObservationList(this->sharedLists[j]);
+      this->sharedStores[j] = ObservationStore();
+    }
+
     size_t i = 0;
     this->getPeers().forEachDataowner([&,
                                        this](const Identity & other) {
@@ -404,8 +414,8 @@ void Regression::handleReceive(IncomingMessage & msg) {
         } else {
           temp_revealer = &other;
         }
-        log_debug("preparingSISOSort");
-        std::unique_ptr<Fronctocol> siso_sort(new SISOSort(
+        log_debug("preparingObliviousMerge");
+        std::unique_ptr<Fronctocol> merge(new ObliviousMerge(
             this->sharedLists[i],
             this->info->startModulus,
             this->info->keyModulus,
@@ -417,13 +427,13 @@ void Regression::handleReceive(IncomingMessage & msg) {
         ps.add(other);
         this->getPeers().forEachDealer(
             [&ps](const Identity & other2) { ps.add(other2); });
-        this->invoke(std::move(siso_sort), ps);
+        this->invoke(std::move(merge), ps);
         i++;
       }
     });
     this->numPartiesAwaiting = this->info->numCrossParties;
-    this->state = awaitingSISOSort;
-    log_debug("awaitingSISOSort");
+    this->state = awaitingMerge;
+    log_debug("awaitingMerge");
   }
 }
 
@@ -434,7 +444,7 @@ void Regression::handleComplete(Fronctocol & f) {
     auto * patron = dynamic_cast<RegressionRandomnessPatron *>(&f);
     if (patron == nullptr) {
       log_debug("no");
-      // i.e. fronctocol returned = SISOSORT
+      // i.e. fronctocol returned = ObliviousMerge
       this->numPartiesAwaiting--;
       if (this->numPartiesAwaiting == 0) {
         this->state = awaitingRandomnessOnly;
@@ -443,26 +453,30 @@ void Regression::handleComplete(Fronctocol & f) {
     } else {
       log_debug("yes");
       randomness = std::move(patron->regressionDispenser->get());
-      log_debug("Move onto awaitingSISOSort");
+      log_debug("Move onto awaitingMerge");
       this->randomnessDone = true;
       if (this->state == awaitingRandomnessOnly) {
         this->numPartiesAwaiting = 1; // i.e. this one
-        this->state = awaitingSISOSort;
+        this->state = awaitingMerge;
       } else {
-        this->state = awaitingSISOSort;
+        this->state = awaitingMerge;
         return;
       }
     }
   }
   switch (this->state) {
-    case (awaitingSISOSort): {
-      log_debug("awaitingSISOSort");
+    case (awaitingMerge): {
+      log_debug("awaitingMerge");
 
       //Issue #221
       this->numPartiesAwaiting--;
       if (this->numPartiesAwaiting == 0) {
 
         log_debug("and onto batchedPayloadCompute");
+        for (ff::mpc::ObservationList<LargeNum> & list :
+             this->sharedLists) {
+          ObliviousMerge::dropPackedKey(list);
+        }
         size_t i = 0;
         this->zipAdjacentInfo.reserve(this->info->numCrossParties);
 
@@ -479,7 +493,7 @@ void Regression::handleComplete(Fronctocol & f) {
             log_assert(this->info != nullptr);
 
             zipAdjacentInfo.emplace_back(
-                2 * this->globals->maxListSize,
+                this->info->zipAdjacentInfo.batchSize,
                 this->info->payloadLength,
                 0,
                 this->info->startModulus,
@@ -523,20 +537,34 @@ void Regression::handleComplete(Fronctocol & f) {
       });
 
       //Issue #221
-      this->vectorZippedAdjacent[indexOfCrossParties[cross_party]] =
+      size_t const index = indexOfCrossParties[cross_party];
+      this->vectorZippedAdjacent[index] = std::move(
           static_cast<
               ff::mpc::ZipAdjacent<SAFRN_TYPES, LargeNum, SmallNum> &>(
               f)
-              .zippedAdjacentPairs;
+              .zippedAdjacentPairs);
+
+      /* The merged list is spent once zipped. */
+      this->sharedLists[index] = ff::mpc::ObservationList<LargeNum>();
+
+      /* The batched moments are only summed, not multiplied, so are
+       * summed as each zipped list arrives. */
+      for (ff::mpc::Observation<LargeNum> const & o :
+           this->vectorZippedAdjacent[index].elements) {
+        for (size_t i = 0; i < this->momentsPowerSums.size(); i++) {
+          this->momentsPowerSums[i] = ff::mpc::modAdd(
+              this->momentsPowerSums[i],
+              o.arithmeticPayloadCols
+                  [this->info->momentsPayloadOffset + i],
+              this->info->startModulus);
+        }
+      }
 
       //Issue #221
       this->numPartiesAwaiting--;
       if (this->numPartiesAwaiting == 0) {
-        log_debug("and onto zipReduce");
+        log_debug("and onto payloadCompute");
         size_t i = 0;
-        this->fronctocolFactories.reserve(this->info->numCrossParties);
-        this->factoryMultiplyInfo.reserve(this->info->numCrossParties);
-
         this->getPeers().forEachDataowner([&, this](
                                               const Identity & other) {
           if (other.vertical != this->getSelf().vertical) {
@@ -547,58 +575,40 @@ void Regression::handleComplete(Fronctocol & f) {
             } else {
               temp_revealer = &other;
             }
-            log_debug("About to crash?");
-            log_assert(this->info != nullptr);
-            this->factoryMultiplyInfo.emplace_back(
-                temp_revealer,
-                BeaverInfo<LargeNum>(this->info->startModulus));
-            log_debug(
-                "Address of dispenser %p",
-                randomness.beaverTripleForFactoryDispensers[i].get());
-            this->fronctocolFactories.emplace_back(
-                this->info.get(),
-                std::move(
-                    randomness.beaverTripleForFactoryDispensers[i]),
-                &this->factoryMultiplyInfo.back());
-            log_assert(this->fronctocolFactories.size() == i + 1);
-            log_debug("address %p", &this->fronctocolFactories[i]);
-
-            std::unique_ptr<Fronctocol> zipRed(
-                new ff::mpc::ZipReduce<SAFRN_TYPES, LargeNum>(
+
+            std::unique_ptr<Fronctocol> payloadCompute(
+                new RegressionPayloadCompute(
                     std::move(vectorZippedAdjacent[i]),
-                    this->fronctocolFactories[i]));
+                    std::move(
+                        randomness.beaverTripleForFactoryDispensers[i]),
+                    *temp_revealer,
+                    this->info.get(),
+                    this->globals->workingSetRows));
 
             PeerSet ps = PeerSet();
             ps.add(this->getSelf());
             ps.add(other);
 
-            this->invoke(std::move(zipRed), ps);
+            this->invoke(std::move(payloadCompute), ps);
             i++;
           }
         });
-        log_debug("Done invoking batchedZipreduce");
+        log_debug("Done invoking batchedPayloadCompute");
         this->numPartiesAwaiting = this->info->numCrossParties;
-        this->state = awaitingZipReduce;
+        this->state = awaitingPayloadCompute;
       }
 
     } break;
-    case (awaitingZipReduce): {
-
-      ff::mpc::ObservationList<LargeNum> payloadShares =
-          static_cast<ff::mpc::ZipReduce<SAFRN_TYPES, LargeNum> &>(f)
-              .outputList;
-
-      for (size_t i = 0; i < this->globals->maxListSize * 2 - 1; i++) {
-        for (size_t j = 0;
-             j < this->info->num_IVs * this->info->num_IVs +
-                 this->info->num_IVs + 3;
-             j++) {
-          this->startModulusPayloadVector[j] +=
-              payloadShares.elements[i].arithmeticPayloadCols[j];
-          this->startModulusPayloadVector[j] %=
-              this->info->startModulus;
-        }
-      }
+    case (awaitingPayloadCompute): {
+      std::vector<LargeNum> const & sums =
+          static_cast<RegressionPayloadCompute &>(f).sums;
+
+      modAddColumn(
+          this->startModulusPayloadVector.data(),
+          sums.data(),
+          this->startModulusPayloadVector.data(),
+          sums.size(),
+          this->info->startModulus);
 
       this->numPartiesAwaiting--;
 
@@ -620,9 +630,7 @@ void Regression::handleComplete(Fronctocol & f) {
         /** Issue #223 */
         std::unique_ptr<ff::mpc::Batch<SAFRN_TYPES>> batchedModConv(
             new ff::mpc::Batch<SAFRN_TYPES>());
-        for (size_t i = 0;
-             i < info->num_IVs * info->num_IVs + info->num_IVs + 3;
-             i++) {
+        for (size_t i = 0; i < this->info->payloadSumsLength; i++) {
           batchedModConv->children.emplace_back(
               new ModConvUp<SmallNum, LargeNum, LargeNum>(
                   this->startModulusPayloadVector[i],
@@ -630,6 +638,14 @@ void Regression::handleComplete(Fronctocol & f) {
                   std::move(
                       this->randomness.modConvUpDispenser->get())));
         }
+        for (size_t i = 0; i < this->info->numMomentsPayloads; i++) {
+          batchedModConv->children.emplace_back(
+              new ModConvUp<SmallNum, LargeNum, LargeNum>(
+                  this->momentsPowerSums[i],
+                  &this->info->modConvUpInfo,
+                  std::move(
+                      this->randomness.modConvUpDispenser->get())));
+        }
 
         PeerSet ps(this->getPeers());
         ps.removeDealer();
@@ -654,31 +670,44 @@ void Regression::handleComplete(Fronctocol & f) {
                 .c_str());
       }
 
-      for (size_t i = 0; i < info->num_IVs * info->num_IVs; i++) {
-        matrixShare[i] =
-            static_cast<ModConvUp<SmallNum, LargeNum, LargeNum> &>(
-                *batch.children[i])
-                .outputShare;
+      /* expand the packed upper triangle into the full A^TA */
+      for (size_t i = 0; i < info->num_IVs; i++) {
+        for (size_t j = i; j < info->num_IVs; j++) {
+          matrixShare[i * info->num_IVs + j] =
+              static_cast<ModConvUp<SmallNum, LargeNum, LargeNum> &>(
+                  *batch.children[info->packedIndex(i, j)])
+                  .outputShare;
+          matrixShare[j * info->num_IVs + i] =
+              matrixShare[i * info->num_IVs + j];
+        }
       }
+      size_t const vector_start = info->packedMatrixLength;
       for (size_t i = 0; i < info->num_IVs; i++) {
         vectorShare[i] =
             static_cast<ModConvUp<SmallNum, LargeNum, LargeNum> &>(
-                *batch.children[i + info->num_IVs * info->num_IVs])
+                *batch.children[vector_start + i])
                 .outputShare;
       }
 
       ySquaredShare =
           static_cast<ModConvUp<SmallNum, LargeNum, LargeNum> &>(
-              *batch.children[info->num_IVs * (info->num_IVs + 1)])
+              *batch.children[vector_start + info->num_IVs])
               .outputShare;
       yShare =
           static_cast<ModConvUp<SmallNum, LargeNum, LargeNum> &>(
-              *batch.children[info->num_IVs * (info->num_IVs + 1) + 1])
+              *batch.children[vector_start + info->num_IVs + 1])
               .outputShare;
       oneShare =
           static_cast<ModConvUp<SmallNum, LargeNum, LargeNum> &>(
-              *batch.children[info->num_IVs * (info->num_IVs + 1) + 2])
+              *batch.children[vector_start + info->num_IVs + 2])
               .outputShare;
+      size_t const moments_start = info->payloadSumsLength;
+      for (size_t i = 0; i < this->info->numMomentsPayloads; i++) {
+        this->momentsPowerSums[i] =
+            static_cast<ModConvUp<SmallNum, LargeNum, LargeNum> &>(
+                *batch.children[moments_start + i])
+                .outputShare;
+      }
 
       dealer::RandomSquareMatrix<LargeNum> random_matrix =
           this->randomness.randomMatrixAndDetInverseDispenser->get();
@@ -711,20 +740,17 @@ void Regression::handleComplete(Fronctocol & f) {
 
       // (d x d) * (d x (d+1)) output is (d x (d+1)) final column = R(A^Ty)
 
-      std::unique_ptr<ff::mpc::MatrixMult<SAFRN_TYPES, LargeNum>>
-          matMult(new ff::mpc::MatrixMult<SAFRN_TYPES, LargeNum>(
-              &r.front(),
-              &m.front(),
-              &this->matMultiplyOutput,
-              this->info->endModulusMultiplyInfo,
-              std::move(this->randomness
-                            .beaverTripleForMatrixMultiplyDispenser)));
+      std::unique_ptr<Fronctocol> matMult(new MatrixMultiply(
+          this->r.front(),
+          this->m.front(),
+          this->randomness.matrixBeaverTripleDispenser->get(),
+          this->info->endModulus,
+          *this->info->endModulusMultiplyInfo.revealer));
 
       PeerSet ps(this->getPeers());
       ps.removeDealer();
       ps.removeRecipients();
       this->invoke(std::move(matMult), ps);
-      // kimee's invoke of MatrixMultiply
 
       /** invoke matrix multiplication, Issue #225 */
       this->state = awaitingMatrixMultiply;
@@ -732,7 +758,8 @@ void Regression::handleComplete(Fronctocol & f) {
     } break;
     case (awaitingMatrixMultiply): {
       log_debug("awaitingMatrixMultiply");
-      // pointer to result now holds result
+      this->matMultiplyOutput =
+          std::move(static_cast<MatrixMultiply &>(f).output);
 
       std::unique_ptr<Batch> batchedReveal(new Batch());
 
@@ -824,36 +851,24 @@ void Regression::handleComplete(Fronctocol & f) {
       log_debug(
           "this->info->divideInfo.ell %zu", this->info->divideInfo.ell);
 
-      std::unique_ptr<Batch> batchedMultiply(new Batch());
-
-      this->regressionMultiplyOutput.resize(
-          vectorShareAsMatrixObject.getNumRows());
+      std::vector<LargeNum> xs(
+          vectorShareAsMatrixObject.getNumRows(),
+          this->det * this->detShare);
+      std::vector<LargeNum> ys(vectorShareAsMatrixObject.getNumRows());
       for (size_t i = 0; i < vectorShareAsMatrixObject.getNumRows();
            i++) {
-        batchedMultiply->children.emplace_back(
-            new ff::mpc::Multiply<
-                SAFRN_TYPES,
-                LargeNum,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                this->det * this->detShare,
-                vectorShareAsMatrixObject.at(i, 0),
-                &this->regressionMultiplyOutput[i],
-                std::move(
-                    this->randomness
-                        .beaverTripleForFinalMultiplyDispenser->get()),
-                &this->info->endModulusMultiplyInfo));
+        ys[i] = vectorShareAsMatrixObject.at(i, 0);
       }
 
-      PeerSet ps(this->getPeers());
-      ps.removeDealer();
-      ps.removeRecipients();
-      this->invoke(std::move(batchedMultiply), ps);
+      this->invokeFinalMultiply(std::move(xs), std::move(ys));
       this->state =
           awaitingRegressionMultiply; // i.e. final for regression coefficients
 
     } break;
     case awaitingRegressionMultiply: {
       log_debug("awaitingRegressionMultiply");
+      this->regressionMultiplyOutput =
+          std::move(static_cast<VectorMultiply &>(f).outputs);
 
       std::unique_ptr<Batch> batchedFirstCompare(new Batch());
 
@@ -907,8 +922,6 @@ void Regression::handleComplete(Fronctocol & f) {
       log_debug("awaitingFirstTypeCastFromBit");
       auto & batch = static_cast<Batch &>(f);
 
-      std::unique_ptr<Batch> batchedMultiply(new Batch());
-
       this->negativeOrPositiveOneShares.resize(this->info->num_IVs);
       for (size_t i = 0; i < this->info->num_IVs; i++) {
         this->negativeOrPositiveOneShares[i] = ff::mpc::modMul(
@@ -926,53 +939,35 @@ void Regression::handleComplete(Fronctocol & f) {
         }
       }
 
-      this->negativeCorrectionMultiplyOutput.resize(
-          this->info->num_IVs);
-      for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedMultiply->children.emplace_back(
-            new ff::mpc::Multiply<
-                SAFRN_TYPES,
-                LargeNum,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                this->negativeOrPositiveOneShares[i],
-                this->regressionMultiplyOutput[i],
-                &this->negativeCorrectionMultiplyOutput[i],
-                std::move(
-                    this->randomness
-                        .beaverTripleForFinalMultiplyDispenser->get()),
-                &this->info->endModulusMultiplyInfo));
-      }
-
-      PeerSet ps(this->getPeers());
-      ps.removeDealer();
-      ps.removeRecipients();
-      this->invoke(std::move(batchedMultiply), ps);
+      this->invokeFinalMultiply(
+          std::vector<LargeNum>(this->negativeOrPositiveOneShares),
+          std::vector<LargeNum>(this->regressionMultiplyOutput));
       this->state =
           awaitingNegativeCorrectionMultiply; // i.e. final for regression coefficients
 
     } break;
     case awaitingNegativeCorrectionMultiply: {
-
-      std::unique_ptr<Batch> batchedDivision(new Batch());
-
-      for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedDivision->children.emplace_back(
-            new ff::mpc::Divide<SAFRN_TYPES, LargeNum, SmallNum>(
-                this->negativeCorrectionMultiplyOutput[i],
-                this->det * this->detShare,
-                &this->outputWeightShares[i],
-                &this->info->divideInfo,
-                std::move(this->randomness.divideDispenser->get())));
-      }
+      this->negativeCorrectionMultiplyOutput =
+          std::move(static_cast<VectorMultiply &>(f).outputs);
+
+      /* Every coefficient is divided by the same determinant. */
+      std::unique_ptr<Fronctocol> sharedDivide(new SharedDivide(
+          std::move(this->negativeCorrectionMultiplyOutput),
+          this->det * this->detShare,
+          &this->info->sharedDivideInfo,
+          std::move(this->randomness.divideDispenser->get()),
+          *this->randomness.beaverTripleForFinalMultiplyDispenser,
+          *this->randomness.truncationPairDispenser));
       PeerSet ps(this->getPeers());
       ps.removeDealer();
       ps.removeRecipients();
-      /** batched division constructor goes here, Issue # 163 */
-      this->invoke(std::move(batchedDivision), ps);
+      this->invoke(std::move(sharedDivide), ps);
       this->state = awaitingDivision;
     } break;
     case (awaitingDivision): {
       log_debug("awaitingDivision");
+      this->outputWeightShares =
+          std::move(static_cast<SharedDivide &>(f).outputs);
 
       for (size_t i = 0; i < this->info->num_IVs; i++) {
         log_debug(
@@ -981,217 +976,148 @@ void Regression::handleComplete(Fronctocol & f) {
             ff::mpc::dec(this->outputWeightShares[i]).c_str());
       }
 
-      std::unique_ptr<Batch> batchedMultiply(new Batch());
-
-      this->beta_i.resize(this->info->num_IVs);
-      for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedMultiply->children.emplace_back(
-            new ff::mpc::Multiply<
-                SAFRN_TYPES,
-                LargeNum,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                this->outputWeightShares[i],
-                this->negativeOrPositiveOneShares[i],
-                &this->beta_i[i],
-                std::move(
-                    this->randomness
-                        .beaverTripleForFinalMultiplyDispenser->get()),
-                &this->info->endModulusMultiplyInfo));
-      }
-
-      PeerSet ps(this->getPeers());
-      ps.removeDealer();
-      ps.removeRecipients();
-      /** batched division constructor goes here, Issue # 163 */
-      this->invoke(std::move(batchedMultiply), ps);
+      this->invokeFinalMultiply(
+          std::vector<LargeNum>(this->outputWeightShares),
+          std::vector<LargeNum>(this->negativeOrPositiveOneShares));
       this->state = awaitingNegativeRecorrectionMultiply;
     } break;
     case (awaitingNegativeRecorrectionMultiply): {
+      this->beta_i =
+          std::move(static_cast<VectorMultiply &>(f).outputs);
 
-      std::unique_ptr<Batch> batchedMultiply(new Batch());
-
-      this->beta_ibeta_j.resize(
-          this->info->num_IVs * this->info->num_IVs);
-
-      size_t outputCounter = 0;
+      std::vector<LargeNum> xs;
+      std::vector<LargeNum> ys;
 
       // all pairwise products of coefficients
       for (size_t i = 0; i < this->info->num_IVs; i++) {
         for (size_t j = i; j < this->info->num_IVs; j++) {
-          batchedMultiply->children.emplace_back(
-              new ff::mpc::Multiply<
-                  SAFRN_TYPES,
-                  LargeNum,
-                  ff::mpc::BeaverInfo<LargeNum>>(
-                  this->beta_i[i],
-                  this->beta_i[j],
-                  &this->beta_ibeta_j[i * this->info->num_IVs + j],
-                  std::move(this->randomness
-                                .beaverTripleForFinalMultiplyDispenser
-                                ->get()),
-                  &this->info->endModulusMultiplyInfo));
+          xs.push_back(this->beta_i[i]);
+          ys.push_back(this->beta_i[j]);
         }
       }
 
-      this->x_ix_jn.resize(this->info->num_IVs * this->info->num_IVs);
       // all products of sum x_i x_j with n
       for (size_t i = 0; i < this->info->num_IVs; i++) {
         for (size_t j = i; j < this->info->num_IVs; j++) {
-          batchedMultiply->children.emplace_back(
-              new ff::mpc::Multiply<
-                  SAFRN_TYPES,
-                  LargeNum,
-                  ff::mpc::BeaverInfo<LargeNum>>(
-                  this->m.front().at(i, j),
-                  this->oneShare,
-                  &this->x_ix_jn[i * this->info->num_IVs + j],
-                  std::move(this->randomness
-                                .beaverTripleForFinalMultiplyDispenser
-                                ->get()),
-                  &this->info->endModulusMultiplyInfo));
+          xs.push_back(this->m.front().at(i, j));
+          ys.push_back(this->oneShare);
         }
       }
 
-      this->beta_ix_iy.resize(this->info->num_IVs);
       // product of sum x_i y with beta_i
       for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedMultiply->children.emplace_back(
-            new ff::mpc::Multiply<
-                SAFRN_TYPES,
-                LargeNum,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                this->m.front().at(i, this->info->num_IVs),
-                this->beta_i[i],
-                &this->beta_ix_iy[i],
-                std::move(
-                    this->randomness
-                        .beaverTripleForFinalMultiplyDispenser->get()),
-                &this->info->endModulusMultiplyInfo));
+        xs.push_back(this->m.front().at(i, this->info->num_IVs));
+        ys.push_back(this->beta_i[i]);
       }
 
-      batchedMultiply->children.emplace_back(
-          new ff::mpc::Multiply<
-              SAFRN_TYPES,
-              LargeNum,
-              ff::mpc::BeaverInfo<LargeNum>>(
-              this->ySquaredShare,
-              this->oneShare,
-              &this->ySquaredn,
-              std::move(
-                  this->randomness
-                      .beaverTripleForFinalMultiplyDispenser->get()),
-              &this->info->endModulusMultiplyInfo));
-
-      batchedMultiply->children.emplace_back(
-          new ff::mpc::Multiply<
-              SAFRN_TYPES,
-              LargeNum,
-              ff::mpc::BeaverInfo<LargeNum>>(
-              this->yShare,
-              this->yShare,
-              &this->ySumThenSquared,
-              std::move(
-                  this->randomness
-                      .beaverTripleForFinalMultiplyDispenser->get()),
-              &this->info->endModulusMultiplyInfo));
+      xs.push_back(this->ySquaredShare);
+      ys.push_back(this->oneShare);
 
-      PeerSet ps(this->getPeers());
-      ps.removeDealer();
-      ps.removeRecipients();
-      /** batched division constructor goes here, Issue # 163 */
-      this->invoke(std::move(batchedMultiply), ps);
+      xs.push_back(this->yShare);
+      ys.push_back(this->yShare);
+
+      this->invokeFinalMultiply(std::move(xs), std::move(ys));
       this->state = awaitingFirstMultiplyForErrorTerms;
     } break;
     case (awaitingFirstMultiplyForErrorTerms): {
       log_debug("awaitingFirstMultiplyForErrorTerms");
+      std::vector<LargeNum> const & products =
+          static_cast<VectorMultiply &>(f).outputs;
 
       size_t outputCounter = 0;
 
-      std::unique_ptr<Batch> batchedMultiply(new Batch());
+      this->beta_ibeta_j.resize(
+          this->info->num_IVs * this->info->num_IVs);
+      for (size_t i = 0; i < this->info->num_IVs; i++) {
+        for (size_t j = i; j < this->info->num_IVs; j++) {
+          this->beta_ibeta_j[i * this->info->num_IVs + j] =
+              products[outputCounter++];
+        }
+      }
+
+      this->x_ix_jn.resize(this->info->num_IVs * this->info->num_IVs);
+      for (size_t i = 0; i < this->info->num_IVs; i++) {
+        for (size_t j = i; j < this->info->num_IVs; j++) {
+          this->x_ix_jn[i * this->info->num_IVs + j] =
+              products[outputCounter++];
+        }
+      }
+
+      this->beta_ix_iy.resize(this->info->num_IVs);
+      for (size_t i = 0; i < this->info->num_IVs; i++) {
+        this->beta_ix_iy[i] = products[outputCounter++];
+      }
+
+      this->ySquaredn = products[outputCounter++];
+      this->ySumThenSquared = products[outputCounter++];
+
+      std::vector<LargeNum> xs;
+      std::vector<LargeNum> ys;
 
       // all pairwise products of coefficients and x_ix_j * n
-      this->beta_ibeta_jx_ix_jn.resize(
-          this->info->num_IVs * this->info->num_IVs);
       for (size_t i = 0; i < this->info->num_IVs; i++) {
         for (size_t j = i; j < this->info->num_IVs; j++) {
-          batchedMultiply->children.emplace_back(new ff::mpc::Multiply<
-                                                 SAFRN_TYPES,
-                                                 LargeNum,
-                                                 ff::mpc::BeaverInfo<
-                                                     LargeNum>>(
-              this->beta_ibeta_j[i * this->info->num_IVs + j],
-              this->x_ix_jn[i * this->info->num_IVs + j],
-              &this->beta_ibeta_jx_ix_jn[i * this->info->num_IVs + j],
-              std::move(
-                  this->randomness
-                      .beaverTripleForFinalMultiplyDispenser->get()),
-              &this->info->endModulusMultiplyInfo));
+          xs.push_back(this->beta_ibeta_j[i * this->info->num_IVs + j]);
+          ys.push_back(this->x_ix_jn[i * this->info->num_IVs + j]);
         }
       }
 
       // all pairwise products of coefficients and x_ix_j
-      this->beta_ibeta_jx_ix_j.resize(
-          this->info->num_IVs * this->info->num_IVs);
       for (size_t i = 0; i < this->info->num_IVs; i++) {
         for (size_t j = i; j < this->info->num_IVs; j++) {
-          batchedMultiply->children.emplace_back(new ff::mpc::Multiply<
-                                                 SAFRN_TYPES,
-                                                 LargeNum,
-                                                 ff::mpc::BeaverInfo<
-                                                     LargeNum>>(
-              this->beta_ibeta_j[i * this->info->num_IVs + j],
-              this->m.front().at(i, j),
-              &this->beta_ibeta_jx_ix_j[i * this->info->num_IVs + j],
-              std::move(
-                  this->randomness
-                      .beaverTripleForFinalMultiplyDispenser->get()),
-              &this->info->endModulusMultiplyInfo));
+          xs.push_back(this->beta_ibeta_j[i * this->info->num_IVs + j]);
+          ys.push_back(this->m.front().at(i, j));
         }
       }
 
       // product of sum x_i y with n and with beta_i
-      this->beta_ix_iyn.resize(this->info->num_IVs);
       for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedMultiply->children.emplace_back(
-            new ff::mpc::Multiply<
-                SAFRN_TYPES,
-                LargeNum,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                this->oneShare,
-                this->beta_ix_iy[i],
-                &this->beta_ix_iyn[i],
-                std::move(
-                    this->randomness
-                        .beaverTripleForFinalMultiplyDispenser->get()),
-                &this->info->endModulusMultiplyInfo));
+        xs.push_back(this->oneShare);
+        ys.push_back(this->beta_ix_iy[i]);
       }
 
       // product of diagonal terms of (X^TX)^inv with determinant to clear denominators
-      this->X_T_X_inv_diag_reweighted.resize(this->info->num_IVs);
       for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedMultiply->children.emplace_back(
-            new ff::mpc::Multiply<
-                SAFRN_TYPES,
-                LargeNum,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                this->det * this->detShare,
-                this->r.front().at(i, i),
-                &this->X_T_X_inv_diag_reweighted[i],
-                std::move(
-                    this->randomness
-                        .beaverTripleForFinalMultiplyDispenser->get()),
-                &this->info->endModulusMultiplyInfo));
+        xs.push_back(this->det * this->detShare);
+        ys.push_back(this->r.front().at(i, i));
       }
 
-      PeerSet ps(this->getPeers());
-      ps.removeDealer();
-      ps.removeRecipients();
-      /** batched division constructor goes here, Issue # 163 */
-      this->invoke(std::move(batchedMultiply), ps);
+      this->invokeFinalMultiply(std::move(xs), std::move(ys));
       this->state = awaitingSecondMultiplyForErrorTerms;
     } break;
     case (awaitingSecondMultiplyForErrorTerms): {
       log_debug("awaitingSecondMultiplyForErrorTerms");
+      std::vector<LargeNum> const & products =
+          static_cast<VectorMultiply &>(f).outputs;
+      size_t outputCounter = 0;
+
+      this->beta_ibeta_jx_ix_jn.resize(
+          this->info->num_IVs * this->info->num_IVs);
+      for (size_t i = 0; i < this->info->num_IVs; i++) {
+        for (size_t j = i; j < this->info->num_IVs; j++) {
+          this->beta_ibeta_jx_ix_jn[i * this->info->num_IVs + j] =
+              products[outputCounter++];
+        }
+      }
+
+      this->beta_ibeta_jx_ix_j.resize(
+          this->info->num_IVs * this->info->num_IVs);
+      for (size_t i = 0; i < this->info->num_IVs; i++) {
+        for (size_t j = i; j < this->info->num_IVs; j++) {
+          this->beta_ibeta_jx_ix_j[i * this->info->num_IVs + j] =
+              products[outputCounter++];
+        }
+      }
+
+      this->beta_ix_iyn.resize(this->info->num_IVs);
+      for (size_t i = 0; i < this->info->num_IVs; i++) {
+        this->beta_ix_iyn[i] = products[outputCounter++];
+      }
+
+      this->X_T_X_inv_diag_reweighted.resize(this->info->num_IVs);
+      for (size_t i = 0; i < this->info->num_IVs; i++) {
+        this->X_T_X_inv_diag_reweighted[i] = products[outputCounter++];
+      }
 
       /** MSE = numer_MSE/denom_MSE
         * numer_MSE = (y_i - y_pred)^2 = sum y_i^2 + sum beta_i^2 x_i^2 + 2sum beta_i beta_j x_i x_j - 2 sum beta_i x_i y
@@ -1272,89 +1198,49 @@ void Regression::handleComplete(Fronctocol & f) {
       this->numer_RSquared += this->denom_RSquared;
       this->numer_RSquared %= this->info->endModulus;
 
-      std::unique_ptr<Batch> batchedMultiply(new Batch());
+      std::vector<LargeNum> xs;
+      std::vector<LargeNum> ys;
 
       // product of diagonal terms of (X^TX)^inv with numer_MSE
-      this->X_T_X_inv_diag_s_e.resize(this->info->num_IVs);
       for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedMultiply->children.emplace_back(
-            new ff::mpc::Multiply<
-                SAFRN_TYPES,
-                LargeNum,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                X_T_X_inv_diag_reweighted[i],
-                this->numer_MSE,
-                &this->X_T_X_inv_diag_s_e[i],
-                std::move(
-                    this->randomness
-                        .beaverTripleForFinalMultiplyDispenser->get()),
-                &this->info->endModulusMultiplyInfo));
+        xs.push_back(this->X_T_X_inv_diag_reweighted[i]);
+        ys.push_back(this->numer_MSE);
       }
 
-      batchedMultiply->children.emplace_back(
-          new ff::mpc::Multiply<
-              SAFRN_TYPES,
-              LargeNum,
-              ff::mpc::BeaverInfo<LargeNum>>(
-              this->det * this->detShare,
-              this->denom_MSE,
-              &denom_MSE_reweighted,
-              std::move(
-                  this->randomness
-                      .beaverTripleForFinalMultiplyDispenser->get()),
-              &this->info->endModulusMultiplyInfo));
-
-      batchedMultiply->children.emplace_back(
-          new ff::mpc::Multiply<
-              SAFRN_TYPES,
-              LargeNum,
-              ff::mpc::BeaverInfo<LargeNum>>(
-              this->numer_RSquared,
-              this->denom_MSE,
-              &this->numer_F_statistic,
-              std::move(
-                  this->randomness
-                      .beaverTripleForFinalMultiplyDispenser->get()),
-              &this->info->endModulusMultiplyInfo));
+      xs.push_back(this->det * this->detShare);
+      ys.push_back(this->denom_MSE);
 
-      PeerSet ps(this->getPeers());
-      ps.removeDealer();
-      ps.removeRecipients();
-      /** batched division constructor goes here, Issue # 163 */
-      this->invoke(std::move(batchedMultiply), ps);
+      xs.push_back(this->numer_RSquared);
+      ys.push_back(this->denom_MSE);
+
+      this->invokeFinalMultiply(std::move(xs), std::move(ys));
       this->state = awaitingThirdMultiplyForErrorTerms;
     } break;
     case (awaitingThirdMultiplyForErrorTerms): {
       log_debug("awaitingThirdMultiplyForErrorTerms");
+      std::vector<LargeNum> const & products =
+          static_cast<VectorMultiply &>(f).outputs;
 
-      std::unique_ptr<Batch> batchedMultiply(new Batch());
+      this->X_T_X_inv_diag_s_e.assign(
+          products.begin(), products.begin() + this->info->num_IVs);
+      this->denom_MSE_reweighted = products[this->info->num_IVs];
+      this->numer_F_statistic = products[this->info->num_IVs + 1];
 
       // product of diagonal terms of (X^TX)^inv with numer_MSE
-      this->t_statisticNumerators.resize(this->info->num_IVs);
+      std::vector<LargeNum> xs(
+          this->info->num_IVs, this->denom_MSE_reweighted);
+      std::vector<LargeNum> ys(this->info->num_IVs);
       for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedMultiply->children.emplace_back(
-            new ff::mpc::Multiply<
-                SAFRN_TYPES,
-                LargeNum,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                denom_MSE_reweighted,
-                beta_ibeta_j[i * this->info->num_IVs + i],
-                &this->t_statisticNumerators[i],
-                std::move(
-                    this->randomness
-                        .beaverTripleForFinalMultiplyDispenser->get()),
-                &this->info->endModulusMultiplyInfo));
+        ys[i] = this->beta_ibeta_j[i * this->info->num_IVs + i];
       }
 
-      PeerSet ps(this->getPeers());
-      ps.removeDealer();
-      ps.removeRecipients();
-      /** batched division constructor goes here, Issue # 163 */
-      this->invoke(std::move(batchedMultiply), ps);
+      this->invokeFinalMultiply(std::move(xs), std::move(ys));
       this->state = awaitingFourthMultiplyForErrorTerms;
     } break;
     case (awaitingFourthMultiplyForErrorTerms): {
       log_debug("awaitingFourthMultiplyForErrorTerms");
+      this->t_statisticNumerators =
+          std::move(static_cast<VectorMultiply &>(f).outputs);
 
       std::unique_ptr<Batch> batchedDivision(new Batch());
       log_debug(
@@ -1415,6 +1301,18 @@ void Regression::handleComplete(Fronctocol & f) {
                 std::move(this->randomness.divideDispenser->get())));
       }
 
+      /* E[X^i] of the batched moments, over the count of joined rows */
+      for (size_t i = 0; i < this->info->numMomentsPayloads; i++) {
+        batchedDivision->children.emplace_back(
+            new ff::mpc::Divide<SAFRN_TYPES, LargeNum, SmallNum>(
+                this->momentsPowerSums[i] *
+                    (LargeNum(1) << this->globals->bitsOfPrecision),
+                this->oneShare,
+                &this->momentsExpectations[i],
+                &this->info->divideInfo,
+                std::move(this->randomness.divideDispenser->get())));
+      }
+
       PeerSet ps(this->getPeers());
       ps.removeDealer();
       ps.removeRecipients();
@@ -1425,119 +1323,46 @@ void Regression::handleComplete(Fronctocol & f) {
     case (awaitingDivisionForErrorTerms): {
       log_debug("awaitingDivisionForErrorTerms");
 
-      std::unique_ptr<Batch> batchedFinalCompare(new Batch());
-
-      for (size_t i = 0; i < this->F_row_ids.size() - 1; i++) {
-        if (this->getSelf() == *this->info->revealer) {
-          batchedFinalCompare->children.emplace_back(
-              new ff::mpc::Compare<SAFRN_TYPES, LargeNum, SmallNum>(
-                  ff::mpc::modSub(
-                      this->startModulusPayloadVector
-                          [this->info->num_IVs *
-                               (this->info->num_IVs + 1) +
-                           2],
-                      static_cast<LargeNum>(info->num_IVs),
-                      this->info->startModulus), // count
-                  this->F_row_ids[i],
-                  &this->info->compareInfo,
-                  this->randomness.compareDispenser->get()));
-        } else {
-          batchedFinalCompare->children.emplace_back(
-              new ff::mpc::Compare<SAFRN_TYPES, LargeNum, SmallNum>(
-                  this->startModulusPayloadVector
-                      [info->num_IVs * (info->num_IVs + 1) +
-                       2], // count
-                  LargeNum(0),
-                  &this->info->compareInfo,
-                  this->randomness.compareDispenser->get()));
-        }
+      /* The residual degrees of freedom pick the F and t table rows. */
+      LargeNum degreesOfFreedom = this->oneShare;
+      if (this->getSelf() == *this->info->revealer) {
+        degreesOfFreedom = ff::mpc::modSub(
+            degreesOfFreedom,
+            static_cast<LargeNum>(this->info->num_IVs),
+            this->info->endModulus);
       }
-
-      for (size_t i = 0; i < this->t_row_ids.size() - 1; i++) {
-        if (this->getSelf() == *this->info->revealer) {
-          batchedFinalCompare->children.emplace_back(
-              new ff::mpc::Compare<SAFRN_TYPES, LargeNum, SmallNum>(
-                  ff::mpc::modSub(
-                      this->startModulusPayloadVector
-                          [this->info->num_IVs *
-                               (this->info->num_IVs + 1) +
-                           2],
-                      static_cast<LargeNum>(info->num_IVs),
-                      this->info->startModulus), // count
-                  this->t_row_ids[i],
-                  &this->info->compareInfo,
-                  this->randomness.compareDispenser->get()));
-        } else {
-          batchedFinalCompare->children.emplace_back(
-              new ff::mpc::Compare<SAFRN_TYPES, LargeNum, SmallNum>(
-                  this->startModulusPayloadVector
-                      [info->num_IVs * (info->num_IVs + 1) +
-                       2], // count
-                  LargeNum(0),
-                  &this->info->compareInfo,
-                  this->randomness.compareDispenser->get()));
-        }
+      LargeNum const keyBound =
+          LargeNum(this->globals->maxIntersectionSize) + 1;
+
+      std::unique_ptr<Batch> batchedRowLocator(new Batch());
+      for (std::vector<size_t> const * rowIds :
+           {&this->F_row_ids, &this->t_row_ids}) {
+        batchedRowLocator->children.emplace_back(new RowLocator(
+            degreesOfFreedom,
+            *rowIds,
+            keyBound,
+            &this->info->compareInfoEndModulus,
+            *this->randomness.compareEndModulusDispenser,
+            *this->randomness.typeCastFromBitDispenser,
+            *this->randomness.beaverTripleForFinalMultiplyDispenser,
+            this->info->endModulus,
+            *this->info->revealer));
       }
 
       PeerSet ps(this->getPeers());
       ps.removeDealer();
       ps.removeRecipients();
-      /** batched division constructor goes here, Issue # 163 */
-      this->invoke(std::move(batchedFinalCompare), ps);
-      this->state = awaitingCompareForFtStatistics;
+      this->invoke(std::move(batchedRowLocator), ps);
+      this->state = awaitingRowLocator;
     } break;
-
-    case (awaitingCompareForFtStatistics): {
-      log_debug("awaitingCompareForFtStatistics");
+    case (awaitingRowLocator): {
+      log_debug("awaitingRowLocator");
       auto & batch = static_cast<Batch &>(f);
 
-      std::unique_ptr<Batch> batchedTypeCastFromBit(new Batch());
-
-      for (size_t i = 0; i < batch.children.size(); i++) {
-
-        batchedTypeCastFromBit->children.emplace_back(
-            new ff::mpc::TypeCastFromBit<SAFRN_TYPES, LargeNum>(
-                static_cast<
-                    ff::mpc::
-                        Compare<SAFRN_TYPES, LargeNum, SmallNum> &>(
-                    *batch.children[i])
-                        .outputShare %
-                    2,
-                this->info->endModulus,
-                this->info->revealer,
-                this->randomness.typeCastFromBitDispenser->get()));
-      }
-
-      PeerSet ps(this->getPeers());
-      ps.removeDealer();
-      ps.removeRecipients();
-      this->invoke(std::move(batchedTypeCastFromBit), ps);
-      this->state = awaitingBatchedTypeCastFromBit;
-    } break;
-    case (awaitingBatchedTypeCastFromBit): {
-      log_debug("awaitingBatchedTypeCastFromBit");
-      auto & batch = static_cast<Batch &>(f);
-
-      size_t counter = 0;
-      for (size_t i = 0; i < this->F_row_ids.size() - 1; i++) {
-        this->F_row_id_share +=
-            static_cast<
-                ff::mpc::TypeCastFromBit<SAFRN_TYPES, LargeNum> &>(
-                *batch.children[counter++])
-                .outputBitShare;
-        this->F_row_id_share %= this->info->endModulus;
-      }
-
-      t_row_id_share = 0;
-      for (size_t j = 0; j < this->t_row_ids.size() - 1; j++) {
-        this->t_row_id_share = ff::mpc::modAdd(
-            this->t_row_id_share,
-            static_cast<
-                ff::mpc::TypeCastFromBit<SAFRN_TYPES, LargeNum> &>(
-                *batch.children[counter++])
-                .outputBitShare,
-            this->info->endModulus);
-      }
+      this->F_row_id_share =
+          static_cast<RowLocator &>(*batch.children[0]).output;
+      this->t_row_id_share =
+          static_cast<RowLocator &>(*batch.children[1]).output;
 
       std::unique_ptr<Batch> batchedFinalCompareEndModulus(new Batch());
 
@@ -1642,49 +1467,31 @@ void Regression::handleComplete(Fronctocol & f) {
         revealer_val_shift_t = (this->num_t_cols - 1);
       }
 
-      std::unique_ptr<Batch> batchedMultiply(new Batch());
-
-      batchedMultiply->children.emplace_back(
-          new ff::mpc::Multiply<
-              SAFRN_TYPES,
-              LargeNum,
-              ff::mpc::BeaverInfo<LargeNum>>(
-              F_statistic_overflow_bit,
-              revealer_val_shift + this->info->endModulus -
-                  this->F_statistic,
-              &this->F_statistic_col_index,
-              std::move(
-                  this->randomness
-                      .beaverTripleForFinalMultiplyDispenser->get()),
-              &this->info->endModulusMultiplyInfo));
+      std::vector<LargeNum> xs;
+      std::vector<LargeNum> ys;
+
+      xs.push_back(F_statistic_overflow_bit);
+      ys.push_back(
+          revealer_val_shift + this->info->endModulus -
+          this->F_statistic);
 
-      // product of diagonal terms of (X^TX)^inv with numer_MSE
-      this->t_statistic_col_indices.resize(this->info->num_IVs);
       for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedMultiply->children.emplace_back(
-            new ff::mpc::Multiply<
-                SAFRN_TYPES,
-                LargeNum,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                t_statistic_overflow_bits[i],
-                revealer_val_shift_t + this->info->endModulus -
-                    this->t_statisticsSquared[i],
-                &this->t_statistic_col_indices[i],
-                std::move(
-                    this->randomness
-                        .beaverTripleForFinalMultiplyDispenser->get()),
-                &this->info->endModulusMultiplyInfo));
+        xs.push_back(t_statistic_overflow_bits[i]);
+        ys.push_back(
+            revealer_val_shift_t + this->info->endModulus -
+            this->t_statisticsSquared[i]);
       }
 
-      PeerSet ps(this->getPeers());
-      ps.removeDealer();
-      ps.removeRecipients();
-      /** batched division constructor goes here, Issue # 163 */
-      this->invoke(std::move(batchedMultiply), ps);
+      this->invokeFinalMultiply(std::move(xs), std::move(ys));
       this->state = awaitingFifthMultiplyForErrorTerms;
     } break;
     case (awaitingFifthMultiplyForErrorTerms): {
       log_debug("awaitingFifthMultiplyForErrorTerms");
+      std::vector<LargeNum> const & products =
+          static_cast<VectorMultiply &>(f).outputs;
+      this->F_statistic_col_index = products[0];
+      this->t_statistic_col_indices.assign(
+          products.begin() + 1, products.end());
 
       this->F_statistic_col_index = ff::mpc::modAdd(
           this->F_statistic_col_index,
@@ -1710,24 +1517,30 @@ void Regression::handleComplete(Fronctocol & f) {
           this->F_statistic_col_index +
               this->F_row_id_share * this->num_F_cols,
           this->F_p_value,
-          this->F_table_data,
+          this->F_table,
           this->randomness.F_lookupDispenser->get(),
           &this->F_info,
-          this->info->bytesInLookupTableCells,
           this->info->revealer));
 
-      this->t_p_values.resize(this->info->num_IVs);
+      /* The t statistics all look up the t table, in one pass. */
+      std::vector<LargeNum> t_locations;
+      std::vector<LookupRandomness> t_randomness;
+      t_locations.reserve(this->info->num_IVs);
+      t_randomness.reserve(this->info->num_IVs);
       for (size_t i = 0; i < this->info->num_IVs; i++) {
-        batchedLookup->children.emplace_back(new Lookup(
+        t_locations.push_back(
             this->t_statistic_col_indices[i] +
-                this->t_row_id_share * this->num_t_cols,
-            this->t_p_values[i],
-            this->t_table_data,
-            this->randomness.t_lookupDispenser->get(),
-            &this->t_info,
-            this->info->bytesInLookupTableCells,
-            this->info->revealer));
+            this->t_row_id_share * this->num_t_cols);
+        t_randomness.emplace_back(
+            this->randomness.t_lookupDispenser->get());
       }
+      batchedLookup->children.emplace_back(new MultiLookup(
+          std::move(t_locations),
+          this->t_p_values,
+          this->t_table,
+          std::move(t_randomness),
+          &this->t_info,
+          this->info->revealer));
 
       PeerSet ps(this->getPeers());
       ps.removeDealer();
@@ -1782,6 +1595,18 @@ void Regression::handleComplete(Fronctocol & f) {
           }
         }
 
+        size_t next_moment = 0;
+        for (BatchedMoments const & moments :
+             this->info->batchedMoments) {
+          if (moments.includeCount) {
+            omsg->write<LargeNum>(this->oneShare);
+          }
+          for (size_t i = 0; i < moments.highestMoment; i++) {
+            omsg->write<LargeNum>(
+                this->momentsExpectations[next_moment++]);
+          }
+        }
+
         log_debug(
             "Num f cols: %s", ff::mpc::dec(this->num_F_cols).c_str());
 
@@ -12,6 +12,7 @@
 /* C and POSIX Headers */
 
 /* C++ Headers */
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 #include <map>
@@ -25,19 +26,23 @@
 #include <ff/Message.h>
 
 #include <dataowner/RegressionPayloadCompute.h>
-#include <mpc/AbstractZipReduceFactory.h>
 #include <mpc/Batch.h>
 #include <mpc/ModConvUp.h>
 #include <mpc/ObservationList.h>
 #include <mpc/Randomness.h>
 #include <mpc/RandomnessDealer.h>
-#include <mpc/SISOSort.h>
 #include <mpc/ZipAdjacent.h>
-#include <mpc/ZipReduce.h>
 
 #include <dataowner/Lookup.h>
+#include <dataowner/LookupTable.h>
+#include <dataowner/MatrixMultiply.h>
+#include <dataowner/ObliviousMerge.h>
+#include <dataowner/ObservationStore.h>
 #include <dataowner/RegressionInfo.h>
+#include <dataowner/SharedDivide.h>
 #include <dataowner/RegressionPatron.h>
+#include <dataowner/RowLocator.h>
+#include <dataowner/VectorMultiply.h>
 #include <dataowner/fortissimo.h>
 #include <framework/Framework.h>
 
@@ -61,11 +66,14 @@ public:
    *
    */
   Regression(
-      ff::mpc::ObservationList<LargeNum> && olist,
+      ObservationStore && ownStore,
       std::string F_tableFile,
       std::string t_tableFile,
       GlobalInfo const * const globals,
-      std::unique_ptr<const RegressionInfo> info);
+      std::unique_ptr<const RegressionInfo> info,
+      std::unique_ptr<RandomnessStore const> store = nullptr,
+      std::vector<std::vector<LargeNum>> && momentsData =
+          std::vector<std::vector<LargeNum>>());
 
   void init() override;
 
@@ -79,11 +87,11 @@ public:
 
 private:
   enum RegressionState {
-    awaitingRandomnessAndSISOSort,
+    awaitingRandomnessAndMerge,
     awaitingRandomnessOnly,
-    awaitingSISOSort,
+    awaitingMerge,
     awaitingZipAdjacent,
-    awaitingZipReduce,
+    awaitingPayloadCompute,
     awaitingBatchedModConvUp,
     awaitingMatrixMultiply,
     awaitingMatrixReveal,
@@ -99,14 +107,13 @@ private:
     awaitingFourthMultiplyForErrorTerms,
     awaitingFifthMultiplyForErrorTerms,
     awaitingDivisionForErrorTerms,
-    awaitingCompareForFtStatistics,
-    awaitingBatchedTypeCastFromBit,
+    awaitingRowLocator,
     awaitingCompareForFtStatisticsEndModulus,
     awaitingBatchedTypeCastFromBitLast,
     awaitingBatchedLookup
   };
 
-  RegressionState state = awaitingRandomnessAndSISOSort;
+  RegressionState state = awaitingRandomnessAndMerge;
 
   RegressionRandomness randomness;
 
@@ -116,6 +123,13 @@ private:
   void shareWithCrossVerticalParties();
   void invokeRandomnessPatron();
 
+  /**
+   * Multiplies xs by ys element-wise, modulo the end modulus, with one
+   * VectorMultiply among the dataowners.
+   */
+  void invokeFinalMultiply(
+      std::vector<LargeNum> && xs, std::vector<LargeNum> && ys);
+
   void
   rowReduceInTheClear(); // Probably just calls Zane's code, but that has old BIG_NUM stuff
 
@@ -125,17 +139,33 @@ private:
   GlobalInfo const * const globals;
   std::unique_ptr<RegressionInfo const> const info;
 
-  std::vector<RegressionPayloadComputeFactory> fronctocolFactories;
+  /** Pre-generated randomness, or nullptr to always use the dealer. */
+  std::unique_ptr<RandomnessStore const> const store;
+
   std::vector<
       ff::mpc::ZipAdjacentInfo<safrn::Identity, LargeNum, SmallNum>>
       zipAdjacentInfo;
 
-  ff::mpc::ObservationList<LargeNum> ownList;
+  ObservationStore ownStore;
+
+  /**
+   * The data column of each batched moments function on this vertical,
+   * in the order of info->batchedMoments.
+   */
+  std::vector<std::vector<LargeNum>> momentsData;
+
+  /** Sums of the batched moments' payloads, then E[X^i] shares. */
+  std::vector<LargeNum> momentsPowerSums;
+  std::vector<LargeNum> momentsExpectations;
 
-  std::vector<ff::mpc::ObservationList<LargeNum>>
-      outgoingListShares; // one for each cross-vertical party.
-  std::vector<ff::mpc::ObservationList<LargeNum>>
-      sharedLists; // one for each cross-vertical party.
+  std::vector<ObservationStore>
+      sharedStores; // one for each cross-vertical party.
+
+  /** Rows of each cross-vertical party's shares received so far. */
+  std::vector<size_t> rowsReceived;
+
+  /** sharedStores, as lists for ObliviousMerge once all are in. */
+  std::vector<ff::mpc::ObservationList<LargeNum>> sharedLists;
 
   std::vector<ff::mpc::ObservationList<LargeNum>> vectorZippedAdjacent;
 
@@ -164,8 +194,6 @@ private:
 
   bool randomnessDone = false;
 
-  std::vector<MultiplyInfo<BeaverInfo<LargeNum>>> factoryMultiplyInfo;
-
   std::vector<ff::mpc::Matrix<LargeNum>> m;
   std::vector<ff::mpc::Matrix<LargeNum>> r;
 
@@ -209,10 +237,8 @@ private:
   std::vector<size_t> F_row_ids;
   std::vector<size_t> t_row_ids;
 
-  std::vector<std::vector<Boolean_t>>
-      F_table_data; // indexed by (row*i + j) and then w/i a cell
-  std::vector<std::vector<Boolean_t>>
-      t_table_data; // indexed by (row*i + j) and then w/i a cell
+  LookupTable F_table; // indexed by (row*i + j) and then w/i a cell
+  LookupTable t_table; // indexed by (row*i + j) and then w/i a cell
 
   LargeNum F_row_id_share;
   LargeNum t_row_id_share;
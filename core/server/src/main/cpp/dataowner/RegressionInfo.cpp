@@ -6,6 +6,8 @@
 
 #include <algorithm>
 
+#include <util/PrimeCatalogue.h>
+
 #include <ff/logging.h>
 
 namespace safrn {
@@ -16,10 +18,30 @@ static inline size_t computePayloadLength(size_t d1, size_t d2) {
       d1 + d1 * (d1 + 1) / 2, (d2 + 1) + d2 * (d2 + 3) / 2 + 3);
 }
 
+static inline size_t
+countMomentsPayloads(std::vector<BatchedMoments> const & moments) {
+  size_t count = 0;
+  for (BatchedMoments const & m : moments) {
+    count += m.highestMoment;
+  }
+  return count;
+}
+
+/**
+ * Width of the determinant of A^TA, and of the coefficients' numerators
+ * by Cramer's rule.
+ */
+static inline size_t
+determinantBits(size_t num_IVs, GlobalInfo const * const globals) {
+  return static_cast<size_t>(ceil(
+      static_cast<double>(num_IVs) *
+      (log2(num_IVs) + 2 * globals->bitsOfPrecision + 2 +
+       log2(globals->maxIntersectionSize))));
+}
+
 static inline LargeNum computeEndModulus(size_t numBits) {
-  log_debug("Finding a prime with %zu bits", numBits);
-  return ff::mpc::nextPrime(
-      static_cast<LargeNum>(LargeNum(1) << numBits));
+  log_debug("Using a prime modulus above 2^%zu", numBits);
+  return nextPrimeAbovePowerOfTwo(numBits);
 }
 
 RegressionInfo::RegressionInfo(
@@ -31,32 +53,39 @@ RegressionInfo::RegressionInfo(
     size_t numCrossParties,
     bool fit_intercept,
     const safrn::Identity * revealer,
-    const safrn::Identity * dealer) :
+    const safrn::Identity * dealer,
+    std::vector<BatchedMoments> const & batchedMoments) :
     selfVertical(selfVertical),
     verticalDV(verticalDV),
     verticalDV_numIVs(vDV_nIVs),
     verticalNonDV_numIVs(vnDV_nIVs),
+    listSizeDV(globals->listSize(verticalDV)),
+    listSizeNonDV(globals->joinedListSize - this->listSizeDV),
     numCrossParties(numCrossParties),
     num_IVs(vDV_nIVs + vnDV_nIVs),
     fitIntercept(fit_intercept),
     revealer(revealer),
     dealer(dealer),
-    payloadLength(computePayloadLength(vnDV_nIVs, vDV_nIVs)),
+    payloadLength(
+        computePayloadLength(vnDV_nIVs, vDV_nIVs) +
+        countMomentsPayloads(batchedMoments)),
+    batchedMoments(batchedMoments),
+    momentsPayloadOffset(computePayloadLength(vnDV_nIVs, vDV_nIVs)),
+    numMomentsPayloads(countMomentsPayloads(batchedMoments)),
+    packedMatrixLength(this->num_IVs * (this->num_IVs + 1) / 2),
+    payloadSumsLength(this->packedMatrixLength + this->num_IVs + 3),
     bytesInLookupTableCells(globals->bytesInLookupTableCells),
     max_F_t_table_num_rows(globals->max_F_t_table_num_rows),
-    keyModulus(
-        ff::mpc::nextPrime(static_cast<LargeNum>(globals->key_max))),
-    startModulus(ff::mpc::nextPrime(static_cast<LargeNum>(
+    /* Packed keys, 2 * key + 1 with padding at key_max + 1, must stay
+     * below half the modulus for ObliviousMerge's comparisons. */
+    keyModulus(cachedNextPrime(4 * (globals->key_max + 2))),
+    startModulus(cachedNextPrime(static_cast<LargeNum>(
         (LargeNum(1) << (4 * globals->bitsOfPrecision + 2)) *
         LargeNum(static_cast<uint64_t>(
             floor(globals->maxIntersectionSize)))))),
-    endModulus(computeEndModulus(
-        2 *
-        static_cast<size_t>(ceil(
-            static_cast<double>(this->num_IVs) *
-            (log2(this->num_IVs) + 2 * globals->bitsOfPrecision + 2 +
-             log2(globals->maxIntersectionSize)))))),
-    compareInfo(this->startModulus, this->revealer),
+    /* Twice the determinant's width, plus SharedDivide's mask. */
+    endModulus(computeEndModulus(SharedDivideInfo::modulusBits(
+        determinantBits(this->num_IVs, globals)))),
     compareInfoEndModulus(this->endModulus, this->revealer),
     startModulusMultiplyInfo(
         this->revealer,
@@ -74,14 +103,24 @@ RegressionInfo::RegressionInfo(
         this->compareInfoEndModulus
             .lagrangePolynomialSet, // this is wrong but also we don't use it anymore, fix in next ff MR
         &this->compareInfoEndModulus),
+    sharedDivideInfo(
+        this->revealer,
+        this->endModulus,
+        determinantBits(this->num_IVs, globals),
+        &this->divideInfo),
     modConvUpInfo(this->endModulus, this->startModulus, this->revealer),
     zipAdjacentInfo(
-        2 * globals->maxListSize,
+        this->listSizeDV + this->listSizeNonDV,
         this->payloadLength,
         0,
         this->startModulus,
         this->revealer) {
 }
 
+size_t RegressionInfo::packedIndex(size_t i, size_t j) const {
+  log_assert(i <= j && j < this->num_IVs);
+  return i * (2 * this->num_IVs - i + 1) / 2 + (j - i);
+}
+
 } // namespace dataowner
 } // namespace safrn
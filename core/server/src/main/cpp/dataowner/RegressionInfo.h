@@ -21,7 +21,9 @@
 /* Safrn Headers */
 #include <dataowner/GlobalInfo.h>
 #include <dataowner/Lookup.h>
+#include <dataowner/SharedDivide.h>
 #include <dataowner/fortissimo.h>
+#include <dealer/MatrixBeaverTriple.h>
 #include <dealer/RandomSquareMatrix.h>
 #include <dealer/RandomTableLookup.h>
 #include <ff/Fronctocol.h>
@@ -38,6 +40,18 @@
 namespace safrn {
 namespace dataowner {
 
+/**
+ * A moments function batched into a regression query. Its powers of
+ * the data column ride along the regression's payloads through the
+ * join, and are divided by the regression's count of joined rows.
+ */
+struct BatchedMoments {
+  size_t dataVertical;
+  size_t dataColumn;
+  size_t highestMoment; // payload columns x, x^2, ..., x^highestMoment
+  bool includeCount;
+};
+
 struct RegressionInfo {
 
   size_t selfVertical; // 0 or 1
@@ -48,6 +62,11 @@ struct RegressionInfo {
   size_t verticalDV_numIVs;
   size_t verticalNonDV_numIVs;
 
+  /* Rows of the DV's and the other vertical's lists, which each shared
+   * list holds in that order. */
+  size_t listSizeDV;
+  size_t listSizeNonDV;
+
   /* IV for Independent Variable
    * By convention, sort so when keys match, Opp first, then Same
    */
@@ -62,6 +81,23 @@ struct RegressionInfo {
 
   size_t payloadLength;
 
+  std::vector<BatchedMoments> const batchedMoments;
+
+  /** The batched moments' payloads follow the regression's. */
+  size_t momentsPayloadOffset;
+  size_t numMomentsPayloads;
+
+  /**
+   * A^TA is symmetric, so the summed payload carries only its upper
+   * triangle, packed row by row, followed by A^Ty, y^Ty, y and the
+   * count. It is expanded to the full matrix for the masking multiply.
+   */
+  size_t packedMatrixLength; // num_IVs * (num_IVs + 1) / 2
+  size_t payloadSumsLength;
+
+  /** Position of A^TA[i][j], for i <= j, in the summed payload. */
+  size_t packedIndex(size_t i, size_t j) const;
+
   const size_t bytesInLookupTableCells;
   const size_t max_F_t_table_num_rows;
 
@@ -69,9 +105,6 @@ struct RegressionInfo {
   LargeNum startModulus;
   LargeNum endModulus;
 
-  ff::mpc::
-      CompareInfo<safrn::Identity, ff::mpc::LargeNum, ff::mpc::SmallNum>
-          compareInfo;
   ff::mpc::CompareInfo<safrn::Identity, LargeNum, SmallNum>
       compareInfoEndModulus;
   ff::mpc::MultiplyInfo<safrn::Identity, ff::mpc::BeaverInfo<LargeNum>>
@@ -81,6 +114,8 @@ struct RegressionInfo {
   ff::mpc::MultiplyInfo<safrn::Identity, ff::mpc::BooleanBeaverInfo>
       booleanMultiplyInfo;
   ff::mpc::DivideInfo<safrn::Identity, LargeNum, SmallNum> divideInfo;
+  /** The coefficients are all divided by the same determinant. */
+  SharedDivideInfo sharedDivideInfo;
   ff::mpc::ModConvUpInfo<safrn::Identity, SmallNum, LargeNum, LargeNum>
       modConvUpInfo;
   ff::mpc::ZipAdjacentInfo<safrn::Identity, LargeNum, SmallNum>
@@ -100,7 +135,9 @@ struct RegressionInfo {
       size_t numCrossParties,
       bool fit_intercept,
       const safrn::Identity * revealer,
-      const safrn::Identity * dealer);
+      const safrn::Identity * dealer,
+      std::vector<BatchedMoments> const & batchedMoments =
+          std::vector<BatchedMoments>());
 };
 
 struct RegressionRandomness {
@@ -126,9 +163,9 @@ struct RegressionRandomness {
       beaverTripleForFactoryDispensers;
 
   std::unique_ptr<ff::mpc::RandomnessDispenser<
-      ff::mpc::BeaverTriple<LargeNum>,
-      ff::mpc::BeaverInfo<LargeNum>>>
-      beaverTripleForMatrixMultiplyDispenser;
+      dealer::MatrixBeaverTriple<LargeNum>,
+      dealer::MatrixBeaverTripleInfo<LargeNum, LargeNum>>>
+      matrixBeaverTripleDispenser;
 
   std::unique_ptr<ff::mpc::RandomnessDispenser<
       dealer::RandomSquareMatrix<LargeNum>,
@@ -140,15 +177,13 @@ struct RegressionRandomness {
       ff::mpc::BeaverInfo<LargeNum>>>
       beaverTripleForFinalMultiplyDispenser;
 
-  std::unique_ptr<ff::mpc::RandomnessDispenser<
-      ff::mpc::CompareRandomness<LargeNum, SmallNum>,
-      ff::mpc::DoNotGenerateInfo>>
-      compareEndModulusDispenser;
+  std::unique_ptr<SharedDivide::TruncationDispenser>
+      truncationPairDispenser;
 
   std::unique_ptr<ff::mpc::RandomnessDispenser<
       ff::mpc::CompareRandomness<LargeNum, SmallNum>,
       ff::mpc::DoNotGenerateInfo>>
-      compareDispenser;
+      compareEndModulusDispenser;
 
   std::unique_ptr<ff::mpc::RandomnessDispenser<
       ff::mpc::TypeCastTriple<LargeNum>,
@@ -180,9 +215,9 @@ struct RegressionRandomness {
           ff::mpc::BeaverInfo<LargeNum>>>> &&
           beaverTripleForFactoryDispensers,
       std::unique_ptr<ff::mpc::RandomnessDispenser<
-          ff::mpc::BeaverTriple<LargeNum>,
-          ff::mpc::BeaverInfo<LargeNum>>>
-          beaverTripleForMatrixMultiplyDispenser,
+          dealer::MatrixBeaverTriple<LargeNum>,
+          dealer::MatrixBeaverTripleInfo<LargeNum, LargeNum>>>
+          matrixBeaverTripleDispenser,
       std::unique_ptr<ff::mpc::RandomnessDispenser<
           dealer::RandomSquareMatrix<LargeNum>,
           dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>>>
@@ -191,12 +226,11 @@ struct RegressionRandomness {
           ff::mpc::BeaverTriple<LargeNum>,
           ff::mpc::BeaverInfo<LargeNum>>>
           beaverTripleForFinalMultiplyDispenser,
+      std::unique_ptr<SharedDivide::TruncationDispenser>
+          truncationPairDispenser,
       std::unique_ptr<ff::mpc::RandomnessDispenser<
           ff::mpc::CompareRandomness<LargeNum, SmallNum>,
           ff::mpc::DoNotGenerateInfo>> compareEndModulusDispenser,
-      std::unique_ptr<ff::mpc::RandomnessDispenser<
-          ff::mpc::CompareRandomness<LargeNum, SmallNum>,
-          ff::mpc::DoNotGenerateInfo>> compareDispenser,
       std::unique_ptr<ff::mpc::RandomnessDispenser<
           ff::mpc::TypeCastTriple<LargeNum>,
           ff::mpc::TypeCastFromBitInfo<LargeNum>>>
@@ -212,14 +246,14 @@ struct RegressionRandomness {
       zipAdjacentDispensers(std::move(zipAdjacentDispensers)),
       beaverTripleForFactoryDispensers(
           std::move(beaverTripleForFactoryDispensers)),
-      beaverTripleForMatrixMultiplyDispenser(
-          std::move(beaverTripleForMatrixMultiplyDispenser)),
+      matrixBeaverTripleDispenser(
+          std::move(matrixBeaverTripleDispenser)),
       randomMatrixAndDetInverseDispenser(
           std::move(randomMatrixAndDetInverseDispenser)),
       beaverTripleForFinalMultiplyDispenser(
           std::move(beaverTripleForFinalMultiplyDispenser)),
+      truncationPairDispenser(std::move(truncationPairDispenser)),
       compareEndModulusDispenser(std::move(compareEndModulusDispenser)),
-      compareDispenser(std::move(compareDispenser)),
       typeCastFromBitDispenser(std::move(typeCastFromBitDispenser)),
       F_lookupDispenser(std::move(F_lookupDispenser)),
       t_lookupDispenser(std::move(t_lookupDispenser)) {
@@ -228,10 +262,10 @@ struct RegressionRandomness {
   RegressionRandomness() :
       modConvUpDispenser(nullptr),
       divideDispenser(nullptr),
-      beaverTripleForMatrixMultiplyDispenser(nullptr),
+      matrixBeaverTripleDispenser(nullptr),
       randomMatrixAndDetInverseDispenser(nullptr),
+      truncationPairDispenser(nullptr),
       compareEndModulusDispenser(nullptr),
-      compareDispenser(nullptr),
       typeCastFromBitDispenser(nullptr),
       F_lookupDispenser(nullptr),
       t_lookupDispenser(nullptr) {
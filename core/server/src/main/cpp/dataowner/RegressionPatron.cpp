@@ -12,6 +12,7 @@
 
 /* Safrn Headers */
 #include <dataowner/RegressionPatron.h>
+#include <dataowner/RowLocator.h>
 #include <dealer/RandomTableLookup.h>
 
 /* logging configuration */
@@ -27,7 +28,8 @@ RegressionRandomnessPatron::RegressionRandomnessPatron(
     const size_t t_rows,
     dealer::RandomTableLookupInfo const * const F_info,
     dealer::RandomTableLookupInfo const * const t_info,
-    const size_t dispenserSize) :
+    const size_t dispenserSize,
+    RandomnessStore const * const store) :
     regressionDispenser(
         new ff::mpc::RandomnessDispenser<
             RegressionRandomness,
@@ -40,21 +42,20 @@ RegressionRandomnessPatron::RegressionRandomnessPatron(
     t_info(t_info),
     dispenserSize(
         dispenserSize), // dispenserSize = num Regressions we're going to need
+    store(store),
     numModConvUpNeeded(
-        (this->info->num_IVs * this->info->num_IVs +
-         this->info->num_IVs + 3)),
+        this->info->payloadSumsLength + this->info->numMomentsPayloads),
     numDivideNeeded(
-        this->info->num_IVs + 2 + this->info->num_IVs + 1 +
+        1 + 2 + this->info->num_IVs + 1 +
         this->info
-            ->num_IVs), // 2 for R^2 and MSE, num_IVs for SE_coeffs, 1 for F-statistic, num_IVs for t-statistics
+            ->num_IVs + // 1 for the coefficients' shared divide, 2 for R^2 and MSE, num_IVs for SE_coeffs, 1 for F-statistic, num_IVs for t-statistics
+        this->info->numMomentsPayloads),
     numConditionalEvaluateNeeded(1),
     numBeaverTripleForFactoryNeeded(
         (this->info->zipAdjacentInfo.batchSize - 1) *
         (this->info->verticalNonDV_numIVs *
          (this->info->verticalDV_numIVs + 1))),
-    numBeaverTripleForMatrixMultiplyNeeded(
-        this->info->num_IVs * this->info->num_IVs *
-        (this->info->num_IVs + 1)),
+    numMatrixBeaverTripleNeeded(1),
     numRandomSquareMatrixNeeded(1),
     numBeaverTripleForFinalMultiplyNeeded(
         this->info->num_IVs +
@@ -65,13 +66,17 @@ RegressionRandomnessPatron::RegressionRandomnessPatron(
         2 * this->info->num_IVs + 2 +
         this->info->num_IVs * this->info->num_IVs +
         3 * this->info->num_IVs + this->info->num_IVs + 2 +
-        this->info->num_IVs + this->info->num_IVs + 1),
+        this->info->num_IVs + this->info->num_IVs + 1 +
+        this->info->num_IVs + // for the coefficients' shared divide
+        RowLocator::numBeaverTriples(this->F_rows) + // row locators
+        RowLocator::numBeaverTriples(this->t_rows)),
+    numTruncationPairNeeded(this->info->num_IVs),
     numCompareEndModulusNeeded(
-        this->info->num_IVs + 1 + this->info->num_IVs),
-    numCompareNeeded(this->F_rows + this->t_rows),
+        this->info->num_IVs + RowLocator::numLevels(this->F_rows) +
+        RowLocator::numLevels(this->t_rows) + 1 + this->info->num_IVs),
     numTypeCastFromBitNeeded(
-        this->info->num_IVs + this->F_rows + this->t_rows + 1 +
-        this->info->num_IVs),
+        this->info->num_IVs + RowLocator::numLevels(this->F_rows) +
+        RowLocator::numLevels(this->t_rows) + 1 + this->info->num_IVs),
     numTableLookupFNeeded(1),
     numTableLookuptNeeded(this->info->num_IVs)
 /** lines above for `FirstMultiplyForErrorTerms`,
@@ -95,8 +100,67 @@ void RegressionRandomnessPatron::init() {
       i++;
     }
   });
-  log_debug("HERE");
-  std::unique_ptr<Fronctocol> patron(
+  this->zipAdjacentDispensers.resize(this->numCrossParties);
+  this->arithmeticMultiplyForFactoryDispensers.resize(
+      this->numCrossParties);
+
+  /**
+   * Offer the dealer the next batch of stored randomness (if any). It
+   * is only used if every dataowner offers the same batch, otherwise
+   * all randomness is fetched from the dealer.
+   */
+  if (this->store != nullptr && this->dispenserSize == 1) {
+    this->storeKey = RegressionStoredRandomness::key(
+        *this->store, this->info, *this->F_info, *this->t_info);
+    uint64_t const batch = this->store->nextBatch(this->storeKey);
+    if (batch != RandomnessStore::NO_BATCH &&
+        this->stored.read(
+            *this->store,
+            this->storeKey,
+            batch,
+            this->info,
+            *this->F_info,
+            *this->t_info)) {
+      this->storedBatch = batch;
+    }
+  }
+
+  std::unique_ptr<OutgoingMessage> omsg(
+      new OutgoingMessage(*this->dealerIdentity));
+  omsg->template write<uint64_t>(this->storedBatch);
+  this->send(std::move(omsg));
+}
+
+void RegressionRandomnessPatron::invokePatrons(bool const useStored) {
+  std::unique_ptr<ff::mpc::RandomnessDispenser<
+      dealer::RandomTableLookup,
+      dealer::RandomTableLookupInfo>>
+      F_storedTableLookups;
+  std::unique_ptr<ff::mpc::RandomnessDispenser<
+      dealer::RandomTableLookup,
+      dealer::RandomTableLookupInfo>>
+      t_storedTableLookups;
+  if (useStored) {
+    log_debug("Using stored randomness batch %lu", this->storedBatch);
+    if (!this->store->consume(this->storeKey, this->storedBatch)) {
+      log_error("Stored randomness batch could not be removed");
+    }
+    this->randomMatrixAndDetInverseDispenser = makeStoredDispenser(
+        std::move(this->stored.randomSquareMatrices),
+        dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>(
+            this->info->num_IVs, this->info->endModulus));
+    F_storedTableLookups = makeStoredDispenser(
+        std::move(this->stored.F_tableLookups), *this->F_info);
+    t_storedTableLookups = makeStoredDispenser(
+        std::move(this->stored.t_tableLookups), *this->t_info);
+  }
+
+  /**
+   * The dealer's RegressionRandomnessBasement invokes all of its houses
+   * at once, so every patron is invoked here as well, in the same order
+   * as the basement invokes its houses.
+   */
+  std::unique_ptr<Fronctocol> modConvUpPatron(
       new ff::mpc::ModConvUpRandomnessPatron<
           SAFRN_TYPES,
           SmallNum,
@@ -105,23 +169,197 @@ void RegressionRandomnessPatron::init() {
           &this->info->modConvUpInfo,
           dealerIdentity,
           this->numModConvUpNeeded * this->dispenserSize));
-  log_debug("HERE");
-  this->invoke(std::move(patron), this->getPeers());
+  this->invokePatron(
+      std::move(modConvUpPatron), this->getPeers(), awaitingModConvUp);
+
+  std::unique_ptr<Fronctocol> dividePatron(
+      new ff::mpc::
+          DivideRandomnessPatron<SAFRN_TYPES, LargeNum, SmallNum>(
+              &this->info->divideInfo,
+              dealerIdentity,
+              this->numDivideNeeded * this->dispenserSize));
+  this->invokePatron(
+      std::move(dividePatron), this->getPeers(), awaitingDivide);
+
+  this->getPeers().forEachDataowner([&, this](const Identity & other) {
+    if (other.vertical != this->getSelf().vertical) {
+      std::unique_ptr<Fronctocol> patron(
+          new ff::mpc::ZipAdjacentRandomnessPatron<
+              SAFRN_TYPES,
+              LargeNum,
+              SmallNum>(
+              &this->info->zipAdjacentInfo,
+              dealerIdentity,
+              this->numConditionalEvaluateNeeded * this->dispenserSize));
+
+      PeerSet ps = PeerSet();
+      ps.add(this->getSelf());
+      ps.add(other);
+      ps.add(*dealerIdentity);
+
+      this->invokePatron(
+          std::move(patron), ps, awaitingConditionalEvaluate);
+    }
+  });
+
+  this->getPeers().forEachDataowner([&, this](const Identity & other) {
+    if (other.vertical != this->getSelf().vertical) {
+      std::unique_ptr<Fronctocol> patron(
+          new ff::mpc::RandomnessPatron<
+              SAFRN_TYPES,
+              ff::mpc::BeaverTriple<LargeNum>,
+              ff::mpc::BeaverInfo<LargeNum>>(
+              *dealerIdentity,
+              this->numBeaverTripleForFactoryNeeded * this->dispenserSize,
+              ff::mpc::BeaverInfo<LargeNum>(this->info->startModulus)));
+
+      PeerSet ps = PeerSet();
+      ps.add(this->getSelf());
+      ps.add(other);
+      ps.add(*dealerIdentity);
 
-  this->state = awaitingModConvUp;
+      this->invokePatron(
+          std::move(patron), ps, awaitingBeaverTripleForFactory);
+    }
+  });
+
+  /** R (d x d) times [A^TA | A^Ty] (d x (d + 1)), see Regression. */
+  std::unique_ptr<Fronctocol> matrixBeaverTriplePatron(
+      new SeededRandomnessPatron<
+          dealer::MatrixBeaverTriple<LargeNum>,
+          dealer::MatrixBeaverTripleInfo<LargeNum, LargeNum>>(
+          *dealerIdentity,
+          this->numMatrixBeaverTripleNeeded * this->dispenserSize,
+          dealer::MatrixBeaverTripleInfo<LargeNum, LargeNum>(
+              this->info->num_IVs,
+              this->info->num_IVs,
+              this->info->num_IVs + 1,
+              this->info->endModulus)));
+  this->invokePatron(
+      std::move(matrixBeaverTriplePatron),
+      this->getPeers(),
+      awaitingMatrixBeaverTriple);
+
+  if (!useStored) {
+    std::unique_ptr<Fronctocol> randomSquareMatrixPatron(
+        new SeededRandomnessPatron<
+            dealer::RandomSquareMatrix<LargeNum>,
+            dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>>(
+            *dealerIdentity,
+            this->numRandomSquareMatrixNeeded * this->dispenserSize,
+            dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>(
+                this->info->num_IVs, this->info->endModulus)));
+    this->invokePatron(
+        std::move(randomSquareMatrixPatron),
+        this->getPeers(),
+        awaitingRandomSquareMatrix);
+  }
+
+  std::unique_ptr<Fronctocol> finalMultiplyPatron(
+      new ff::mpc::RandomnessPatron<
+          SAFRN_TYPES,
+          ff::mpc::BeaverTriple<LargeNum>,
+          ff::mpc::BeaverInfo<LargeNum>>(
+          *dealerIdentity,
+          this->numBeaverTripleForFinalMultiplyNeeded *
+              this->dispenserSize,
+          ff::mpc::BeaverInfo<LargeNum>(this->info->endModulus)));
+  this->invokePatron(
+      std::move(finalMultiplyPatron),
+      this->getPeers(),
+      awaitingBeaverTripleForFinalMultiply);
+
+  std::unique_ptr<Fronctocol> truncationPairPatron(
+      new SeededRandomnessPatron<
+          dealer::TruncationPair<LargeNum>,
+          dealer::TruncationPairInfo<LargeNum, LargeNum>>(
+          *dealerIdentity,
+          this->numTruncationPairNeeded * this->dispenserSize,
+          this->info->sharedDivideInfo.truncationInfo));
+  this->invokePatron(
+      std::move(truncationPairPatron),
+      this->getPeers(),
+      awaitingTruncationPair);
+
+  std::unique_ptr<Fronctocol> compareEndModulusPatron(
+      new ff::mpc::
+          CompareRandomnessPatron<SAFRN_TYPES, LargeNum, SmallNum>(
+              &this->info->compareInfoEndModulus,
+              dealerIdentity,
+              this->numCompareEndModulusNeeded * this->dispenserSize));
+  this->invokePatron(
+      std::move(compareEndModulusPatron),
+      this->getPeers(),
+      awaitingCompareEndModulus);
+
+  std::unique_ptr<Fronctocol> typeCastFromBitPatron(
+      new ff::mpc::RandomnessPatron<
+          SAFRN_TYPES,
+          ff::mpc::TypeCastTriple<LargeNum>,
+          ff::mpc::TypeCastFromBitInfo<LargeNum>>(
+          *dealerIdentity,
+          this->numTypeCastFromBitNeeded * this->dispenserSize,
+          ff::mpc::TypeCastFromBitInfo<LargeNum>(this->info->endModulus)));
+  this->invokePatron(
+      std::move(typeCastFromBitPatron),
+      this->getPeers(),
+      awaitingTypeCastFromBit);
+
+  log_debug(
+      "F_info.size(), t_info.size() %u, %u",
+      this->F_info->table_size_,
+      this->t_info->table_size_);
+  std::unique_ptr<Fronctocol> F_lookupPatron(new LookupRandomnessPatron(
+      this->F_info,
+      &this->info->compareInfoEndModulus,
+      dealerIdentity,
+      this->numTableLookupFNeeded * this->dispenserSize,
+      std::move(F_storedTableLookups)));
+  this->invokePatron(
+      std::move(F_lookupPatron), this->getPeers(), awaitingF_lookup);
+
+  std::unique_ptr<Fronctocol> t_lookupPatron(new LookupRandomnessPatron(
+      this->t_info,
+      &this->info->compareInfoEndModulus,
+      dealerIdentity,
+      this->numTableLookuptNeeded * this->dispenserSize,
+      std::move(t_storedTableLookups)));
+  this->invokePatron(
+      std::move(t_lookupPatron), this->getPeers(), awaitingt_lookup);
+}
+
+void RegressionRandomnessPatron::invokePatron(
+    std::unique_ptr<Fronctocol> patron,
+    PeerSet const & ps,
+    RegressionPatronPromiseState kind) {
+  this->awaitingPatrons.emplace(patron.get(), kind);
+  this->invoke(std::move(patron), ps);
 }
 
 void RegressionRandomnessPatron::handleReceive(IncomingMessage & imsg) {
-  log_error("RegressionPatron Fronctocol received unexpected "
-            "handle receive");
-  (void)imsg;
+  log_debug("RegressionPatron received the dealer's decision");
+  Boolean_t useStored = 0;
+  if (!imsg.template read<Boolean_t>(useStored)) {
+    log_error("RegressionPatron could not read the dealer's decision");
+    return;
+  }
+  this->invokePatrons(
+      useStored != 0 && this->storedBatch != RandomnessStore::NO_BATCH);
 }
 
 void RegressionRandomnessPatron::handleComplete(Fronctocol & f) {
   log_debug("RegressionPatron received handle complete");
-  switch (this->state) {
-    case awaitingModConvUp: {
+  auto const awaiting = this->awaitingPatrons.find(&f);
+  if (awaiting == this->awaitingPatrons.end()) {
+    log_error("RegressionPatron received completion from unknown patron");
+    return;
+  }
+  RegressionPatronPromiseState const kind = awaiting->second;
+  this->awaitingPatrons.erase(awaiting);
 
+  switch (kind) {
+    case awaitingModConvUp: {
+      log_debug("awaitingModConvUp");
       this->modConvUpDispenser =
           std::move(static_cast<ff::mpc::ModConvUpRandomnessPatron<
                         SAFRN_TYPES,
@@ -129,51 +367,18 @@ void RegressionRandomnessPatron::handleComplete(Fronctocol & f) {
                         LargeNum,
                         LargeNum> &>(f)
                         .modConvUpDispenser);
-
-      std::unique_ptr<Fronctocol> patron(
-          new ff::mpc::
-              DivideRandomnessPatron<SAFRN_TYPES, LargeNum, SmallNum>(
-                  &this->info->divideInfo,
-                  dealerIdentity,
-                  this->numDivideNeeded * this->dispenserSize));
-      this->invoke(std::move(patron), this->getPeers());
-      this->state = awaitingDivide;
     } break;
     case awaitingDivide: {
+      log_debug("awaitingDivide");
       this->divideDispenser =
           std::move(static_cast<ff::mpc::DivideRandomnessPatron<
                         SAFRN_TYPES,
                         LargeNum,
                         SmallNum> &>(f)
                         .divideDispenser);
-
-      this->getPeers().forEachDataowner(
-          [&, this](const Identity & other) {
-            if (other.vertical != this->getSelf().vertical) {
-              zipAdjacentDispensers.emplace_back(nullptr);
-
-              std::unique_ptr<Fronctocol> patron(
-                  new ff::mpc::ZipAdjacentRandomnessPatron<
-                      SAFRN_TYPES,
-                      LargeNum,
-                      SmallNum>(
-                      &this->info->zipAdjacentInfo,
-                      dealerIdentity,
-                      this->numConditionalEvaluateNeeded *
-                          this->dispenserSize));
-
-              PeerSet ps = PeerSet();
-              ps.add(this->getSelf());
-              ps.add(other);
-              ps.add(*dealerIdentity);
-
-              this->invoke(std::move(patron), ps);
-            }
-          });
-      this->numPartiesAwaiting = this->numCrossParties;
-      this->state = awaitingConditionalEvaluate;
     } break;
     case awaitingConditionalEvaluate: {
+      log_debug("awaitingConditionalEvaluate");
       PeerSet ps = f.getPeers(); // should be only one other party
       ps.forEachDataowner([&, this](const Identity & other) {
         if (other.vertical != this->getSelf().vertical) {
@@ -187,44 +392,12 @@ void RegressionRandomnessPatron::handleComplete(Fronctocol & f) {
                       .zipAdjacentDispenser);
         }
       });
-
-      this->numPartiesAwaiting--;
-      if (this->numPartiesAwaiting == 0) {
-
-        arithmeticMultiplyForFactoryDispensers.resize(
-            this->numCrossParties);
-        this->getPeers().forEachDataowner(
-            [&, this](const Identity & other) {
-              if (other.vertical != this->getSelf().vertical) {
-
-                std::unique_ptr<Fronctocol> patron(
-                    new ff::mpc::RandomnessPatron<
-                        SAFRN_TYPES,
-                        ff::mpc::BeaverTriple<LargeNum>,
-                        ff::mpc::BeaverInfo<LargeNum>>(
-                        *dealerIdentity,
-                        this->numBeaverTripleForFactoryNeeded *
-                            this->dispenserSize,
-                        ff::mpc::BeaverInfo<LargeNum>(
-                            this->info->startModulus)));
-
-                PeerSet ps = PeerSet();
-                ps.add(this->getSelf());
-                ps.add(other);
-                ps.add(*dealerIdentity);
-
-                this->invoke(std::move(patron), ps);
-              }
-            });
-        this->numPartiesAwaiting = this->numCrossParties;
-        this->state = awaitingBeaverTripleForFactory;
-      }
     } break;
     case awaitingBeaverTripleForFactory: {
+      log_debug("awaitingBeaverTripleForFactory");
       PeerSet ps = f.getPeers(); // should be only one other party
       ps.forEachDataowner([&, this](const Identity & other) {
         if (other.vertical != this->getSelf().vertical) {
-
           this->arithmeticMultiplyForFactoryDispensers.at(
               indexOfCrossParties.at(other)) =
               std::move(
@@ -235,41 +408,15 @@ void RegressionRandomnessPatron::handleComplete(Fronctocol & f) {
                       .result);
         }
       });
-
-      this->numPartiesAwaiting--;
-      if (this->numPartiesAwaiting == 0) {
-
-        std::unique_ptr<Fronctocol> patron(
-            new ff::mpc::RandomnessPatron<
-                SAFRN_TYPES,
-                ff::mpc::BeaverTriple<LargeNum>,
-                ff::mpc::BeaverInfo<LargeNum>>(
-                *dealerIdentity,
-                this->numBeaverTripleForMatrixMultiplyNeeded *
-                    this->dispenserSize,
-                ff::mpc::BeaverInfo<LargeNum>(this->info->endModulus)));
-        this->invoke(std::move(patron), this->getPeers());
-        this->state = awaitingBeaverTripleForMatrixMultiply;
-      }
     } break;
-    case awaitingBeaverTripleForMatrixMultiply: {
-      this->arithmeticMultiplyForMatrixDispenser = std::move(
+    case awaitingMatrixBeaverTriple: {
+      log_debug("awaitingMatrixBeaverTriple");
+      this->matrixBeaverTripleDispenser = std::move(
           static_cast<PromiseFronctocol<ff::mpc::RandomnessDispenser<
-              ff::mpc::BeaverTriple<LargeNum>,
-              ff::mpc::BeaverInfo<LargeNum>>> &>(f)
+              dealer::MatrixBeaverTriple<LargeNum>,
+              dealer::MatrixBeaverTripleInfo<LargeNum, LargeNum>>> &>(
+              f)
               .result);
-
-      std::unique_ptr<Fronctocol> patron(
-          new ff::mpc::RandomnessPatron<
-              SAFRN_TYPES,
-              dealer::RandomSquareMatrix<LargeNum>,
-              dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>>(
-              *dealerIdentity,
-              this->numRandomSquareMatrixNeeded * this->dispenserSize,
-              dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>(
-                  this->info->num_IVs, this->info->endModulus)));
-      this->invoke(std::move(patron), this->getPeers());
-      this->state = awaitingRandomSquareMatrix;
     } break;
     case awaitingRandomSquareMatrix: {
       log_debug("awaitingRandomSquareMatrix");
@@ -278,18 +425,6 @@ void RegressionRandomnessPatron::handleComplete(Fronctocol & f) {
               dealer::RandomSquareMatrix<LargeNum>,
               dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>>> &>(f)
               .result);
-
-      std::unique_ptr<Fronctocol> patron(
-          new ff::mpc::RandomnessPatron<
-              SAFRN_TYPES,
-              ff::mpc::BeaverTriple<LargeNum>,
-              ff::mpc::BeaverInfo<LargeNum>>(
-              *dealerIdentity,
-              this->numBeaverTripleForFinalMultiplyNeeded *
-                  this->dispenserSize,
-              ff::mpc::BeaverInfo<LargeNum>(this->info->endModulus)));
-      this->invoke(std::move(patron), this->getPeers());
-      this->state = awaitingBeaverTripleForFinalMultiply;
     } break;
     case awaitingBeaverTripleForFinalMultiply: {
       log_debug("awaitingBeaverTripleForFinalMultiply");
@@ -298,16 +433,13 @@ void RegressionRandomnessPatron::handleComplete(Fronctocol & f) {
               ff::mpc::BeaverTriple<LargeNum>,
               ff::mpc::BeaverInfo<LargeNum>>> &>(f)
               .result);
-
-      std::unique_ptr<Fronctocol> patron(
-          new ff::mpc::
-              CompareRandomnessPatron<SAFRN_TYPES, LargeNum, SmallNum>(
-                  &this->info->compareInfoEndModulus,
-                  dealerIdentity,
-                  this->numCompareEndModulusNeeded *
-                      this->dispenserSize));
-      this->invoke(std::move(patron), this->getPeers());
-      this->state = awaitingCompareEndModulus;
+    } break;
+    case awaitingTruncationPair: {
+      log_debug("awaitingTruncationPair");
+      this->truncationPairDispenser = std::move(
+          static_cast<
+              PromiseFronctocol<SharedDivide::TruncationDispenser> &>(f)
+              .result);
     } break;
     case awaitingCompareEndModulus: {
       log_debug("awaitingCompareEndModulus");
@@ -317,36 +449,6 @@ void RegressionRandomnessPatron::handleComplete(Fronctocol & f) {
                         LargeNum,
                         SmallNum> &>(f)
                         .compareDispenser);
-
-      std::unique_ptr<Fronctocol> patron(
-          new ff::mpc::
-              CompareRandomnessPatron<SAFRN_TYPES, LargeNum, SmallNum>(
-                  &this->info->compareInfo,
-                  dealerIdentity,
-                  this->numCompareNeeded * this->dispenserSize));
-      this->invoke(std::move(patron), this->getPeers());
-      this->state = awaitingCompare;
-    } break;
-    case awaitingCompare: {
-      log_debug("awaitingCompare");
-      this->compareDispenser =
-          std::move(static_cast<ff::mpc::CompareRandomnessPatron<
-                        SAFRN_TYPES,
-                        LargeNum,
-                        SmallNum> &>(f)
-                        .compareDispenser);
-
-      std::unique_ptr<Fronctocol> patron(
-          new ff::mpc::RandomnessPatron<
-              SAFRN_TYPES,
-              ff::mpc::TypeCastTriple<LargeNum>,
-              ff::mpc::TypeCastFromBitInfo<LargeNum>>(
-              *dealerIdentity,
-              this->numTypeCastFromBitNeeded * this->dispenserSize,
-              ff::mpc::TypeCastFromBitInfo<LargeNum>(
-                  this->info->endModulus)));
-      this->invoke(std::move(patron), this->getPeers());
-      this->state = awaitingTypeCastFromBit;
     } break;
     case awaitingTypeCastFromBit: {
       log_debug("awaitingTypeCastFromBit");
@@ -355,41 +457,24 @@ void RegressionRandomnessPatron::handleComplete(Fronctocol & f) {
               ff::mpc::TypeCastTriple<LargeNum>,
               ff::mpc::TypeCastFromBitInfo<LargeNum>>> &>(f)
               .result);
-      log_debug(
-          "F_info.size(), t_info.size() %u, %u",
-          this->F_info->table_size_,
-          this->t_info->table_size_);
-      ::std::unique_ptr<Fronctocol> patron(new LookupRandomnessPatron(
-          this->F_info,
-          &this->info->compareInfoEndModulus,
-          dealerIdentity,
-          this->numTableLookupFNeeded * this->dispenserSize));
-      this->invoke(::std::move(patron), this->getPeers());
-      this->state = awaitingF_lookup;
     } break;
     case awaitingF_lookup: {
       log_debug("awaitingF_lookup");
       this->F_lookupDispenser = std::move(
           static_cast<LookupRandomnessPatron &>(f).lookupDispenser);
-
-      ::std::unique_ptr<Fronctocol> patron(new LookupRandomnessPatron(
-          this->t_info,
-          &this->info->compareInfoEndModulus,
-          dealerIdentity,
-          this->numTableLookuptNeeded * this->dispenserSize));
-      this->invoke(::std::move(patron), this->getPeers());
-      this->state = awaitingt_lookup;
     } break;
     case awaitingt_lookup: {
       log_debug("awaitingt_lookup");
       this->t_lookupDispenser = std::move(
           static_cast<LookupRandomnessPatron &>(f).lookupDispenser);
-
-      this->generateOutputDispenser();
     } break;
     default:
       log_error("State machine in unexpected state");
   }
+
+  if (this->awaitingPatrons.empty()) {
+    this->generateOutputDispenser();
+  }
 }
 
 void RegressionRandomnessPatron::handlePromise(Fronctocol &) {
@@ -435,19 +520,18 @@ void RegressionRandomnessPatron::generateOutputDispenser() {
             this->numDivideNeeded)),
         std::move(littleZipAdjacentDispensers),
         std::move(littleArithmeticMultiplyForFactoryDispensers),
-        std::move(
-            this->arithmeticMultiplyForMatrixDispenser->littleDispenser(
-                this->numBeaverTripleForMatrixMultiplyNeeded)),
+        std::move(this->matrixBeaverTripleDispenser->littleDispenser(
+            this->numMatrixBeaverTripleNeeded)),
         std::move(
             this->randomMatrixAndDetInverseDispenser->littleDispenser(
                 this->numRandomSquareMatrixNeeded)),
         std::move(
             this->arithmeticMultiplyForFinalDispenser->littleDispenser(
                 this->numBeaverTripleForFinalMultiplyNeeded)),
+        std::move(this->truncationPairDispenser->littleDispenser(
+            this->numTruncationPairNeeded)),
         std::move(this->compareEndModulusDispenser->littleDispenser(
             this->numCompareEndModulusNeeded)),
-        std::move(this->compareDispenser->littleDispenser(
-            this->numCompareNeeded)),
         std::move(this->typeCastFromBitDispenser->littleDispenser(
             this->numTypeCastFromBitNeeded)),
         std::move(this->F_lookupDispenser->littleDispenser(
@@ -460,5 +544,88 @@ void RegressionRandomnessPatron::generateOutputDispenser() {
   this->complete();
 }
 
+static char const * const RANDOM_SQUARE_MATRIX_KIND =
+    "random_square_matrix";
+static char const * const F_TABLE_LOOKUP_KIND = "F_table_lookup";
+static char const * const T_TABLE_LOOKUP_KIND = "t_table_lookup";
+
+std::string RegressionStoredRandomness::key(
+    RandomnessStore const & store,
+    RegressionInfo const * const info,
+    dealer::RandomTableLookupInfo const & F_info,
+    dealer::RandomTableLookupInfo const & t_info) {
+  return store.key(
+      "regression",
+      {info->endModulus,
+       LargeNum(info->num_IVs),
+       LargeNum(F_info.table_size_),
+       LargeNum(t_info.table_size_)});
+}
+
+bool RegressionStoredRandomness::read(
+    RandomnessStore const & store,
+    std::string const & key,
+    uint64_t const batch,
+    RegressionInfo const * const info,
+    dealer::RandomTableLookupInfo const & F_info,
+    dealer::RandomTableLookupInfo const & t_info) {
+  bool success = store.read(
+      key,
+      batch,
+      RANDOM_SQUARE_MATRIX_KIND,
+      dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>(
+          info->num_IVs, info->endModulus),
+      this->randomSquareMatrices);
+  success = success &&
+      store.read(
+          key,
+          batch,
+          F_TABLE_LOOKUP_KIND,
+          F_info,
+          this->F_tableLookups);
+  success = success &&
+      store.read(
+          key,
+          batch,
+          T_TABLE_LOOKUP_KIND,
+          t_info,
+          this->t_tableLookups);
+
+  /** One regression's worth, see RegressionRandomnessPatron. */
+  return success && this->randomSquareMatrices.size() == 1 &&
+      this->F_tableLookups.size() == 1 &&
+      this->t_tableLookups.size() == info->num_IVs;
+}
+
+bool RegressionStoredRandomness::pregenerate(
+    std::vector<RandomnessStore> const & shards,
+    std::string const & key,
+    uint64_t const batch,
+    RegressionInfo const * const info,
+    dealer::RandomTableLookupInfo const & F_info,
+    dealer::RandomTableLookupInfo const & t_info) {
+  bool success =
+      safrn::pregenerate<dealer::RandomSquareMatrix<LargeNum>>(
+          shards,
+          key,
+          batch,
+          RANDOM_SQUARE_MATRIX_KIND,
+          dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>(
+              info->num_IVs, info->endModulus),
+          1);
+  success = success &&
+      safrn::pregenerate<dealer::RandomTableLookup>(
+          shards, key, batch, F_TABLE_LOOKUP_KIND, F_info, 1);
+  success = success &&
+      safrn::pregenerate<dealer::RandomTableLookup>(
+          shards,
+          key,
+          batch,
+          T_TABLE_LOOKUP_KIND,
+          t_info,
+          info->num_IVs);
+  return success;
+}
+
 } // namespace dataowner
 } // namespace safrn
@@ -29,9 +29,13 @@
 #include <dataowner/LookupPatron.h>
 #include <dataowner/RegressionInfo.h>
 #include <dataowner/fortissimo.h>
+#include <dealer/MatrixBeaverTriple.h>
 #include <dealer/RandomSquareMatrix.h>
 #include <dealer/RandomTableLookup.h>
+#include <dealer/TruncationPair.h>
 #include <framework/Framework.h>
+#include <util/RandomnessDealer.h>
+#include <util/RandomnessStore.h>
 
 /* logging configuration */
 #include <ff/logging.h>
@@ -39,6 +43,43 @@
 namespace safrn {
 namespace dataowner {
 
+/**
+ * The part of a regression's randomness which may be generated ahead of
+ * time and kept in a RandomnessStore: SAFRN's own random square matrix
+ * and table lookup vectors. Fortissimo's randomness is always fetched
+ * from the dealer during the query.
+ */
+struct RegressionStoredRandomness {
+  std::vector<dealer::RandomSquareMatrix<LargeNum>>
+      randomSquareMatrices;
+  std::vector<dealer::RandomTableLookup> F_tableLookups;
+  std::vector<dealer::RandomTableLookup> t_tableLookups;
+
+  static std::string key(
+      RandomnessStore const & store,
+      RegressionInfo const * const info,
+      dealer::RandomTableLookupInfo const & F_info,
+      dealer::RandomTableLookupInfo const & t_info);
+
+  /** Reads this party's share of one batch from its store. */
+  bool read(
+      RandomnessStore const & store,
+      std::string const & key,
+      uint64_t const batch,
+      RegressionInfo const * const info,
+      dealer::RandomTableLookupInfo const & F_info,
+      dealer::RandomTableLookupInfo const & t_info);
+
+  /** Generates one batch and writes every party's share of it. */
+  static bool pregenerate(
+      std::vector<RandomnessStore> const & shards,
+      std::string const & key,
+      uint64_t const batch,
+      RegressionInfo const * const info,
+      dealer::RandomTableLookupInfo const & F_info,
+      dealer::RandomTableLookupInfo const & t_info);
+};
+
 class RegressionRandomnessPatron : public Fronctocol {
 public:
   void init() override;
@@ -59,26 +100,44 @@ public:
       const size_t t_rows,
       dealer::RandomTableLookupInfo const * const F_info,
       dealer::RandomTableLookupInfo const * const t_info,
-      const size_t dispenserSize);
+      const size_t dispenserSize,
+      RandomnessStore const * const store = nullptr);
 
 private:
   void generateOutputDispenser();
 
+  /**
+   * Invokes the patrons for all randomness which is not being taken
+   * from the RandomnessStore.
+   */
+  void invokePatrons(bool const useStored);
+
+  /**
+   * Every randomness patron is invoked up front by init(), and each
+   * outstanding child is tagged with the kind of randomness it is
+   * fetching, so that completions may arrive in any order.
+   */
   enum RegressionPatronPromiseState {
     awaitingModConvUp,
     awaitingDivide,
     awaitingConditionalEvaluate,
     awaitingBeaverTripleForFactory,
-    awaitingBeaverTripleForMatrixMultiply,
+    awaitingMatrixBeaverTriple,
     awaitingRandomSquareMatrix,
     awaitingBeaverTripleForFinalMultiply,
+    awaitingTruncationPair,
     awaitingCompareEndModulus,
-    awaitingCompare,
     awaitingTypeCastFromBit,
     awaitingF_lookup,
     awaitingt_lookup
   };
-  RegressionPatronPromiseState state = awaitingModConvUp;
+  std::map<Fronctocol const *, RegressionPatronPromiseState>
+      awaitingPatrons;
+
+  void invokePatron(
+      std::unique_ptr<Fronctocol> patron,
+      PeerSet const & ps,
+      RegressionPatronPromiseState kind);
 
   RegressionInfo const * const info;
   const safrn::Identity * dealerIdentity;
@@ -88,20 +147,24 @@ private:
   dealer::RandomTableLookupInfo const * const t_info;
   const size_t dispenserSize;
 
+  RandomnessStore const * const store;
+  std::string storeKey;
+  uint64_t storedBatch = RandomnessStore::NO_BATCH;
+  RegressionStoredRandomness stored;
+
   const size_t numModConvUpNeeded;
   const size_t numDivideNeeded;
   const size_t numConditionalEvaluateNeeded;
   const size_t numBeaverTripleForFactoryNeeded;
-  const size_t numBeaverTripleForMatrixMultiplyNeeded;
+  const size_t numMatrixBeaverTripleNeeded;
   const size_t numRandomSquareMatrixNeeded;
   const size_t numBeaverTripleForFinalMultiplyNeeded;
+  const size_t numTruncationPairNeeded;
   const size_t numCompareEndModulusNeeded;
-  const size_t numCompareNeeded;
   const size_t numTypeCastFromBitNeeded;
   const size_t numTableLookupFNeeded;
   const size_t numTableLookuptNeeded;
 
-  size_t numPartiesAwaiting;
   size_t numCrossParties;
   std::map<safrn::Identity, size_t> indexOfCrossParties;
 
@@ -122,9 +185,9 @@ private:
       ff::mpc::BeaverInfo<LargeNum>>>>
       arithmeticMultiplyForFactoryDispensers;
   std::unique_ptr<ff::mpc::RandomnessDispenser<
-      ff::mpc::BeaverTriple<LargeNum>,
-      ff::mpc::BeaverInfo<LargeNum>>>
-      arithmeticMultiplyForMatrixDispenser;
+      dealer::MatrixBeaverTriple<LargeNum>,
+      dealer::MatrixBeaverTripleInfo<LargeNum, LargeNum>>>
+      matrixBeaverTripleDispenser;
   std::unique_ptr<ff::mpc::RandomnessDispenser<
       dealer::RandomSquareMatrix<LargeNum>,
       dealer::RandomSquareMatrixInfo<LargeNum, LargeNum>>>
@@ -133,14 +196,12 @@ private:
       ff::mpc::BeaverTriple<LargeNum>,
       ff::mpc::BeaverInfo<LargeNum>>>
       arithmeticMultiplyForFinalDispenser;
+  std::unique_ptr<SharedDivide::TruncationDispenser>
+      truncationPairDispenser;
   std::unique_ptr<ff::mpc::RandomnessDispenser<
       ff::mpc::CompareRandomness<LargeNum, SmallNum>,
       ff::mpc::DoNotGenerateInfo>>
       compareEndModulusDispenser;
-  std::unique_ptr<ff::mpc::RandomnessDispenser<
-      ff::mpc::CompareRandomness<LargeNum, SmallNum>,
-      ff::mpc::DoNotGenerateInfo>>
-      compareDispenser;
   std::unique_ptr<ff::mpc::RandomnessDispenser<
       ff::mpc::TypeCastTriple<LargeNum>,
       ff::mpc::TypeCastFromBitInfo<LargeNum>>>
@@ -2,143 +2,194 @@
  * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
  */
 
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <algorithm>
+#include <utility>
+
+/* 3rd Party Headers */
+
+/* SAFRN Headers */
 #include <dataowner/RegressionPayloadCompute.h>
+#include <util/ModColumns.h>
 
+/* logging configuration */
 #include <ff/logging.h>
 
 namespace safrn {
 namespace dataowner {
 
 RegressionPayloadCompute::RegressionPayloadCompute(
-    std::vector<LargeNum> && vec1,
-    std::vector<LargeNum> && vec2,
+    ff::mpc::ObservationList<LargeNum> && zipped,
     std::unique_ptr<ff::mpc::RandomnessDispenser<
         ff::mpc::BeaverTriple<LargeNum>,
         ff::mpc::BeaverInfo<LargeNum>>> beaverDispenser,
-    MultiplyInfo<BeaverInfo<LargeNum>> const * const multiplyInfo,
-    RegressionInfo const * const regressionInfo) :
-    vec1(std::move(vec1)),
-    vec2(std::move(vec2)),
+    Identity const & revealer,
+    RegressionInfo const * const regressionInfo,
+    size_t const pairsPerMultiply) :
+    zipped(std::move(zipped)),
     beaverDispenser(std::move(beaverDispenser)),
-    multiplyInfo(multiplyInfo),
-    regressionInfo(regressionInfo) {
+    revealer(revealer),
+    regressionInfo(regressionInfo),
+    pairsPerMultiply(pairsPerMultiply) {
 }
 
 void RegressionPayloadCompute::init() {
-  //log_debug("Calling init on RegressionPayloadCompute");
-
-  std::unique_ptr<ff::mpc::Batch<SAFRN_TYPES>> batch(
-      new ff::mpc::Batch<SAFRN_TYPES>());
-
-  this->multiplyResults.resize(
-      regressionInfo->verticalNonDV_numIVs *
-      (regressionInfo->verticalDV_numIVs + 1));
-  for (size_t i = 0; i < regressionInfo->verticalNonDV_numIVs; i++) {
-    for (size_t j = 0; j < regressionInfo->verticalDV_numIVs + 1; j++) {
-      //log_debug("i %zu, j %zu",i,j);
-      //log_debug("vec1 length %zu, vec2 length %zu", this->vec1.size(),this->vec2.size());
-
-      batch->children.emplace_back(new ff::mpc::Multiply<
-                                   SAFRN_TYPES,
-                                   LargeNum,
-                                   ff::mpc::BeaverInfo<LargeNum>>(
-          this->vec1[i],
-          this->vec2[j],
-          &this->multiplyResults
-               [i * (regressionInfo->verticalDV_numIVs + 1) + j],
-          this->beaverDispenser->get(),
-          this->multiplyInfo));
+  log_debug("Calling init on RegressionPayloadCompute");
+  size_t const n = this->zipped.elements.size();
+  size_t const dv_width = this->regressionInfo->verticalDV_numIVs + 1;
+
+  this->productsPerPair =
+      this->regressionInfo->verticalNonDV_numIVs * dv_width;
+  this->numPairs = n < 2 ? 0 : n - 1;
+
+  /* The sums of the pairs themselves need no multiplies. */
+  LargeNum const & p = this->regressionInfo->startModulus;
+  size_t const width = this->regressionInfo->payloadLength;
+  this->firstSums.assign(width, LargeNum(0));
+  this->secondSums.assign(width, LargeNum(0));
+  for (size_t pair = 0; pair < this->numPairs; pair++) {
+    modAddColumn(
+        this->firstSums.data(),
+        this->zipped.elements[pair].arithmeticPayloadCols.data(),
+        this->firstSums.data(),
+        width,
+        p);
+    modAddColumn(
+        this->secondSums.data(),
+        this->zipped.elements[pair + 1].arithmeticPayloadCols.data(),
+        this->secondSums.data(),
+        width,
+        p);
+  }
+
+  this->productSums.assign(this->productsPerPair, LargeNum(0));
+  this->invokeMultiply();
+}
+
+void RegressionPayloadCompute::invokeMultiply() {
+  size_t const begin = this->nextPair;
+  size_t const end = this->pairsPerMultiply == 0 ?
+      this->numPairs :
+      std::min(this->numPairs, begin + this->pairsPerMultiply);
+  size_t const dv_width = this->regressionInfo->verticalDV_numIVs + 1;
+
+  std::vector<LargeNum> xs;
+  std::vector<LargeNum> ys;
+  xs.reserve((end - begin) * this->productsPerPair);
+  ys.reserve((end - begin) * this->productsPerPair);
+  for (size_t pair = begin; pair < end; pair++) {
+    std::vector<LargeNum> const & vec1 =
+        this->zipped.elements[pair].arithmeticPayloadCols;
+    std::vector<LargeNum> const & vec2 =
+        this->zipped.elements[pair + 1].arithmeticPayloadCols;
+    for (size_t i = 0; i < this->regressionInfo->verticalNonDV_numIVs;
+         i++) {
+      for (size_t j = 0; j < dv_width; j++) {
+        xs.push_back(vec1[i]);
+        ys.push_back(vec2[j]);
+      }
     }
   }
-  this->invoke(std::move(batch), this->getPeers());
+  this->nextPair = end;
+  this->pairsInMultiply = end - begin;
+  if (this->nextPair == this->numPairs) {
+    this->zipped = ff::mpc::ObservationList<LargeNum>();
+  }
+
+  std::unique_ptr<Fronctocol> multiply(new VectorMultiply(
+      std::move(xs),
+      std::move(ys),
+      *this->beaverDispenser,
+      this->regressionInfo->startModulus,
+      this->revealer));
+  this->invoke(std::move(multiply), this->getPeers());
+}
+
+void RegressionPayloadCompute::handleReceive(IncomingMessage &) {
+  log_error("Unexpected handleReceive in RegressionPayloadCompute");
+  this->abort();
 }
 
 void RegressionPayloadCompute::handlePromise(Fronctocol &) {
   log_error("Unexpected handlePromise in RegressionPayloadCompute");
+  this->abort();
 }
 
-void RegressionPayloadCompute::handleReceive(IncomingMessage &) {
-  log_error("Unexpected handleReceive in RegressionPayloadCompute");
+std::string RegressionPayloadCompute::name() {
+  return std::string("Regression Payload Compute");
 }
 
-void RegressionPayloadCompute::handleComplete(Fronctocol &) {
-  log_debug("Calling handleComplete");
+void RegressionPayloadCompute::handleComplete(Fronctocol & f) {
+  log_debug("Calling handleComplete on RegressionPayloadCompute");
+  LargeNum const & p = this->regressionInfo->startModulus;
+  std::vector<LargeNum> const & products =
+      static_cast<VectorMultiply &>(f).outputs;
+
+  for (size_t pair = 0; pair < this->pairsInMultiply; pair++) {
+    modAddColumn(
+        this->productSums.data(),
+        &products[pair * this->productsPerPair],
+        this->productSums.data(),
+        this->productsPerPair,
+        p);
+  }
+  if (this->nextPair < this->numPairs) {
+    this->invokeMultiply();
+    return;
+  }
+
   size_t d = this->regressionInfo->num_IVs;
   size_t d_1 = this->regressionInfo->verticalNonDV_numIVs;
-  this->output.arithmeticPayloadCols =
-      std::vector<LargeNum>(d * d + d + 3);
+  size_t const v = this->regressionInfo->packedMatrixLength;
+  this->sums.assign(
+      this->regressionInfo->payloadSumsLength, LargeNum(0));
   for (size_t i = 0; i < d; i++) {
-    for (size_t j = 0; j < d; j++) {
-      this->output.arithmeticPayloadCols[i * d + j] =
+    for (size_t j = i; j < d; j++) {
+      this->sums[this->regressionInfo->packedIndex(i, j)] =
           accessMatrixShare(i, j, d, d_1);
     }
   }
 
   for (size_t i = 0; i < d_1; i++) {
-    this->output.arithmeticPayloadCols[d * d + i] =
-        this->multiplyResults
-            [i * (regressionInfo->verticalDV_numIVs + 1) + d - d_1];
+    this->sums[v + i] = this->productSums
+        [i * (regressionInfo->verticalDV_numIVs + 1) + d - d_1];
   }
   for (size_t i = d_1; i < d; i++) {
-    this->output.arithmeticPayloadCols[d * d + i] =
-        this->vec2
-            [(d - d_1 + 1) + (d - d_1) * (d - d_1 + 1) / 2 +
-             (i - d_1)]; // see above;
+    this->sums[v + i] = this->secondSums
+        [(d - d_1 + 1) + (d - d_1) * (d - d_1 + 1) / 2 +
+         (i - d_1)]; // see accessMatrixShare
   }
 
   size_t d2_offset = (d - d_1 + 1) + ((d - d_1) * (d - d_1 + 3)) / 2;
   // y*y
-  this->output.arithmeticPayloadCols[d * d + d] = this->vec2[d2_offset];
+  this->sums[v + d] = this->secondSums[d2_offset];
   //y
-  this->output.arithmeticPayloadCols[d * d + d + 1] =
-      this->vec2[d2_offset + 1];
+  this->sums[v + d + 1] = this->secondSums[d2_offset + 1];
   // 1
-  this->output.arithmeticPayloadCols[d * d + d + 2] =
-      this->vec2[d2_offset + 2];
+  this->sums[v + d + 2] = this->secondSums[d2_offset + 2];
 
   this->complete();
 }
 
 LargeNum RegressionPayloadCompute::accessMatrixShare(
     size_t i, size_t j, size_t d, size_t d_1) {
-  //log_debug("Calling accessMatrixShare on %zu, %zu, %zu, %zu",i,j, d, d_1);
   if (i > j) {
     return accessMatrixShare(j, i, d, d_1);
   } else if (i < d_1 && j < d_1) {
-    return this->vec1
+    return this->firstSums
         [d_1 + d_1 * (d_1 + 1) / 2 - (d_1 - i) * (d_1 - i + 1) / 2 +
          (j - i)]; // (d_1 + d_1-1 + ... + (d_1 - j + 1))+(i-j)
   } else if (i < d_1 && j >= d_1) {
-    return this->multiplyResults
+    return this->productSums
         [i * (regressionInfo->verticalDV_numIVs + 1) + (j - d_1)];
   } else {
-    return this->vec2
+    return this->secondSums
         [(d - d_1 + 1) + (d - d_1) * (d - d_1 + 1) / 2 -
          (d - i) * (d - i + 1) / 2 + (j - i)]; // see above
   }
 }
 
-std::unique_ptr<ff::mpc::ZipReduceFronctocol<SAFRN_TYPES, LargeNum>>
-RegressionPayloadComputeFactory::generate(
-    std::unique_ptr<ff::mpc::Observation<LargeNum>> o1,
-    std::unique_ptr<ff::mpc::Observation<LargeNum>> o2) {
-  log_debug("HI");
-  log_debug(
-      "o1.arithmeticPayloadCols.size() %zu, "
-      "o2.arithmeticPayloadCols.size() %zu",
-      o1->arithmeticPayloadCols.size(),
-      o2->arithmeticPayloadCols.size());
-  return std::move(std::unique_ptr<
-                   ff::mpc::ZipReduceFronctocol<SAFRN_TYPES, LargeNum>>(
-      new RegressionPayloadCompute(
-          std::move(o1->arithmeticPayloadCols),
-          std::move(o2->arithmeticPayloadCols),
-          std::move(this->dispenser->littleDispenser(
-              this->info->verticalNonDV_numIVs *
-              (this->info->verticalDV_numIVs + 1))),
-          multiplyInfo,
-          this->info)));
-}
-
 } // namespace dataowner
 } // namespace safrn
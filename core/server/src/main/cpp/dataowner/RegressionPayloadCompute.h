@@ -8,7 +8,9 @@
 /* C and POSIX Headers */
 
 /* C++ Headers */
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <vector>
 
 /* 3rd Party Headers */
@@ -17,17 +19,14 @@
 #include <ff/Fronctocol.h>
 #include <ff/Message.h>
 
-#include <mpc/Batch.h>
 #include <mpc/Multiply.h>
+#include <mpc/ObservationList.h>
 #include <mpc/Randomness.h>
 #include <mpc/RandomnessDealer.h>
-#include <mpc/UnboundedFaninOr.h>
 #include <mpc/templates.h>
 
 #include <dataowner/RegressionInfo.h>
-#include <mpc/AbstractZipReduceFactory.h>
-
-#include <dataowner/RegressionInfo.h>
+#include <dataowner/VectorMultiply.h>
 #include <dataowner/fortissimo.h>
 #include <framework/Framework.h>
 
@@ -37,69 +36,69 @@
 namespace safrn {
 namespace dataowner {
 
-class RegressionPayloadCompute
-    : public ff::mpc::ZipReduceFronctocol<SAFRN_TYPES, LargeNum> {
+/**
+ * Computes, between this party and one cross vertical party, the sums
+ * over all adjacent pairs of a zipped list of the regression's cross
+ * product terms (A^TA, A^Ty, y^Ty, y and the count).
+ *
+ * The products of the pairs are taken by VectorMultiplies of at most
+ * pairsPerMultiply pairs each, or of every pair if it is zero, and
+ * summed straight into the output, so no per-pair payloads are kept.
+ * The zipped list is released once its last pairs are multiplied.
+ */
+class RegressionPayloadCompute : public Fronctocol {
 public:
-  /*
-   * Takes in two Arithmetic vectors (from two observations)
-   * and computes all necessary cross product terms
-   */
   RegressionPayloadCompute(
-      std::vector<LargeNum> && vec1,
-      std::vector<LargeNum> && vec2,
+      ff::mpc::ObservationList<LargeNum> && zipped,
       std::unique_ptr<ff::mpc::RandomnessDispenser<
           ff::mpc::BeaverTriple<LargeNum>,
           ff::mpc::BeaverInfo<LargeNum>>> beaverDispenser,
-      MultiplyInfo<BeaverInfo<LargeNum>> const * const multiplyInfo,
-      RegressionInfo const * const regressionInfo);
+      Identity const & revealer,
+      RegressionInfo const * const regressionInfo,
+      size_t const pairsPerMultiply = 0);
 
   void init() override;
   void handleReceive(IncomingMessage & imsg) override;
   void handleComplete(Fronctocol & f) override;
   void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+  /**
+   * Shares of the summed payload, laid out as in the regression's
+   * payload vector: the packed upper triangle of A^TA, d vector terms,
+   * then y*y, y and the count.
+   */
+  std::vector<LargeNum> sums;
 
 private:
-  std::vector<LargeNum> vec1;
-  std::vector<LargeNum> vec2;
+  ff::mpc::ObservationList<LargeNum> zipped;
   std::unique_ptr<ff::mpc::RandomnessDispenser<
       ff::mpc::BeaverTriple<LargeNum>,
       ff::mpc::BeaverInfo<LargeNum>>>
       beaverDispenser;
-  MultiplyInfo<BeaverInfo<LargeNum>> const * const multiplyInfo;
+  Identity const revealer;
   RegressionInfo const * const regressionInfo;
+  size_t const pairsPerMultiply;
 
-  std::vector<LargeNum> multiplyResults;
-
-  LargeNum accessMatrixShare(size_t i, size_t j, size_t d, size_t d_1);
-};
+  /**
+   * Products per pair, each of the non-DV vertical's IVs with each of
+   * the DV vertical's IVs and its y.
+   */
+  size_t productsPerPair = 0;
 
-class RegressionPayloadComputeFactory
-    : public ff::mpc::ZipReduceFactory<SAFRN_TYPES, LargeNum> {
+  /* Pairs of the zipped list, the next to multiply, and the number in
+   * the VectorMultiply awaited. */
+  size_t numPairs = 0;
+  size_t nextPair = 0;
+  size_t pairsInMultiply = 0;
 
-public:
-  RegressionPayloadComputeFactory(
-      RegressionInfo const * const info,
-      std::unique_ptr<ff::mpc::RandomnessDispenser<
-          ff::mpc::BeaverTriple<LargeNum>,
-          ff::mpc::BeaverInfo<LargeNum>>> dispenser,
-      MultiplyInfo<BeaverInfo<LargeNum>> const * const multiplyInfo) :
-      info(info),
-      dispenser(std::move(dispenser)),
-      multiplyInfo(multiplyInfo) {
-  }
-
-  std::unique_ptr<ff::mpc::ZipReduceFronctocol<SAFRN_TYPES, LargeNum>>
-  generate(
-      std::unique_ptr<ff::mpc::Observation<LargeNum>> o1,
-      std::unique_ptr<ff::mpc::Observation<LargeNum>> o2) override;
+  /* Per-column sums of the first and the second of each pair. */
+  std::vector<LargeNum> firstSums;
+  std::vector<LargeNum> secondSums;
+  std::vector<LargeNum> productSums;
 
-private:
-  RegressionInfo const * const info;
-  std::unique_ptr<ff::mpc::RandomnessDispenser<
-      ff::mpc::BeaverTriple<LargeNum>,
-      ff::mpc::BeaverInfo<LargeNum>>>
-      dispenser;
-  MultiplyInfo<BeaverInfo<LargeNum>> const * const multiplyInfo;
+  void invokeMultiply();
+  LargeNum accessMatrixShare(size_t i, size_t j, size_t d, size_t d_1);
 };
 
 } // namespace dataowner
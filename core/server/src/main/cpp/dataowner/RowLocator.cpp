@@ -0,0 +1,196 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+/* 3rd Party Headers */
+
+/* SAFRN Headers */
+#include <dataowner/RowLocator.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+size_t RowLocator::numLevels(size_t const rows) {
+  size_t levels = 0;
+  while ((size_t(1) << levels) < rows) {
+    levels++;
+  }
+  return levels;
+}
+
+size_t RowLocator::numBeaverTriples(size_t const rows) {
+  /* The one-hot shares double from 2 to 2^(levels - 1) entries. */
+  size_t const levels = numLevels(rows);
+  return levels < 2 ? 0 : (size_t(1) << (levels - 1)) - 2;
+}
+
+RowLocator::RowLocator(
+    LargeNum const & keyShare,
+    std::vector<size_t> const & rowIds,
+    LargeNum const & keyBound,
+    ff::mpc::CompareInfo<Identity, LargeNum, SmallNum> const * const
+        compareInfo,
+    CompareDispenser & compareDispenser,
+    TypeCastFromBitDispenser & typeCastFromBitDispenser,
+    BeaverDispenser & beaverDispenser,
+    LargeNum const & modulus,
+    Identity const & revealer) :
+    keyShare(keyShare),
+    compareInfo(compareInfo),
+    modulus(modulus),
+    revealer(revealer),
+    levels(numLevels(rowIds.size())) {
+  log_assert(std::is_sorted(rowIds.begin(), rowIds.end()));
+
+  /* The last row takes every key above the row ids before it. */
+  this->thresholds.resize((size_t(1) << this->levels) - 1, keyBound);
+  for (size_t i = 0; i + 1 < rowIds.size(); i++) {
+    this->thresholds[i] = LargeNum(rowIds[i]);
+  }
+
+  this->compareDispenser =
+      compareDispenser.littleDispenser(this->levels);
+  this->typeCastFromBitDispenser =
+      typeCastFromBitDispenser.littleDispenser(this->levels);
+  this->beaverDispenser =
+      beaverDispenser.littleDispenser(numBeaverTriples(rowIds.size()));
+}
+
+void RowLocator::init() {
+  if (this->levels == 0) {
+    this->complete();
+    return;
+  }
+
+  /* Before the first level the prefix is empty, a share of 1. */
+  this->prefix.assign(
+      1, this->revealer == this->getSelf() ? LargeNum(1) : LargeNum(0));
+  this->invokeCompare();
+}
+
+void RowLocator::handleReceive(IncomingMessage &) {
+  log_error("Unexpected handleReceive in RowLocator");
+  this->abort();
+}
+
+void RowLocator::handleComplete(Fronctocol & f) {
+  switch (this->state) {
+    case awaitingCompare: {
+      log_debug("awaitingCompare, level %zu", this->level);
+      std::unique_ptr<Fronctocol> typeCast(
+          new ff::mpc::TypeCastFromBit<SAFRN_TYPES, LargeNum>(
+              static_cast<
+                  ff::mpc::Compare<SAFRN_TYPES, LargeNum, SmallNum> &>(
+                  f)
+                      .outputShare %
+                  2,
+              this->modulus,
+              &this->revealer,
+              this->typeCastFromBitDispenser->get()));
+      this->invoke(std::move(typeCast), this->getPeers());
+      this->state = awaitingTypeCastFromBit;
+    } break;
+    case awaitingTypeCastFromBit: {
+      log_debug("awaitingTypeCastFromBit, level %zu", this->level);
+      this->bit =
+          static_cast<
+              ff::mpc::TypeCastFromBit<SAFRN_TYPES, LargeNum> &>(f)
+              .outputBitShare;
+      this->output = ff::mpc::modAdd(
+          this->output,
+          ff::mpc::modMul(
+              this->bit,
+              LargeNum(1) << (this->levels - 1 - this->level),
+              this->modulus),
+          this->modulus);
+
+      this->level++;
+      if (this->level == this->levels) {
+        this->complete();
+      } else if (this->prefix.size() == 1) {
+        /* The empty prefix is 1, so its product with the bit is b. */
+        this->extendPrefix(std::vector<LargeNum>(1, this->bit));
+      } else {
+        size_t const n = this->prefix.size();
+        std::unique_ptr<Fronctocol> multiply(new VectorMultiply(
+            std::vector<LargeNum>(this->prefix),
+            std::vector<LargeNum>(n, this->bit),
+            *this->beaverDispenser,
+            this->modulus,
+            this->revealer));
+        this->invoke(std::move(multiply), this->getPeers());
+        this->state = awaitingMultiply;
+      }
+    } break;
+    case awaitingMultiply: {
+      log_debug("awaitingMultiply, level %zu", this->level);
+      this->extendPrefix(static_cast<VectorMultiply &>(f).outputs);
+    } break;
+    default:
+      log_error("RowLocator state machine in unexpected state");
+      this->abort();
+  }
+}
+
+void RowLocator::handlePromise(Fronctocol &) {
+  log_error("Unexpected handlePromise in RowLocator");
+  this->abort();
+}
+
+std::string RowLocator::name() {
+  return std::string("Row Locator");
+}
+
+void RowLocator::invokeCompare() {
+  /**
+   * The key is above thresholds[j] exactly when the row index exceeds
+   * j. With the bits found so far making p, the next bit is whether
+   * the key is above the threshold ending the lower half of p's rows.
+   */
+  size_t const remaining = this->levels - this->level;
+  size_t const half = size_t(1) << (remaining - 1);
+  LargeNum threshold(0);
+  for (size_t p = 0; p < this->prefix.size(); p++) {
+    threshold = ff::mpc::modAdd(
+        threshold,
+        ff::mpc::modMul(
+            this->prefix[p],
+            this->thresholds[(p << remaining) + half - 1],
+            this->modulus),
+        this->modulus);
+  }
+
+  std::unique_ptr<Fronctocol> compare(
+      new ff::mpc::Compare<SAFRN_TYPES, LargeNum, SmallNum>(
+          this->keyShare,
+          threshold,
+          this->compareInfo,
+          this->compareDispenser->get()));
+  this->invoke(std::move(compare), this->getPeers());
+  this->state = awaitingCompare;
+}
+
+void RowLocator::extendPrefix(std::vector<LargeNum> const & products) {
+  /* Prefix p, then bit b, makes prefix 2p + b. */
+  std::vector<LargeNum> next(2 * this->prefix.size());
+  for (size_t p = 0; p < this->prefix.size(); p++) {
+    next[2 * p + 1] = products[p];
+    next[2 * p] =
+        ff::mpc::modSub(this->prefix[p], products[p], this->modulus);
+  }
+  this->prefix = std::move(next);
+  this->invokeCompare();
+}
+
+} // namespace dataowner
+} // namespace safrn
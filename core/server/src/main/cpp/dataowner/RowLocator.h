@@ -0,0 +1,133 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_DATAOWNER_ROW_LOCATOR_H_
+#define SAFRN_DATAOWNER_ROW_LOCATOR_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* Fortissimo Headers */
+#include <ff/Fronctocol.h>
+#include <ff/Message.h>
+
+#include <mpc/Compare.h>
+#include <mpc/ModConvUp.h>
+#include <mpc/Randomness.h>
+#include <mpc/RandomnessDealer.h>
+
+#include <dataowner/VectorMultiply.h>
+#include <dataowner/fortissimo.h>
+#include <framework/Framework.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+/**
+ * Finds the row of a lookup table for a shared key, as a share of the
+ * number of the table's row ids, all but the last, which are below the
+ * key. The row ids are public and sorted.
+ *
+ * Where one Compare per row id would do, this searches the row ids in
+ * binary, one bit of the row index per level. Each level compares the
+ * key with the row id halfway through the rows left, selected by a
+ * one-hot share of the bits found so far, so a table of n rows costs
+ * ceil(log2(n)) Compares and TypeCastFromBits, and fewer than n / 2
+ * Beaver triples to extend the one-hot shares.
+ */
+class RowLocator : public Fronctocol {
+public:
+  using CompareDispenser = ff::mpc::RandomnessDispenser<
+      ff::mpc::CompareRandomness<LargeNum, SmallNum>,
+      ff::mpc::DoNotGenerateInfo>;
+  using TypeCastFromBitDispenser = ff::mpc::RandomnessDispenser<
+      ff::mpc::TypeCastTriple<LargeNum>,
+      ff::mpc::TypeCastFromBitInfo<LargeNum>>;
+  using BeaverDispenser = ff::mpc::RandomnessDispenser<
+      ff::mpc::BeaverTriple<LargeNum>,
+      ff::mpc::BeaverInfo<LargeNum>>;
+
+  /** Levels of the search, and so Compares, for a table of rows. */
+  static size_t numLevels(size_t const rows);
+
+  /** Beaver triples used by the search for a table of rows. */
+  static size_t numBeaverTriples(size_t const rows);
+
+  /**
+   * Draws the search's randomness from the dispensers up front. The
+   * keyBound must exceed any key, it pads the row ids to a power of
+   * two.
+   */
+  RowLocator(
+      LargeNum const & keyShare,
+      std::vector<size_t> const & rowIds,
+      LargeNum const & keyBound,
+      ff::mpc::CompareInfo<Identity, LargeNum, SmallNum> const * const
+          compareInfo,
+      CompareDispenser & compareDispenser,
+      TypeCastFromBitDispenser & typeCastFromBitDispenser,
+      BeaverDispenser & beaverDispenser,
+      LargeNum const & modulus,
+      Identity const & revealer);
+
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+  /** Share of the row index, once complete. */
+  LargeNum output = 0;
+
+private:
+  LargeNum const keyShare;
+  ff::mpc::CompareInfo<Identity, LargeNum, SmallNum> const * const
+      compareInfo;
+  LargeNum const modulus;
+  Identity const revealer;
+
+  /* The row ids but the last, padded by the key bound. */
+  std::vector<LargeNum> thresholds;
+  size_t const levels;
+
+  std::unique_ptr<CompareDispenser> compareDispenser;
+  std::unique_ptr<TypeCastFromBitDispenser> typeCastFromBitDispenser;
+  std::unique_ptr<BeaverDispenser> beaverDispenser;
+
+  enum RowLocatorState {
+    awaitingCompare,
+    awaitingTypeCastFromBit,
+    awaitingMultiply
+  };
+  RowLocatorState state = awaitingCompare;
+
+  /**
+   * The level being searched, and a one-hot share of the bits found
+   * so far, indexed by their value.
+   */
+  size_t level = 0;
+  std::vector<LargeNum> prefix;
+  LargeNum bit = 0;
+
+  void invokeCompare();
+  void extendPrefix(std::vector<LargeNum> const & products);
+};
+
+} // namespace dataowner
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_DATAOWNER_ROW_LOCATOR_H_
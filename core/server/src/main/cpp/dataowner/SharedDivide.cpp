@@ -0,0 +1,211 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+/* 3rd Party Headers */
+
+/* SAFRN Headers */
+#include <dataowner/SharedDivide.h>
+#include <util/LargeNumArray.h>
+#include <util/ModColumns.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+size_t const SharedDivideInfo::STATISTICAL_BITS;
+
+SharedDivideInfo::SharedDivideInfo(
+    Identity const * const revealer,
+    LargeNum const & modulus,
+    size_t const numeratorBits,
+    ff::mpc::DivideInfo<safrn::Identity, LargeNum, SmallNum> const *
+        const divideInfo) :
+    revealer(revealer),
+    modulus(modulus),
+    numeratorBits(numeratorBits),
+    divideInfo(divideInfo),
+    truncationInfo(
+        numeratorBits,
+        2 * numeratorBits + STATISTICAL_BITS,
+        modulus) {
+  log_assert(
+      modulus > (LargeNum(1) << modulusBits(this->numeratorBits)));
+}
+
+SharedDivide::SharedDivide(
+    std::vector<LargeNum> && numerators,
+    LargeNum const & denominator,
+    SharedDivideInfo const * const info,
+    ff::mpc::DivideRandomness<LargeNum, SmallNum> && divideRandomness,
+    BeaverDispenser & beaverDispenser,
+    TruncationDispenser & truncationDispenser) :
+    info(info),
+    numerators(std::move(numerators)),
+    denominator(denominator),
+    divideRandomness(std::move(divideRandomness)) {
+  size_t const n = this->numerators.size();
+  this->beaverDispenser = beaverDispenser.littleDispenser(n);
+  this->masks.resize(n);
+  this->shiftedMasks.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    dealer::TruncationPair<LargeNum> pair = truncationDispenser.get();
+    this->masks[i] = std::move(pair.r_);
+    this->shiftedMasks[i] = std::move(pair.shifted_);
+  }
+  this->opened.resize(n, LargeNum(0));
+}
+
+void SharedDivide::init() {
+  if (this->numerators.empty()) {
+    this->complete();
+    return;
+  }
+
+  this->getPeers().forEach([this](Identity const & other) {
+    if (other != this->getSelf()) {
+      this->numPeersAwaiting++;
+    }
+  });
+
+  /* Only the revealer holds a share of the constant 2^k. */
+  LargeNum const scale = *this->info->revealer == this->getSelf() ?
+      LargeNum(1) << this->info->numeratorBits :
+      LargeNum(0);
+  std::unique_ptr<Fronctocol> divide(
+      new ff::mpc::Divide<SAFRN_TYPES, LargeNum, SmallNum>(
+          scale,
+          this->denominator,
+          &this->reciprocal,
+          this->info->divideInfo,
+          std::move(this->divideRandomness)));
+  this->invoke(std::move(divide), this->getPeers());
+  this->state = awaitingReciprocal;
+}
+
+void SharedDivide::handleReceive(IncomingMessage & imsg) {
+  size_t const n = this->opened.size();
+  size_t const width = fixedWidthBytes(this->info->modulus);
+  std::vector<LargeNum> opened_products(n);
+
+  if (!readLargeNumArray(imsg, opened_products.data(), n, width)) {
+    log_error("SharedDivide could not read opened products");
+    this->abort();
+    return;
+  }
+
+  modAddColumn(
+      this->opened.data(),
+      opened_products.data(),
+      this->opened.data(),
+      n,
+      this->info->modulus);
+
+  this->numPeersAwaiting--;
+  if (this->numPeersAwaiting == 0 && this->state == awaitingOpenings) {
+    this->finish();
+  }
+}
+
+void SharedDivide::handleComplete(Fronctocol & f) {
+  switch (this->state) {
+    case awaitingReciprocal: {
+      log_debug("awaitingReciprocal");
+      size_t const n = this->numerators.size();
+      std::unique_ptr<Fronctocol> multiply(new VectorMultiply(
+          std::move(this->numerators),
+          std::vector<LargeNum>(n, this->reciprocal),
+          *this->beaverDispenser,
+          this->info->modulus,
+          *this->info->revealer));
+      this->invoke(std::move(multiply), this->getPeers());
+      this->state = awaitingProducts;
+    } break;
+    case awaitingProducts: {
+      log_debug("awaitingProducts");
+      std::vector<LargeNum> & products =
+          static_cast<VectorMultiply &>(f).outputs;
+      size_t const n = products.size();
+
+      /* Open each product under its mask, adding in our own share. */
+      modAddColumn(
+          products.data(),
+          this->masks.data(),
+          products.data(),
+          n,
+          this->info->modulus);
+      size_t const width = fixedWidthBytes(this->info->modulus);
+      this->getPeers().forEach([&, this](Identity const & other) {
+        if (other == this->getSelf()) {
+          return;
+        }
+        std::unique_ptr<OutgoingMessage> omsg(
+            new OutgoingMessage(other));
+        writeLargeNumArray(*omsg, products.data(), n, width);
+        this->send(std::move(omsg));
+      });
+      modAddColumn(
+          this->opened.data(),
+          products.data(),
+          this->opened.data(),
+          n,
+          this->info->modulus);
+
+      this->state = awaitingOpenings;
+      if (this->numPeersAwaiting == 0) {
+        this->finish();
+      }
+    } break;
+    default:
+      log_error("SharedDivide state machine in unexpected state");
+      this->abort();
+  }
+}
+
+void SharedDivide::handlePromise(Fronctocol &) {
+  log_error("Unexpected handlePromise in SharedDivide");
+  this->abort();
+}
+
+std::string SharedDivide::name() {
+  return std::string("Shared Divide");
+}
+
+void SharedDivide::finish() {
+  size_t const n = this->opened.size();
+
+  /**
+   * The opened values did not wrap, so (x + r) >> k less r >> k is
+   * x >> k, or one more.
+   */
+  if (*this->info->revealer == this->getSelf()) {
+    for (size_t i = 0; i < n; i++) {
+      this->opened[i] >>= this->info->numeratorBits;
+    }
+  } else {
+    std::fill(this->opened.begin(), this->opened.end(), LargeNum(0));
+  }
+  modSubColumn(
+      this->opened.data(),
+      this->shiftedMasks.data(),
+      this->opened.data(),
+      n,
+      this->info->modulus);
+
+  this->outputs = std::move(this->opened);
+  this->masks.clear();
+  this->shiftedMasks.clear();
+  this->complete();
+}
+
+} // namespace dataowner
+} // namespace safrn
@@ -0,0 +1,149 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_DATAOWNER_SHARED_DIVIDE_H_
+#define SAFRN_DATAOWNER_SHARED_DIVIDE_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* Fortissimo Headers */
+#include <ff/Fronctocol.h>
+#include <ff/Message.h>
+
+#include <mpc/Divide.h>
+#include <mpc/Randomness.h>
+#include <mpc/RandomnessDealer.h>
+
+#include <dataowner/VectorMultiply.h>
+#include <dataowner/fortissimo.h>
+#include <dealer/TruncationPair.h>
+#include <framework/Framework.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+struct SharedDivideInfo {
+  /** Bits of slack by which the opened products are masked. */
+  static size_t const STATISTICAL_BITS = 40;
+
+  /**
+   * Numerators must be below 2^numeratorBits, and the modulus must be
+   * at least modulusBits(numeratorBits) wide.
+   */
+  SharedDivideInfo(
+      Identity const * const revealer,
+      LargeNum const & modulus,
+      size_t const numeratorBits,
+      ff::mpc::DivideInfo<safrn::Identity, LargeNum, SmallNum> const *
+          const divideInfo);
+
+  /**
+   * Width of the smallest modulus in which numerators of numeratorBits
+   * times the reciprocal, plus a mask, never wrap.
+   */
+  static size_t modulusBits(size_t const numeratorBits) {
+    return 2 * numeratorBits + STATISTICAL_BITS + 1;
+  }
+
+  Identity const * revealer;
+  LargeNum modulus;
+  size_t numeratorBits;
+  ff::mpc::DivideInfo<safrn::Identity, LargeNum, SmallNum> const *
+      divideInfo;
+
+  /** Randomness for the final shift, one pair per numerator. */
+  dealer::TruncationPairInfo<LargeNum, LargeNum> truncationInfo;
+};
+
+/**
+ * Divides a vector of shared numerators by one shared denominator, as
+ * a Batch of ff::mpc::Divide would, but with a single Divide.
+ *
+ * That Divide finds the reciprocal R = 2^k / d, for k the numerators'
+ * width. Each numerator is then multiplied by R, by a VectorMultiply,
+ * and the products are shifted right by k, by opening them under the
+ * masks of TruncationPairs. A batch of n quotients so costs one Divide
+ * plus n Beaver triples and n truncation pairs, where it cost n Divides
+ * and their comparisons. The quotients are within one of the Divides'.
+ */
+class SharedDivide : public Fronctocol {
+public:
+  using BeaverDispenser = ff::mpc::RandomnessDispenser<
+      ff::mpc::BeaverTriple<LargeNum>,
+      ff::mpc::BeaverInfo<LargeNum>>;
+  using TruncationDispenser = ff::mpc::RandomnessDispenser<
+      dealer::TruncationPair<LargeNum>,
+      dealer::TruncationPairInfo<LargeNum, LargeNum>>;
+
+  /**
+   * Draws numerators.size() Beaver triples and truncation pairs from
+   * the dispensers up front.
+   */
+  SharedDivide(
+      std::vector<LargeNum> && numerators,
+      LargeNum const & denominator,
+      SharedDivideInfo const * const info,
+      ff::mpc::DivideRandomness<LargeNum, SmallNum> && divideRandomness,
+      BeaverDispenser & beaverDispenser,
+      TruncationDispenser & truncationDispenser);
+
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+  /** Shares of numerators[i] / denominator, once complete. */
+  std::vector<LargeNum> outputs;
+
+private:
+  SharedDivideInfo const * const info;
+  std::vector<LargeNum> numerators;
+  LargeNum const denominator;
+  ff::mpc::DivideRandomness<LargeNum, SmallNum> divideRandomness;
+  std::unique_ptr<BeaverDispenser> beaverDispenser;
+
+  /* Shares of each mask r, and of r shifted right by k. */
+  std::vector<LargeNum> masks;
+  std::vector<LargeNum> shiftedMasks;
+
+  /** Shares of 2^k / denominator, from the Divide. */
+  LargeNum reciprocal = 0;
+
+  enum SharedDivideState {
+    awaitingReciprocal,
+    awaitingProducts,
+    awaitingOpenings
+  };
+  SharedDivideState state = awaitingReciprocal;
+
+  /**
+   * Sum of the masked products opened so far. Peers may open theirs
+   * before this party's products are ready, so they are summed as they
+   * arrive.
+   */
+  std::vector<LargeNum> opened;
+  size_t numPeersAwaiting = 0;
+
+  void finish();
+};
+
+} // namespace dataowner
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_DATAOWNER_SHARED_DIVIDE_H_
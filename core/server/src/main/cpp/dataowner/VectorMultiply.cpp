@@ -0,0 +1,183 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <memory>
+#include <utility>
+
+/* 3rd Party Headers */
+
+/* SAFRN Headers */
+#include <dataowner/VectorMultiply.h>
+#include <util/LargeNumArray.h>
+#include <util/ModColumns.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+VectorMultiply::VectorMultiply(
+    std::vector<LargeNum> && xs,
+    std::vector<LargeNum> && ys,
+    ff::mpc::RandomnessDispenser<
+        ff::mpc::BeaverTriple<LargeNum>,
+        ff::mpc::BeaverInfo<LargeNum>> & beaverDispenser,
+    LargeNum const & modulus,
+    Identity const & revealer) :
+    modulus(modulus),
+    revealer(revealer),
+    openedX(std::move(xs)),
+    openedY(std::move(ys)) {
+  log_assert(this->openedX.size() == this->openedY.size());
+  size_t const n = this->openedX.size();
+  this->tripleA.resize(n);
+  this->tripleB.resize(n);
+  this->tripleC.resize(n);
+  for (size_t i = 0; i < n; i++) {
+    ff::mpc::BeaverTriple<LargeNum> triple = beaverDispenser.get();
+    this->tripleA[i] = std::move(triple.a);
+    this->tripleB[i] = std::move(triple.b);
+    this->tripleC[i] = std::move(triple.c);
+    this->openedX[i] %= this->modulus;
+    this->openedY[i] %= this->modulus;
+  }
+}
+
+void VectorMultiply::init() {
+  size_t const n = this->openedX.size();
+  modSubColumn(
+      this->openedX.data(),
+      this->tripleA.data(),
+      this->openedX.data(),
+      n,
+      this->modulus);
+  modSubColumn(
+      this->openedY.data(),
+      this->tripleB.data(),
+      this->openedY.data(),
+      n,
+      this->modulus);
+
+  size_t const width = fixedWidthBytes(this->modulus);
+  this->getPeers().forEach([&, this](Identity const & other) {
+    if (other == this->getSelf()) {
+      return;
+    }
+    std::unique_ptr<OutgoingMessage> omsg(new OutgoingMessage(other));
+    writeLargeNumArray(*omsg, this->openedX.data(), n, width);
+    writeLargeNumArray(*omsg, this->openedY.data(), n, width);
+    this->send(std::move(omsg));
+    this->numPeersAwaiting++;
+  });
+
+  if (this->numPeersAwaiting == 0) {
+    this->finish();
+  }
+}
+
+void VectorMultiply::handleReceive(IncomingMessage & imsg) {
+  size_t const n = this->openedX.size();
+  size_t const width = fixedWidthBytes(this->modulus);
+  std::vector<LargeNum> opened_x(n);
+  std::vector<LargeNum> opened_y(n);
+
+  bool success = readLargeNumArray(imsg, opened_x.data(), n, width);
+  success =
+      success && readLargeNumArray(imsg, opened_y.data(), n, width);
+  if (!success) {
+    log_error("VectorMultiply could not read opened shares");
+    this->abort();
+    return;
+  }
+
+  modAddColumn(
+      this->openedX.data(),
+      opened_x.data(),
+      this->openedX.data(),
+      n,
+      this->modulus);
+  modAddColumn(
+      this->openedY.data(),
+      opened_y.data(),
+      this->openedY.data(),
+      n,
+      this->modulus);
+
+  this->numPeersAwaiting--;
+  if (this->numPeersAwaiting == 0) {
+    this->finish();
+  }
+}
+
+void VectorMultiply::handleComplete(Fronctocol &) {
+  log_error("Unexpected handleComplete in VectorMultiply");
+  this->abort();
+}
+
+void VectorMultiply::handlePromise(Fronctocol &) {
+  log_error("Unexpected handlePromise in VectorMultiply");
+  this->abort();
+}
+
+std::string VectorMultiply::name() {
+  return std::string("Vector Multiply");
+}
+
+void VectorMultiply::finish() {
+  size_t const n = this->openedX.size();
+
+  /* xy = c + (x - a) * b + (y - b) * a, plus (x - a) * (y - b) once. */
+  modMulColumn(
+      this->openedX.data(),
+      this->tripleB.data(),
+      this->tripleB.data(),
+      n,
+      this->modulus);
+  modAddColumn(
+      this->tripleC.data(),
+      this->tripleB.data(),
+      this->tripleC.data(),
+      n,
+      this->modulus);
+  modMulColumn(
+      this->openedY.data(),
+      this->tripleA.data(),
+      this->tripleA.data(),
+      n,
+      this->modulus);
+  modAddColumn(
+      this->tripleC.data(),
+      this->tripleA.data(),
+      this->tripleC.data(),
+      n,
+      this->modulus);
+  if (this->revealer == this->getSelf()) {
+    modMulColumn(
+        this->openedX.data(),
+        this->openedY.data(),
+        this->openedX.data(),
+        n,
+        this->modulus);
+    modAddColumn(
+        this->tripleC.data(),
+        this->openedX.data(),
+        this->tripleC.data(),
+        n,
+        this->modulus);
+  }
+
+  this->outputs = std::move(this->tripleC);
+  this->tripleA.clear();
+  this->tripleB.clear();
+  this->openedX.clear();
+  this->openedY.clear();
+  this->complete();
+}
+
+} // namespace dataowner
+} // namespace safrn
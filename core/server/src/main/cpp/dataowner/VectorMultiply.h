@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_DATAOWNER_VECTOR_MULTIPLY_H_
+#define SAFRN_DATAOWNER_VECTOR_MULTIPLY_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* Fortissimo Headers */
+#include <ff/Fronctocol.h>
+#include <ff/Message.h>
+
+#include <mpc/Multiply.h>
+#include <mpc/Randomness.h>
+#include <mpc/RandomnessDealer.h>
+
+#include <dataowner/fortissimo.h>
+#include <framework/Framework.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dataowner {
+
+/**
+ * Multiplies two vectors of arithmetic shares element-wise, as a
+ * Batch of ff::mpc::Multiply would, with one Beaver triple each.
+ *
+ * All of the masked operands are opened together, in a single message
+ * to each peer, and the products are finished column-wise, so the cost
+ * per element is a few modular operations rather than a fronctocol.
+ */
+class VectorMultiply : public Fronctocol {
+public:
+  /**
+   * Draws xs.size() triples from the dispenser up front. Shares need
+   * not be reduced modulo the modulus.
+   */
+  VectorMultiply(
+      std::vector<LargeNum> && xs,
+      std::vector<LargeNum> && ys,
+      ff::mpc::RandomnessDispenser<
+          ff::mpc::BeaverTriple<LargeNum>,
+          ff::mpc::BeaverInfo<LargeNum>> & beaverDispenser,
+      LargeNum const & modulus,
+      Identity const & revealer);
+
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+  /** Shares of xs[i] * ys[i], once complete. */
+  std::vector<LargeNum> outputs;
+
+private:
+  LargeNum const modulus;
+  Identity const revealer;
+
+  /* Beaver triples, then opened x - a and y - b. */
+  std::vector<LargeNum> tripleA;
+  std::vector<LargeNum> tripleB;
+  std::vector<LargeNum> tripleC;
+  std::vector<LargeNum> openedX;
+  std::vector<LargeNum> openedY;
+
+  size_t numPeersAwaiting = 0;
+
+  void finish();
+};
+
+} // namespace dataowner
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_DATAOWNER_VECTOR_MULTIPLY_H_
@@ -13,7 +13,6 @@
 #include <Identity.h>
 #include <PeerSet.h>
 #include <mpc/ModConvUp.h>
-#include <mpc/SISOSort.h>
 
 namespace safrn {
 namespace dataowner {
@@ -27,7 +26,6 @@ template<typename Info_T>
 using MultiplyInfo = ff::mpc::MultiplyInfo<safrn::Identity, Info_T>;
 template<typename Number_T>
 using BeaverInfo = ff::mpc::BeaverInfo<Number_T>;
-using SISOSort = ff::mpc::SISOSort<SAFRN_TYPES, LargeNum, SmallNum>;
 
 template<
     typename SmallNumber_T,
@@ -14,15 +14,18 @@ LookupRandomnessHouse::LookupRandomnessHouse(
     ff::mpc::CompareInfo<
         safrn::Identity,
         dataowner::LargeNum,
-        dataowner::SmallNum> const * const compareInfo) :
-    info(info), compareInfo(compareInfo) {
+        dataowner::SmallNum> const * const compareInfo,
+    bool const liveTableLookup) :
+    info(info),
+    compareInfo(compareInfo),
+    liveTableLookup(liveTableLookup) {
   log_debug("LookupRandomnessHouse constructor");
 }
 
 void LookupRandomnessHouse::init() {
   log_debug("LookupRandomnessHouse init");
   this->numDealersRemaining =
-      3; // counting only dealers for the whole party; we handle the pairwise dealer counts separately
+      2; // counting only dealers for the whole party; we handle the pairwise dealer counts separately
 
   std::unique_ptr<Fronctocol> rd1(
       new ff::mpc::CompareRandomnessHouse<
@@ -38,11 +41,13 @@ void LookupRandomnessHouse::init() {
           ff::mpc::TypeCastFromBitInfo<dataowner::LargeNum>>());
   this->invoke(std::move(rd2), this->getPeers());
 
-  std::unique_ptr<Fronctocol> rd3(new ff::mpc::RandomnessHouse<
-                                  SAFRN_TYPES,
-                                  dealer::RandomTableLookup,
-                                  dealer::RandomTableLookupInfo>());
-  this->invoke(std::move(rd3), this->getPeers());
+  if (this->liveTableLookup) {
+    std::unique_ptr<Fronctocol> rd3(new SeededRandomnessHouse<
+        dealer::RandomTableLookup,
+        dealer::RandomTableLookupInfo>());
+    this->invoke(std::move(rd3), this->getPeers());
+    this->numDealersRemaining++;
+  }
 }
 
 void LookupRandomnessHouse::handleReceive(IncomingMessage &) {
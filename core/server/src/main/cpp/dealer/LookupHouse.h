@@ -33,6 +33,7 @@
 
 #include <dataowner/fortissimo.h>
 #include <framework/Framework.h>
+#include <util/RandomnessDealer.h>
 
 /* logging configuration */
 #include <ff/logging.h>
@@ -50,13 +51,18 @@ public:
 
   /** we only pass in the identity of the revealer because it's needed in the
     * constructor for CompareInfo, the House object doesn't actually need it
+    *
+    * liveTableLookup is false when the dataowners are using stored
+    * table lookup randomness, in which case no RandomTableLookup house
+    * is invoked.
     */
   LookupRandomnessHouse(
       RandomTableLookupInfo const * const info,
       ff::mpc::CompareInfo<
           safrn::Identity,
           dataowner::LargeNum,
-          dataowner::SmallNum> const * const compareInfo);
+          dataowner::SmallNum> const * const compareInfo,
+      bool const liveTableLookup = true);
 
 private:
   RandomTableLookupInfo const * const info;
@@ -64,6 +70,7 @@ private:
       safrn::Identity,
       dataowner::LargeNum,
       dataowner::SmallNum> const * const compareInfo;
+  bool const liveTableLookup;
 
   size_t numDealersRemaining = 0;
 };
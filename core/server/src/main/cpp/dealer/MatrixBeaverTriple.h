@@ -0,0 +1,255 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_MATRIX_BEAVER_TRIPLE_H_
+#define SAFRN_MATRIX_BEAVER_TRIPLE_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* Fortissimo Headers */
+#include <mpc/MatrixMult.h> // For Matrix.
+#include <mpc/Randomness.h>
+
+#include <mpc/templates.h>
+
+/* Safrn Headers */
+#include <util/SeedPrg.h>
+
+/* Logging config */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dealer {
+
+template<typename Value_T, typename MatrixValue_T>
+struct MatrixBeaverTripleInfo;
+
+/**
+ * A Beaver triple of matrices, shares of random U (rows x inner) and
+ * V (inner x cols) and of their product W = UV. One of these masks an
+ * entire matrix product, where scalar triples would need one per term
+ * of the product, rows * inner * cols of them.
+ */
+template<typename Value_T>
+struct MatrixBeaverTriple {
+public:
+  MatrixBeaverTriple(
+      const size_t rows, const size_t inner, const size_t cols) :
+      u_(rows, inner), v_(inner, cols), w_(rows, cols) {
+    rows_ = rows;
+    inner_ = inner;
+    cols_ = cols;
+  }
+
+  MatrixBeaverTriple(MatrixBeaverTriple const &) = default;
+  MatrixBeaverTriple & operator=(MatrixBeaverTriple const &) = default;
+
+  template<typename InfoValue_T>
+  MatrixBeaverTriple(
+      MatrixBeaverTripleInfo<InfoValue_T, Value_T> const & info);
+
+  ff::mpc::Matrix<Value_T> u_;
+  ff::mpc::Matrix<Value_T> v_;
+  ff::mpc::Matrix<Value_T> w_;
+  size_t rows_;
+  size_t inner_;
+  size_t cols_;
+
+  static std::string name() {
+    return std::string("Matrix Beaver Triple");
+  }
+};
+
+template<typename Value_T, typename MatrixValue_T>
+struct MatrixBeaverTripleInfo {
+public:
+  MatrixBeaverTripleInfo(
+      const size_t rows,
+      const size_t inner,
+      const size_t cols,
+      const Value_T & field_characteristic) {
+    rows_ = rows;
+    inner_ = inner;
+    cols_ = cols;
+    field_characteristic_ = field_characteristic;
+  }
+
+  MatrixBeaverTripleInfo() = default;
+
+  size_t instanceSize() const {
+    return (
+        3 * sizeof(uint64_t) + // For rows_, inner_ and cols_
+        sizeof(MatrixValue_T) *
+            (rows_ * inner_ + inner_ * cols_ + rows_ * cols_));
+  }
+
+  void generate(
+      size_t n_parties,
+      size_t,
+      std::vector<MatrixBeaverTriple<MatrixValue_T>> & vals) const;
+
+  /**
+   * Seeded generation (see SeededRandomnessHouse), as for
+   * RandomSquareMatrixInfo.
+   */
+  void expandShare(
+      SeedPrg & prg, MatrixBeaverTriple<MatrixValue_T> & share) const;
+  void generateCorrection(
+      std::vector<MatrixBeaverTriple<MatrixValue_T>> & vals) const;
+
+  bool operator==(MatrixBeaverTripleInfo const & other) const {
+    return (this->rows_ == other.rows_) &&
+        (this->inner_ == other.inner_) &&
+        (this->cols_ == other.cols_) &&
+        (this->field_characteristic_ == other.field_characteristic_);
+  }
+  bool operator!=(MatrixBeaverTripleInfo const & other) const {
+    return !(*this == other);
+  }
+
+  size_t rows_ = 0;
+  size_t inner_ = 0;
+  size_t cols_ = 0;
+  Value_T field_characteristic_ = 0;
+};
+
+/**
+ * Adds the product of a (rows x inner) and b (inner x cols) into out
+ * (rows x cols), modulo p. All entries must already be reduced.
+ */
+template<typename Value_T>
+void modMatrixProductAdd(
+    ff::mpc::Matrix<Value_T> const & a,
+    ff::mpc::Matrix<Value_T> const & b,
+    ff::mpc::Matrix<Value_T> & out,
+    size_t const rows,
+    size_t const inner,
+    size_t const cols,
+    Value_T const & p);
+
+} // namespace dealer
+} // namespace safrn
+
+namespace ff {
+// ==================== Helper functions: msg_read and msg_write ===============
+// Code below instantiates msg_read/write for template type MatrixBeaverTriple[Info].
+template<typename Identity_T, typename Value_T, typename MatrixValue_T>
+bool msg_read(
+    ff::IncomingMessage<Identity_T> & msg,
+    safrn::dealer::MatrixBeaverTripleInfo<Value_T, MatrixValue_T> &
+        input) {
+  uint64_t local_rows = 0;
+  uint64_t local_inner = 0;
+  uint64_t local_cols = 0;
+  bool success = msg.template read<uint64_t>(local_rows);
+  success = success && msg.template read<uint64_t>(local_inner);
+  success = success && msg.template read<uint64_t>(local_cols);
+  input.rows_ = (size_t)local_rows;
+  input.inner_ = (size_t)local_inner;
+  input.cols_ = (size_t)local_cols;
+  success = success &&
+      msg.template read<Value_T>(input.field_characteristic_);
+
+  return success;
+}
+
+template<typename Identity_T, typename Value_T, typename MatrixValue_T>
+bool msg_write(
+    ff::OutgoingMessage<Identity_T> & msg,
+    safrn::dealer::
+        MatrixBeaverTripleInfo<Value_T, MatrixValue_T> const & input) {
+  bool success = msg.template write<uint64_t>((uint64_t)input.rows_);
+  success =
+      success && msg.template write<uint64_t>((uint64_t)input.inner_);
+  success =
+      success && msg.template write<uint64_t>((uint64_t)input.cols_);
+  success = success &&
+      msg.template write<Value_T>(input.field_characteristic_);
+  return success;
+}
+
+template<typename Identity_T, typename Value_T>
+bool msg_read(
+    ff::IncomingMessage<Identity_T> & msg,
+    safrn::dealer::MatrixBeaverTriple<Value_T> & input) {
+  uint64_t local_rows = 0;
+  uint64_t local_inner = 0;
+  uint64_t local_cols = 0;
+  bool success = msg.template read<uint64_t>(local_rows);
+  success = success && msg.template read<uint64_t>(local_inner);
+  success = success && msg.template read<uint64_t>(local_cols);
+  if (!success || local_rows != input.rows_ ||
+      local_inner != input.inner_ || local_cols != input.cols_) {
+    return false;
+  }
+
+  for (size_t row = 0; row < input.rows_; ++row) {
+    for (size_t col = 0; col < input.inner_; ++col) {
+      success =
+          success && msg.template read<Value_T>(input.u_.at(row, col));
+    }
+  }
+  for (size_t row = 0; row < input.inner_; ++row) {
+    for (size_t col = 0; col < input.cols_; ++col) {
+      success =
+          success && msg.template read<Value_T>(input.v_.at(row, col));
+    }
+  }
+  for (size_t row = 0; row < input.rows_; ++row) {
+    for (size_t col = 0; col < input.cols_; ++col) {
+      success =
+          success && msg.template read<Value_T>(input.w_.at(row, col));
+    }
+  }
+
+  return success;
+}
+
+template<typename Identity_T, typename Value_T>
+bool msg_write(
+    ff::OutgoingMessage<Identity_T> & msg,
+    safrn::dealer::MatrixBeaverTriple<Value_T> const & input) {
+  bool success = msg.template write<uint64_t>((uint64_t)input.rows_);
+  success =
+      success && msg.template write<uint64_t>((uint64_t)input.inner_);
+  success =
+      success && msg.template write<uint64_t>((uint64_t)input.cols_);
+
+  for (size_t row = 0; row < input.rows_; ++row) {
+    for (size_t col = 0; col < input.inner_; ++col) {
+      success =
+          success && msg.template write<Value_T>(input.u_.at(row, col));
+    }
+  }
+  for (size_t row = 0; row < input.inner_; ++row) {
+    for (size_t col = 0; col < input.cols_; ++col) {
+      success =
+          success && msg.template write<Value_T>(input.v_.at(row, col));
+    }
+  }
+  for (size_t row = 0; row < input.rows_; ++row) {
+    for (size_t col = 0; col < input.cols_; ++col) {
+      success =
+          success && msg.template write<Value_T>(input.w_.at(row, col));
+    }
+  }
+
+  return success;
+}
+
+} // namespace ff
+
+#include <dealer/MatrixBeaverTriple.t.h>
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif
@@ -0,0 +1,137 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+namespace safrn {
+namespace dealer {
+
+template<typename Value_T>
+template<typename InfoValue_T>
+MatrixBeaverTriple<Value_T>::MatrixBeaverTriple(
+    MatrixBeaverTripleInfo<InfoValue_T, Value_T> const & info) :
+    MatrixBeaverTriple(info.rows_, info.inner_, info.cols_) {
+}
+
+template<typename Value_T, typename MatrixValue_T>
+void MatrixBeaverTripleInfo<Value_T, MatrixValue_T>::generate(
+    size_t n_parties,
+    size_t,
+    std::vector<MatrixBeaverTriple<MatrixValue_T>> & vals) const {
+  vals.clear();
+  vals.reserve(n_parties);
+  for (size_t i = 0; i < n_parties; i++) {
+    vals.emplace_back(MatrixBeaverTriple<MatrixValue_T>(
+        this->rows_, this->inner_, this->cols_));
+  }
+
+  for (size_t i = 1; i < n_parties; i++) {
+    SeedPrg prg(SeedPrg::newSeed());
+    this->expandShare(prg, vals[i]);
+  }
+  this->generateCorrection(vals);
+}
+
+template<typename Value_T, typename MatrixValue_T>
+void MatrixBeaverTripleInfo<Value_T, MatrixValue_T>::expandShare(
+    SeedPrg & prg, MatrixBeaverTriple<MatrixValue_T> & share) const {
+  for (size_t row = 0; row < this->rows_; ++row) {
+    for (size_t col = 0; col < this->inner_; ++col) {
+      share.u_.at(row, col) =
+          prg.randomModP<MatrixValue_T>(this->field_characteristic_);
+    }
+  }
+  for (size_t row = 0; row < this->inner_; ++row) {
+    for (size_t col = 0; col < this->cols_; ++col) {
+      share.v_.at(row, col) =
+          prg.randomModP<MatrixValue_T>(this->field_characteristic_);
+    }
+  }
+  for (size_t row = 0; row < this->rows_; ++row) {
+    for (size_t col = 0; col < this->cols_; ++col) {
+      share.w_.at(row, col) =
+          prg.randomModP<MatrixValue_T>(this->field_characteristic_);
+    }
+  }
+}
+
+template<typename Value_T>
+void subtractMatrixShare(
+    ff::mpc::Matrix<Value_T> & orig,
+    ff::mpc::Matrix<Value_T> const & share,
+    size_t const rows,
+    size_t const cols,
+    Value_T const & p) {
+  for (size_t row = 0; row < rows; ++row) {
+    for (size_t col = 0; col < cols; ++col) {
+      orig.at(row, col) =
+          (orig.at(row, col) + (p - share.at(row, col))) % p;
+    }
+  }
+}
+
+template<typename Value_T, typename MatrixValue_T>
+void MatrixBeaverTripleInfo<Value_T, MatrixValue_T>::generateCorrection(
+    std::vector<MatrixBeaverTriple<MatrixValue_T>> & vals) const {
+  MatrixValue_T const p = this->field_characteristic_;
+
+  /* Step 1. Randomly create the "original" U and V. */
+  MatrixBeaverTriple<MatrixValue_T> & orig = vals[0];
+  for (size_t row = 0; row < this->rows_; ++row) {
+    for (size_t col = 0; col < this->inner_; ++col) {
+      orig.u_.at(row, col) = ff::mpc::randomModP<MatrixValue_T>(p);
+    }
+  }
+  for (size_t row = 0; row < this->inner_; ++row) {
+    for (size_t col = 0; col < this->cols_; ++col) {
+      orig.v_.at(row, col) = ff::mpc::randomModP<MatrixValue_T>(p);
+    }
+  }
+
+  /* Step 2. compute W = UV. */
+  for (size_t row = 0; row < this->rows_; ++row) {
+    for (size_t col = 0; col < this->cols_; ++col) {
+      orig.w_.at(row, col) = 0;
+    }
+  }
+  modMatrixProductAdd(
+      orig.u_,
+      orig.v_,
+      orig.w_,
+      this->rows_,
+      this->inner_,
+      this->cols_,
+      p);
+
+  /* Step 3. subtract away the other parties' shares. */
+  for (size_t i = 1; i < vals.size(); i++) {
+    subtractMatrixShare(
+        orig.u_, vals[i].u_, this->rows_, this->inner_, p);
+    subtractMatrixShare(
+        orig.v_, vals[i].v_, this->inner_, this->cols_, p);
+    subtractMatrixShare(
+        orig.w_, vals[i].w_, this->rows_, this->cols_, p);
+  }
+}
+
+template<typename Value_T>
+void modMatrixProductAdd(
+    ff::mpc::Matrix<Value_T> const & a,
+    ff::mpc::Matrix<Value_T> const & b,
+    ff::mpc::Matrix<Value_T> & out,
+    size_t const rows,
+    size_t const inner,
+    size_t const cols,
+    Value_T const & p) {
+  for (size_t row = 0; row < rows; ++row) {
+    for (size_t k = 0; k < inner; ++k) {
+      Value_T const & a_rk = a.at(row, k);
+      for (size_t col = 0; col < cols; ++col) {
+        out.at(row, col) =
+            (out.at(row, col) + (a_rk * b.at(k, col)) % p) % p;
+      }
+    }
+  }
+}
+
+} // namespace dealer
+} // namespace safrn
@@ -0,0 +1,74 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#include <dealer/MergeHouse.h>
+
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dealer {
+
+MergeRandomnessHouse::MergeRandomnessHouse(
+    dataowner::LargeNum const & keyModulus,
+    Identity const * const revealer) :
+    compareInfo(keyModulus, revealer) {
+}
+
+void MergeRandomnessHouse::init() {
+  log_debug("MergeRandomnessHouse init");
+  this->numDealersRemaining = 5;
+
+  std::unique_ptr<Fronctocol> compareHouse(
+      new ff::mpc::CompareRandomnessHouse<
+          SAFRN_TYPES,
+          dataowner::LargeNum,
+          dataowner::SmallNum>(&this->compareInfo));
+  this->invoke(std::move(compareHouse), this->getPeers());
+
+  /* One cast to the key modulus, one to the payload modulus. */
+  for (size_t i = 0; i < 2; i++) {
+    std::unique_ptr<Fronctocol> typeCastHouse(
+        new ff::mpc::RandomnessHouse<
+            SAFRN_TYPES,
+            ff::mpc::TypeCastTriple<dataowner::LargeNum>,
+            ff::mpc::TypeCastFromBitInfo<dataowner::LargeNum>>());
+    this->invoke(std::move(typeCastHouse), this->getPeers());
+  }
+
+  /* Swaps of the key columns, then of the payload columns. */
+  for (size_t i = 0; i < 2; i++) {
+    std::unique_ptr<Fronctocol> beaverHouse(
+        new ff::mpc::RandomnessHouse<
+            SAFRN_TYPES,
+            ff::mpc::BeaverTriple<dataowner::LargeNum>,
+            ff::mpc::BeaverInfo<dataowner::LargeNum>>());
+    this->invoke(std::move(beaverHouse), this->getPeers());
+  }
+}
+
+void MergeRandomnessHouse::handleReceive(IncomingMessage &) {
+  log_error("MergeRandomnessHouse received unexpected "
+            "handle receive");
+}
+
+void MergeRandomnessHouse::handleComplete(Fronctocol &) {
+  log_debug("MergeRandomnessHouse handleComplete");
+  this->numDealersRemaining--;
+  if (this->numDealersRemaining == 0) {
+    log_debug("Dealer done");
+    this->complete();
+  }
+}
+
+void MergeRandomnessHouse::handlePromise(Fronctocol &) {
+  log_error("MergeRandomnessHouse received unexpected "
+            "handle promise");
+}
+
+std::string MergeRandomnessHouse::name() {
+  return std::string("Merge Randomness House");
+}
+
+} // namespace dealer
+} // namespace safrn
@@ -0,0 +1,70 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_DEALER_MERGE_HOUSE_H_
+#define SAFRN_DEALER_MERGE_HOUSE_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <string>
+
+/* 3rd Party Headers */
+
+/* Fortissimo Headers */
+#include <ff/Fronctocol.h>
+#include <ff/Message.h>
+
+#include <mpc/Compare.h>
+#include <mpc/CompareDealer.h>
+#include <mpc/ModConvUp.h>
+#include <mpc/Randomness.h>
+#include <mpc/RandomnessDealer.h>
+
+#include <dataowner/fortissimo.h>
+#include <framework/Framework.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dealer {
+
+/**
+ * Deals the randomness of one dataowner::ObliviousMerge, invoking its
+ * houses in the same order as the merge invokes its patrons.
+ */
+class MergeRandomnessHouse : public Fronctocol {
+public:
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+  /**
+   * The revealer is only needed to construct the CompareInfo, as in
+   * LookupRandomnessHouse.
+   */
+  MergeRandomnessHouse(
+      dataowner::LargeNum const & keyModulus,
+      Identity const * const revealer);
+
+private:
+  ff::mpc::CompareInfo<
+      safrn::Identity,
+      dataowner::LargeNum,
+      dataowner::SmallNum>
+      compareInfo;
+
+  size_t numDealersRemaining = 0;
+};
+
+} // namespace dealer
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_DEALER_MERGE_HOUSE_H_
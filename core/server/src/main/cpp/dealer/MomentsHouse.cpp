@@ -35,17 +35,8 @@ void MomentsRandomnessHouse::init() {
             ps.add(other);
             ps.add(other_two);
 
-            std::unique_ptr<Fronctocol> rd7(
-                new ff::mpc::SISOSortRandomnessHouse<
-                    SAFRN_TYPES,
-                    dataowner::LargeNum,
-                    dataowner::SmallNum>(
-                    // size of list shared between pair of parties
-                    2 * this->globals->maxListSize,
-                    this->info->startModulus,
-                    this->info->keyModulus,
-                    this->info->dealer,
-                    this->info->revealer));
+            std::unique_ptr<Fronctocol> rd7(new MergeRandomnessHouse(
+                this->info->keyModulus, this->info->revealer));
             this->invoke(std::move(rd7), ps);
             this->numDealersRemaining++;
           }
@@ -84,7 +75,7 @@ MomentsRandomnessBasement::MomentsRandomnessBasement(
 void MomentsRandomnessBasement::init() {
   log_debug("MomentsRandomnessBasement init");
   this->numDealersRemaining =
-      2; // counting the ones without cross-vertical differentiation
+      4; // counting the ones without cross-vertical differentiation
 
   std::unique_ptr<Fronctocol> rd(
       new ff::mpc::ModConvUpRandomnessHouse<
@@ -101,6 +92,22 @@ void MomentsRandomnessBasement::init() {
           dataowner::SmallNum>(&this->info->divideInfo));
   this->invoke(std::move(rd2), this->getPeers());
 
+  /* The reciprocal's products and shifts, see SharedDivide. */
+  std::unique_ptr<Fronctocol> divideBeaverHouse(
+      new ff::mpc::RandomnessHouse<
+          SAFRN_TYPES,
+          ff::mpc::BeaverTriple<dataowner::LargeNum>,
+          ff::mpc::BeaverInfo<dataowner::LargeNum>>());
+  this->invoke(std::move(divideBeaverHouse), this->getPeers());
+
+  std::unique_ptr<Fronctocol> truncationPairHouse(
+      new SeededRandomnessHouse<
+          dealer::TruncationPair<dataowner::LargeNum>,
+          dealer::TruncationPairInfo<
+              dataowner::LargeNum,
+              dataowner::LargeNum>>());
+  this->invoke(std::move(truncationPairHouse), this->getPeers());
+
   this->getPeers().forEachDataowner([&, this](const Identity & other) {
     this->getPeers().forEachDataowner(
         [&, this](const Identity & other_two) {
@@ -33,10 +33,12 @@
 #include <mpc/ModConvUpDealer.h>
 #include <mpc/ZipAdjacentDealer.h>
 
+#include <dealer/MergeHouse.h>
 #include <dealer/RandomSquareMatrix.h>
+#include <dealer/TruncationPair.h>
 
 #include <framework/Framework.h>
-#include <mpc/SISOSortDealer.h>
+#include <util/RandomnessDealer.h>
 
 /* logging configuration */
 #include <ff/logging.h>
@@ -19,6 +19,9 @@
 
 #include <mpc/templates.h>
 
+/* Safrn Headers */
+#include <util/SeedPrg.h>
+
 /* Logging config */
 #include <ff/logging.h>
 
@@ -74,6 +77,17 @@ public:
       size_t,
       std::vector<RandomSquareMatrix<MatrixValue_T>> & vals) const;
 
+  /**
+   * Seeded generation (see SeededRandomnessHouse). expandShare fills
+   * in one party's share from its seed, and generateCorrection draws a
+   * fresh instance and sets vals[0] to the share which, along with the
+   * already expanded vals[1..n_parties - 1], adds up to it.
+   */
+  void expandShare(
+      SeedPrg & prg, RandomSquareMatrix<MatrixValue_T> & share) const;
+  void generateCorrection(
+      std::vector<RandomSquareMatrix<MatrixValue_T>> & vals) const;
+
   bool operator==(RandomSquareMatrixInfo const & other) const {
     return (this->d_ == other.d_) &&
         (this->field_characteristic_ == other.field_characteristic_);
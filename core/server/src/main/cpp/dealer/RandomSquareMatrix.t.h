@@ -23,6 +23,29 @@ void RandomSquareMatrixInfo<Value_T, MatrixValue_T>::generate(
     vals.emplace_back(RandomSquareMatrix<MatrixValue_T>(this->d_));
   }
 
+  for (size_t i = 1; i < n_parties; i++) {
+    SeedPrg prg(SeedPrg::newSeed());
+    this->expandShare(prg, vals[i]);
+  }
+  this->generateCorrection(vals);
+}
+
+template<typename Value_T, typename MatrixValue_T>
+void RandomSquareMatrixInfo<Value_T, MatrixValue_T>::expandShare(
+    SeedPrg & prg, RandomSquareMatrix<MatrixValue_T> & share) const {
+  for (size_t row = 0; row < this->d_; ++row) {
+    for (size_t col = 0; col < this->d_; ++col) {
+      share.values_.at(row, col) =
+          prg.randomModP<MatrixValue_T>(this->field_characteristic_);
+    }
+  }
+  share.det_of_inverse_ =
+      prg.randomModP<MatrixValue_T>(this->field_characteristic_);
+}
+
+template<typename Value_T, typename MatrixValue_T>
+void RandomSquareMatrixInfo<Value_T, MatrixValue_T>::generateCorrection(
+    std::vector<RandomSquareMatrix<MatrixValue_T>> & vals) const {
   /* Step 1. Randomly create the "original" random matrix instance. */
   RandomSquareMatrix<MatrixValue_T> & orig = vals[0];
   for (size_t row = 0; row < this->d_; ++row) {
@@ -37,24 +60,19 @@ void RandomSquareMatrixInfo<Value_T, MatrixValue_T>::generate(
   orig.det_of_inverse_ = ff::mpc::modInvert<MatrixValue_T>(
       det, this->field_characteristic_);
 
-  /* Step 3. randomly secret share the original. */
-  for (size_t i = 1; i < n_parties; i++) {
-    RandomSquareMatrix<MatrixValue_T> & share_i = vals[i];
+  /* Step 3. subtract away the other parties' shares. */
+  for (size_t i = 1; i < vals.size(); i++) {
+    RandomSquareMatrix<MatrixValue_T> const & share_i = vals[i];
     for (size_t row = 0; row < this->d_; ++row) {
       for (size_t col = 0; col < this->d_; ++col) {
-        MatrixValue_T & current = share_i.values_.at(row, col);
-        current = ff::mpc::randomModP<MatrixValue_T>(
-            this->field_characteristic_);
+        MatrixValue_T const & current = share_i.values_.at(row, col);
         orig.values_.at(row, col) =
             (orig.values_.at(row, col) +
              (this->field_characteristic_ - current)) %
             (this->field_characteristic_);
       }
     }
-    // Also, generate random share of the det(inverse).
-    MatrixValue_T & det_share = share_i.det_of_inverse_;
-    det_share =
-        ff::mpc::randomModP<MatrixValue_T>(this->field_characteristic_);
+    MatrixValue_T const & det_share = share_i.det_of_inverse_;
     orig.det_of_inverse_ = (orig.det_of_inverse_ +
                             (this->field_characteristic_ - det_share)) %
         (this->field_characteristic_);
@@ -110,7 +110,10 @@ bool read_table_csv_file(
 
 RandomTableLookup::RandomTableLookup(
     RandomTableLookupInfo const & info) :
-    RandomTableLookup() {
+    RandomTableLookup(
+        dataowner::LargeNum(0),
+        ::std::vector<uint64_t>(RandomTableLookup::numWords(
+            static_cast<size_t>(info.table_size_)))) {
 }
 
 void RandomTableLookupInfo::generate(
@@ -122,45 +125,65 @@ void RandomTableLookupInfo::generate(
 
   log_debug("Calling generate");
   for (::std::size_t i = 0; i < n_parties; ++i) {
-    vals.emplace_back(RandomTableLookup(
-        dataowner::LargeNum(1),
-        ::std::vector<Boolean_t>(this->table_size_)));
+    vals.emplace_back(*this);
   }
 
-  log_debug("HI");
+  for (::std::size_t i = 1; i < n_parties; ++i) {
+    SeedPrg prg(SeedPrg::newSeed());
+    this->expandShare(prg, vals[i]);
+  }
+  this->generateCorrection(vals);
+  log_debug("leaving generate");
+}
 
+void RandomTableLookupInfo::expandShare(
+    SeedPrg & prg, RandomTableLookup & share) const {
+  share.r_ = prg.randomModP<dataowner::LargeNum>(this->r_modulus_);
+
+  size_t const num_bits = static_cast<size_t>(this->table_size_);
+  share.u_.resize(RandomTableLookup::numWords(num_bits));
+  ::std::vector<uint8_t> bytes(share.u_.size() * sizeof(uint64_t));
+  prg.bytes(bytes.data(), bytes.size());
+  for (::std::size_t j = 0; j < share.u_.size(); ++j) {
+    uint64_t word = 0;
+    for (size_t k = sizeof(uint64_t); k > 0; --k) {
+      word = (word << 8) | bytes[j * sizeof(uint64_t) + k - 1];
+    }
+    share.u_[j] = word;
+  }
+  if (num_bits % 64 != 0) {
+    share.u_.back() &= (uint64_t(1) << (num_bits % 64)) - 1;
+  }
+}
+
+void RandomTableLookupInfo::generateCorrection(
+    ::std::vector<RandomTableLookup> & vals) const {
   log_debug("Table size: %zu", this->table_size_);
 
   /* Step 1: Randomly create the original TableLookup instance */
   auto & orig = vals.front();
+  orig.u_.assign(
+      RandomTableLookup::numWords(
+          static_cast<size_t>(this->table_size_)),
+      0);
 
   dataowner::SmallNum original_r_small =
       ::ff::mpc::randomModP<dataowner::SmallNum>(this->table_size_);
 
-  log_debug("r %u", original_r_small);
-  orig.u_[original_r_small] = 0x01;
+  orig.u_[original_r_small / 64] |= uint64_t(1)
+      << (original_r_small % 64);
   orig.r_ = original_r_small;
 
   log_debug("original_r_small %u", original_r_small);
 
-  /* Step 2: Randomly secret share the original */
-  for (::std::size_t i = 1; i < n_parties; ++i) {
-    auto & share = vals[i];
-    share.r_ =
-        ::ff::mpc::randomModP<dataowner::LargeNum>(this->r_modulus_);
+  /* Step 2: Subtract away the other parties' shares */
+  for (::std::size_t i = 1; i < vals.size(); ++i) {
+    auto const & share = vals[i];
     orig.r_ = ::ff::mpc::modSub(orig.r_, share.r_, this->r_modulus_);
-
-    if (!ff::mpc::randomBytes(share.u_.data(), share.u_.size())) {
-      throw std::runtime_error("Bad rands");
-    }
-
     for (::std::size_t j = 0; j < share.u_.size(); ++j) {
-      /** n.b. these both need to be random bits, not random bytes, for efficient share reconstruction */
-      orig.u_[j] = orig.u_[j] ^ (share.u_[j] & 0x01);
-      share.u_[j] = share.u_[j] & 0x01;
+      orig.u_[j] = orig.u_[j] ^ share.u_[j];
     }
   }
-  log_debug("leaving generate");
 }
 
 } // namespace dealer
@@ -18,6 +18,7 @@
 #include <mpc/templates.h>
 
 #include <dataowner/fortissimo.h>
+#include <util/SeedPrg.h>
 
 /* Logging config */
 #include <ff/logging.h>
@@ -40,7 +41,7 @@ class RandomTableLookupInfo;
 class RandomTableLookup {
 public:
   RandomTableLookup(
-      const dataowner::LargeNum r, ::std::vector<Boolean_t> u) :
+      const dataowner::LargeNum r, ::std::vector<uint64_t> u) :
       r_(r), u_(std::move(u)){};
 
   RandomTableLookup() : RandomTableLookup(0U, {}){};
@@ -48,7 +49,20 @@ public:
   RandomTableLookup(RandomTableLookupInfo const & info);
 
   dataowner::LargeNum r_ = dataowner::LargeNum(0);
-  ::std::vector<Boolean_t> u_;
+
+  /**
+   * The one-hot vector, packed 64 bits to a word: bit i is bit i % 64
+   * of word i / 64. Bits past the table size are always zero.
+   */
+  ::std::vector<uint64_t> u_;
+
+  bool bit(::std::size_t const i) const {
+    return ((this->u_[i / 64] >> (i % 64)) & 0x01) != 0;
+  }
+
+  static ::std::size_t numWords(::std::size_t const num_bits) {
+    return (num_bits + 63) / 64;
+  }
 
   static std::string name() {
     return std::string("Random Table Lookup");
@@ -65,8 +79,9 @@ public:
   RandomTableLookupInfo() : RandomTableLookupInfo(1U, 0U){};
 
   ::std::size_t instanceSize() const {
-    return (static_cast<size_t>(this->table_size_) *
-            sizeof(Boolean_t)) +
+    return (RandomTableLookup::numWords(
+                static_cast<size_t>(this->table_size_)) *
+            sizeof(uint64_t)) +
         (ff::mpc::numberLen(this->r_modulus_));
   }
 
@@ -75,6 +90,16 @@ public:
       ::std::size_t /*unused*/,
       ::std::vector<RandomTableLookup> & vals) const;
 
+  /**
+   * Seeded generation (see SeededRandomnessHouse). expandShare fills
+   * in one party's share from its seed, and generateCorrection draws a
+   * fresh instance and sets vals[0] to the share which, along with the
+   * already expanded vals[1..n_parties - 1], reconstructs it.
+   */
+  void expandShare(SeedPrg & prg, RandomTableLookup & share) const;
+  void generateCorrection(
+      ::std::vector<RandomTableLookup> & vals) const;
+
   bool operator==(RandomTableLookupInfo const & other) const {
     return this->r_modulus_ == other.r_modulus_ &&
         this->table_size_ == other.table_size_;
@@ -32,13 +32,13 @@ bool msg_read(
   log_debug("Calling read");
   bool success = msg.template read<mpc::LargeNum>(input.r_);
 
-  uint64_t local_table_size = 0;
-  success = msg.template read<uint64_t>(local_table_size);
-  size_t recast_size = (size_t)local_table_size;
+  uint64_t local_num_words = 0;
+  success = success & msg.template read<uint64_t>(local_num_words);
+  size_t recast_size = (size_t)local_num_words;
   input.u_.resize(recast_size);
 
   for (size_t i = 0; i < recast_size; i++) {
-    success = success & msg.template read<Boolean_t>(input.u_[i]);
+    success = success & msg.template read<uint64_t>(input.u_[i]);
   }
   log_debug("success");
   return success;
@@ -50,12 +50,12 @@ bool msg_write(
     ::safrn::dealer::RandomTableLookup const & input) {
   bool success = msg.template write<mpc::LargeNum>(input.r_);
 
-  uint64_t local_table_size = static_cast<uint64_t>(input.u_.size());
-  success = msg.template write<uint64_t>(local_table_size);
-  size_t recast_size = (size_t)local_table_size;
+  uint64_t local_num_words = static_cast<uint64_t>(input.u_.size());
+  success = success & msg.template write<uint64_t>(local_num_words);
+  size_t recast_size = (size_t)local_num_words;
 
   for (size_t i = 0; i < recast_size; i++) {
-    success = success & msg.template write<Boolean_t>(input.u_.at(i));
+    success = success & msg.template write<uint64_t>(input.u_[i]);
   }
   return success;
 }
@@ -36,17 +36,8 @@ void RegressionRandomnessHouse::init() {
         ps.add(other_two);
 
         // low-level
-        std::unique_ptr<Fronctocol> rd7(
-            new ff::mpc::SISOSortRandomnessHouse<
-                SAFRN_TYPES,
-                dataowner::LargeNum,
-                dataowner::SmallNum>(
-                2 * this->globals->maxListSize,
-                this->info->startModulus,
-                this->info->keyModulus,
-                this->info->dealer,
-                this->info
-                    ->revealer)); // For now, we only allow 2 key cols. With bignums, we probably should never do anything else
+        std::unique_ptr<Fronctocol> rd7(new MergeRandomnessHouse(
+            this->info->keyModulus, this->info->revealer));
         this->invoke(std::move(rd7), ps);
         this->numDealersRemaining++;
       }
@@ -85,8 +76,14 @@ RegressionRandomnessBasement::RegressionRandomnessBasement(
 void RegressionRandomnessBasement::init() {
   log_debug("RegressionRandomnessBasement init");
 
+  /** The houses are invoked once every dataowner's offer is in. */
+  this->getPeers().forEachDataowner(
+      [this](const Identity &) { this->numOffersAwaiting++; });
+}
+
+void RegressionRandomnessBasement::invokeHouses(bool const useStored) {
   this->numDealersRemaining =
-      10; // counting only dealers for the whole party; we handle the pairwise dealer counts separately
+      9; // counting only dealers for the whole party; we handle the pairwise dealer counts separately
 
   std::unique_ptr<Fronctocol> rd(
       new ff::mpc::ModConvUpRandomnessHouse<
@@ -150,20 +147,23 @@ void RegressionRandomnessBasement::init() {
   });
 
   std::unique_ptr<Fronctocol> rd5(
-      new ff::mpc::RandomnessHouse<
-          SAFRN_TYPES,
-          ff::mpc::BeaverTriple<dataowner::LargeNum>,
-          ff::mpc::BeaverInfo<dataowner::LargeNum>>());
-  this->invoke(std::move(rd5), this->getPeers());
-
-  std::unique_ptr<Fronctocol> rd6(
-      new ff::mpc::RandomnessHouse<
-          SAFRN_TYPES,
-          dealer::RandomSquareMatrix<dataowner::LargeNum>,
-          dealer::RandomSquareMatrixInfo<
+      new SeededRandomnessHouse<
+          dealer::MatrixBeaverTriple<dataowner::LargeNum>,
+          dealer::MatrixBeaverTripleInfo<
               dataowner::LargeNum,
               dataowner::LargeNum>>());
-  this->invoke(std::move(rd6), this->getPeers());
+  this->invoke(std::move(rd5), this->getPeers());
+
+  if (!useStored) {
+    std::unique_ptr<Fronctocol> rd6(
+        new SeededRandomnessHouse<
+            dealer::RandomSquareMatrix<dataowner::LargeNum>,
+            dealer::RandomSquareMatrixInfo<
+                dataowner::LargeNum,
+                dataowner::LargeNum>>());
+    this->invoke(std::move(rd6), this->getPeers());
+    this->numDealersRemaining++;
+  }
 
   log_debug("here");
 
@@ -174,6 +174,15 @@ void RegressionRandomnessBasement::init() {
           ff::mpc::BeaverInfo<dataowner::LargeNum>>());
   this->invoke(std::move(rd7), this->getPeers());
 
+  /** For the coefficients' shared divide, see SharedDivide. */
+  std::unique_ptr<Fronctocol> rd7b(
+      new SeededRandomnessHouse<
+          dealer::TruncationPair<dataowner::LargeNum>,
+          dealer::TruncationPairInfo<
+              dataowner::LargeNum,
+              dataowner::LargeNum>>());
+  this->invoke(std::move(rd7b), this->getPeers());
+
   std::unique_ptr<Fronctocol> rd8(
       new ff::mpc::CompareRandomnessHouse<
           SAFRN_TYPES,
@@ -181,13 +190,6 @@ void RegressionRandomnessBasement::init() {
           dataowner::SmallNum>(&this->info->compareInfoEndModulus));
   this->invoke(std::move(rd8), this->getPeers());
 
-  std::unique_ptr<Fronctocol> rd8b(
-      new ff::mpc::CompareRandomnessHouse<
-          SAFRN_TYPES,
-          dataowner::LargeNum,
-          dataowner::SmallNum>(&this->info->compareInfo));
-  this->invoke(std::move(rd8b), this->getPeers());
-
   std::unique_ptr<Fronctocol> rd9(
       new ff::mpc::RandomnessHouse<
           SAFRN_TYPES,
@@ -200,21 +202,53 @@ void RegressionRandomnessBasement::init() {
   /** For F-test */
   std::unique_ptr<Fronctocol> rd10(new LookupRandomnessHouse(
       new dealer::RandomTableLookupInfo(this->info->endModulus, 0UL),
-      &this->info->compareInfoEndModulus));
+      &this->info->compareInfoEndModulus,
+      !useStored));
   this->invoke(std::move(rd10), this->getPeers());
 
   /** For t-test, need a different info object for a different possible table size */
   std::unique_ptr<Fronctocol> rd11(new LookupRandomnessHouse(
       new dealer::RandomTableLookupInfo(this->info->endModulus, 0UL),
-      &this->info->compareInfoEndModulus));
+      &this->info->compareInfoEndModulus,
+      !useStored));
   this->invoke(std::move(rd11), this->getPeers());
 
   log_debug("here");
 }
 
-void RegressionRandomnessBasement::handleReceive(IncomingMessage &) {
-  log_error("RegressionRandomnessBasement received unexpected "
-            "handle receive");
+void RegressionRandomnessBasement::handleReceive(
+    IncomingMessage & imsg) {
+  uint64_t batch = RandomnessStore::NO_BATCH;
+  if (!imsg.template read<uint64_t>(batch) ||
+      this->numOffersAwaiting == 0) {
+    log_error("RegressionRandomnessBasement received unexpected "
+              "handle receive");
+    return;
+  }
+
+  if (batch == RandomnessStore::NO_BATCH ||
+      (this->offeredBatch != RandomnessStore::NO_BATCH &&
+       this->offeredBatch != batch)) {
+    this->offersAgree = false;
+  }
+  this->offeredBatch = batch;
+  this->numOffersAwaiting--;
+  if (this->numOffersAwaiting > 0) {
+    return;
+  }
+
+  bool const useStored = this->offersAgree;
+  log_debug(
+      "RegressionRandomnessBasement using %s randomness",
+      useStored ? "stored" : "live");
+  this->getPeers().forEachDataowner([&, this](const Identity & other) {
+    std::unique_ptr<OutgoingMessage> omsg(new OutgoingMessage(other));
+    omsg->template write<Boolean_t>(
+        static_cast<Boolean_t>(useStored ? 0x01 : 0x00));
+    this->send(std::move(omsg));
+  });
+
+  this->invokeHouses(useStored);
 }
 
 void RegressionRandomnessBasement::handleComplete(Fronctocol &) {
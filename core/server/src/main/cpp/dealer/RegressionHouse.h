@@ -32,12 +32,16 @@
 #include <mpc/ZipAdjacentDealer.h>
 
 #include <dealer/LookupHouse.h>
+#include <dealer/MatrixBeaverTriple.h>
+#include <dealer/MergeHouse.h>
 #include <dealer/RandomSquareMatrix.h>
 #include <dealer/RandomTableLookup.h>
+#include <dealer/TruncationPair.h>
 
 #include <dataowner/fortissimo.h>
 #include <framework/Framework.h>
-#include <mpc/SISOSortDealer.h>
+#include <util/RandomnessDealer.h>
+#include <util/RandomnessStore.h>
 
 /* logging configuration */
 #include <ff/logging.h>
@@ -78,6 +82,20 @@ public:
 private:
   dataowner::RegressionInfo const * const info;
 
+  /**
+   * Invokes the houses for all randomness which the dataowners are not
+   * taking from their RandomnessStores.
+   */
+  void invokeHouses(bool const useStored);
+
+  /**
+   * Each dataowner offers a batch of stored randomness, which is used
+   * only when every dataowner offers the same batch.
+   */
+  size_t numOffersAwaiting = 0;
+  uint64_t offeredBatch = RandomnessStore::NO_BATCH;
+  bool offersAgree = true;
+
   size_t numDealersRemaining = 0;
 };
 
@@ -0,0 +1,166 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_TRUNCATION_PAIR_H_
+#define SAFRN_TRUNCATION_PAIR_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* Fortissimo Headers */
+#include <mpc/Randomness.h>
+
+#include <mpc/templates.h>
+
+/* Safrn Headers */
+#include <util/SeedPrg.h>
+
+/* Logging config */
+#include <ff/logging.h>
+
+namespace safrn {
+namespace dealer {
+
+template<typename Value_T, typename PairValue_T>
+struct TruncationPairInfo;
+
+/**
+ * Shares of a random mask r, below 2^maskBits, and of r shifted right
+ * by shiftBits. Opening x + r for a shared x below 2^(maskBits - s)
+ * then lets each party shift x right by shiftBits locally, off by at
+ * most one, with x statistically hidden by the s bits of slack in the
+ * mask. The modulus must exceed 2^(maskBits + 1), so x + r never wraps.
+ */
+template<typename Value_T>
+struct TruncationPair {
+public:
+  TruncationPair() = default;
+  TruncationPair(TruncationPair const &) = default;
+  TruncationPair & operator=(TruncationPair const &) = default;
+
+  template<typename InfoValue_T>
+  TruncationPair(TruncationPairInfo<InfoValue_T, Value_T> const & info);
+
+  Value_T r_ = 0;
+  Value_T shifted_ = 0;
+
+  static std::string name() {
+    return std::string("Truncation Pair");
+  }
+};
+
+template<typename Value_T, typename PairValue_T>
+struct TruncationPairInfo {
+public:
+  TruncationPairInfo(
+      const size_t shift_bits,
+      const size_t mask_bits,
+      const Value_T & field_characteristic) {
+    shiftBits_ = shift_bits;
+    maskBits_ = mask_bits;
+    field_characteristic_ = field_characteristic;
+  }
+
+  TruncationPairInfo() = default;
+
+  size_t instanceSize() const {
+    return 2 * sizeof(PairValue_T);
+  }
+
+  void generate(
+      size_t n_parties,
+      size_t,
+      std::vector<TruncationPair<PairValue_T>> & vals) const;
+
+  /**
+   * Seeded generation (see SeededRandomnessHouse), as for
+   * MatrixBeaverTripleInfo.
+   */
+  void expandShare(
+      SeedPrg & prg, TruncationPair<PairValue_T> & share) const;
+  void generateCorrection(
+      std::vector<TruncationPair<PairValue_T>> & vals) const;
+
+  bool operator==(TruncationPairInfo const & other) const {
+    return (this->shiftBits_ == other.shiftBits_) &&
+        (this->maskBits_ == other.maskBits_) &&
+        (this->field_characteristic_ == other.field_characteristic_);
+  }
+  bool operator!=(TruncationPairInfo const & other) const {
+    return !(*this == other);
+  }
+
+  size_t shiftBits_ = 0;
+  size_t maskBits_ = 0;
+  Value_T field_characteristic_ = 0;
+};
+
+} // namespace dealer
+} // namespace safrn
+
+namespace ff {
+// ==================== Helper functions: msg_read and msg_write ===============
+// Code below instantiates msg_read/write for template type TruncationPair[Info].
+template<typename Identity_T, typename Value_T, typename PairValue_T>
+bool msg_read(
+    ff::IncomingMessage<Identity_T> & msg,
+    safrn::dealer::TruncationPairInfo<Value_T, PairValue_T> & input) {
+  uint64_t local_shift = 0;
+  uint64_t local_mask = 0;
+  bool success = msg.template read<uint64_t>(local_shift);
+  success = success && msg.template read<uint64_t>(local_mask);
+  input.shiftBits_ = (size_t)local_shift;
+  input.maskBits_ = (size_t)local_mask;
+  success = success &&
+      msg.template read<Value_T>(input.field_characteristic_);
+
+  return success;
+}
+
+template<typename Identity_T, typename Value_T, typename PairValue_T>
+bool msg_write(
+    ff::OutgoingMessage<Identity_T> & msg,
+    safrn::dealer::TruncationPairInfo<Value_T, PairValue_T> const &
+        input) {
+  bool success =
+      msg.template write<uint64_t>((uint64_t)input.shiftBits_);
+  success = success &&
+      msg.template write<uint64_t>((uint64_t)input.maskBits_);
+  success = success &&
+      msg.template write<Value_T>(input.field_characteristic_);
+  return success;
+}
+
+template<typename Identity_T, typename Value_T>
+bool msg_read(
+    ff::IncomingMessage<Identity_T> & msg,
+    safrn::dealer::TruncationPair<Value_T> & input) {
+  bool success = msg.template read<Value_T>(input.r_);
+  success = success && msg.template read<Value_T>(input.shifted_);
+  return success;
+}
+
+template<typename Identity_T, typename Value_T>
+bool msg_write(
+    ff::OutgoingMessage<Identity_T> & msg,
+    safrn::dealer::TruncationPair<Value_T> const & input) {
+  bool success = msg.template write<Value_T>(input.r_);
+  success = success && msg.template write<Value_T>(input.shifted_);
+  return success;
+}
+
+} // namespace ff
+
+#include <dealer/TruncationPair.t.h>
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif
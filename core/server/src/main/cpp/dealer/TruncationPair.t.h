@@ -0,0 +1,57 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+namespace safrn {
+namespace dealer {
+
+template<typename Value_T>
+template<typename InfoValue_T>
+TruncationPair<Value_T>::TruncationPair(
+    TruncationPairInfo<InfoValue_T, Value_T> const &) :
+    TruncationPair() {
+}
+
+template<typename Value_T, typename PairValue_T>
+void TruncationPairInfo<Value_T, PairValue_T>::generate(
+    size_t n_parties,
+    size_t,
+    std::vector<TruncationPair<PairValue_T>> & vals) const {
+  vals.clear();
+  vals.resize(n_parties);
+
+  for (size_t i = 1; i < n_parties; i++) {
+    SeedPrg prg(SeedPrg::newSeed());
+    this->expandShare(prg, vals[i]);
+  }
+  this->generateCorrection(vals);
+}
+
+template<typename Value_T, typename PairValue_T>
+void TruncationPairInfo<Value_T, PairValue_T>::expandShare(
+    SeedPrg & prg, TruncationPair<PairValue_T> & share) const {
+  share.r_ = prg.randomModP<PairValue_T>(this->field_characteristic_);
+  share.shifted_ =
+      prg.randomModP<PairValue_T>(this->field_characteristic_);
+}
+
+template<typename Value_T, typename PairValue_T>
+void TruncationPairInfo<Value_T, PairValue_T>::generateCorrection(
+    std::vector<TruncationPair<PairValue_T>> & vals) const {
+  PairValue_T const p = this->field_characteristic_;
+
+  /* Step 1. Randomly create the mask, and shift it. */
+  TruncationPair<PairValue_T> & orig = vals[0];
+  orig.r_ = ff::mpc::randomModP<PairValue_T>(
+      PairValue_T(1) << this->maskBits_);
+  orig.shifted_ = orig.r_ >> this->shiftBits_;
+
+  /* Step 2. subtract away the other parties' shares. */
+  for (size_t i = 1; i < vals.size(); i++) {
+    orig.r_ = (orig.r_ + (p - vals[i].r_)) % p;
+    orig.shifted_ = (orig.shifted_ + (p - vals[i].shifted_)) % p;
+  }
+}
+
+} // namespace dealer
+} // namespace safrn
@@ -17,33 +17,6 @@
 
 namespace safrn {
 
-bool QueryId::operator<(QueryId const & other) const {
-  return this->studyId < other.studyId &&
-      this->analyst < other.analyst && this->queryId < other.queryId;
-}
-
-bool QueryId::operator>(QueryId const & other) const {
-  return this->studyId > other.studyId &&
-      this->analyst > other.analyst && this->queryId > other.queryId;
-}
-
-bool QueryId::operator<=(QueryId const & other) const {
-  return !(*this > other);
-}
-
-bool QueryId::operator>=(QueryId const & other) const {
-  return !(*this < other);
-}
-
-bool QueryId::operator==(QueryId const & other) const {
-  return this->studyId == other.studyId &&
-      this->analyst == other.analyst && this->queryId == other.queryId;
-}
-
-bool QueryId::operator!=(QueryId const & other) const {
-  return !(*this == other);
-}
-
 QueryContext::QueryContext(
     QueryId const & qid,
     StudyConfig const * study,
@@ -15,6 +15,7 @@
 #include <JSON/Config/StudyConfig.h>
 #include <JSON/Query/Query.h>
 #include <Util/Utils.h>
+#include <framework/QueryId.h>
 #include <network/EventHandler.h>
 
 #ifndef SAFRN_QUERY_CONTEXT_H_
@@ -22,24 +23,6 @@
 
 namespace safrn {
 
-/**
-   * A given query is identified by a StudyID (assigned by dashboard) and
-   * a query id (assigned sequentially by the analyst).
-   */
-struct QueryId {
-  dbuid_t studyId;
-  dbuid_t analyst; // analyst who started this query
-  uint64_t queryId; // sequentially assigned by given analyst
-
-  bool operator<(QueryId const & other) const;
-  bool operator>(QueryId const & other) const;
-  bool operator<=(QueryId const & other) const;
-  bool operator>=(QueryId const & other) const;
-
-  bool operator==(QueryId const & other) const;
-  bool operator!=(QueryId const & other) const;
-};
-
 struct NewConnectionHandler;
 
 struct QueryContext {
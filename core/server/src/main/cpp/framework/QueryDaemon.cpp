@@ -0,0 +1,237 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <utility>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <nlohmann/json.hpp>
+
+/* SAFRN Headers */
+#include <Startup.h>
+#include <framework/QueryDaemon.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+/** Message types sent between daemons. */
+static uint8_t const DAEMON_QUERY = 0x01;
+static uint8_t const DAEMON_STOP = 0x02;
+
+QueryDaemon::QueryDaemon(
+    StudyConfig const & scfg, DaemonConfig const & config) :
+    studyCfg(scfg), config(config) {
+}
+
+void QueryDaemon::init() {
+  log_info(
+      "Query daemon started%s",
+      this->isCoordinator() ? " as coordinator" : "");
+  if (this->isCoordinator()) {
+    this->spool.reset(new SpoolWatcher(this->config.spoolDirectory));
+    this->awaitQueries();
+    this->completeIfDone();
+  }
+}
+
+void QueryDaemon::handleReceive(IncomingMessage & imsg) {
+  uint8_t type = 0;
+  bool success = imsg.read<uint8_t>(type);
+
+  if (success && type == DAEMON_QUERY) {
+    QueryId qid;
+    uint32_t length = 0;
+    success = success && imsg.read<QueryId>(qid);
+    success = success && imsg.read<uint32_t>(length);
+    std::string query_json(length, '\0');
+    success = success &&
+        imsg.remove(
+            reinterpret_cast<uint8_t *>(&query_json[0]), length);
+    if (!success) {
+      log_error("Query daemon could not read a forwarded query");
+      this->abort();
+      return;
+    }
+    if (qid.studyId != this->studyCfg.studyId ||
+        qid.queryId != this->nextQueryId) {
+      log_error(
+          "Query daemon expected query %lu of this study, not %s",
+          this->nextQueryId,
+          qid.str().c_str());
+      this->abort();
+      return;
+    }
+    this->nextQueryId++;
+    this->startQuery(qid, query_json, std::string(""));
+  } else if (success && type == DAEMON_STOP) {
+    log_info("Query daemon stopping");
+    this->stopping = true;
+    this->completeIfDone();
+  } else {
+    log_error("Query daemon received an unrecognized message");
+    this->abort();
+  }
+}
+
+void QueryDaemon::handleComplete(Fronctocol & f) {
+  std::map<Fronctocol const *, RunningQuery>::iterator const found =
+      this->running.find(&f);
+  if (found == this->running.end()) {
+    log_error("Query daemon received completion of an unknown query");
+    this->abort();
+    return;
+  }
+
+  log_info("Finished query %s", found->second.queryId.str().c_str());
+  if (!found->second.spoolFile.empty()) {
+    std::rename(
+        (found->second.spoolFile + ".running").c_str(),
+        (found->second.spoolFile + ".done").c_str());
+  }
+  this->running.erase(found);
+
+  if (this->isCoordinator() && !this->stopping) {
+    this->awaitQueries();
+  }
+  this->completeIfDone();
+}
+
+void QueryDaemon::handlePromise(Fronctocol &) {
+  log_error("Query daemon received unexpected handle promise");
+  this->abort();
+}
+
+std::string QueryDaemon::name() {
+  return std::string("Query Daemon");
+}
+
+bool QueryDaemon::startQuery(
+    QueryId const & qid,
+    std::string const & queryJson,
+    std::string const & spoolFile) {
+  std::unique_ptr<Query> query;
+  try {
+    query.reset(
+        new Query(this->studyCfg, nlohmann::json::parse(queryJson)));
+  } catch (std::exception const & e) {
+    log_error("Invalid query %s: %s", qid.str().c_str(), e.what());
+    return false;
+  }
+
+  PeerSet ps;
+  std::unique_ptr<Fronctocol> child = startup(
+      this->config.dataFile,
+      this->config.lookupTableDirectory,
+      *query,
+      this->studyCfg,
+      this->getSelf(),
+      ps,
+      this->config.randomnessDirectory);
+  if (child == nullptr) {
+    log_info("Not running query %s", qid.str().c_str());
+    return false;
+  }
+
+  log_info("Starting query %s", qid.str().c_str());
+  RunningQuery & rq = this->running[child.get()];
+  rq.queryId = qid;
+  rq.query = std::move(query);
+  rq.spoolFile = spoolFile;
+  this->invoke(std::move(child), ps);
+  return true;
+}
+
+void QueryDaemon::admitQueries() {
+  std::vector<std::string> const files = this->spool->queries();
+  size_t admitted = 0;
+  for (std::string const & file : files) {
+    if (this->running.size() >= this->config.maxConcurrentQueries) {
+      break;
+    }
+    admitted++;
+
+    std::ifstream stream(file);
+    std::string const query_json(
+        (std::istreambuf_iterator<char>(stream)),
+        std::istreambuf_iterator<char>());
+    std::rename(file.c_str(), (file + ".running").c_str());
+
+    QueryId qid;
+    qid.studyId = this->studyCfg.studyId;
+    qid.analyst = this->getSelf().orgId;
+    qid.queryId = this->nextQueryId;
+
+    /* peers are only told of queries which start here. */
+    if (this->startQuery(qid, query_json, file)) {
+      this->nextQueryId++;
+      this->forwardQuery(qid, query_json);
+    } else {
+      std::rename(
+          (file + ".running").c_str(), (file + ".failed").c_str());
+    }
+  }
+
+  if (admitted == files.size() && this->spool->stopRequested()) {
+    this->stop();
+  }
+}
+
+void QueryDaemon::awaitQueries() {
+  this->admitQueries();
+  while (this->running.empty() && !this->stopping) {
+    this->spool->wait();
+    this->admitQueries();
+  }
+}
+
+void QueryDaemon::forwardQuery(
+    QueryId const & qid, std::string const & queryJson) {
+  this->getPeers().forEach([&, this](Identity const & other) {
+    if (other == this->getSelf()) {
+      return;
+    }
+    std::unique_ptr<OutgoingMessage> omsg(new OutgoingMessage(other));
+    omsg->write<uint8_t>(DAEMON_QUERY);
+    omsg->write<QueryId>(qid);
+    omsg->write<uint32_t>(static_cast<uint32_t>(queryJson.size()));
+    omsg->add(
+        reinterpret_cast<uint8_t const *>(queryJson.data()),
+        queryJson.size());
+    this->send(std::move(omsg));
+  });
+}
+
+void QueryDaemon::stop() {
+  log_info("Query daemon stopping");
+  this->spool->markStopped();
+
+  this->getPeers().forEach([this](Identity const & other) {
+    if (other == this->getSelf()) {
+      return;
+    }
+    std::unique_ptr<OutgoingMessage> omsg(new OutgoingMessage(other));
+    omsg->write<uint8_t>(DAEMON_STOP);
+    this->send(std::move(omsg));
+  });
+
+  this->stopping = true;
+}
+
+void QueryDaemon::completeIfDone() {
+  if (this->stopping && this->running.empty()) {
+    this->complete();
+  }
+}
+
+} // namespace safrn
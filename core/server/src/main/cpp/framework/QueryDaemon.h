@@ -0,0 +1,142 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_QUERY_DAEMON_H_
+#define SAFRN_QUERY_DAEMON_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <string>
+
+/* 3rd Party Headers */
+
+/* SAFRN Headers */
+#include <Identity.h>
+#include <JSON/Config/StudyConfig.h>
+#include <JSON/Query/Query.h>
+#include <PeerSet.h>
+#include <framework/Framework.h>
+#include <framework/QueryId.h>
+#include <framework/SpoolWatcher.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+/**
+ * Settings a daemon applies to every query it runs.
+ */
+struct DaemonConfig {
+  std::string dataFile;
+  std::string lookupTableDirectory;
+  std::string randomnessDirectory;
+
+  /**
+   * Directory of query files to run. Exactly one party, a recipient,
+   * is given a spool directory and coordinates the others.
+   */
+  std::string spoolDirectory;
+
+  size_t maxConcurrentQueries = 8;
+};
+
+/**
+ * Root fronctocol of a long lived SAFRN server.
+ *
+ * It runs once for the whole life of the process, with every party of
+ * the study as its peers, so the connections and the parsed study stay
+ * up between queries. Each query runs as a child fronctocol of the
+ * daemon, several at once, and fortissimo routes their messages to
+ * them over the daemon's connections, as it does for any children.
+ *
+ * The coordinator picks query files up from its spool directory,
+ * assigns each the next QueryId and forwards it to the other daemons,
+ * which all start the query's fronctocol in the same order. They
+ * check that QueryIds arrive in sequence, since fortissimo matches
+ * children by the order they are invoked in. A file named "stop" in
+ * the spool directory shuts every daemon down once the queries
+ * spooled before it are done.
+ *
+ * Fortissimo has no timers, so the spool is watched by a SpoolWatcher
+ * rather than polled from a message loop. While queries run, spooled
+ * files are admitted as they complete. Once none run, nothing else
+ * can reach the daemons, so the coordinator blocks on the watcher
+ * until a file is spooled.
+ */
+class QueryDaemon : public Fronctocol {
+public:
+  QueryDaemon(StudyConfig const & scfg, DaemonConfig const & config);
+
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+private:
+  struct RunningQuery {
+    QueryId queryId;
+
+    /** The query is kept alive for as long as its fronctocol runs. */
+    std::unique_ptr<Query> query;
+
+    /** The spool file it came from, on the coordinator. */
+    std::string spoolFile;
+  };
+
+  StudyConfig const & studyCfg;
+  DaemonConfig const config;
+
+  /** Queries in progress, by their fronctocol. */
+  std::map<Fronctocol const *, RunningQuery> running;
+
+  /** The coordinator's watch on its spool directory. */
+  std::unique_ptr<SpoolWatcher> spool;
+
+  /** The next QueryId to assign, or to expect from the coordinator. */
+  uint64_t nextQueryId = 0;
+  bool stopping = false;
+
+  bool isCoordinator() const {
+    return !this->config.spoolDirectory.empty();
+  }
+
+  /**
+   * Parses a query and invokes this party's fronctocol for it. Returns
+   * false if the query is invalid or this party is not a participant.
+   */
+  bool startQuery(
+      QueryId const & qid,
+      std::string const & queryJson,
+      std::string const & spoolFile);
+
+  /**
+   * Starts spooled queries, up to the concurrency limit, then stops if
+   * the spool holds a stop file and no more queries. Never blocks.
+   */
+  void admitQueries();
+
+  /**
+   * Admits spooled queries, first waiting for one to be spooled if
+   * none are running.
+   */
+  void awaitQueries();
+
+  void forwardQuery(QueryId const & qid, std::string const & queryJson);
+  void stop();
+  void completeIfDone();
+};
+
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_QUERY_DAEMON_H_
@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <string>
+
+/* SAFRN Headers */
+#include <Util/Utils.h>
+
+#include <framework/QueryId.h>
+
+namespace safrn {
+
+bool QueryId::operator<(QueryId const & other) const {
+  if (this->studyId != other.studyId) {
+    return this->studyId < other.studyId;
+  }
+  if (this->analyst != other.analyst) {
+    return this->analyst < other.analyst;
+  }
+  return this->queryId < other.queryId;
+}
+
+bool QueryId::operator>(QueryId const & other) const {
+  return other < *this;
+}
+
+bool QueryId::operator<=(QueryId const & other) const {
+  return !(*this > other);
+}
+
+bool QueryId::operator>=(QueryId const & other) const {
+  return !(*this < other);
+}
+
+bool QueryId::operator==(QueryId const & other) const {
+  return this->studyId == other.studyId &&
+      this->analyst == other.analyst && this->queryId == other.queryId;
+}
+
+bool QueryId::operator!=(QueryId const & other) const {
+  return !(*this == other);
+}
+
+std::string QueryId::str() const {
+  return dbuidToStr(this->studyId) + "/" + dbuidToStr(this->analyst) +
+      "/" + std::to_string(this->queryId);
+}
+
+} // namespace safrn
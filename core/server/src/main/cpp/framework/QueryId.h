@@ -0,0 +1,72 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_QUERY_ID_H_
+#define SAFRN_QUERY_ID_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <string>
+
+/* 3rd Party Headers */
+#include <ff/Message.h>
+
+/* SAFRN Headers */
+#include <Util/Utils.h>
+
+namespace safrn {
+
+/**
+ * A given query is identified by a StudyID (assigned by dashboard) and
+ * a query id (assigned sequentially by the analyst).
+ */
+struct QueryId {
+  dbuid_t studyId;
+  dbuid_t analyst; // analyst who started this query
+  uint64_t queryId; // sequentially assigned by given analyst
+
+  bool operator<(QueryId const & other) const;
+  bool operator>(QueryId const & other) const;
+  bool operator<=(QueryId const & other) const;
+  bool operator>=(QueryId const & other) const;
+
+  bool operator==(QueryId const & other) const;
+  bool operator!=(QueryId const & other) const;
+
+  /**
+   * Printable form, for logging.
+   */
+  std::string str() const;
+};
+
+} // namespace safrn
+
+namespace ff {
+
+template<typename Identity_T>
+bool msg_read(
+    ff::IncomingMessage<Identity_T> & imsg, safrn::QueryId & qid) {
+  bool ret = true;
+  ret = ret && imsg.remove(&qid.studyId[0], safrn::DBUID_LENGTH);
+  ret = ret && imsg.remove(&qid.analyst[0], safrn::DBUID_LENGTH);
+  ret = ret && imsg.template read<uint64_t>(qid.queryId);
+  return ret;
+}
+
+template<typename Identity_T>
+bool msg_write(
+    ff::OutgoingMessage<Identity_T> & omsg,
+    safrn::QueryId const & qid) {
+  bool ret = true;
+  ret = ret && omsg.add(&qid.studyId[0], safrn::DBUID_LENGTH);
+  ret = ret && omsg.add(&qid.analyst[0], safrn::DBUID_LENGTH);
+  ret = ret && omsg.template write<uint64_t>(qid.queryId);
+  return ret;
+}
+
+} // namespace ff
+
+#endif //SAFRN_QUERY_ID_H_
@@ -0,0 +1,122 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+#include <dirent.h>
+#include <errno.h>
+#include <limits.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+/* C++ Headers */
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* SAFRN Headers */
+#include <framework/SpoolWatcher.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+/** Without inotify, the seconds between spool scans. */
+static unsigned int const SPOOL_RESCAN_INTERVAL = 1;
+
+static std::string const QUERY_SUFFIX = ".json";
+static std::string const STOP_FILE = "stop";
+
+static bool endsWith(std::string const & str, std::string const & end) {
+  return str.size() >= end.size() &&
+      str.compare(str.size() - end.size(), end.size(), end) == 0;
+}
+
+SpoolWatcher::SpoolWatcher(std::string const & directory) :
+    directory(directory) {
+#ifdef __linux__
+  this->inotifyFd = inotify_init1(IN_CLOEXEC);
+  if (this->inotifyFd >= 0 &&
+      inotify_add_watch(
+          this->inotifyFd,
+          this->directory.c_str(),
+          IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+    close(this->inotifyFd);
+    this->inotifyFd = -1;
+  }
+#endif
+  if (this->inotifyFd < 0) {
+    log_warn(
+        "Not watching spool directory \"%s\", rescanning it every %us",
+        this->directory.c_str(),
+        SPOOL_RESCAN_INTERVAL);
+  }
+}
+
+SpoolWatcher::~SpoolWatcher() {
+  if (this->inotifyFd >= 0) {
+    close(this->inotifyFd);
+  }
+}
+
+std::vector<std::string> SpoolWatcher::queries() const {
+  std::vector<std::string> files;
+  DIR * dir = opendir(this->directory.c_str());
+  if (dir == nullptr) {
+    log_error(
+        "Could not open spool directory \"%s\"",
+        this->directory.c_str());
+    return files;
+  }
+
+  for (dirent * ent = readdir(dir); ent != nullptr;
+       ent = readdir(dir)) {
+    std::string const name(ent->d_name);
+    if (endsWith(name, QUERY_SUFFIX)) {
+      files.push_back(this->directory + "/" + name);
+    }
+  }
+  closedir(dir);
+
+  std::sort(files.begin(), files.end());
+  return files;
+}
+
+bool SpoolWatcher::stopRequested() const {
+  return access((this->directory + "/" + STOP_FILE).c_str(), F_OK) ==
+      0;
+}
+
+void SpoolWatcher::markStopped() const {
+  std::string const stop_file = this->directory + "/" + STOP_FILE;
+  std::rename(stop_file.c_str(), (stop_file + ".done").c_str());
+}
+
+void SpoolWatcher::wait() {
+  if (this->inotifyFd < 0) {
+    sleep(SPOOL_RESCAN_INTERVAL);
+    return;
+  }
+
+#ifdef __linux__
+  /* Events are only a wake up, the caller rescans the directory. */
+  char events[16 * (sizeof(inotify_event) + NAME_MAX + 1)];
+  while (read(this->inotifyFd, events, sizeof(events)) < 0) {
+    if (errno != EINTR) {
+      log_error("Could not watch spool directory, rescanning it");
+      close(this->inotifyFd);
+      this->inotifyFd = -1;
+      sleep(SPOOL_RESCAN_INTERVAL);
+      return;
+    }
+  }
+#endif
+}
+
+} // namespace safrn
@@ -0,0 +1,76 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_SPOOL_WATCHER_H_
+#define SAFRN_SPOOL_WATCHER_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* SAFRN Headers */
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+/**
+ * Watches a QueryDaemon's spool directory of query files.
+ *
+ * A query file is named *.json. It is claimed by renaming it to
+ * *.json.running, and renamed again to *.json.done or *.json.failed
+ * once it is finished. A file named "stop" asks the daemons to shut
+ * down, and is renamed to "stop.done" when they do.
+ *
+ * On Linux the directory is watched with inotify, from construction
+ * on, so that wait() sleeps until a file is written or moved into it
+ * and no file is missed between a scan and the next wait(). Elsewhere
+ * wait() sleeps for a rescan interval.
+ */
+class SpoolWatcher {
+public:
+  explicit SpoolWatcher(std::string const & directory);
+  ~SpoolWatcher();
+
+  SpoolWatcher(SpoolWatcher const &) = delete;
+  SpoolWatcher & operator=(SpoolWatcher const &) = delete;
+
+  /**
+   * Query files not yet claimed, in name order.
+   */
+  std::vector<std::string> queries() const;
+
+  /**
+   * Whether the spool holds a stop file.
+   */
+  bool stopRequested() const;
+
+  /**
+   * Renames the stop file to mark that the daemons have stopped.
+   */
+  void markStopped() const;
+
+  /**
+   * Blocks until the directory may have changed. Wakes spuriously for
+   * the daemon's own renames, so callers rescan and wait again.
+   */
+  void wait();
+
+  std::string const directory;
+
+private:
+  int inotifyFd = -1;
+};
+
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_SPOOL_WATCHER_H_
@@ -241,6 +241,17 @@ void RegressionReceiver::handleReceive(IncomingMessage & imsg) {
     }
   }
 
+  for (std::vector<dataowner::LargeNum> & moments :
+       this->momentsResults) {
+    for (size_t i = 0; i < moments.size(); i++) {
+      dataowner::LargeNum res = 0;
+      imsg.read<dataowner::LargeNum>(res);
+
+      moments[i] =
+          ff::mpc::modAdd(moments[i], res, this->info->endModulus);
+    }
+  }
+
   this->numDataowners--;
   if (this->numDataowners == 0) {
     std::vector<double> results_cast;
@@ -248,6 +259,7 @@ void RegressionReceiver::handleReceive(IncomingMessage & imsg) {
       results_cast.push_back(castToDouble(
           num, this->bitsOfPrecision, this->info->endModulus));
     }
+    this->coefficients = results_cast;
     std::vector<double> s_e_coeffs_cast;
     for (dataowner::LargeNum num : this->standardErrorCoeffs) {
       s_e_coeffs_cast.push_back(castToDouble(
@@ -291,6 +303,18 @@ void RegressionReceiver::handleReceive(IncomingMessage & imsg) {
             F_p_value, this->info->bytesInLookupTableCells),
         t_p_values_converted,
         this->info->bytesInLookupTableCells);
+
+    for (size_t i = 0; i < this->momentsResults.size(); i++) {
+      std::vector<dataowner::SmallNum> resultsDowncast;
+      for (dataowner::LargeNum num : this->momentsResults[i]) {
+        resultsDowncast.push_back(
+            static_cast<dataowner::SmallNum>(num));
+      }
+      MomentsPrettyPrint(
+          resultsDowncast,
+          this->info->batchedMoments[i].includeCount,
+          this->bitsOfPrecision);
+    }
     this->complete();
   }
 }
@@ -25,6 +25,7 @@
 #include <dataowner/RegressionInfo.h>
 #include <dataowner/fortissimo.h>
 #include <framework/Framework.h>
+#include <recipient/MomentsReceiver.h>
 
 namespace safrn {
 namespace recipient {
@@ -60,10 +61,17 @@ public:
   std::vector<dataowner::LargeNum> results;
   std::vector<dataowner::LargeNum> standardErrorCoeffs;
 
+  /** The coefficients as doubles, once every dataowner has replied. */
+  std::vector<double> coefficients;
+
   std::vector<Boolean_t> F_p_value;
   std::vector<std::vector<Boolean_t>> t_p_values;
   dataowner::LargeNum rootMSE = 0;
   dataowner::LargeNum rsquare = 0;
+
+  /** Results of each batched moments function, as MomentsReceiver. */
+  std::vector<std::vector<dataowner::LargeNum>> momentsResults;
+
   size_t numDataowners = 0;
 
   RegressionReceiver(
@@ -95,6 +103,11 @@ public:
               this->info->verticalNonDV_numIVs,
           std::vector<Boolean_t>(
               this->info->bytesInLookupTableCells, 0x00)) {
+    for (dataowner::BatchedMoments const & moments :
+         this->info->batchedMoments) {
+      this->momentsResults.emplace_back(
+          moments.highestMoment + (moments.includeCount ? 1 : 0), 0);
+    }
   }
 
   void init() override;
@@ -0,0 +1,121 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <algorithm>
+#include <vector>
+
+/* 3rd Party Headers */
+
+/* Safrn Headers */
+#include <util/LargeNumArray.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+using dataowner::LargeNum;
+
+/** Arrays are encoded in blocks of this many bytes. */
+static size_t const ARRAY_BLOCK_BYTES = 1 << 16;
+
+size_t fixedWidthBytes(LargeNum const & modulus) {
+  size_t bytes = 0;
+  for (LargeNum v = modulus - 1; v > 0; v /= 256) {
+    bytes++;
+  }
+  return std::max(bytes, static_cast<size_t>(1));
+}
+
+void encodeFixedWidth(
+    LargeNum const & val, uint8_t * out, size_t const width) {
+  if (width <= sizeof(uint64_t)) {
+    uint64_t const word = static_cast<uint64_t>(val);
+    for (size_t i = 0; i < width; i++) {
+      out[i] = static_cast<uint8_t>(word >> (8 * i));
+    }
+    return;
+  }
+
+  /* a word at a time, least significant first. */
+  LargeNum v = val;
+  for (size_t offset = 0; offset < width; offset += sizeof(uint64_t)) {
+    LargeNum const high = v >> 64;
+    uint64_t const word = static_cast<uint64_t>(v - (high << 64));
+    size_t const len = std::min(sizeof(uint64_t), width - offset);
+    for (size_t i = 0; i < len; i++) {
+      out[offset + i] = static_cast<uint8_t>(word >> (8 * i));
+    }
+    v = high;
+  }
+}
+
+void decodeFixedWidth(
+    uint8_t const * in, size_t const width, LargeNum & val) {
+  size_t const num_words =
+      (width + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+  /* a word at a time, most significant first. */
+  val = 0;
+  for (size_t w = num_words; w > 0; w--) {
+    size_t const offset = (w - 1) * sizeof(uint64_t);
+    size_t const len = std::min(sizeof(uint64_t), width - offset);
+    uint64_t word = 0;
+    for (size_t i = 0; i < len; i++) {
+      word |= static_cast<uint64_t>(in[offset + i]) << (8 * i);
+    }
+    if (w == num_words) {
+      val = LargeNum(word);
+    } else {
+      val = (val << 64) + LargeNum(word);
+    }
+  }
+}
+
+bool writeLargeNumArray(
+    OutgoingMessage & omsg,
+    LargeNum const * vals,
+    size_t const n,
+    size_t const width) {
+  size_t const per_block =
+      std::max(ARRAY_BLOCK_BYTES / width, static_cast<size_t>(1));
+  std::vector<uint8_t> buffer(std::min(n, per_block) * width);
+
+  for (size_t start = 0; start < n; start += per_block) {
+    size_t const count = std::min(per_block, n - start);
+    for (size_t i = 0; i < count; i++) {
+      encodeFixedWidth(vals[start + i], &buffer[i * width], width);
+    }
+    if (!omsg.add(buffer.data(), count * width)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool readLargeNumArray(
+    IncomingMessage & imsg,
+    LargeNum * vals,
+    size_t const n,
+    size_t const width) {
+  size_t const per_block =
+      std::max(ARRAY_BLOCK_BYTES / width, static_cast<size_t>(1));
+  std::vector<uint8_t> buffer(std::min(n, per_block) * width);
+
+  for (size_t start = 0; start < n; start += per_block) {
+    size_t const count = std::min(per_block, n - start);
+    if (!imsg.remove(buffer.data(), count * width)) {
+      return false;
+    }
+    for (size_t i = 0; i < count; i++) {
+      decodeFixedWidth(&buffer[i * width], width, vals[start + i]);
+    }
+  }
+  return true;
+}
+
+} // namespace safrn
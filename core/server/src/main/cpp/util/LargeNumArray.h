@@ -0,0 +1,75 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_UTIL_LARGE_NUM_ARRAY_H_
+#define SAFRN_UTIL_LARGE_NUM_ARRAY_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <cstdint>
+
+/* 3rd Party Headers */
+
+/* Safrn Headers */
+#include <dataowner/fortissimo.h>
+#include <framework/Framework.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+/*
+ * Bulk serialization of LargeNum arrays.
+ *
+ * Every value of an array reduced modulo p takes the same number of
+ * bytes, just enough to hold p - 1, little-endian. Arrays are encoded
+ * into a buffer and moved in or out of the message a block at a time,
+ * rather than one LargeNum at a time.
+ */
+
+/**
+ * Bytes taken by each value of an array reduced modulo p.
+ */
+size_t fixedWidthBytes(dataowner::LargeNum const & modulus);
+
+/**
+ * Encodes a value into width bytes, little-endian. The value must fit.
+ */
+void encodeFixedWidth(
+    dataowner::LargeNum const & val, uint8_t * out, size_t const width);
+
+/**
+ * Decodes a value from width bytes, little-endian.
+ */
+void decodeFixedWidth(
+    uint8_t const * in, size_t const width, dataowner::LargeNum & val);
+
+/**
+ * Writes n values, each width bytes wide.
+ */
+bool writeLargeNumArray(
+    OutgoingMessage & omsg,
+    dataowner::LargeNum const * vals,
+    size_t const n,
+    size_t const width);
+
+/**
+ * Reads n values, each width bytes wide, as written by
+ * writeLargeNumArray.
+ */
+bool readLargeNumArray(
+    IncomingMessage & imsg,
+    dataowner::LargeNum * vals,
+    size_t const n,
+    size_t const width);
+
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_UTIL_LARGE_NUM_ARRAY_H_
@@ -0,0 +1,266 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <mpc/ModUtils.h>
+
+/* Safrn Headers */
+#include <util/ModColumns.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+using dataowner::LargeNum;
+
+namespace {
+
+using uint128_t = unsigned __int128;
+
+/** Values are drawn this many at a time, to bound the buffer. */
+size_t const RANDOM_BLOCK = 1024;
+
+size_t bitLength(LargeNum v) {
+  size_t bits = 0;
+  while (v > 0) {
+    v /= 2;
+    bits++;
+  }
+  return bits;
+}
+
+uint128_t toWords(LargeNum const & v) {
+  LargeNum const hi = v >> 64;
+  LargeNum const lo = v - (hi << 64);
+  return (static_cast<uint128_t>(static_cast<uint64_t>(hi)) << 64) |
+      static_cast<uint64_t>(lo);
+}
+
+LargeNum fromWords(uint128_t const v) {
+  uint64_t const hi = static_cast<uint64_t>(v >> 64);
+  uint64_t const lo = static_cast<uint64_t>(v);
+  if (hi == 0) {
+    return LargeNum(lo);
+  }
+  return (LargeNum(hi) << 64) + LargeNum(lo);
+}
+
+/**
+ * Reduces a value which is usually, but not always, below p already.
+ */
+template<typename Word_T>
+Word_T reduce(Word_T const v, Word_T const p) {
+  return (v < p) ? v : v % p;
+}
+
+/**
+ * Full 256-bit product of two 128-bit words.
+ */
+void mulWide(
+    uint128_t const a,
+    uint128_t const b,
+    uint128_t & hi,
+    uint128_t & lo) {
+  uint128_t const a0 = static_cast<uint64_t>(a);
+  uint128_t const a1 = a >> 64;
+  uint128_t const b0 = static_cast<uint64_t>(b);
+  uint128_t const b1 = b >> 64;
+
+  uint128_t const p00 = a0 * b0;
+  uint128_t const p01 = a0 * b1;
+  uint128_t const p10 = a1 * b0;
+  uint128_t const p11 = a1 * b1;
+
+  uint128_t const mid = (p00 >> 64) + static_cast<uint64_t>(p01) +
+      static_cast<uint64_t>(p10);
+  lo = (mid << 64) | static_cast<uint64_t>(p00);
+  hi = p11 + (p01 >> 64) + (p10 >> 64) + (mid >> 64);
+}
+
+/**
+ * Montgomery multiplication modulo an odd p < 2^127, with R = 2^128.
+ */
+class Montgomery128 {
+public:
+  explicit Montgomery128(LargeNum const & modulus) :
+      p(toWords(modulus)),
+      r2(toWords((LargeNum(1) << 256) % modulus)) {
+    /* Newton's iteration doubles the correct low bits each time. */
+    uint128_t inv = this->p;
+    for (size_t i = 0; i < 6; i++) {
+      inv *= 2 - this->p * inv;
+    }
+    this->negInv = 0 - inv;
+  }
+
+  /** a * b mod p, for a, b < p. */
+  uint128_t mulMod(uint128_t const a, uint128_t const b) const {
+    return this->mul(this->mul(a, b), this->r2);
+  }
+
+private:
+  uint128_t p;
+  uint128_t r2; // R^2 mod p
+  uint128_t negInv; // -p^-1 mod R
+
+  /** a * b / R mod p. */
+  uint128_t mul(uint128_t const a, uint128_t const b) const {
+    uint128_t t_hi, t_lo;
+    mulWide(a, b, t_hi, t_lo);
+
+    uint128_t const m = t_lo * this->negInv;
+    uint128_t mp_hi, mp_lo;
+    mulWide(m, this->p, mp_hi, mp_lo);
+
+    /* the low words cancel, but may carry. */
+    uint128_t const carry = (t_lo + mp_lo < t_lo) ? 1 : 0;
+    uint128_t t = t_hi + mp_hi + carry;
+    if (t >= this->p) {
+      t -= this->p;
+    }
+    return t;
+  }
+};
+
+} // namespace
+
+void randomModPColumn(
+    SeedPrg & prg,
+    LargeNum const & p,
+    LargeNum * out,
+    size_t const n) {
+  size_t const bits = bitLength(p - 1);
+  if (bits > 127) {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = prg.randomModP(p);
+    }
+    return;
+  }
+
+  size_t const words = (bits > 64) ? 2 : 1;
+  uint128_t const p_words = toWords(p);
+  uint128_t const mask = (static_cast<uint128_t>(1) << bits) - 1;
+
+  std::vector<uint64_t> block(RANDOM_BLOCK * words);
+  for (size_t start = 0; start < n; start += RANDOM_BLOCK) {
+    size_t const count = std::min(RANDOM_BLOCK, n - start);
+    prg.bytes(
+        reinterpret_cast<uint8_t *>(block.data()),
+        count * words * sizeof(uint64_t));
+
+    for (size_t i = 0; i < count; i++) {
+      uint64_t * draw = &block[i * words];
+      uint128_t v = 0;
+      while (true) {
+        v = draw[0];
+        if (words == 2) {
+          v |= static_cast<uint128_t>(draw[1]) << 64;
+        }
+        v &= mask;
+        if (v < p_words) {
+          break;
+        }
+        prg.bytes(
+            reinterpret_cast<uint8_t *>(draw),
+            words * sizeof(uint64_t));
+      }
+      out[start + i] = fromWords(v);
+    }
+  }
+}
+
+void modAddColumn(
+    LargeNum const * a,
+    LargeNum const * b,
+    LargeNum * out,
+    size_t const n,
+    LargeNum const & p) {
+  size_t const bits = bitLength(p);
+  if (bits > 127) {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = ff::mpc::modAdd(a[i], b[i], p);
+    }
+  } else if (bits > 64) {
+    uint128_t const p_words = toWords(p);
+    for (size_t i = 0; i < n; i++) {
+      uint128_t const x = reduce(toWords(a[i]), p_words);
+      uint128_t const y = reduce(toWords(b[i]), p_words);
+      out[i] = fromWords(x >= p_words - y ? x - (p_words - y) : x + y);
+    }
+  } else {
+    uint64_t const p_word = static_cast<uint64_t>(p);
+    for (size_t i = 0; i < n; i++) {
+      uint64_t const x = reduce(static_cast<uint64_t>(a[i]), p_word);
+      uint64_t const y = reduce(static_cast<uint64_t>(b[i]), p_word);
+      out[i] = LargeNum(x >= p_word - y ? x - (p_word - y) : x + y);
+    }
+  }
+}
+
+void modSubColumn(
+    LargeNum const * a,
+    LargeNum const * b,
+    LargeNum * out,
+    size_t const n,
+    LargeNum const & p) {
+  size_t const bits = bitLength(p);
+  if (bits > 127) {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = ff::mpc::modSub(a[i], b[i], p);
+    }
+  } else if (bits > 64) {
+    uint128_t const p_words = toWords(p);
+    for (size_t i = 0; i < n; i++) {
+      uint128_t const x = reduce(toWords(a[i]), p_words);
+      uint128_t const y = reduce(toWords(b[i]), p_words);
+      out[i] = fromWords(x >= y ? x - y : x + (p_words - y));
+    }
+  } else {
+    uint64_t const p_word = static_cast<uint64_t>(p);
+    for (size_t i = 0; i < n; i++) {
+      uint64_t const x = reduce(static_cast<uint64_t>(a[i]), p_word);
+      uint64_t const y = reduce(static_cast<uint64_t>(b[i]), p_word);
+      out[i] = LargeNum(x >= y ? x - y : x + (p_word - y));
+    }
+  }
+}
+
+void modMulColumn(
+    LargeNum const * a,
+    LargeNum const * b,
+    LargeNum * out,
+    size_t const n,
+    LargeNum const & p) {
+  size_t const bits = bitLength(p);
+  if (bits > 127 || (bits > 64 && p % 2 == 0)) {
+    for (size_t i = 0; i < n; i++) {
+      out[i] = ff::mpc::modMul(a[i], b[i], p);
+    }
+  } else if (bits > 64) {
+    Montgomery128 const mont(p);
+    uint128_t const p_words = toWords(p);
+    for (size_t i = 0; i < n; i++) {
+      out[i] = fromWords(mont.mulMod(
+          reduce(toWords(a[i]), p_words),
+          reduce(toWords(b[i]), p_words)));
+    }
+  } else {
+    uint64_t const p_word = static_cast<uint64_t>(p);
+    for (size_t i = 0; i < n; i++) {
+      uint128_t const x = static_cast<uint64_t>(a[i]);
+      uint128_t const y = static_cast<uint64_t>(b[i]);
+      out[i] = LargeNum(static_cast<uint64_t>((x * y) % p_word));
+    }
+  }
+}
+
+} // namespace safrn
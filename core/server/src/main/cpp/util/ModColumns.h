@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_UTIL_MOD_COLUMNS_H_
+#define SAFRN_UTIL_MOD_COLUMNS_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+
+/* 3rd Party Headers */
+
+/* Safrn Headers */
+#include <dataowner/fortissimo.h>
+#include <util/SeedPrg.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+/*
+ * Modular arithmetic over whole columns of LargeNums.
+ *
+ * When the modulus is below 2^64, or below 2^127, each value is
+ * unpacked once into one or two machine words and the arithmetic runs
+ * on native integers (128-bit products are reduced by Montgomery
+ * multiplication). Larger moduli fall back to fortissimo's
+ * per-element operations.
+ */
+
+/**
+ * Fills out[0..n) with values drawn uniformly from [0, p).
+ */
+void randomModPColumn(
+    SeedPrg & prg,
+    dataowner::LargeNum const & p,
+    dataowner::LargeNum * out,
+    size_t const n);
+
+/**
+ * out[i] = a[i] + b[i] mod p, for reduced a[i] and b[i]. out may alias
+ * a or b.
+ */
+void modAddColumn(
+    dataowner::LargeNum const * a,
+    dataowner::LargeNum const * b,
+    dataowner::LargeNum * out,
+    size_t const n,
+    dataowner::LargeNum const & p);
+
+/**
+ * out[i] = a[i] - b[i] mod p, for reduced a[i] and b[i]. out may alias
+ * a or b.
+ */
+void modSubColumn(
+    dataowner::LargeNum const * a,
+    dataowner::LargeNum const * b,
+    dataowner::LargeNum * out,
+    size_t const n,
+    dataowner::LargeNum const & p);
+
+/**
+ * out[i] = a[i] * b[i] mod p, for reduced a[i] and b[i]. out may alias
+ * a or b.
+ */
+void modMulColumn(
+    dataowner::LargeNum const * a,
+    dataowner::LargeNum const * b,
+    dataowner::LargeNum * out,
+    size_t const n,
+    dataowner::LargeNum const & p);
+
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_UTIL_MOD_COLUMNS_H_
@@ -0,0 +1,305 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <map>
+#include <mutex>
+
+/* 3rd Party Headers */
+#include <mpc/ModUtils.h>
+
+/* Safrn Headers */
+#include <util/PrimeCatalogue.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+using dataowner::LargeNum;
+
+namespace {
+
+/**
+ * PRIME_OFFSETS[k - 2] is the smallest d such that 2^k + d is prime.
+ *
+ * Generated offline by sieving odd d against the primes below 20000
+ * and confirming the first survivor with OpenSSL's BN_check_prime.
+ * PrimeCatalogue.test.cpp checks entries against ff::mpc::nextPrime.
+ */
+uint16_t const PRIME_OFFSETS[] = {
+       1,    3,    1,    5,    3,    3,    1,    9,    7,    5, // 2
+       3,   17,   27,    3,    1,   29,    3,   21,    7,   17, // 12
+      15,    9,   43,   35,   15,   29,    3,   11,    3,   11, // 22
+      15,   17,   25,   53,   31,    9,    7,   23,   15,   27, // 32
+      15,   29,    7,   59,   15,    5,   21,   69,   55,   21, // 42
+      21,    5,  159,    3,   81,    9,   69,  131,   33,   15, // 52
+     135,   29,   13,  131,    9,    3,   33,   29,   25,   11, // 62
+      15,   29,   37,   33,   15,   11,    7,   23,   13,   17, // 72
+       9,   75,    3,  171,   27,   39,    7,   29,  133,   59, // 82
+      25,  105,  129,    9,   61,  105,    7,  255,  277,   81, // 92
+     267,   81,  111,   39,   99,   39,   33,  147,   27,   51, // 102
+      25,  281,   43,   71,   33,   29,   25,    9,  451,   41, // 112
+     277,  165,   67,   27,    7,   29,   51,   17,  169,   39, // 122
+      67,   27,   27,   33,   85,  155,   87,  155,   37,    5, // 132
+     217,    5,  175,   27,   85,   51,   91,   69,  147,   45, // 142
+     253,   95,   27,   15,   45,   69,   97,  299,    7,  107, // 152
+      19,   21,  117,  141,   85,   83,   87,  147,   49,  129, // 162
+     105,   77,    7,    9,  427,   75,   87,  309,   15,  165, // 172
+      49,  215,   27,  159,  205,  303,   57,   35,  129,    5, // 182
+     133,   65,   27,   35,   21,  107,   15,  101,  235,  351, // 192
+      67,   15,    7,  581,   33,  203,  375,   47,   33,   71, // 202
+      57,   75,    7,  251,  423,  129,  163,  185,  217,   81, // 212
+      49,  189,  735,  119,  735,  483,    3,  249,   67,  105, // 222
+     357,  431,   43,   81,   25,  249,   67,   29,  115,  261, // 232
+      69,   59,  133,  315,  337,   63,   81,  119,   25,   65, // 242
+     421,   39,   79,   95,  297,  155,   73,  435,  223,  105, // 252
+      79,    9,  175,   77,  133,  309,   43,  245,  127,  855, // 262
+      57,    5,   63,  363,  157,  101,  117,   89,   45,  197, // 272
+     159,  375,  343,   17,   43,   35,  127,  101,  553,   71, // 282
+      13,  239,   67,    9,   61,   11,  463,  443,  157,   27, // 292
+     307,  101,   37,  131,   45,  135,   27,  659,   15,  111, // 302
+      91,  125,   93,   81,   87,    9,  933,    9,   27,  165, // 312
+     219,  273,  397,  137,  249,    9,   15,   39,   93,  203, // 322
+     393,  285,  507,  173,  241,   71,   97,  185,  291,    5, // 332
+      15,  225,  231,  107, 1039,  441,  241,  377,  427,  143, // 342
+      55,  141,  805,  141,  691,  231,  417,   23,  105,  281, // 352
+     705,  309,  867,  239,  309,   69,  127,   65,   69,  329, // 362
+     147,  585,  289,   81,  115,  435,   25,   99,  127,  507, // 372
+     255,  369,  231,  189,  235,  789,  133,   89,    3,  885, // 382
+     207,   77,   97,   29,  231,  387,  127,   51,  181,  807, // 392
+     505,  293,   55,  539,  129,  309,   37,   29,   33,   63, // 402
+      67,  221,  315,  323,  235,  245,  163,  299,   45,  105, // 412
+     163,  309,  163,   57,  423,   69,  345,  131,   73,  173, // 422
+    1093,  335,  103,  561,  295,  117,   25,  101,  187,  227, // 432
+     189,   53,  267,   41,   33,   99,  211,  459,  213,   23, // 442
+      37,   89,  375,  105,   21,  519,  127,  101, 1257,  321, // 452
+     567,   81,  841,   29,  423,  329,  765,  879,   99,  659, // 462
+     445,  149,  309, 1235,  223,  315,  583,  221,  165,   65, // 472
+     475,  329,  333,  165,  207,  443,  777,  179,  655,  813, // 482
+      21,  549,  375,   51,  583,  159,  375,  161,   55,  519, // 492
+      49,  165,  133,   51,  559,  351,   15,   35,   15,  111, // 502
+      75,  159,  169,   15,  121,  357,   37,  393,  513,  887, // 512
+     345,  375,  117,  731,  697,  249,  381,   69,  189,  375, // 522
+     123,  279,  675,   83,   37,  701,   87,  119,   31,  729, // 532
+      93,  989,  163,  845,   15,  809,  453,  261, 1005,  335, // 542
+      81,  549,  417,  345,   63,  357,   33,  153,  211,  701, // 552
+      45,  459,  115,  669,  427, 1163,   51,  369,   25,   71, // 562
+      57,   11,  129,  131,  243,  489,  177,  333,  133,  321, // 572
+     135,  629,  253,  407,   73,  303,    7,  405,  445, 1335, // 582
+      87,  405,  315,  575,   67,  159,  279,  323,  187,   51, // 592
+     265,  129,  337,   77,  477,  485,  253,  369,    7,  261, // 602
+     297,  417,  933,  119,  175,  599,  267,   59, 1063,  135, // 612
+     555,   83,  451,  249,  483,  143,  121,   41,  715, 1281, // 622
+     391, 2081,  249, 1533, 1041,  591,   69,  413,  115,  681, // 632
+    1165,   59,  247,  497,  573,  473,   81,  329,  385,   89, // 642
+     445,  159,   19,  549,   81,  555,   69,  681,  765,  165, // 652
+    1005,  219,  331, 1875,  439,  141,  385, 1067,    9,  299, // 662
+     583,  101,  603,  269, 1155,  357,  229,  323,  211, 2235, // 672
+    1795,   83,  183,   27,  303,  285,  165,  515,   85,  135, // 682
+     651,   35,  115,  225,  681,    9, 1275, 1719,  535,  321, // 692
+    2049,  203,  327, 2217,  105,   93,  141,  407,  337,  203, // 702
+     265,  515,   19,  473,  883,   51, 1753,  113,  141,  279, // 712
+    1225,  119,  177,  629,  789,  155,  505,  939,  273,  345, // 722
+      81,  639,  117,  411,  297,  837,  847,   51,  345,   81, // 732
+     519,  239,  975,  267,  207, 1085,  331,  777,  145,  771, // 742
+     417,  701,  295, 1619,  567,  105,  265, 1515,  333,  705, // 752
+     537,  615,  711, 1031, 2143,  699,  183,   17,   63,  365, // 762
+     745, 1091,  745,  825,  247,  605, 1107,  345,  687, 2925, // 772
+     595, 1373,    3,   75,  309,   39,  133,  761,  205,  335, // 782
+     201,  417,  289,   63,  567,  105,    7,  221,   25, 1557, // 792
+     423, 1355,  367, 1505,  117,  149,   15,  107,  669,   65, // 802
+     603,  129,  235,  179,  127,  359,  417,  165, 1105,  929, // 812
+     169, 1469,  285,  231,  417, 1421, 1041,  197,   63,  129, // 822
+     637,  225,   37,  245,   61,   29, 2925,   41,  133,  617, // 832
+     427,  225,   31,   77,  945,  959,  673, 1691,  235,   33, // 842
+      43,   59,  525,  635,  147,  135,  385,   53, 1131,  131, // 852
+    1815, 1721,  213,  885,  369,  575,  237,  719,  453,  209, // 862
+    4395,  275,  837,  809, 1657,  599,  117,  723,  541,  707, // 872
+     613,  309,  175,  761,    9,  621,  565,  939,  645, 1739, // 882
+    1035,   39,  175,  359,  993, 1167,  153,  719,  693, 1149, // 892
+     435,  791,  507,  135,  925,  293,  937, 1101,   39,   21, // 902
+     261, 1319,  903,  329,  445,  555, 1027,  713,  847,  345, // 912
+     219,  105,  165, 1371,    7,  435,  177,  149,  163,  113, // 922
+    1231,  347,   63,   41, 1017,  371,   57, 3083,  471,   69, // 932
+     165,  981,  657,  201,  427, 1133,  465, 1179,  133,  513, // 942
+     267, 1485,  609,  225,   85,  185, 1057,  233, 1465,  501, // 952
+     133,   63,  427, 1029, 1599,   95,  837,  701,  459,  225, // 962
+     333,  125,   43,  431,  115, 3351,   37,   69,  475,  429, // 972
+      87,  249,  403,   77, 2463, 3449,  807,  239, 1657,  521, // 982
+    2431,  921,  169,  515,  403,   21, 2049, 1239,  297,   27, // 992
+     327,  419, 1141, 2007,  979, 2081,  763, 1577, 1729,  873, // 1002
+     267,  149,  205,  413,  285,  611,  583,  285,  393,  459, // 1012
+    1443, 1155,  643, 1481,  537,  855,  187,  639,  603,   23, // 1022
+     877,  227,   79, 3363, 2775,   39,  577,   23,  387, 1629, // 1032
+    1057, 1365, 2493, 3089, 2209,  803,  463,   47,  595, 1515, // 1042
+    1215,  215,  475,   51, 1123, 1529, 1657,  119,  295, 1479, // 1052
+     273,  521,  483,  149,   27,  999, 1215,  227,  163,  693, // 1062
+    1113,  567, 1215,  473,  531,  611,  207,  515,  451,  651, // 1072
+     225, 2543,   67,  981, 2313,   35, 1591,  407,  609, 1133, // 1082
+      93,  689, 2077,  225,  207,  119,   39, 1035, 2191,  485, // 1092
+     147,  203,  913, 2499,  565, 2271,  541,  777,    3, 1121, // 1102
+     313,  149,  927,  405,  297,  161,  537,   53,   73,  209, // 1112
+    1099, 1011,  495, 1367, 1053,  725,  145, 2307,  357,  305, // 1122
+      13,  327,  427,  443,  531, 1547, 1939, 1451,  333,  287, // 1132
+      97, 1779,  273,   35,  817,  513,  571,   95,   85,  635, // 1142
+     561,  125,  427,   95, 1483,  615,  243,   35,   63,  309, // 1152
+     423,  491,  807, 2555,  237, 2685,  597,  455,  397,  375, // 1162
+    3621,  855,  909,  821,  157,  861,   93,  173,  183,  455, // 1172
+      67,  309,   55,  819,  267,  431, 1467,   45,    7,  555, // 1182
+      31, 1085,  849,  203,  301,  921,    7, 2163, 1515,  611, // 1192
+    1927,  221,  351, 2205,  399,   95,  573,  105,  909,  203, // 1202
+     457,  629,  133,  269,  483,  315,  315, 1551,  561,  221, // 1212
+    2509,  743, 2905,  279,   75,   39, 2557,  389,  375, 1443, // 1222
+     141,  477,  805,  141, 1731,   41,  363,  543, 1123,  915, // 1232
+    4075,  221, 1045, 1029,  139,  491,  673,  251, 1447,  299, // 1242
+    2083, 3035,   73,  543,  307, 2265,  373,  749,  585,  255, // 1252
+     657,   51,  415,  687,   93, 1661,  531,   57, 1057, 2769, // 1262
+     745,  539,  153,   71,  315, 1535,  513, 2055, 1815, 2045, // 1272
+    1729, 2303,   81,  561,  397, 1509,  445, 1037,  225,  563, // 1282
+     531, 1199,  595,  645,  927, 4715, 2709,   81,  135,   11, // 1292
+     613,  351,  975, 1215,   99,  165,  873,   81,  705,  233, // 1302
+    1581,  359,  399,  633, 3451, 1415,  925,  183,   57,  561, // 1312
+    1065, 1271, 1057, 3009,  247, 1655,  253,   51, 1245,  609, // 1322
+      81, 5219, 2155,  413,  675, 3791,  717,  155,   85, 1619, // 1332
+       9, 1845, 2467,  917,  349,  555,  837,   39,  315, 1101, // 1342
+     141,   57,  847, 1551,   67,  471,  205,  515,  121,  249, // 1352
+     439,  143, 1797,  239,  787,   51,  595, 1245,   19,  435, // 1362
+     685, 1551,   87,  779,  133, 2915, 2727, 1485, 1863,  881, // 1372
+     265,  753,  133,   65, 2769,  429,  603, 1641,  253,  249, // 1382
+     361,  849,  267,  411, 1107, 1157, 2997,  213,  721,  239, // 1392
+      87, 9273, 4515,   59,  235,  995,  255,  495,   73,  155, // 1402
+     877,  455,  223,  989,  327,  669,  975, 2201,  891,  509, // 1412
+     739, 1109,   85,  297, 3147, 2165,  871,  435, 1639, 1013, // 1422
+     823,  347, 3483,  329,  547,  945,  469, 1965, 3307, 2405, // 1432
+     135,  693,  183, 1677,  655,  489,  427,  785,  535, 1341, // 1442
+     277,  185, 1825,  581,  303, 2205,  775, 1175,  267, 1449, // 1452
+    1567,  369,  261, 1067, 1485,   71, 1561,  957,   75, 1563, // 1462
+     231, 7047, 1939,  363,  201, 5015,  849,  255,  105, 1155, // 1472
+      33,  185,  907, 1899, 1933,  183,  297,  497,  453,  231, // 1482
+     331,  261,  255,  699,   27,  485,  213,   33, 1465,   51, // 1492
+    2227,  855, 1035,  581,  135,   71, 1047, 1397, 1617, 4461, // 1502
+     163, 1275,  249,   59,  655,  431,  295,  659,  187, 1697, // 1512
+    1369,  965, 1135, 5429,  847,  581,  865,  531,  255,  333, // 1522
+     351,  647,  265,  699,   75, 1541,  579,  779,   37,  221, // 1532
+    1803, 1803, 1791, 1881, 1899,  743,  453,  807,  385,  425, // 1542
+    1051,   39,  123,   11,   93, 1839, 1443,  729,  361,  561, // 1552
+    4489,   15, 1411,  149,  609, 1491,  141,  605,   69, 2679, // 1562
+     247, 1799,  309,  873,  457, 1131, 1489,  609, 2707,  221, // 1572
+      39,  413,  253, 4781, 2793,  693, 5461, 3651, 2725, 1959, // 1582
+    1287,  809,  427,  273, 1615,  489, 2823, 1775,  895,  221, // 1592
+    1447,  741,   51, 2315,  135, 3383, 1023,  785, 1947,   81, // 1602
+     393,  431,  879,  125,   21,  435,  247,  105,  315, 2241, // 1612
+     435,  609, 1107, 1215,  577, 1469, 2281, 2409,  385,   21, // 1622
+     505,   27, 3247,  803,   25, 1257, 1129,   81,  105, 3831, // 1632
+    1585, 1451,  561, 2235,  205,   21,  597,  785, 3703, 1121, // 1642
+     727,  717, 2295, 1581,  253,  197,  949,  501,  427,   11, // 1652
+      19, 1025,  117, 1955,  199,  491, 1111,   39,  757,  423, // 1662
+     757,  651,  757,  759, 2185,  161, 1179,  191, 2191, 2457, // 1672
+     499,   51,  627,  621, 5503, 2789, 1443, 1995,  415, 2259, // 1682
+     577, 1485, 1869, 1323,  993, 3639, 2683,  219, 1365,  731, // 1692
+    1995,  351,    3,  615, 1887,  149,  183, 1091, 1599, 2081, // 1702
+    1815,  225,  585,  263,  261,    9,  879, 1601,   57,  665, // 1712
+      19, 1305,  781,  549, 2893,  473,  465,  807, 2515,  501, // 1722
+    1017,  411,   93,  905,  223, 2717, 2697,  221,   73,  275, // 1732
+    1659, 2219, 1525,  879, 3697,  671,  427,  899, 1707,  719, // 1742
+     303,   65, 2169,  633,  837,  347,  757,  155, 2035, 1317, // 1752
+     723, 3245, 2103, 3605,  823,  425, 3135,  407,  393, 1073, // 1762
+      55,  417,  529,  449, 1005,  639, 1549,  303,  697, 1041, // 1772
+    1549,  539,  363,  597,  969, 4233, 1113, 1157,  133,  873, // 1782
+     277, 1755,   73, 2285, 2835, 1745, 3927,  953,  787,  555, // 1792
+     915,   21, 2565, 1517,    7, 2481,  103, 1899,  259, 1419, // 1802
+     115,  275, 1365, 1845, 2061,  651, 1233,  843,  663, 3081, // 1812
+     925,  431,  157,  567, 3537, 1703,  807,  569,  399, 1151, // 1822
+     471, 2549,  357, 2459,  777, 1211,  235,  683, 2145,   51, // 1832
+     669,  659, 1393,   35,  127,  713, 1627,  177, 1873,  605, // 1842
+    3331,  755,  283,    9,  421,  815, 2167, 2169,  735,  477, // 1852
+     649,  485, 1743,  245, 1219,  881,  951, 1335,  519,  491, // 1862
+     561, 1931, 1567,  561,  471, 1191, 1159, 1499,  343,  807, // 1872
+     127,  293, 1885,  407, 1423, 1353,    7, 2801, 1699,  681, // 1882
+     457,  365,  183,  819, 1173, 2729, 2137,   21,  115,  117, // 1892
+    2353, 6029,  453, 1515,  655, 1229,  927, 2037, 1927, 1473, // 1902
+     657, 1937,  477,  905,  357, 2087,  247,  141, 1515,  891, // 1912
+     937,  221,  525, 2189, 2713,  683, 1531, 1097,  717, 1349, // 1922
+     367,  207,  649,  693, 1285, 2619,   45, 5049,  315, 5811, // 1932
+     115,  965, 7933, 1887, 5109,  593,  507,  389,   93, 1235, // 1942
+    2725,  551,  849, 4221, 2005,  545,  169,  351, 2037,  131, // 1952
+    3999,  713,  847, 1011, 2467,  219, 2605,  815,  225, 1893, // 1962
+     331,  749, 1027, 2159,  571, 2471, 1365,   39, 2401, 1485, // 1972
+    1423,  381, 3681,  401, 1239,  185, 2701,  407, 3375,  665, // 1982
+      37,  189, 9919, 1283, 1833, 5091, 1627,  345,  841,  137, // 1992
+    2605,  533,  823,   27,  943, 1883,    3,  767, 1537,  573, // 2002
+     237, 2469,  925, 1245, 4167,  641, 2319,  231, 1813,  729, // 2012
+    1149,  239,  631,  717, 2197, 2813, 1683, 1185, 2533,  905, // 2022
+     225,  285, 1347,  461, 2515,  351, 4143,   33,  261, 3555, // 2032
+     187, 1545, 5257,  875, 4147, 1919,  981, // 2042
+};
+
+size_t const FIRST_CATALOGUED_BITS = 2;
+
+std::mutex memoMutex;
+std::map<LargeNum, LargeNum> memo;
+
+/**
+ * Returns k when n is 2^k, and 0 otherwise.
+ */
+size_t powerOfTwoBits(LargeNum const & n) {
+  if (n < 2) {
+    return 0;
+  }
+  size_t bits = 0;
+  for (LargeNum v = n; v > 1; v = v >> 1) {
+    bits++;
+  }
+  return ((LargeNum(1) << bits) == n) ? bits : 0;
+}
+
+} // namespace
+
+size_t const PRIME_CATALOGUE_MAX_BITS = FIRST_CATALOGUED_BITS +
+    sizeof(PRIME_OFFSETS) / sizeof(PRIME_OFFSETS[0]) - 1;
+
+static bool isCatalogued(size_t const bits) {
+  return bits >= FIRST_CATALOGUED_BITS &&
+      bits <= PRIME_CATALOGUE_MAX_BITS;
+}
+
+LargeNum nextPrimeAbovePowerOfTwo(size_t const bits) {
+  if (isCatalogued(bits)) {
+    return (LargeNum(1) << bits) +
+        LargeNum(static_cast<uint64_t>(
+            PRIME_OFFSETS[bits - FIRST_CATALOGUED_BITS]));
+  }
+
+  log_info("Finding a prime above 2^%zu", bits);
+  return cachedNextPrime(LargeNum(1) << bits);
+}
+
+LargeNum cachedNextPrime(LargeNum const & n) {
+  size_t const bits = powerOfTwoBits(n);
+  if (isCatalogued(bits)) {
+    return nextPrimeAbovePowerOfTwo(bits);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(memoMutex);
+    std::map<LargeNum, LargeNum>::const_iterator const found =
+        memo.find(n);
+    if (found != memo.end()) {
+      return found->second;
+    }
+  }
+
+  /* search outside the lock; racing searches find the same prime. */
+  LargeNum const prime = ff::mpc::nextPrime(n);
+
+  std::lock_guard<std::mutex> lock(memoMutex);
+  memo.emplace(n, prime);
+  return prime;
+}
+
+} // namespace safrn
@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_UTIL_PRIME_CATALOGUE_H_
+#define SAFRN_UTIL_PRIME_CATALOGUE_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+
+/* 3rd Party Headers */
+
+/* Safrn Headers */
+#include <dataowner/fortissimo.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+/*
+ * Moduli without a runtime prime search.
+ *
+ * Every party of a query derives the same moduli from the same global
+ * info, and for wide queries each ff::mpc::nextPrime search on a
+ * several hundred bit number takes noticeable time. The next prime
+ * above 2^k is compiled in for every k up to PRIME_CATALOGUE_MAX_BITS,
+ * as its offset from 2^k; anything else is searched for once per
+ * process and remembered.
+ */
+
+/** Largest k for which the next prime above 2^k is compiled in. */
+extern size_t const PRIME_CATALOGUE_MAX_BITS;
+
+/**
+ * The smallest prime above 2^bits.
+ */
+dataowner::LargeNum nextPrimeAbovePowerOfTwo(size_t const bits);
+
+/**
+ * The same prime as ff::mpc::nextPrime(n), from the catalogue when n
+ * is a power of two, and otherwise from a per process memo of earlier
+ * searches.
+ */
+dataowner::LargeNum cachedNextPrime(dataowner::LargeNum const & n);
+
+} // namespace safrn
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_UTIL_PRIME_CATALOGUE_H_
@@ -5,9 +5,14 @@
 /* C and POSIX Headers */
 
 /* C++ Headers */
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 
 /* 3rd Party Headers */
 #include <mpc/RandomnessDealer.h>
+#include <mpc/templates.h>
 
 /* SAFRN Headers */
 #include <Identity.h>
@@ -15,6 +20,10 @@
 #include <Util/Utils.h>
 #include <framework/Framework.h>
 #include <util/Randomness.h>
+#include <util/SeedPrg.h>
+
+/* logging configuration */
+#include <ff/logging.h>
 
 #ifndef SAFRN_FORTISSIMO_RANDOMNESS_DEALER_H_
 #define SAFRN_FORTISSIMO_RANDOMNESS_DEALER_H_
@@ -39,6 +48,68 @@ using RandomnessPatron = ff::mpc::RandomnessPatron<
     Rand_T,
     Info_T>;
 
+/**
+ * Dealer half of a seed compressed alternative to RandomnessHouse.
+ *
+ * Rather than sending each dataowner all of its shares, the dealer
+ * sends every dataowner but the first a 128-bit seed, from which it
+ * expands its own shares (see SeedPrg). Only the first dataowner is
+ * sent its shares explicitly, as the correction which makes all the
+ * shares add up to the dealt randomness. This cuts the dealer's
+ * traffic for n dataowners down to about 1/n.
+ *
+ * Info_T must support seeded generation, by way of
+ *   void expandShare(SeedPrg &, Rand_T &) const;
+ *   void generateCorrection(std::vector<Rand_T> &) const;
+ *
+ * Like RandomnessHouse, the count and info are sent by the patrons.
+ */
+template<typename Rand_T, typename Info_T>
+class SeededRandomnessHouse : public Fronctocol {
+public:
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+private:
+  size_t numRequestsAwaiting = 0;
+  bool haveRequest = false;
+  uint64_t count = 0;
+  Info_T info;
+
+  void deal();
+};
+
+/**
+ * Dataowner half of SeededRandomnessHouse, promising a dispenser of
+ * count instances of randomness, the same as RandomnessPatron.
+ */
+template<typename Rand_T, typename Info_T>
+class SeededRandomnessPatron
+    : public PromiseFronctocol<RandomnessDispenser<Rand_T, Info_T>> {
+public:
+  SeededRandomnessPatron(
+      Identity const & dealer, size_t const count, Info_T const & info);
+
+  void init() override;
+  void handleReceive(IncomingMessage & imsg) override;
+  void handleComplete(Fronctocol & f) override;
+  void handlePromise(Fronctocol & f) override;
+  std::string name() override;
+
+private:
+  Identity const dealer;
+  size_t const count;
+  Info_T const info;
+};
+
 } // namespace safrn
 
+#include <util/RandomnessDealer.t.h>
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
 #endif // SAFRN_FORTISSIMO_RANDOMNESS_DEALER_H_
@@ -0,0 +1,188 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+namespace safrn {
+
+template<typename Rand_T, typename Info_T>
+void SeededRandomnessHouse<Rand_T, Info_T>::init() {
+  log_debug("SeededRandomnessHouse init");
+  this->getPeers().forEachDataowner(
+      [this](Identity const &) { this->numRequestsAwaiting++; });
+}
+
+template<typename Rand_T, typename Info_T>
+void SeededRandomnessHouse<Rand_T, Info_T>::handleReceive(
+    IncomingMessage & imsg) {
+  uint64_t request_count = 0;
+  Info_T request_info;
+  if (!imsg.template read<uint64_t>(request_count) ||
+      !imsg.template read<Info_T>(request_info)) {
+    log_error("SeededRandomnessHouse could not read request");
+    this->abort();
+    return;
+  }
+
+  if (!this->haveRequest) {
+    this->count = request_count;
+    this->info = request_info;
+    this->haveRequest = true;
+  } else if (
+      this->count != request_count || this->info != request_info) {
+    log_error("SeededRandomnessHouse received mismatched requests");
+    this->abort();
+    return;
+  }
+
+  this->numRequestsAwaiting--;
+  if (this->numRequestsAwaiting == 0) {
+    this->deal();
+    this->complete();
+  }
+}
+
+template<typename Rand_T, typename Info_T>
+void SeededRandomnessHouse<Rand_T, Info_T>::deal() {
+  std::vector<Identity> dataowners;
+  this->getPeers().forEachDataowner([&dataowners](Identity const & d) {
+    dataowners.push_back(d);
+  });
+
+  /* Seeds for all but the first dataowner, who gets the corrections */
+  std::vector<SeedPrg::Seed> seeds;
+  std::vector<SeedPrg> prgs;
+  seeds.reserve(dataowners.size() - 1);
+  prgs.reserve(dataowners.size() - 1);
+  for (size_t i = 1; i < dataowners.size(); i++) {
+    seeds.push_back(SeedPrg::newSeed());
+    prgs.emplace_back(seeds.back());
+  }
+
+  std::unique_ptr<OutgoingMessage> correction_msg(
+      new OutgoingMessage(dataowners[0]));
+  correction_msg->template write<Boolean_t>(0x01);
+
+  std::vector<Rand_T> vals;
+  vals.reserve(dataowners.size());
+  for (size_t i = 0; i < dataowners.size(); i++) {
+    vals.emplace_back(this->info);
+  }
+  for (uint64_t c = 0; c < this->count; c++) {
+    for (size_t i = 1; i < dataowners.size(); i++) {
+      this->info.expandShare(prgs[i - 1], vals[i]);
+    }
+    this->info.generateCorrection(vals);
+    correction_msg->template write<Rand_T>(vals[0]);
+  }
+  this->send(std::move(correction_msg));
+
+  for (size_t i = 1; i < dataowners.size(); i++) {
+    std::unique_ptr<OutgoingMessage> seed_msg(
+        new OutgoingMessage(dataowners[i]));
+    seed_msg->template write<Boolean_t>(0x00);
+    for (size_t j = 0; j < SeedPrg::SEED_SIZE; j++) {
+      seed_msg->template write<Boolean_t>(seeds[i - 1][j]);
+    }
+    this->send(std::move(seed_msg));
+  }
+}
+
+template<typename Rand_T, typename Info_T>
+void SeededRandomnessHouse<Rand_T, Info_T>::handleComplete(
+    Fronctocol &) {
+  log_error("SeededRandomnessHouse received unexpected "
+            "handle complete");
+}
+
+template<typename Rand_T, typename Info_T>
+void SeededRandomnessHouse<Rand_T, Info_T>::handlePromise(
+    Fronctocol &) {
+  log_error("SeededRandomnessHouse received unexpected "
+            "handle promise");
+}
+
+template<typename Rand_T, typename Info_T>
+std::string SeededRandomnessHouse<Rand_T, Info_T>::name() {
+  return std::string("Seeded Randomness House: ") + Rand_T::name();
+}
+
+template<typename Rand_T, typename Info_T>
+SeededRandomnessPatron<Rand_T, Info_T>::SeededRandomnessPatron(
+    Identity const & dealer, size_t const count, Info_T const & info) :
+    dealer(dealer), count(count), info(info) {
+}
+
+template<typename Rand_T, typename Info_T>
+void SeededRandomnessPatron<Rand_T, Info_T>::init() {
+  std::unique_ptr<OutgoingMessage> omsg(
+      new OutgoingMessage(this->dealer));
+  omsg->template write<uint64_t>(static_cast<uint64_t>(this->count));
+  omsg->template write<Info_T>(this->info);
+  this->send(std::move(omsg));
+}
+
+template<typename Rand_T, typename Info_T>
+void SeededRandomnessPatron<Rand_T, Info_T>::handleReceive(
+    IncomingMessage & imsg) {
+  Boolean_t is_correction = 0x00;
+  if (!imsg.template read<Boolean_t>(is_correction)) {
+    log_error("SeededRandomnessPatron could not read response");
+    this->abort();
+    return;
+  }
+
+  this->result.reset(
+      new RandomnessDispenser<Rand_T, Info_T>(this->info));
+  if (is_correction) {
+    for (size_t c = 0; c < this->count; c++) {
+      Rand_T val(this->info);
+      if (!imsg.template read<Rand_T>(val)) {
+        log_error("SeededRandomnessPatron could not read correction");
+        this->abort();
+        return;
+      }
+      this->result->insert(std::move(val));
+    }
+  } else {
+    SeedPrg::Seed seed;
+    for (size_t j = 0; j < SeedPrg::SEED_SIZE; j++) {
+      Boolean_t b = 0x00;
+      if (!imsg.template read<Boolean_t>(b)) {
+        log_error("SeededRandomnessPatron could not read seed");
+        this->abort();
+        return;
+      }
+      seed[j] = static_cast<uint8_t>(b);
+    }
+
+    /* Same order of expansion as the dealer. */
+    SeedPrg prg(seed);
+    for (size_t c = 0; c < this->count; c++) {
+      Rand_T val(this->info);
+      this->info.expandShare(prg, val);
+      this->result->insert(std::move(val));
+    }
+  }
+  this->complete();
+}
+
+template<typename Rand_T, typename Info_T>
+void SeededRandomnessPatron<Rand_T, Info_T>::handleComplete(
+    Fronctocol &) {
+  log_error("SeededRandomnessPatron received unexpected "
+            "handle complete");
+}
+
+template<typename Rand_T, typename Info_T>
+void SeededRandomnessPatron<Rand_T, Info_T>::handlePromise(
+    Fronctocol &) {
+  log_error("SeededRandomnessPatron received unexpected "
+            "handle promise");
+}
+
+template<typename Rand_T, typename Info_T>
+std::string SeededRandomnessPatron<Rand_T, Info_T>::name() {
+  return std::string("Seeded Randomness Patron: ") + Rand_T::name();
+}
+
+} // namespace safrn
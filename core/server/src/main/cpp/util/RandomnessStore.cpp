@@ -0,0 +1,332 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+/* C++ Headers */
+#include <cstring>
+
+/* Safrn Headers */
+#include <util/RandomnessStore.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+const uint32_t RandomnessStore::FORMAT_VERSION;
+const uint64_t RandomnessStore::NO_BATCH;
+
+static char const RANDOMNESS_FILE_MAGIC[8] = {
+    'S', 'A', 'F', 'R', 'N', 'R', 'N', 'D'};
+
+/**
+ * Creates each directory along the path, like mkdir -p.
+ */
+static bool makeDirectories(std::string const & path) {
+  for (size_t i = 1; i <= path.size(); i++) {
+    if (i == path.size() || path[i] == '/') {
+      std::string const prefix = path.substr(0, i);
+      if (0 != mkdir(prefix.c_str(), 0700) && errno != EEXIST) {
+        log_error(
+            "Could not create directory %s: %s",
+            prefix.c_str(),
+            strerror(errno));
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/**
+ * Parses a batch directory name, rejecting anything but digits.
+ */
+static bool parseBatch(char const * name, uint64_t & batch) {
+  if (name[0] == '\0') {
+    return false;
+  }
+  batch = 0;
+  for (char const * c = name; *c != '\0'; c++) {
+    if (*c < '0' || *c > '9') {
+      return false;
+    }
+    batch = batch * 10 + static_cast<uint64_t>(*c - '0');
+  }
+  return true;
+}
+
+RandomnessStore::RandomnessStore(
+    std::string const & directory,
+    std::string const & study,
+    std::string const & party) :
+    directory_(directory), study_(study), party_(party) {
+  if (!this->directory_.empty() && this->directory_.back() != '/') {
+    this->directory_.push_back('/');
+  }
+}
+
+std::string RandomnessStore::key(
+    std::string const & function,
+    std::vector<dataowner::LargeNum> const & params) const {
+  std::string ret = this->study_ + "-" + function;
+  for (dataowner::LargeNum const & p : params) {
+    ret += "-" + ff::mpc::dec(p);
+  }
+  return ret;
+}
+
+std::string RandomnessStore::shardPath(std::string const & key) const {
+  return this->directory_ + key + "/" + this->party_ + "/";
+}
+
+std::string RandomnessStore::batchPath(
+    std::string const & key, uint64_t batch) const {
+  return this->shardPath(key) + std::to_string(batch) + "/";
+}
+
+std::string RandomnessStore::filePath(
+    std::string const & key,
+    uint64_t batch,
+    std::string const & kind) const {
+  return this->batchPath(key, batch) + kind + ".rnd";
+}
+
+uint64_t RandomnessStore::nextBatch(std::string const & key) const {
+  std::string const path = this->shardPath(key);
+  DIR * dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    return NO_BATCH;
+  }
+
+  uint64_t ret = NO_BATCH;
+  struct dirent * entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    uint64_t batch;
+    if (parseBatch(entry->d_name, batch) && batch < ret) {
+      ret = batch;
+    }
+  }
+  closedir(dir);
+  return ret;
+}
+
+uint64_t RandomnessStore::endBatch(std::string const & key) const {
+  std::string const path = this->shardPath(key);
+  DIR * dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    return 0;
+  }
+
+  uint64_t ret = 0;
+  struct dirent * entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    uint64_t batch;
+    if (parseBatch(entry->d_name, batch) && batch + 1 > ret) {
+      ret = batch + 1;
+    }
+  }
+  closedir(dir);
+  return ret;
+}
+
+bool RandomnessStore::consume(
+    std::string const & key, uint64_t const batch) const {
+  std::string const path = this->batchPath(key, batch);
+  DIR * dir = opendir(path.c_str());
+  if (dir == nullptr) {
+    log_error("Could not open randomness batch %s", path.c_str());
+    return false;
+  }
+
+  bool success = true;
+  struct dirent * entry;
+  while ((entry = readdir(dir)) != nullptr) {
+    if (0 == strcmp(entry->d_name, ".") ||
+        0 == strcmp(entry->d_name, "..")) {
+      continue;
+    }
+    std::string const file = path + entry->d_name;
+    if (0 != unlink(file.c_str())) {
+      log_error(
+          "Could not remove %s: %s", file.c_str(), strerror(errno));
+      success = false;
+    }
+  }
+  closedir(dir);
+
+  if (success && 0 != rmdir(path.c_str())) {
+    log_error("Could not remove %s: %s", path.c_str(), strerror(errno));
+    success = false;
+  }
+  return success;
+}
+
+bool RandomnessStore::makeBatch(
+    std::string const & key, uint64_t const batch) const {
+  std::string const path = this->batchPath(key, batch);
+  return makeDirectories(path.substr(0, path.size() - 1));
+}
+
+bool RandomnessStore::writeHeader(
+    std::ostream & os,
+    std::string const & key,
+    std::string const & kind,
+    uint64_t count) const {
+  os.write(RANDOMNESS_FILE_MAGIC, sizeof(RANDOMNESS_FILE_MAGIC));
+  return storeWrite(os, static_cast<uint64_t>(FORMAT_VERSION)) &&
+      storeWrite(os, key) && storeWrite(os, kind) &&
+      storeWrite(os, count);
+}
+
+bool RandomnessStore::readHeader(
+    std::istream & is,
+    std::string const & key,
+    std::string const & kind,
+    uint64_t & count) const {
+  char magic[sizeof(RANDOMNESS_FILE_MAGIC)];
+  is.read(magic, sizeof(magic));
+  if (!is.good() ||
+      0 != memcmp(magic, RANDOMNESS_FILE_MAGIC, sizeof(magic))) {
+    return false;
+  }
+
+  uint64_t version = 0;
+  std::string file_key;
+  std::string file_kind;
+  if (!storeRead(is, version) || !storeRead(is, file_key) ||
+      !storeRead(is, file_kind) || !storeRead(is, count)) {
+    return false;
+  }
+  if (version != FORMAT_VERSION) {
+    log_error(
+        "Randomness file version %lu, expected %u",
+        (unsigned long)version,
+        FORMAT_VERSION);
+    return false;
+  }
+  return file_key == key && file_kind == kind;
+}
+
+bool storeWrite(std::ostream & os, uint64_t const val) {
+  char bytes[sizeof(uint64_t)];
+  for (size_t i = 0; i < sizeof(uint64_t); i++) {
+    bytes[i] = static_cast<char>((val >> (8 * i)) & 0xFF);
+  }
+  os.write(bytes, sizeof(bytes));
+  return os.good();
+}
+
+bool storeRead(std::istream & is, uint64_t & val) {
+  unsigned char bytes[sizeof(uint64_t)];
+  is.read(reinterpret_cast<char *>(bytes), sizeof(bytes));
+  val = 0;
+  for (size_t i = 0; i < sizeof(uint64_t); i++) {
+    val |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  return is.good();
+}
+
+bool storeWrite(std::ostream & os, std::string const & val) {
+  storeWrite(os, static_cast<uint64_t>(val.size()));
+  os.write(val.data(), static_cast<std::streamsize>(val.size()));
+  return os.good();
+}
+
+bool storeRead(std::istream & is, std::string & val) {
+  uint64_t size = 0;
+  if (!storeRead(is, size)) {
+    return false;
+  }
+  val.resize(size);
+  is.read(&val[0], static_cast<std::streamsize>(size));
+  return is.good();
+}
+
+bool storeWriteLargeNum(
+    std::ostream & os, dataowner::LargeNum const & val) {
+  std::string bytes;
+  dataowner::LargeNum v = val;
+  while (v > 0) {
+    bytes.push_back(static_cast<char>(static_cast<uint64_t>(v % 256)));
+    v /= 256;
+  }
+  return storeWrite(os, bytes);
+}
+
+bool storeReadLargeNum(std::istream & is, dataowner::LargeNum & val) {
+  std::string bytes;
+  if (!storeRead(is, bytes)) {
+    return false;
+  }
+  val = 0;
+  for (size_t i = bytes.size(); i > 0; i--) {
+    val *= 256;
+    val += static_cast<uint64_t>(
+        static_cast<unsigned char>(bytes[i - 1]));
+  }
+  return true;
+}
+
+bool storeWrite(
+    std::ostream & os,
+    dealer::RandomSquareMatrix<dataowner::LargeNum> const & val) {
+  bool success = storeWrite(os, static_cast<uint64_t>(val.d_));
+  success = success && storeWriteLargeNum(os, val.det_of_inverse_);
+  for (size_t row = 0; row < val.d_; ++row) {
+    for (size_t col = 0; col < val.d_; ++col) {
+      success =
+          success && storeWriteLargeNum(os, val.values_.at(row, col));
+    }
+  }
+  return success;
+}
+
+bool storeRead(
+    std::istream & is,
+    dealer::RandomSquareMatrix<dataowner::LargeNum> & val) {
+  uint64_t local_d = 0;
+  if (!storeRead(is, local_d) || local_d != val.d_) {
+    return false;
+  }
+  bool success = storeReadLargeNum(is, val.det_of_inverse_);
+  for (size_t row = 0; row < val.d_; ++row) {
+    for (size_t col = 0; col < val.d_; ++col) {
+      success =
+          success && storeReadLargeNum(is, val.values_.at(row, col));
+    }
+  }
+  return success;
+}
+
+bool storeWrite(
+    std::ostream & os, dealer::RandomTableLookup const & val) {
+  bool success = storeWriteLargeNum(os, val.r_);
+  success = success &&
+      storeWrite(os, static_cast<uint64_t>(val.u_.size()));
+  for (size_t i = 0; success && i < val.u_.size(); i++) {
+    success = storeWrite(os, val.u_[i]);
+  }
+  return success;
+}
+
+bool storeRead(std::istream & is, dealer::RandomTableLookup & val) {
+  uint64_t size = 0;
+  if (!storeReadLargeNum(is, val.r_) || !storeRead(is, size)) {
+    return false;
+  }
+  val.u_.resize(size);
+  bool success = true;
+  for (size_t i = 0; success && i < size; i++) {
+    success = storeRead(is, val.u_[i]);
+  }
+  return success;
+}
+
+} // namespace safrn
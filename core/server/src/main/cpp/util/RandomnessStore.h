@@ -0,0 +1,182 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_UTIL_RANDOMNESS_STORE_H_
+#define SAFRN_UTIL_RANDOMNESS_STORE_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <mpc/Randomness.h>
+
+/* Safrn Headers */
+#include <dataowner/fortissimo.h>
+#include <dealer/RandomSquareMatrix.h>
+#include <dealer/RandomTableLookup.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+/**
+ * On-disk store of dealer randomness which was generated ahead of time
+ * (see safrnffnet --pregenerate).
+ *
+ * Randomness is grouped under a key, which names the study, the
+ * function and every parameter the randomness depends on (moduli,
+ * dimensions, table sizes). Each key is sharded by party, and each
+ * shard holds numbered batches. A batch holds one query's worth of
+ * randomness, one file per kind of randomness:
+ *
+ *   {directory}/{key}/{party}/{batch}/{kind}.rnd
+ *
+ * The dealer writes every party's shard, and each dataowner is given
+ * (only) its own shard. A batch is deleted once it has been used.
+ */
+class RandomnessStore {
+public:
+  /** Version of the .rnd file format, checked on every read. */
+  static const uint32_t FORMAT_VERSION = 2;
+
+  /** Sentinel batch number, for when no batch is available. */
+  static const uint64_t NO_BATCH = UINT64_MAX;
+
+  RandomnessStore(
+      std::string const & directory,
+      std::string const & study,
+      std::string const & party);
+
+  /**
+   * Builds the key for a function's randomness, given the parameters
+   * which the randomness depends on.
+   */
+  std::string key(
+      std::string const & function,
+      std::vector<dataowner::LargeNum> const & params) const;
+
+  /**
+   * Returns the lowest numbered batch held for a key, or NO_BATCH.
+   */
+  uint64_t nextBatch(std::string const & key) const;
+
+  /**
+   * Returns one past the highest numbered batch held for a key, so
+   * that newly generated batches do not collide with old ones.
+   */
+  uint64_t endBatch(std::string const & key) const;
+
+  /**
+   * Deletes a batch so that it is never used twice.
+   */
+  bool consume(std::string const & key, uint64_t const batch) const;
+
+  /**
+   * Writes one kind of randomness into a batch.
+   */
+  template<typename Rand_T>
+  bool write(
+      std::string const & key,
+      uint64_t const batch,
+      std::string const & kind,
+      std::vector<Rand_T> const & vals) const;
+
+  /**
+   * Reads one kind of randomness from a batch. Each instance is first
+   * constructed from the info, as the randomness dispensers do.
+   */
+  template<typename Rand_T, typename Info_T>
+  bool read(
+      std::string const & key,
+      uint64_t const batch,
+      std::string const & kind,
+      Info_T const & info,
+      std::vector<Rand_T> & vals) const;
+
+  std::string const & party() const {
+    return this->party_;
+  }
+
+private:
+  std::string directory_;
+  std::string study_;
+  std::string party_;
+
+  std::string shardPath(std::string const & key) const;
+  std::string batchPath(std::string const & key, uint64_t batch) const;
+  std::string filePath(
+      std::string const & key,
+      uint64_t batch,
+      std::string const & kind) const;
+
+  bool makeBatch(std::string const & key, uint64_t const batch) const;
+  bool writeHeader(
+      std::ostream & os,
+      std::string const & key,
+      std::string const & kind,
+      uint64_t count) const;
+  bool readHeader(
+      std::istream & is,
+      std::string const & key,
+      std::string const & kind,
+      uint64_t & count) const;
+};
+
+/**
+ * Generates count instances of randomness from the info and writes
+ * one share of each instance into each of the shards.
+ */
+template<typename Rand_T, typename Info_T>
+bool pregenerate(
+    std::vector<RandomnessStore> const & shards,
+    std::string const & key,
+    uint64_t const batch,
+    std::string const & kind,
+    Info_T const & info,
+    size_t const count);
+
+/**
+ * Moves stored randomness into a dispenser, as if a patron had
+ * received it from the dealer.
+ */
+template<typename Rand_T, typename Info_T>
+std::unique_ptr<ff::mpc::RandomnessDispenser<Rand_T, Info_T>>
+makeStoredDispenser(std::vector<Rand_T> && vals, Info_T const & info);
+
+/* Serialization of individual values, little-endian. */
+bool storeWrite(std::ostream & os, uint64_t const val);
+bool storeRead(std::istream & is, uint64_t & val);
+bool storeWrite(std::ostream & os, std::string const & val);
+bool storeRead(std::istream & is, std::string & val);
+bool storeWriteLargeNum(
+    std::ostream & os, dataowner::LargeNum const & val);
+bool storeReadLargeNum(std::istream & is, dataowner::LargeNum & val);
+
+/* Serialization of SAFRN's own randomness types. */
+bool storeWrite(
+    std::ostream & os,
+    dealer::RandomSquareMatrix<dataowner::LargeNum> const & val);
+bool storeRead(
+    std::istream & is,
+    dealer::RandomSquareMatrix<dataowner::LargeNum> & val);
+bool storeWrite(
+    std::ostream & os, dealer::RandomTableLookup const & val);
+bool storeRead(std::istream & is, dealer::RandomTableLookup & val);
+
+} // namespace safrn
+
+#include <util/RandomnessStore.t.h>
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_UTIL_RANDOMNESS_STORE_H_
@@ -0,0 +1,106 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C++ Headers */
+#include <fstream>
+
+namespace safrn {
+
+template<typename Rand_T>
+bool RandomnessStore::write(
+    std::string const & key,
+    uint64_t const batch,
+    std::string const & kind,
+    std::vector<Rand_T> const & vals) const {
+  if (!this->makeBatch(key, batch)) {
+    return false;
+  }
+  std::string const path = this->filePath(key, batch, kind);
+  std::ofstream os(path.c_str(), std::ios::out | std::ios::binary);
+  if (!os.is_open()) {
+    log_error("Could not open randomness file %s", path.c_str());
+    return false;
+  }
+
+  bool success = this->writeHeader(os, key, kind, vals.size());
+  for (size_t i = 0; success && i < vals.size(); i++) {
+    success = storeWrite(os, vals[i]);
+  }
+  os.flush();
+  return success && os.good();
+}
+
+template<typename Rand_T, typename Info_T>
+bool RandomnessStore::read(
+    std::string const & key,
+    uint64_t const batch,
+    std::string const & kind,
+    Info_T const & info,
+    std::vector<Rand_T> & vals) const {
+  std::string const path = this->filePath(key, batch, kind);
+  std::ifstream is(path.c_str(), std::ios::in | std::ios::binary);
+  if (!is.is_open()) {
+    log_error("Could not open randomness file %s", path.c_str());
+    return false;
+  }
+
+  uint64_t count = 0;
+  if (!this->readHeader(is, key, kind, count)) {
+    log_error("Bad randomness file header in %s", path.c_str());
+    return false;
+  }
+
+  vals.clear();
+  vals.reserve(count);
+  for (uint64_t i = 0; i < count; i++) {
+    vals.emplace_back(info);
+    if (!storeRead(is, vals.back())) {
+      log_error("Truncated randomness file %s", path.c_str());
+      return false;
+    }
+  }
+  return true;
+}
+
+template<typename Rand_T, typename Info_T>
+bool pregenerate(
+    std::vector<RandomnessStore> const & shards,
+    std::string const & key,
+    uint64_t const batch,
+    std::string const & kind,
+    Info_T const & info,
+    size_t const count) {
+  std::vector<std::vector<Rand_T>> shares(shards.size());
+  for (size_t i = 0; i < shards.size(); i++) {
+    shares[i].reserve(count);
+  }
+
+  std::vector<Rand_T> vals;
+  for (size_t i = 0; i < count; i++) {
+    info.generate(shards.size(), 0, vals);
+    for (size_t j = 0; j < shards.size(); j++) {
+      shares[j].emplace_back(std::move(vals[j]));
+    }
+  }
+
+  bool success = true;
+  for (size_t i = 0; i < shards.size(); i++) {
+    success = success && shards[i].write(key, batch, kind, shares[i]);
+  }
+  return success;
+}
+
+template<typename Rand_T, typename Info_T>
+std::unique_ptr<ff::mpc::RandomnessDispenser<Rand_T, Info_T>>
+makeStoredDispenser(std::vector<Rand_T> && vals, Info_T const & info) {
+  std::unique_ptr<ff::mpc::RandomnessDispenser<Rand_T, Info_T>> ret(
+      new ff::mpc::RandomnessDispenser<Rand_T, Info_T>(info));
+  for (size_t i = 0; i < vals.size(); i++) {
+    ret->insert(std::move(vals[i]));
+  }
+  vals.clear();
+  return ret;
+}
+
+} // namespace safrn
@@ -0,0 +1,99 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <algorithm>
+#include <stdexcept>
+
+/* 3rd Party Headers */
+#include <mpc/templates.h>
+
+/* Safrn Headers */
+#include <util/SeedPrg.h>
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+const size_t SeedPrg::SEED_SIZE;
+const size_t SeedPrg::BUFFER_SIZE;
+
+SeedPrg::Seed SeedPrg::newSeed() {
+  Seed seed;
+  if (!ff::mpc::randomBytes(seed.data(), seed.size())) {
+    throw std::runtime_error("Bad rands");
+  }
+  return seed;
+}
+
+SeedPrg::SeedPrg(Seed const & seed) :
+    ctx(EVP_CIPHER_CTX_new()), buffer(BUFFER_SIZE), position(0) {
+  /* The seed is the key, and the counter starts from zero. */
+  uint8_t const iv[SEED_SIZE] = {0};
+  if (this->ctx == nullptr ||
+      1 !=
+          EVP_EncryptInit_ex(
+              this->ctx,
+              EVP_aes_128_ctr(),
+              nullptr,
+              seed.data(),
+              iv)) {
+    log_error("Could not initialize AES-CTR seed expansion");
+    throw std::runtime_error("Bad PRG");
+  }
+  this->refill();
+}
+
+SeedPrg::SeedPrg(SeedPrg && other) :
+    ctx(other.ctx),
+    buffer(std::move(other.buffer)),
+    position(other.position) {
+  other.ctx = nullptr;
+}
+
+SeedPrg::~SeedPrg() {
+  if (this->ctx != nullptr) {
+    EVP_CIPHER_CTX_free(this->ctx);
+  }
+}
+
+void SeedPrg::refill() {
+  /* Encrypting zeros in counter mode yields the raw keystream. */
+  std::fill(this->buffer.begin(), this->buffer.end(), 0);
+  int out_len = 0;
+  if (1 !=
+          EVP_EncryptUpdate(
+              this->ctx,
+              this->buffer.data(),
+              &out_len,
+              this->buffer.data(),
+              static_cast<int>(this->buffer.size())) ||
+      static_cast<size_t>(out_len) != this->buffer.size()) {
+    log_error("AES-CTR seed expansion failed");
+    throw std::runtime_error("Bad PRG");
+  }
+  this->position = 0;
+}
+
+void SeedPrg::bytes(uint8_t * out, size_t n) {
+  while (n > 0) {
+    if (this->position == this->buffer.size()) {
+      this->refill();
+    }
+    size_t const step =
+        std::min(n, this->buffer.size() - this->position);
+    std::copy(
+        this->buffer.begin() + this->position,
+        this->buffer.begin() + this->position + step,
+        out);
+    this->position += step;
+    out += step;
+    n -= step;
+  }
+}
+
+} // namespace safrn
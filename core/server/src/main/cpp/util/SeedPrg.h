@@ -0,0 +1,81 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_UTIL_SEED_PRG_H_
+#define SAFRN_UTIL_SEED_PRG_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <openssl/evp.h>
+
+/* Safrn Headers */
+
+/* logging configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+/**
+ * Pseudorandom generator which expands a short seed with AES-128 in
+ * counter mode.
+ *
+ * The dealer uses it to compress shares of randomness: rather than
+ * sending a party all of its shares, the dealer sends it a seed and
+ * both sides expand the same shares from that seed.
+ */
+class SeedPrg {
+public:
+  static const size_t SEED_SIZE = 16;
+  using Seed = std::array<uint8_t, SEED_SIZE>;
+
+  /**
+   * Draws a fresh seed from the system's randomness.
+   */
+  static Seed newSeed();
+
+  explicit SeedPrg(Seed const & seed);
+  ~SeedPrg();
+
+  SeedPrg(SeedPrg && other);
+  SeedPrg(SeedPrg const &) = delete;
+  SeedPrg & operator=(SeedPrg const &) = delete;
+  SeedPrg & operator=(SeedPrg &&) = delete;
+
+  /**
+   * Fills a buffer with the next bytes of the PRG's output.
+   */
+  void bytes(uint8_t * out, size_t n);
+
+  /**
+   * Draws the next value uniformly from [0, p), by rejection sampling
+   * just enough bytes to hold p - 1.
+   */
+  template<typename Number_T>
+  Number_T randomModP(Number_T const & p);
+
+private:
+  static const size_t BUFFER_SIZE = 4096;
+
+  EVP_CIPHER_CTX * ctx;
+  std::vector<uint8_t> buffer;
+  size_t position;
+
+  void refill();
+};
+
+} // namespace safrn
+
+#include <util/SeedPrg.t.h>
+
+#define LOG_UNCLUDE
+#include <ff/logging.h>
+
+#endif // SAFRN_UTIL_SEED_PRG_H_
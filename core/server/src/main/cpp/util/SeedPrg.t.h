@@ -0,0 +1,40 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+namespace safrn {
+
+template<typename Number_T>
+Number_T SeedPrg::randomModP(Number_T const & p) {
+  size_t bits = 0;
+  for (Number_T v = p - 1; v > 0; v /= 2) {
+    bits++;
+  }
+  size_t const num_bytes = (bits + 7) / 8;
+  uint8_t const top_mask = (bits % 8 == 0)
+      ? static_cast<uint8_t>(0xFF)
+      : static_cast<uint8_t>((1U << (bits % 8)) - 1);
+
+  uint8_t raw[sizeof(uint64_t) * 8];
+  std::vector<uint8_t> big_raw;
+  uint8_t * draw = raw;
+  if (num_bytes > sizeof(raw)) {
+    big_raw.resize(num_bytes);
+    draw = big_raw.data();
+  }
+
+  while (true) {
+    this->bytes(draw, num_bytes);
+    Number_T ret = 0;
+    for (size_t i = num_bytes; i > 0; i--) {
+      uint8_t const b = (i == num_bytes) ? draw[i - 1] & top_mask
+                                         : draw[i - 1];
+      ret = ret * 256 + static_cast<uint64_t>(b);
+    }
+    if (ret < p) {
+      return ret;
+    }
+  }
+}
+
+} // namespace safrn
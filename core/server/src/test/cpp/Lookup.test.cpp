@@ -66,6 +66,7 @@ TEST(Lookup, lookup) {
           static_cast<Boolean_t>((i + list_entry_offset * j) % 256);
     }
   }
+  dataowner::LookupTable const table(tableData, bytesPerEntry);
 
   test[dealer] = std::unique_ptr<Fronctocol>(new Tester(
       [&](Fronctocol * self) {
@@ -96,10 +97,9 @@ TEST(Lookup, lookup) {
           std::unique_ptr<Fronctocol> v0p0Lookup(new dataowner::Lookup(
               sharev0p0,
               outputv0p0,
-              tableData,
+              table,
               std::move(randomness),
               &info,
-              bytesPerEntry,
               &revealer));
           PeerSet ps(self->getPeers());
           ps.removeDealer();
@@ -149,10 +149,9 @@ TEST(Lookup, lookup) {
                   new dataowner::Lookup(
                       sharev1p0,
                       outputv1p0,
-                      tableData,
+                      table,
                       std::move(randomness),
                       &info,
-                      bytesPerEntry,
                       &revealer));
               PeerSet ps(self->getPeers());
               ps.removeDealer();
@@ -189,3 +188,125 @@ TEST(Lookup, lookup) {
             (value_to_extract + list_entry_offset * i) % 256));
   }
 }
+
+/**
+ * MultiLookup shares its rotations' openings among the lookups, so each
+ * of its outputs must match a Lookup of the same location.
+ */
+TEST(Lookup, multi_lookup_matches_lookups) {
+  std::map<Identity, std::unique_ptr<Fronctocol>> test;
+
+  size_t const num_parties = 2;
+  std::vector<Identity> const parties = {
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE01", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE03", ROLE_DATAOWNER, 1)};
+  Identity const & revealer = parties[0];
+  Identity const dealer(
+      "EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE00", ROLE_DEALER, 1);
+
+  const dataowner::LargeNum r_modulus =
+      (dataowner::LargeNum(1) << 61) - 1;
+  const dataowner::SmallNum table_size = 1000;
+  dealer::RandomTableLookupInfo info(r_modulus, table_size);
+  ff::mpc::CompareInfo<
+      safrn::Identity,
+      dataowner::LargeNum,
+      dataowner::SmallNum>
+      compareInfo(r_modulus, &revealer);
+
+  size_t const bytesPerEntry = 8;
+  std::vector<std::vector<Boolean_t>> tableData(
+      table_size, std::vector<Boolean_t>(bytesPerEntry));
+  for (size_t i = 0; i < table_size; i++) {
+    for (size_t j = 0; j < bytesPerEntry; j++) {
+      tableData.at(i).at(j) =
+          static_cast<Boolean_t>((7 * i + 13 * j + i / 256) % 256);
+    }
+  }
+  dataowner::LookupTable const table(tableData, bytesPerEntry);
+
+  /* The edges of the table, and a location looked up twice. */
+  std::vector<dataowner::SmallNum> const locations = {
+      0, 1, 125, 125, 500, 998, 999};
+  size_t const m = locations.size();
+  std::vector<std::vector<dataowner::LargeNum>> shares(
+      num_parties, std::vector<dataowner::LargeNum>(m));
+  for (size_t i = 0; i < m; i++) {
+    shares[1][i] = ff::mpc::randomModP<dataowner::LargeNum>(r_modulus);
+    shares[0][i] =
+        (r_modulus + locations[i] - shares[1][i]) % r_modulus;
+  }
+
+  test[dealer] = std::unique_ptr<Fronctocol>(new Tester(
+      [&](Fronctocol * self) {
+        std::unique_ptr<Fronctocol> house(
+            new dealer::LookupRandomnessHouse(&info, &compareInfo));
+        self->invoke(std::move(house), self->getPeers());
+      },
+      finishTestOnComplete));
+
+  /* A batch of Lookups, then a MultiLookup, per party. */
+  std::vector<std::vector<std::vector<Boolean_t>>> singles(
+      num_parties, std::vector<std::vector<Boolean_t>>(m));
+  std::vector<std::vector<std::vector<Boolean_t>>> multis(num_parties);
+  std::vector<size_t> remaining(num_parties, 3);
+  for (size_t j = 0; j < num_parties; j++) {
+    test[parties[j]] = std::unique_ptr<Fronctocol>(new Tester(
+        [&, j](Fronctocol * self) {
+          std::unique_ptr<Fronctocol> patron(
+              new dataowner::LookupRandomnessPatron(
+                  &info, &compareInfo, &dealer, 2 * m));
+          self->invoke(std::move(patron), self->getPeers());
+        },
+        [&, j](Fronctocol & f, Fronctocol * self) {
+          remaining[j]--;
+          PeerSet ps(self->getPeers());
+          ps.removeDealer();
+          if (remaining[j] == 2) {
+            dataowner::LookupRandomnessPatron & patron =
+                static_cast<dataowner::LookupRandomnessPatron &>(f);
+            std::unique_ptr<dataowner::Batch> lookups(
+                new dataowner::Batch());
+            std::vector<dataowner::LookupRandomness> randomness;
+            for (size_t i = 0; i < m; i++) {
+              lookups->children.emplace_back(new dataowner::Lookup(
+                  shares[j][i],
+                  singles[j][i],
+                  table,
+                  patron.lookupDispenser->get(),
+                  &info,
+                  &revealer));
+              randomness.emplace_back(patron.lookupDispenser->get());
+            }
+            self->invoke(std::move(lookups), ps);
+
+            std::unique_ptr<Fronctocol> multi(
+                new dataowner::MultiLookup(
+                    std::vector<dataowner::LargeNum>(shares[j]),
+                    multis[j],
+                    table,
+                    std::move(randomness),
+                    &info,
+                    &revealer));
+            self->invoke(std::move(multi), ps);
+          } else if (remaining[j] == 0) {
+            self->complete();
+          }
+        }));
+  }
+
+  EXPECT_TRUE(runTests(test));
+
+  ASSERT_EQ(m, multis[0].size());
+  ASSERT_EQ(m, multis[1].size());
+  for (size_t i = 0; i < m; i++) {
+    for (size_t b = 0; b < bytesPerEntry; b++) {
+      Boolean_t const single =
+          singles[0][i].at(b) ^ singles[1][i].at(b);
+      EXPECT_EQ(tableData[locations[i]][b], single)
+          << "location: " << locations[i] << " byte: " << b;
+      EXPECT_EQ(single, multis[0][i].at(b) ^ multis[1][i].at(b))
+          << "location: " << locations[i] << " byte: " << b;
+    }
+  }
+}
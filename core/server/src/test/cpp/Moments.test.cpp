@@ -172,3 +172,22 @@ TEST(Moments, moments) {
   //  EXPECT_TRUE(runTests(test));
   EXPECT_TRUE(true); // PHB
 }
+
+/**
+ * Bounding each vertical's lists by its own size, and working on fewer
+ * rows at a time than any list holds, must give the same sums, but for
+ * rounding in the division.
+ */
+TEST(Moments, bounded_chunked_matches_unbounded_2_parties) {
+  std::vector<double> res;
+  std::vector<std::vector<dataowner::LargeNum>> unbounded;
+  EXPECT_TRUE(
+      testQuery("moments_query.json", res, unbounded, TEST_2_PARTY));
+  std::vector<std::vector<dataowner::LargeNum>> bounded;
+  EXPECT_TRUE(testQuery(
+      "moments_query.json", res, bounded, TEST_2_PARTY_BOUNDED));
+
+  ASSERT_EQ(1U, bounded.size());
+  EXPECT_FALSE(bounded[0].empty());
+  EXPECT_TRUE(momentsNear(unbounded, bounded));
+}
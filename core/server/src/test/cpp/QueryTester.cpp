@@ -6,6 +6,8 @@
 #include <nlohmann/json.hpp>
 
 #include <QueryTester.h>
+#include <recipient/MomentsReceiver.h>
+#include <recipient/RegressionReceiver.h>
 
 /** Logging config */
 #include <ff/logging.h>
@@ -104,9 +106,35 @@ TestStudySetup const TEST_2_PARTY(
     }},
     fileFix("study2.json"));
 
+TestStudySetup const TEST_2_PARTY_BOUNDED(
+    {{Identity("000000000000000000000000000A11CE", ROLE_DATAOWNER, 0),
+      Identity("00000000000000000000000000000B0B", ROLE_DATAOWNER, 1),
+      Identity(
+          "0000000000000000000000000000DEA1", ROLE_DEALER, SIZE_MAX),
+      Identity(
+          "00000000000000000000000000FFFFFF",
+          ROLE_RECIPIENT,
+          SIZE_MAX)}},
+    {{
+        fileFix("alice2.csv"),
+        fileFix("bob2.csv"),
+        std::string(""),
+        std::string(""),
+    }},
+    fileFix("study2_bounded.json"));
+
+bool testQuery(
+    std::string const & query_file,
+    std::vector<double> & results,
+    TestStudySetup const & setup) {
+  std::vector<std::vector<dataowner::LargeNum>> moments;
+  return testQuery(query_file, results, moments, setup);
+}
+
 bool testQuery(
     std::string const & query_file,
     std::vector<double> & results,
+    std::vector<std::vector<dataowner::LargeNum>> & moments,
     TestStudySetup const & setup) {
   std::ifstream study_stream(setup.studyFile.c_str());
   if (!study_stream.is_open()) {
@@ -135,18 +163,67 @@ bool testQuery(
 
   std::vector<PeerSet> peersets;
   peersets.reserve(setup.participants.size());
+  std::unique_ptr<Fronctocol> receiver;
   for (size_t i = 0; i < setup.participants.size(); i++) {
     peersets.emplace_back();
-    tests[setup.participants[i]] = startup(
+    std::unique_ptr<Fronctocol> f = startup(
         setup.dataFiles[i],
         lookupTableDirectory,
         query,
         scfg,
         setup.participants[i],
         peersets.back());
+    if (setup.participants[i].role != ROLE_RECIPIENT) {
+      tests[setup.participants[i]] = std::move(f);
+      continue;
+    }
+
+    /* Wrap the recipient, to pick up its results. */
+    receiver = std::move(f);
+    tests[setup.participants[i]] =
+        std::unique_ptr<Fronctocol>(new Tester(
+            [&receiver](Fronctocol * self) {
+              self->invoke(std::move(receiver), self->getPeers());
+            },
+            [&results, &moments](Fronctocol & f, Fronctocol * self) {
+              recipient::RegressionReceiver * r =
+                  dynamic_cast<recipient::RegressionReceiver *>(&f);
+              if (r != nullptr) {
+                results = r->coefficients;
+                moments = r->momentsResults;
+              }
+              recipient::MomentsReceiver * m =
+                  dynamic_cast<recipient::MomentsReceiver *>(&f);
+              if (m != nullptr) {
+                moments = {m->results};
+              }
+              self->complete();
+            }));
   }
 
   return runTests(tests);
 }
 
+bool momentsNear(
+    std::vector<std::vector<dataowner::LargeNum>> const & a,
+    std::vector<std::vector<dataowner::LargeNum>> const & b) {
+  if (a.size() != b.size()) {
+    return false;
+  }
+  for (size_t i = 0; i < a.size(); i++) {
+    if (a[i].size() != b[i].size()) {
+      return false;
+    }
+    for (size_t j = 0; j < a[i].size(); j++) {
+      dataowner::LargeNum const diff =
+          a[i][j] > b[i][j] ? a[i][j] - b[i][j] : b[i][j] - a[i][j];
+      if (diff > 2) {
+        log_error("moments %zu, %zu differ by more than 2", i, j);
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
 } // namespace safrn
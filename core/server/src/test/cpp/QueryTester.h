@@ -17,6 +17,7 @@
 
 #include <JSON/Config/StudyConfig.h>
 #include <JSON/Query/Query.h>
+#include <dataowner/fortissimo.h>
 
 namespace safrn {
 
@@ -40,11 +41,36 @@ extern TestStudySetup const TEST_7_PARTY;
 extern TestStudySetup const TEST_4_PARTY;
 extern TestStudySetup const TEST_2_PARTY;
 
+/**
+ * TEST_2_PARTY, with each vertical's lists bounded by its own size and
+ * the dataowners working on 7 rows at a time.
+ */
+extern TestStudySetup const TEST_2_PARTY_BOUNDED;
+
 bool testQuery(
     std::string const & query_file,
     std::vector<double> & results,
     TestStudySetup const & setup);
 
+/**
+ * As above, also returning the moments sums the recipient receives:
+ * one list for a moments query, and one per batched moments function
+ * for a regression.
+ */
+bool testQuery(
+    std::string const & query_file,
+    std::vector<double> & results,
+    std::vector<std::vector<dataowner::LargeNum>> & moments,
+    TestStudySetup const & setup);
+
+/**
+ * Whether two runs' moments sums agree, but for the rounding of their
+ * SharedDivide, which may move each sum down by up to two.
+ */
+bool momentsNear(
+    std::vector<std::vector<dataowner::LargeNum>> const & a,
+    std::vector<std::vector<dataowner::LargeNum>> const & b);
+
 } // namespace safrn
 
 #endif //SAFRN_TEST_QUERY_TESTER_H_
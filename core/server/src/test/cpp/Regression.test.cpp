@@ -34,6 +34,67 @@ TEST(Regression, intercept_2_parties) {
       testQuery("regression_intercept.json", res, TEST_2_PARTY));
 }
 
+/**
+ * Least squares over the 26 joined rows of alice2.csv and bob2.csv,
+ * payload4 on payload1, payload2, payload3 and the intercept. With 5
+ * bits of precision, the inputs alone move these by about 0.04.
+ */
+static void expectIntercept2PartyCoefficients(
+    std::vector<double> const & res) {
+  std::vector<double> const expected = {-0.109, -0.080, 1.273, 0.646};
+  ASSERT_EQ(expected.size(), res.size());
+  for (size_t i = 0; i < expected.size(); i++) {
+    EXPECT_NEAR(expected[i], res[i], 0.125);
+  }
+}
+
+TEST(Regression, intercept_2_parties_values) {
+  std::vector<double> res;
+  EXPECT_TRUE(
+      testQuery("regression_intercept.json", res, TEST_2_PARTY));
+  expectIntercept2PartyCoefficients(res);
+}
+
+/* The moments batched with the regression must not disturb it. */
+TEST(Regression, moments_batch_2_parties) {
+  std::vector<double> res;
+  EXPECT_TRUE(
+      testQuery("regression_moments_batch.json", res, TEST_2_PARTY));
+  expectIntercept2PartyCoefficients(res);
+}
+
+/**
+ * Bounding each vertical's lists by its own size, and working on fewer
+ * rows at a time than any list holds, must give the same moments and
+ * coefficients as the unbounded, unchunked query, but for rounding in
+ * the division: four units of the 5 bits of precision.
+ */
+TEST(Regression, bounded_chunked_matches_unbounded_2_parties) {
+  std::vector<double> unbounded_res;
+  std::vector<std::vector<dataowner::LargeNum>> unbounded_moments;
+  EXPECT_TRUE(testQuery(
+      "regression_moments_batch.json",
+      unbounded_res,
+      unbounded_moments,
+      TEST_2_PARTY));
+
+  std::vector<double> bounded_res;
+  std::vector<std::vector<dataowner::LargeNum>> bounded_moments;
+  EXPECT_TRUE(testQuery(
+      "regression_moments_batch.json",
+      bounded_res,
+      bounded_moments,
+      TEST_2_PARTY_BOUNDED));
+
+  expectIntercept2PartyCoefficients(bounded_res);
+  ASSERT_EQ(unbounded_res.size(), bounded_res.size());
+  for (size_t i = 0; i < unbounded_res.size(); i++) {
+    EXPECT_NEAR(unbounded_res[i], bounded_res[i], 0.125) << "i: " << i;
+  }
+  EXPECT_EQ(3U, bounded_moments.size());
+  EXPECT_TRUE(momentsNear(unbounded_moments, bounded_moments));
+}
+
 TEST(Regression, no_intercept_7_parties) {
   std::vector<double> res;
   EXPECT_TRUE(
@@ -3,6 +3,7 @@
  */
 
 #include <cmath>
+#include <fstream>
 #include <gtest/gtest.h>
 #include <nlohmann/json.hpp>
 
@@ -12,8 +13,10 @@
 #include <framework/Framework.h>
 #include <framework/TestRunner.h>
 
+#include <JSON/Columns/IntegerColumn.h>
 #include <JSON/Config/StudyConfig.h>
 #include <JSON/Query/Query.h>
+#include <dataowner/GlobalInfo.h>
 
 #include <Startup.h>
 #include <StartupUtils.h>
@@ -104,14 +107,13 @@ TEST(Startup, readCSV_working) {
     }
   }
 
-  EXPECT_EQ(3, olist.numKeyCols);
+  EXPECT_EQ(2, olist.numKeyCols);
   EXPECT_EQ(3, olist.numArithmeticPayloadCols);
   EXPECT_EQ(0, olist.numXORPayloadCols);
   EXPECT_EQ(2, olist.elements.size());
 
   EXPECT_EQ(dataowner::LargeNum(123), olist.elements[0].keyCols[0]);
   EXPECT_EQ(dataowner::LargeNum(456), olist.elements[0].keyCols[1]);
-  EXPECT_EQ(dataowner::LargeNum(0), olist.elements[0].keyCols[2]);
 
   EXPECT_EQ(
       dataowner::LargeNum(4),
@@ -125,7 +127,6 @@ TEST(Startup, readCSV_working) {
 
   EXPECT_EQ(dataowner::LargeNum(234), olist.elements[1].keyCols[0]);
   EXPECT_EQ(dataowner::LargeNum(567), olist.elements[1].keyCols[1]);
-  EXPECT_EQ(dataowner::LargeNum(0), olist.elements[1].keyCols[2]);
 
   EXPECT_EQ(
       dataowner::LargeNum(15),
@@ -137,3 +138,285 @@ TEST(Startup, readCSV_working) {
       dataowner::LargeNum(694),
       olist.elements[1].arithmeticPayloadCols[2]);
 }
+
+TEST(Startup, double_convert_wide) {
+  dataowner::LargeNum modulus = (dataowner::LargeNum(1) << 127) - 1;
+
+  /* 0.75 * 2^100, more bits than fit in one word. */
+  EXPECT_EQ(
+      dataowner::LargeNum(3) << 98,
+      convertDoubleToLargeNum(0.75, 100, modulus));
+  EXPECT_EQ(
+      modulus - (dataowner::LargeNum(3) << 98),
+      convertDoubleToLargeNum(-0.75, 100, modulus));
+}
+
+TEST(Startup, readCSVColumns_working) {
+  std::string csvFile(
+      "../../../../../server/src/test/data/readCSV_working.csv");
+  std::vector<size_t> keyCols = {{0, 1}};
+  std::vector<size_t> plCols = {{2, 3, 4}};
+
+  StudyConfig scfg;
+
+  scfg.lexicon.emplace_back();
+  scfg.lexicon[0].verticalIndex = 0;
+  nlohmann::json j;
+  j["type"] = "real";
+
+  char const * names[] = {"key0", "key1", "pl0", "pl1", "pl2"};
+  for (size_t i = 0; i < 5; i++) {
+    j["columnIndex"] = i;
+    j["name"] = names[i];
+    scfg.lexicon[0].columns.emplace_back(new ColumnBase(j));
+  }
+
+  Identity id("00000000000000000000000000000001", ROLE_DATAOWNER, 0);
+
+  dataowner::SmallNum mod = 65521;
+  size_t bitsOfPrecisison = 5;
+
+  dataowner::ObservationStore store;
+  EXPECT_TRUE(readCSVColumns(
+      csvFile,
+      store,
+      keyCols,
+      plCols,
+      4,
+      scfg,
+      id,
+      mod,
+      bitsOfPrecisison));
+
+  EXPECT_EQ(2, store.numRows());
+  EXPECT_EQ(2, store.numKeyCols());
+  EXPECT_EQ(3, store.numArithmeticPayloadCols());
+  EXPECT_EQ(0, store.numXORPayloadCols());
+
+  EXPECT_EQ(dataowner::LargeNum(123), store.keyCols[0][0]);
+  EXPECT_EQ(dataowner::LargeNum(234), store.keyCols[0][1]);
+  EXPECT_EQ(dataowner::LargeNum(456), store.keyCols[1][0]);
+  EXPECT_EQ(dataowner::LargeNum(567), store.keyCols[1][1]);
+
+  EXPECT_EQ(dataowner::LargeNum(4), store.arithmeticPayloadCols[0][0]);
+  EXPECT_EQ(dataowner::LargeNum(15), store.arithmeticPayloadCols[0][1]);
+  EXPECT_EQ(
+      dataowner::LargeNum(694), store.arithmeticPayloadCols[2][1]);
+}
+
+/**
+ * Sizes the keys of study2.json's join, of key1 and key2, after giving
+ * them the widths and signs.
+ */
+static dataowner::GlobalInfo joinGlobals(
+    uint64_t const bits1,
+    bool const signed1,
+    uint64_t const bits2,
+    bool const signed2) {
+  std::ifstream study_stream(
+      "../../../../../server/src/test/data/study2.json");
+  nlohmann::json study_json = nlohmann::json::parse(study_stream);
+  study_json["lexicon"][0]["columns"][0]["bits"] = bits1;
+  study_json["lexicon"][0]["columns"][0]["signed"] = signed1;
+  study_json["lexicon"][1]["columns"][0]["bits"] = bits2;
+  study_json["lexicon"][1]["columns"][0]["signed"] = signed2;
+  StudyConfig const scfg = readStudyFromJson(study_json);
+
+  std::ifstream query_stream(
+      "../../../../../server/src/test/data/regression_intercept.json");
+  Query const query(scfg, nlohmann::json::parse(query_stream));
+  return dataowner::generateGlobals(query, scfg);
+}
+
+TEST(Startup, joinKeyDomain_from_column_bits) {
+  dataowner::GlobalInfo const unsigned_keys =
+      joinGlobals(16, false, 10, false);
+  EXPECT_EQ(dataowner::LargeNum(65535), unsigned_keys.key_max);
+  EXPECT_FALSE(unsigned_keys.keySigned);
+
+  /* An unsigned key joined to a signed one takes a sign bit. */
+  dataowner::GlobalInfo const mixed_keys =
+      joinGlobals(16, false, 12, true);
+  EXPECT_EQ(
+      dataowner::LargeNum((dataowner::LargeNum(1) << 17) - 1),
+      mixed_keys.key_max);
+  EXPECT_TRUE(mixed_keys.keySigned);
+
+  dataowner::GlobalInfo const one_width =
+      joinGlobals(0, false, 20, false);
+  EXPECT_EQ(
+      dataowner::LargeNum((dataowner::LargeNum(1) << 20) - 1),
+      one_width.key_max);
+
+  dataowner::GlobalInfo const wide_keys =
+      joinGlobals(64, false, 64, false);
+  EXPECT_EQ(
+      dataowner::LargeNum((dataowner::LargeNum(1) << 64) - 1),
+      wide_keys.key_max);
+
+  /* A signed 64-bit key joined to an unsigned one needs 65 bits. */
+  dataowner::GlobalInfo const wide_mixed_keys =
+      joinGlobals(64, true, 64, false);
+  EXPECT_EQ(
+      dataowner::LargeNum((dataowner::LargeNum(1) << 65) - 1),
+      wide_mixed_keys.key_max);
+  EXPECT_TRUE(wide_mixed_keys.keySigned);
+
+  dataowner::GlobalInfo const no_width =
+      joinGlobals(0, false, 0, true);
+  EXPECT_EQ(
+      dataowner::LargeNum(dataowner::GlobalInfo::KEY_MAX_DEFAULT_VALUE),
+      no_width.key_max);
+  EXPECT_TRUE(no_width.keySigned);
+}
+
+TEST(Startup, list_sizes_from_each_vertical) {
+  std::ifstream study_stream(
+      "../../../../../server/src/test/data/study2_bounded.json");
+  StudyConfig const scfg =
+      readStudyFromJson(nlohmann::json::parse(study_stream));
+  std::ifstream query_stream(
+      "../../../../../server/src/test/data/regression_intercept.json");
+  Query const query(scfg, nlohmann::json::parse(query_stream));
+  dataowner::GlobalInfo const globals =
+      dataowner::generateGlobals(query, scfg);
+
+  /* Each vertical's lists are bounded by its own size, not the
+   * study's 100 rows, and a joined list holds one of each. */
+  EXPECT_EQ(100U, globals.maxListSize);
+  EXPECT_EQ(32U, globals.listSize(0));
+  EXPECT_EQ(56U, globals.listSize(1));
+  EXPECT_EQ(88U, globals.joinedListSize);
+  EXPECT_EQ(32U + 56U, globals.maxIntersectionSize);
+
+  EXPECT_EQ(7U, globals.workingSetRows);
+  EXPECT_EQ(7U, globals.chunkRows(30));
+  EXPECT_EQ(5U, globals.chunkRows(5));
+}
+
+/**
+ * Reads a file of one integer key and one payload, with keys shifted
+ * as signed if key_signed.
+ */
+static bool readKeys(
+    char const * file,
+    uint64_t const bits,
+    bool const is_signed,
+    bool const key_signed,
+    dataowner::LargeNum const & key_max,
+    dataowner::ObservationStore & store) {
+  StudyConfig scfg;
+  scfg.lexicon.emplace_back();
+  scfg.lexicon[0].verticalIndex = 0;
+
+  nlohmann::json j;
+  j["columnIndex"] = 0;
+  j["name"] = "key0";
+  j["type"] = "integer";
+  j["bits"] = bits;
+  j["signed"] = is_signed;
+  scfg.lexicon[0].columns.emplace_back(new IntegerColumn(j));
+  j = nlohmann::json();
+  j["columnIndex"] = 1;
+  j["name"] = "pl0";
+  j["type"] = "real";
+  scfg.lexicon[0].columns.emplace_back(new ColumnBase(j));
+
+  Identity id("00000000000000000000000000000001", ROLE_DATAOWNER, 0);
+  return readCSVColumns(
+      std::string("../../../../../server/src/test/data/").append(file),
+      store,
+      {0},
+      {1},
+      SIZE_MAX,
+      scfg,
+      id,
+      65521,
+      5,
+      key_max,
+      key_signed);
+}
+
+/** As readKeys, with keys shifted as signed if the column is signed. */
+static bool readKeys(
+    char const * file,
+    uint64_t const bits,
+    bool const is_signed,
+    size_t const key_max,
+    dataowner::ObservationStore & store) {
+  return readKeys(
+      file,
+      bits,
+      is_signed,
+      is_signed,
+      dataowner::LargeNum(key_max),
+      store);
+}
+
+TEST(Startup, readCSV_rejects_keys_out_of_domain) {
+  dataowner::ObservationStore store;
+
+  /* 300 is past the column's 8 bits, and past a key_max of 255. */
+  EXPECT_FALSE(readKeys("readCSV_key_range.csv", 8, false, 255, store));
+  EXPECT_FALSE(readKeys("readCSV_key_range.csv", 0, false, 255, store));
+  EXPECT_FALSE(
+      readKeys("readCSV_key_range.csv", 16, false, 255, store));
+  EXPECT_TRUE(
+      readKeys("readCSV_key_range.csv", 16, false, 65535, store));
+  ASSERT_EQ(2, store.numRows());
+  EXPECT_EQ(dataowner::LargeNum(300), store.keyCols[0][1]);
+
+  /* Negative keys need a signed column, and are shifted up. */
+  store = dataowner::ObservationStore();
+  EXPECT_FALSE(
+      readKeys("readCSV_key_negative.csv", 16, false, 65535, store));
+  store = dataowner::ObservationStore();
+  EXPECT_TRUE(
+      readKeys("readCSV_key_negative.csv", 16, true, 65535, store));
+  ASSERT_EQ(2, store.numRows());
+  EXPECT_EQ(dataowner::LargeNum(32768 - 5), store.keyCols[0][0]);
+  EXPECT_EQ(dataowner::LargeNum(32768 + 7), store.keyCols[0][1]);
+}
+
+TEST(Startup, readCSV_long_payload_field) {
+  /* A payload written out to more digits than any double holds. */
+  dataowner::ObservationStore store;
+  EXPECT_TRUE(
+      readKeys("readCSV_long_field.csv", 16, false, 255, store));
+  ASSERT_EQ(1, store.numRows());
+  EXPECT_EQ(dataowner::LargeNum(8), store.arithmeticPayloadCols[0][0]);
+}
+
+TEST(Startup, readCSV_rejects_malformed_keys) {
+  dataowner::ObservationStore store;
+  EXPECT_FALSE(
+      readKeys("readCSV_key_malformed.csv", 16, false, 65535, store));
+  store = dataowner::ObservationStore();
+  EXPECT_FALSE(readKeys(
+      "readCSV_key_malformed_long.csv", 0, false, SIZE_MAX, store));
+}
+
+TEST(Startup, readCSV_joins_signed_and_unsigned_64_bit_keys) {
+  dataowner::GlobalInfo const globals =
+      joinGlobals(64, true, 64, false);
+  dataowner::LargeNum const two_64 = dataowner::LargeNum(1) << 64;
+  dataowner::LargeNum const two_63 = dataowner::LargeNum(1) << 63;
+
+  /* Unsigned keys up to 2^64 - 1 are shifted up by 2^64. */
+  dataowner::ObservationStore store;
+  EXPECT_TRUE(readKeys(
+      "readCSV_key_u64.csv", 64, false, true, globals.key_max, store));
+  ASSERT_EQ(2, store.numRows());
+  EXPECT_EQ(
+      dataowner::LargeNum(two_64 + two_64 - 1), store.keyCols[0][0]);
+  EXPECT_EQ(two_64, store.keyCols[0][1]);
+
+  /* Signed keys from -2^63 to 2^63 - 1, by the same shift. */
+  store = dataowner::ObservationStore();
+  EXPECT_TRUE(readKeys(
+      "readCSV_key_i64.csv", 64, true, true, globals.key_max, store));
+  ASSERT_EQ(2, store.numRows());
+  EXPECT_EQ(dataowner::LargeNum(two_64 - two_63), store.keyCols[0][0]);
+  EXPECT_EQ(
+      dataowner::LargeNum(two_64 + two_63 - 1), store.keyCols[0][1]);
+}
@@ -0,0 +1,231 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+#include <stdlib.h>
+#include <unistd.h>
+
+/* C++ Headers */
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+
+/* SAFRN Headers */
+#include <dataowner/LookupTable.h>
+#include <dealer/RandomTableLookup.h>
+#include <util/SeedPrg.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+using namespace safrn::dataowner;
+
+TEST(LookupTable, rotated_inner_product_matches_bytewise) {
+  size_t const num_entries = 203;
+  size_t const num_bytes = 3;
+  SeedPrg prg(SeedPrg::newSeed());
+
+  std::vector<std::vector<Boolean_t>> entries(
+      num_entries, std::vector<Boolean_t>(num_bytes));
+  for (size_t i = 0; i < num_entries; i++) {
+    prg.bytes(entries[i].data(), num_bytes);
+  }
+  LookupTable const table(entries, num_bytes);
+
+  dealer::RandomTableLookupInfo const info(
+      1009, static_cast<SmallNum>(num_entries));
+  dealer::RandomTableLookup u(info);
+  info.expandShare(prg, u);
+
+  for (size_t offset = 0; offset < num_entries; offset += 7) {
+    std::vector<Boolean_t> expected(num_bytes, 0x00);
+    for (size_t i = 0; i < num_entries; i++) {
+      if (u.bit(i)) {
+        for (size_t j = 0; j < num_bytes; j++) {
+          expected[j] ^= entries[(offset + i) % num_entries][j];
+        }
+      }
+    }
+
+    std::vector<Boolean_t> actual;
+    table.rotatedInnerProduct(u.u_, offset, actual);
+    EXPECT_EQ(expected, actual);
+  }
+}
+
+TEST(LookupTable, rotated_inner_products_match_one_at_a_time) {
+  size_t const num_bytes = 2;
+  SeedPrg prg(SeedPrg::newSeed());
+
+  /* Sizes around a word, so that rotations straddle its edges. */
+  for (size_t num_entries : {1UL, 7UL, 8UL, 9UL, 64UL, 203UL}) {
+    std::vector<std::vector<Boolean_t>> entries(
+        num_entries, std::vector<Boolean_t>(num_bytes));
+    for (size_t i = 0; i < num_entries; i++) {
+      prg.bytes(entries[i].data(), num_bytes);
+    }
+    LookupTable const table(entries, num_bytes);
+
+    dealer::RandomTableLookupInfo const info(
+        1009, static_cast<SmallNum>(num_entries));
+    size_t const num_lookups = 9;
+    std::vector<dealer::RandomTableLookup> lookups(
+        num_lookups, dealer::RandomTableLookup(info));
+    std::vector<std::vector<uint64_t> const *> us;
+    std::vector<size_t> offsets;
+    for (size_t m = 0; m < num_lookups; m++) {
+      info.expandShare(prg, lookups[m]);
+      us.push_back(&lookups[m].u_);
+      offsets.push_back((5 * m + 3) % (2 * num_entries));
+    }
+
+    std::vector<std::vector<Boolean_t>> actual;
+    table.rotatedInnerProducts(us, offsets, actual);
+    ASSERT_EQ(num_lookups, actual.size());
+    for (size_t m = 0; m < num_lookups; m++) {
+      std::vector<Boolean_t> expected;
+      table.rotatedInnerProduct(lookups[m].u_, offsets[m], expected);
+      EXPECT_EQ(expected, actual[m])
+          << "num_entries: " << num_entries << " m: " << m;
+    }
+  }
+}
+
+TEST(LookupTable, binary_table_matches_csv) {
+  char dir_template[] = "/tmp/safrn_table_XXXXXX";
+  char * dir = mkdtemp(dir_template);
+  ASSERT_FALSE(dir == nullptr);
+  std::string const csv_file = std::string(dir) + "/t_table.csv";
+  std::string const bin_file = lookupTableBinaryFile(csv_file);
+  EXPECT_EQ(std::string(dir) + "/t_table.bin", bin_file);
+
+  {
+    std::ofstream csv(csv_file.c_str());
+    csv << "#bits_of_precision=5\n#step_size=4\n";
+    csv << "1,0.5,0.25,0.125\n";
+    csv << "2,0.75,0.0625,0.00000001\n";
+    csv << "7,0.9,0.3,0.1\n";
+  }
+
+  size_t const num_bytes = 4;
+  std::vector<size_t> csv_row_ids;
+  LookupTable csv_table;
+  LargeNum csv_num_cols;
+  size_t csv_bits;
+  LargeNum csv_step;
+  ASSERT_TRUE(loadLookupTable(
+      csv_file,
+      csv_row_ids,
+      csv_table,
+      csv_num_cols,
+      csv_bits,
+      csv_step,
+      10,
+      num_bytes));
+
+  ASSERT_TRUE(convertLookupTableCsv(csv_file, bin_file, num_bytes));
+  std::vector<size_t> bin_row_ids;
+  LookupTable bin_table;
+  LargeNum bin_num_cols;
+  size_t bin_bits;
+  LargeNum bin_step;
+  ASSERT_TRUE(loadLookupTable(
+      csv_file,
+      bin_row_ids,
+      bin_table,
+      bin_num_cols,
+      bin_bits,
+      bin_step,
+      10,
+      num_bytes));
+
+  EXPECT_EQ(csv_row_ids, bin_row_ids);
+  EXPECT_EQ(csv_num_cols, bin_num_cols);
+  EXPECT_EQ(csv_bits, bin_bits);
+  EXPECT_EQ(csv_step, bin_step);
+  ASSERT_EQ(9UL, bin_table.size());
+  ASSERT_EQ(csv_table.size(), bin_table.size());
+  for (size_t i = 0; i < bin_table.size(); i++) {
+    for (size_t j = 0; j < num_bytes; j++) {
+      EXPECT_EQ(csv_table.at(i, j), bin_table.at(i, j));
+    }
+  }
+
+  /* Queries in one process share one mapping. */
+  EXPECT_EQ(
+      MappedLookupTable::openShared(bin_file),
+      MappedLookupTable::openShared(bin_file));
+
+  unlink(csv_file.c_str());
+  unlink(bin_file.c_str());
+  rmdir(dir);
+}
+
+TEST(LookupTable, both_formats_keep_max_rows) {
+  char dir_template[] = "/tmp/safrn_table_XXXXXX";
+  char * dir = mkdtemp(dir_template);
+  ASSERT_FALSE(dir == nullptr);
+  std::string const csv_file = std::string(dir) + "/F_table.csv";
+  std::string const bin_file = lookupTableBinaryFile(csv_file);
+
+  {
+    std::ofstream csv(csv_file.c_str());
+    csv << "#bits_of_precision=5\n#step_size=4\n";
+    csv << "1,0.5,0.25\n";
+    csv << "2,0.75,0.0625\n";
+    csv << "7,0.9,0.3\n";
+  }
+
+  size_t const num_bytes = 2;
+  std::vector<size_t> csv_row_ids;
+  LookupTable csv_table;
+  LargeNum csv_num_cols;
+  size_t csv_bits;
+  LargeNum csv_step;
+  ASSERT_TRUE(loadLookupTable(
+      csv_file,
+      csv_row_ids,
+      csv_table,
+      csv_num_cols,
+      csv_bits,
+      csv_step,
+      2,
+      num_bytes));
+
+  ASSERT_TRUE(convertLookupTableCsv(csv_file, bin_file, num_bytes));
+  std::vector<size_t> bin_row_ids;
+  LookupTable bin_table;
+  LargeNum bin_num_cols;
+  size_t bin_bits;
+  LargeNum bin_step;
+  ASSERT_TRUE(loadLookupTable(
+      csv_file,
+      bin_row_ids,
+      bin_table,
+      bin_num_cols,
+      bin_bits,
+      bin_step,
+      2,
+      num_bytes));
+
+  std::vector<size_t> const row_ids = {1, 2};
+  EXPECT_EQ(row_ids, csv_row_ids);
+  EXPECT_EQ(row_ids, bin_row_ids);
+  ASSERT_EQ(4UL, csv_table.size());
+  ASSERT_EQ(4UL, bin_table.size());
+  for (size_t i = 0; i < bin_table.size(); i++) {
+    for (size_t j = 0; j < num_bytes; j++) {
+      EXPECT_EQ(csv_table.at(i, j), bin_table.at(i, j));
+    }
+  }
+
+  unlink(csv_file.c_str());
+  unlink(bin_file.c_str());
+  rmdir(dir);
+}
@@ -0,0 +1,118 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <map>
+#include <memory>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+#include <mpc/ModUtils.h>
+
+/* SAFRN Headers */
+#include <dataowner/MatrixMultiply.h>
+#include <framework/Framework.h>
+#include <framework/TestRunner.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+using namespace safrn::dataowner;
+
+static void checkMatrixMultiply(LargeNum const & p) {
+  size_t const num_parties = 3;
+  size_t const rows = 4;
+  size_t const inner = 4;
+  size_t const cols = 5;
+  std::vector<Identity> const parties = {
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE01", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE02", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE03", ROLE_DATAOWNER, 1)};
+  Identity const & revealer = parties[0];
+
+  dealer::MatrixBeaverTripleInfo<LargeNum, LargeNum> info(
+      rows, inner, cols, p);
+  std::vector<dealer::MatrixBeaverTriple<LargeNum>> triples;
+  info.generate(num_parties, 1, triples);
+
+  /* Values, some at the edges of the field, and their shares. */
+  ff::mpc::Matrix<LargeNum> x(rows, inner);
+  ff::mpc::Matrix<LargeNum> y(inner, cols);
+  std::vector<ff::mpc::Matrix<LargeNum>> x_shares(
+      num_parties, ff::mpc::Matrix<LargeNum>(rows, inner));
+  std::vector<ff::mpc::Matrix<LargeNum>> y_shares(
+      num_parties, ff::mpc::Matrix<LargeNum>(inner, cols));
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t k = 0; k < inner; k++) {
+      x.at(i, k) = i == k ? p - 1 : ff::mpc::randomModP<LargeNum>(p);
+      LargeNum rest = x.at(i, k);
+      for (size_t j = 1; j < num_parties; j++) {
+        x_shares[j].at(i, k) = ff::mpc::randomModP<LargeNum>(p);
+        rest = ff::mpc::modSub(rest, x_shares[j].at(i, k), p);
+      }
+      x_shares[0].at(i, k) = rest;
+    }
+  }
+  for (size_t k = 0; k < inner; k++) {
+    for (size_t i = 0; i < cols; i++) {
+      y.at(k, i) =
+          k == 0 ? LargeNum(0) : ff::mpc::randomModP<LargeNum>(p);
+      LargeNum rest = y.at(k, i);
+      for (size_t j = 1; j < num_parties; j++) {
+        y_shares[j].at(k, i) = ff::mpc::randomModP<LargeNum>(p);
+        rest = ff::mpc::modSub(rest, y_shares[j].at(k, i), p);
+      }
+      y_shares[0].at(k, i) = rest;
+    }
+  }
+
+  std::vector<ff::mpc::Matrix<LargeNum>> outputs(
+      num_parties, ff::mpc::Matrix<LargeNum>(rows, cols));
+  std::map<Identity, std::unique_ptr<Fronctocol>> test;
+  for (size_t j = 0; j < num_parties; j++) {
+    test[parties[j]] = std::unique_ptr<Fronctocol>(new Tester(
+        [&, j](Fronctocol * self) {
+          std::unique_ptr<Fronctocol> multiply(new MatrixMultiply(
+              x_shares[j],
+              y_shares[j],
+              std::move(triples[j]),
+              p,
+              revealer));
+          self->invoke(std::move(multiply), self->getPeers());
+        },
+        [&, j](Fronctocol & f, Fronctocol * self) {
+          outputs[j] = static_cast<MatrixMultiply &>(f).output;
+          self->complete();
+        }));
+  }
+
+  EXPECT_TRUE(runTests(test));
+
+  for (size_t i = 0; i < rows; i++) {
+    for (size_t l = 0; l < cols; l++) {
+      LargeNum expected(0);
+      for (size_t k = 0; k < inner; k++) {
+        expected = ff::mpc::modAdd(
+            expected, ff::mpc::modMul(x.at(i, k), y.at(k, l), p), p);
+      }
+      LargeNum product(0);
+      for (size_t j = 0; j < num_parties; j++) {
+        product = ff::mpc::modAdd(product, outputs[j].at(i, l), p);
+      }
+      EXPECT_EQ(expected, product) << "i: " << i << " l: " << l;
+    }
+  }
+}
+
+TEST(MatrixMultiply, word_modulus) {
+  checkMatrixMultiply((LargeNum(1) << 61) - 1);
+}
+
+TEST(MatrixMultiply, large_modulus) {
+  checkMatrixMultiply(ff::mpc::nextPrime(LargeNum(1) << 160));
+}
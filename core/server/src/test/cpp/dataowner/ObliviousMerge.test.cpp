@@ -0,0 +1,278 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+#include <mpc/ModUtils.h>
+
+/* SAFRN Headers */
+#include <dataowner/ObliviousMerge.h>
+#include <dealer/MergeHouse.h>
+#include <framework/Framework.h>
+#include <framework/TestRunner.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+using namespace safrn::dataowner;
+
+using Layers = std::vector<std::vector<ObliviousMerge::Comparator>>;
+
+/* Runs the network on plaintext, smaller value first. */
+static void runNetwork(Layers const & layers, std::vector<int> & xs) {
+  for (std::vector<ObliviousMerge::Comparator> const & layer : layers) {
+    for (ObliviousMerge::Comparator const & c : layer) {
+      if (xs[c.first] > xs[c.second]) {
+        std::swap(xs[c.first], xs[c.second]);
+      }
+    }
+  }
+}
+
+TEST(ObliviousMerge, layers_touch_disjoint_rows) {
+  for (size_t n = 1; n <= 128; n++) {
+    Layers const layers = ObliviousMerge::mergeNetwork(n);
+    for (std::vector<ObliviousMerge::Comparator> const & layer :
+         layers) {
+      std::vector<bool> touched(n, false);
+      for (ObliviousMerge::Comparator const & c : layer) {
+        ASSERT_LT(c.first, c.second);
+        ASSERT_LT(c.second, n);
+        EXPECT_FALSE(touched[c.first]) << "n: " << n;
+        EXPECT_FALSE(touched[c.second]) << "n: " << n;
+        touched[c.first] = true;
+        touched[c.second] = true;
+      }
+    }
+  }
+}
+
+/**
+ * By the 0-1 principle, merging every descending 0-1 half against
+ * every ascending 0-1 half covers all inputs.
+ */
+TEST(ObliviousMerge, merges_descending_and_ascending_halves) {
+  for (size_t n = 1; n <= 40; n++) {
+    Layers const layers = ObliviousMerge::mergeNetwork(2 * n);
+    for (size_t a = 0; a <= n; a++) {
+      for (size_t b = 0; b <= n; b++) {
+        std::vector<int> xs(2 * n, 0);
+        std::fill(xs.begin(), xs.begin() + a, 1);
+        std::fill(xs.end() - b, xs.end(), 1);
+        runNetwork(layers, xs);
+        EXPECT_TRUE(std::is_sorted(xs.begin(), xs.end()))
+            << "n: " << n << " a: " << a << " b: " << b;
+      }
+    }
+  }
+}
+
+/**
+ * As above, for halves of unequal lengths, as each vertical's list is
+ * bounded by its own size.
+ */
+TEST(ObliviousMerge, merges_unequal_halves) {
+  for (size_t n = 0; n <= 40; n++) {
+    Layers const layers = ObliviousMerge::mergeNetwork(n);
+    for (size_t split = 0; split <= n; split++) {
+      for (size_t a = 0; a <= split; a++) {
+        for (size_t b = 0; b <= n - split; b++) {
+          std::vector<int> xs(n, 0);
+          std::fill(xs.begin(), xs.begin() + a, 1);
+          std::fill(xs.end() - b, xs.end(), 1);
+          runNetwork(layers, xs);
+          EXPECT_TRUE(std::is_sorted(xs.begin(), xs.end()))
+              << "n: " << n << " split: " << split << " a: " << a
+              << " b: " << b;
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Merges a descending values against b ascending ones, with ties, and
+ * checks the result is the sorted values.
+ */
+static void checkUnequalHalves(size_t const a, size_t const b) {
+  std::vector<int> xs(a + b);
+  for (int & x : xs) {
+    x = rand() % 10;
+  }
+  std::sort(xs.begin(), xs.begin() + a, std::greater<int>());
+  std::sort(xs.begin() + a, xs.end());
+  std::vector<int> expected = xs;
+  std::sort(expected.begin(), expected.end());
+
+  runNetwork(ObliviousMerge::mergeNetwork(a + b), xs);
+  EXPECT_EQ(expected, xs) << "a: " << a << " b: " << b;
+}
+
+TEST(ObliviousMerge, merges_unequal_values) {
+  for (size_t trial = 0; trial < 20; trial++) {
+    checkUnequalHalves(3, 5);
+    checkUnequalHalves(5, 3);
+    checkUnequalHalves(1, 6);
+    checkUnequalHalves(6, 1);
+    checkUnequalHalves(0, 9);
+    checkUnequalHalves(9, 0);
+    checkUnequalHalves(17, 100);
+  }
+}
+
+TEST(ObliviousMerge, logarithmic_depth) {
+  Layers const layers = ObliviousMerge::mergeNetwork(2000);
+  EXPECT_EQ(11U, layers.size());
+  size_t comparators = 0;
+  for (std::vector<ObliviousMerge::Comparator> const & layer : layers) {
+    comparators += layer.size();
+  }
+  EXPECT_EQ(10864U, comparators);
+}
+
+/**
+ * Shares a descending rows of vertical 0 followed by b ascending rows
+ * of vertical 1 between two dataowners, merges them with the dealer's
+ * randomness, then opens the list and checks it is sorted by its
+ * packed key and holds the same rows. Each row is a packed key, the
+ * plain key and two payloads.
+ */
+static void checkObliviousMerge(size_t const a, size_t const b) {
+  size_t const num_parties = 2;
+  size_t const n = a + b;
+  size_t const num_key_cols = 2;
+  size_t const num_cols = 4;
+  std::vector<Identity> const parties = {
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE01", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE02", ROLE_DATAOWNER, 1)};
+  Identity const dealer(
+      "EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE00", ROLE_DEALER, SIZE_MAX);
+  Identity const & revealer = parties[0];
+
+  /* Sized as RegressionInfo sizes it, for the default key_max. */
+  LargeNum const key_modulus =
+      ff::mpc::nextPrime(LargeNum(4) * (LargeNum(1 << 20) + 2));
+  LargeNum const payload_modulus = (LargeNum(1) << 61) - 1;
+
+  /* Few distinct keys, so that packed keys tie across the halves. */
+  std::vector<std::vector<LargeNum>> rows(n);
+  for (size_t i = 0; i < n; i++) {
+    LargeNum const key(static_cast<uint64_t>(rand() % 8));
+    rows[i] = {
+        LargeNum(2 * key + (i < a ? 0 : 1)),
+        key,
+        ff::mpc::randomModP<LargeNum>(payload_modulus),
+        ff::mpc::randomModP<LargeNum>(payload_modulus)};
+  }
+  std::sort(
+      rows.begin(),
+      rows.begin() + a,
+      [](std::vector<LargeNum> const & x,
+         std::vector<LargeNum> const & y) { return x[0] > y[0]; });
+  std::sort(
+      rows.begin() + a,
+      rows.end(),
+      [](std::vector<LargeNum> const & x,
+         std::vector<LargeNum> const & y) { return x[0] < y[0]; });
+
+  std::vector<ff::mpc::ObservationList<LargeNum>> lists(num_parties);
+  for (ff::mpc::ObservationList<LargeNum> & list : lists) {
+    list.numKeyCols = num_key_cols;
+    list.numArithmeticPayloadCols = num_cols - num_key_cols;
+    list.numXORPayloadCols = 0;
+    list.elements.resize(n);
+  }
+  for (size_t i = 0; i < n; i++) {
+    for (size_t c = 0; c < num_cols; c++) {
+      LargeNum const & m =
+          c < num_key_cols ? key_modulus : payload_modulus;
+      LargeNum const share = ff::mpc::randomModP<LargeNum>(m);
+      std::vector<LargeNum> & col0 = c < num_key_cols ?
+          lists[0].elements[i].keyCols :
+          lists[0].elements[i].arithmeticPayloadCols;
+      std::vector<LargeNum> & col1 = c < num_key_cols ?
+          lists[1].elements[i].keyCols :
+          lists[1].elements[i].arithmeticPayloadCols;
+      col0.push_back(ff::mpc::modSub(rows[i][c], share, m));
+      col1.push_back(share);
+    }
+  }
+
+  std::map<Identity, std::unique_ptr<Fronctocol>> test;
+  test[dealer] = std::unique_ptr<Fronctocol>(new Tester(
+      [&](Fronctocol * self) {
+        std::unique_ptr<Fronctocol> house(
+            new dealer::MergeRandomnessHouse(key_modulus, &revealer));
+        self->invoke(std::move(house), self->getPeers());
+      },
+      finishTestOnComplete));
+  for (size_t j = 0; j < num_parties; j++) {
+    test[parties[j]] = std::unique_ptr<Fronctocol>(new Tester(
+        [&, j](Fronctocol * self) {
+          std::unique_ptr<Fronctocol> merge(new ObliviousMerge(
+              lists[j],
+              payload_modulus,
+              key_modulus,
+              &revealer,
+              &dealer));
+          self->invoke(std::move(merge), self->getPeers());
+        },
+        [](Fronctocol &, Fronctocol * self) { self->complete(); }));
+  }
+
+  EXPECT_TRUE(runTests(test));
+
+  std::vector<std::vector<LargeNum>> merged(
+      n, std::vector<LargeNum>(num_cols));
+  for (size_t i = 0; i < n; i++) {
+    for (size_t j = 0; j < num_parties; j++) {
+      ASSERT_EQ(n, lists[j].elements.size());
+      ASSERT_EQ(num_key_cols, lists[j].elements[i].keyCols.size());
+    }
+    for (size_t c = 0; c < num_cols; c++) {
+      LargeNum const & m =
+          c < num_key_cols ? key_modulus : payload_modulus;
+      LargeNum const & share0 = c < num_key_cols ?
+          lists[0].elements[i].keyCols[c] :
+          lists[0].elements[i].arithmeticPayloadCols[c - num_key_cols];
+      LargeNum const & share1 = c < num_key_cols ?
+          lists[1].elements[i].keyCols[c] :
+          lists[1].elements[i].arithmeticPayloadCols[c - num_key_cols];
+      merged[i][c] = ff::mpc::modAdd(share0 % m, share1 % m, m);
+    }
+  }
+
+  for (size_t i = 1; i < n; i++) {
+    EXPECT_LE(merged[i - 1][0], merged[i][0])
+        << "a: " << a << " b: " << b << " i: " << i;
+  }
+  std::sort(rows.begin(), rows.end());
+  std::sort(merged.begin(), merged.end());
+  EXPECT_EQ(rows, merged) << "a: " << a << " b: " << b;
+}
+
+TEST(ObliviousMerge, merges_shared_equal_halves) {
+  checkObliviousMerge(6, 6);
+}
+
+TEST(ObliviousMerge, merges_shared_unequal_halves) {
+  checkObliviousMerge(3, 5);
+  checkObliviousMerge(1, 6);
+  checkObliviousMerge(0, 7);
+  checkObliviousMerge(9, 2);
+}
@@ -0,0 +1,165 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+
+/* SAFRN Headers */
+#include <Identity.h>
+#include <dataowner/GlobalInfo.h>
+#include <dataowner/RegressionInfo.h>
+#include <dataowner/RegressionPatron.h>
+#include <dealer/RandomTableLookup.h>
+#include <dealer/RegressionHouse.h>
+#include <framework/Framework.h>
+#include <framework/TestRunner.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+using namespace safrn::dataowner;
+
+/**
+ * Runs a RegressionRandomnessPatron on each of three dataowners, two in
+ * the dependent vertical and one in the other, against the dealer's
+ * RegressionRandomnessBasement, the part of RegressionRandomnessHouse
+ * which serves it. The seed shuffles message delivery, and so the
+ * order in which the patron's children complete.
+ */
+static void checkRegressionPatron(uint64_t const seed) {
+  size_t const num_parties = 3;
+  size_t const F_rows = 5;
+  size_t const t_rows = 9;
+  std::vector<Identity> const parties = {
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE01", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE02", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE03", ROLE_DATAOWNER, 1)};
+  Identity const dealer(
+      "EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE00", ROLE_DEALER, SIZE_MAX);
+  Identity const & revealer = parties[0];
+
+  GlobalInfo const globals(10, num_parties, 30);
+  std::vector<size_t> const num_cross_parties = {1, 1, 2};
+  std::vector<std::unique_ptr<RegressionInfo const>> infos;
+  for (size_t j = 0; j < num_parties; j++) {
+    infos.emplace_back(new RegressionInfo(
+        &globals,
+        parties[j].vertical,
+        0,
+        2,
+        1,
+        num_cross_parties[j],
+        true,
+        &revealer,
+        &dealer));
+  }
+  RegressionInfo const dealer_info(
+      &globals,
+      SIZE_MAX,
+      0,
+      2,
+      1,
+      num_parties,
+      true,
+      &revealer,
+      &dealer);
+  size_t const num_IVs = dealer_info.num_IVs;
+
+  dealer::RandomTableLookupInfo const F_info(
+      dealer_info.endModulus, F_rows);
+  dealer::RandomTableLookupInfo const t_info(
+      dealer_info.endModulus, t_rows);
+
+  std::map<Identity, std::unique_ptr<Fronctocol>> test;
+  test[dealer] = std::unique_ptr<Fronctocol>(new Tester(
+      [&](Fronctocol * self) {
+        std::unique_ptr<Fronctocol> basement(
+            new dealer::RegressionRandomnessBasement(&dealer_info));
+        self->invoke(std::move(basement), self->getPeers());
+      },
+      finishTestOnComplete));
+
+  std::vector<RegressionRandomness> randomness(num_parties);
+  for (size_t j = 0; j < num_parties; j++) {
+    test[parties[j]] = std::unique_ptr<Fronctocol>(new Tester(
+        [&, j](Fronctocol * self) {
+          std::unique_ptr<Fronctocol> patron(
+              new RegressionRandomnessPatron(
+                  infos[j].get(),
+                  &dealer,
+                  F_rows,
+                  t_rows,
+                  &F_info,
+                  &t_info,
+                  1));
+          self->invoke(std::move(patron), self->getPeers());
+        },
+        [&, j](Fronctocol & f, Fronctocol * self) {
+          randomness[j] = std::move(
+              static_cast<RegressionRandomnessPatron &>(f)
+                  .regressionDispenser->get());
+          self->complete();
+        }));
+  }
+
+  ASSERT_TRUE(runTests(test, seed)) << "seed: " << seed;
+
+  for (size_t j = 0; j < num_parties; j++) {
+    RegressionRandomness const & r = randomness[j];
+    ASSERT_NE(nullptr, r.modConvUpDispenser) << "party: " << j;
+    ASSERT_NE(nullptr, r.divideDispenser) << "party: " << j;
+    ASSERT_NE(nullptr, r.matrixBeaverTripleDispenser) << "party: " << j;
+    ASSERT_NE(nullptr, r.randomMatrixAndDetInverseDispenser)
+        << "party: " << j;
+    ASSERT_NE(nullptr, r.beaverTripleForFinalMultiplyDispenser)
+        << "party: " << j;
+    ASSERT_NE(nullptr, r.truncationPairDispenser) << "party: " << j;
+    ASSERT_NE(nullptr, r.compareEndModulusDispenser) << "party: " << j;
+    ASSERT_NE(nullptr, r.typeCastFromBitDispenser) << "party: " << j;
+    ASSERT_NE(nullptr, r.F_lookupDispenser) << "party: " << j;
+    ASSERT_NE(nullptr, r.t_lookupDispenser) << "party: " << j;
+
+    /* One of each pairwise dispenser per party across the join. */
+    ASSERT_EQ(num_cross_parties[j], r.zipAdjacentDispensers.size());
+    ASSERT_EQ(
+        num_cross_parties[j],
+        r.beaverTripleForFactoryDispensers.size());
+    for (size_t k = 0; k < num_cross_parties[j]; k++) {
+      ASSERT_NE(nullptr, r.zipAdjacentDispensers[k])
+          << "party: " << j << " cross party: " << k;
+      EXPECT_EQ(1U, r.zipAdjacentDispensers[k]->size());
+      ASSERT_NE(nullptr, r.beaverTripleForFactoryDispensers[k])
+          << "party: " << j << " cross party: " << k;
+      EXPECT_LT(0U, r.beaverTripleForFactoryDispensers[k]->size());
+    }
+
+    EXPECT_EQ(1U, r.matrixBeaverTripleDispenser->size());
+    EXPECT_EQ(1U, r.randomMatrixAndDetInverseDispenser->size());
+    EXPECT_EQ(num_IVs, r.truncationPairDispenser->size());
+    EXPECT_EQ(1U, r.F_lookupDispenser->size());
+    EXPECT_EQ(num_IVs, r.t_lookupDispenser->size());
+    EXPECT_LT(0U, r.modConvUpDispenser->size());
+    EXPECT_LT(0U, r.divideDispenser->size());
+    EXPECT_LT(0U, r.beaverTripleForFinalMultiplyDispenser->size());
+    EXPECT_LT(0U, r.compareEndModulusDispenser->size());
+    EXPECT_LT(0U, r.typeCastFromBitDispenser->size());
+  }
+}
+
+TEST(RegressionPatron, fills_every_dispenser) {
+  for (uint64_t seed = 0; seed < 8; seed++) {
+    checkRegressionPatron(seed);
+  }
+}
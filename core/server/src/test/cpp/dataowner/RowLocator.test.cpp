@@ -0,0 +1,206 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+#include <mpc/CompareDealer.h>
+#include <mpc/ModUtils.h>
+
+/* SAFRN Headers */
+#include <dataowner/RowLocator.h>
+#include <framework/Framework.h>
+#include <framework/TestRunner.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+using namespace safrn::dataowner;
+
+/**
+ * Locates each key among the row ids, with one RowLocator per key in a
+ * Batch, and checks the rows found. Each locator is given exactly
+ * numBeaverTriples of its rows.
+ */
+static void checkRowLocator(
+    std::vector<size_t> const & row_ids,
+    std::vector<size_t> const & keys) {
+  size_t const num_parties = 2;
+  size_t const n = keys.size();
+  std::vector<Identity> const parties = {
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE01", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE02", ROLE_DATAOWNER, 1)};
+  Identity const dealer(
+      "EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE00", ROLE_DEALER, SIZE_MAX);
+  Identity const & revealer = parties[0];
+
+  LargeNum const p = (LargeNum(1) << 61) - 1;
+  LargeNum const key_bound = LargeNum(row_ids.back()) + 100;
+  ff::mpc::CompareInfo<Identity, LargeNum, SmallNum> const compare_info(
+      p, &revealer);
+  size_t const levels = RowLocator::numLevels(row_ids.size());
+
+  /* Type casts and Beaver triples, as the dealer would send. */
+  ff::mpc::TypeCastFromBitInfo<LargeNum> type_cast_info(p);
+  ff::mpc::BeaverInfo<LargeNum> beaver_info(p);
+  std::vector<std::unique_ptr<RowLocator::TypeCastFromBitDispenser>>
+      type_casts;
+  std::vector<std::unique_ptr<RowLocator::BeaverDispenser>> beavers;
+  for (size_t j = 0; j < num_parties; j++) {
+    type_casts.emplace_back(
+        new RowLocator::TypeCastFromBitDispenser(type_cast_info));
+    beavers.emplace_back(new RowLocator::BeaverDispenser(beaver_info));
+  }
+  for (size_t i = 0; i < n * levels; i++) {
+    std::vector<ff::mpc::TypeCastTriple<LargeNum>> triples;
+    type_cast_info.generate(num_parties, 1, triples);
+    for (size_t j = 0; j < num_parties; j++) {
+      type_casts[j]->insert(triples[j]);
+    }
+  }
+  size_t const num_beavers =
+      n * RowLocator::numBeaverTriples(row_ids.size());
+  for (size_t i = 0; i < num_beavers; i++) {
+    std::vector<ff::mpc::BeaverTriple<LargeNum>> triples;
+    beaver_info.generate(num_parties, 1, triples);
+    for (size_t j = 0; j < num_parties; j++) {
+      beavers[j]->insert(triples[j]);
+    }
+  }
+
+  std::vector<std::vector<LargeNum>> key_shares(
+      num_parties, std::vector<LargeNum>(n));
+  for (size_t i = 0; i < n; i++) {
+    key_shares[1][i] = ff::mpc::randomModP<LargeNum>(p);
+    key_shares[0][i] =
+        ff::mpc::modSub(LargeNum(keys[i]), key_shares[1][i], p);
+  }
+
+  std::map<Identity, std::unique_ptr<Fronctocol>> test;
+  test[dealer] = std::unique_ptr<Fronctocol>(new Tester(
+      [&](Fronctocol * self) {
+        std::unique_ptr<Fronctocol> house(
+            new ff::mpc::
+                CompareRandomnessHouse<SAFRN_TYPES, LargeNum, SmallNum>(
+                    &compare_info));
+        self->invoke(std::move(house), self->getPeers());
+      },
+      finishTestOnComplete));
+
+  std::vector<std::vector<LargeNum>> outputs(
+      num_parties, std::vector<LargeNum>(n));
+  std::vector<std::unique_ptr<RowLocator::CompareDispenser>> compares(
+      num_parties);
+  for (size_t j = 0; j < num_parties; j++) {
+    test[parties[j]] = std::unique_ptr<Fronctocol>(new Tester(
+        [&, j](Fronctocol * self) {
+          std::unique_ptr<Fronctocol> patron(
+              new ff::mpc::CompareRandomnessPatron<
+                  SAFRN_TYPES,
+                  LargeNum,
+                  SmallNum>(&compare_info, &dealer, n * levels));
+          self->invoke(std::move(patron), self->getPeers());
+        },
+        [&, j](Fronctocol & f, Fronctocol * self) {
+          if (compares[j] != nullptr) {
+            Batch & batch = static_cast<Batch &>(f);
+            for (size_t i = 0; i < n; i++) {
+              outputs[j][i] =
+                  static_cast<RowLocator &>(*batch.children[i]).output;
+            }
+            self->complete();
+            return;
+          }
+          compares[j] =
+              std::move(static_cast<ff::mpc::CompareRandomnessPatron<
+                            SAFRN_TYPES,
+                            LargeNum,
+                            SmallNum> &>(f)
+                            .compareDispenser);
+
+          std::unique_ptr<Batch> batch(new Batch());
+          for (size_t i = 0; i < n; i++) {
+            batch->children.emplace_back(new RowLocator(
+                key_shares[j][i],
+                row_ids,
+                key_bound,
+                &compare_info,
+                *compares[j],
+                *type_casts[j],
+                *beavers[j],
+                p,
+                revealer));
+          }
+          PeerSet ps(self->getPeers());
+          ps.removeDealer();
+          self->invoke(std::move(batch), ps);
+        }));
+  }
+
+  EXPECT_TRUE(runTests(test));
+
+  for (size_t i = 0; i < n; i++) {
+    /* The row is the number of row ids, but the last, below the key. */
+    size_t expected = 0;
+    while (expected + 1 < row_ids.size() &&
+           row_ids[expected] < keys[i]) {
+      expected++;
+    }
+    EXPECT_EQ(
+        LargeNum(expected),
+        ff::mpc::modAdd(outputs[0][i], outputs[1][i], p))
+        << "key: " << keys[i];
+  }
+}
+
+TEST(RowLocator, ties_at_row_boundaries) {
+  std::vector<size_t> const row_ids = {2, 4, 8, 16, 32, 64, 128, 256};
+  std::vector<size_t> keys;
+  for (size_t const id : row_ids) {
+    keys.push_back(id - 1);
+    keys.push_back(id);
+    keys.push_back(id + 1);
+  }
+  checkRowLocator(row_ids, keys);
+}
+
+TEST(RowLocator, one_row) {
+  checkRowLocator({10}, {0, 10, 11});
+}
+
+TEST(RowLocator, two_rows) {
+  checkRowLocator({10, 20}, {0, 9, 10, 11, 20, 21});
+}
+
+TEST(RowLocator, rows_not_a_power_of_two) {
+  checkRowLocator({1, 3, 5}, {0, 1, 2, 3, 4, 5, 6});
+  checkRowLocator({1, 2, 3, 5, 8}, {0, 1, 2, 3, 4, 5, 7, 8, 9});
+  checkRowLocator(
+      {3, 6, 9, 12, 15, 18, 21, 24, 27, 30, 33, 36},
+      {0, 3, 4, 14, 15, 16, 33, 34, 36, 40});
+}
+
+TEST(RowLocator, beaver_triples_count_the_prefix_products) {
+  for (size_t rows = 1; rows <= 1100; rows++) {
+    /* After the first level, each level but the last multiplies the
+     * one-hot prefix, of 2^level entries, by its bit. */
+    size_t const levels = RowLocator::numLevels(rows);
+    size_t products = 0;
+    for (size_t level = 1; level + 1 < levels; level++) {
+      products += size_t(1) << level;
+    }
+    EXPECT_EQ(products, RowLocator::numBeaverTriples(rows))
+        << "rows: " << rows;
+    EXPECT_GE(size_t(1) << levels, rows);
+    EXPECT_TRUE(levels == 0 || (size_t(1) << (levels - 1)) < rows);
+  }
+}
@@ -0,0 +1,200 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+#include <mpc/DivideDealer.h>
+#include <mpc/ModUtils.h>
+
+/* SAFRN Headers */
+#include <dataowner/SharedDivide.h>
+#include <framework/Framework.h>
+#include <framework/TestRunner.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+using namespace safrn::dataowner;
+
+/**
+ * Shares numerators[i] / denominator among two dataowners and checks
+ * each quotient. A negative numerator is divided by its magnitude and
+ * the quotient's shares negated, as Regression corrects the sign.
+ */
+static void checkSharedDivide(
+    std::vector<LargeNum> const & magnitudes,
+    std::vector<bool> const & negative,
+    LargeNum const & denominator,
+    size_t const numerator_bits) {
+  size_t const num_parties = 2;
+  size_t const n = magnitudes.size();
+  std::vector<Identity> const parties = {
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE01", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE02", ROLE_DATAOWNER, 1)};
+  Identity const dealer(
+      "EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE00", ROLE_DEALER, SIZE_MAX);
+  Identity const & revealer = parties[0];
+
+  LargeNum const p = ff::mpc::nextPrime(
+      LargeNum(1) << SharedDivideInfo::modulusBits(numerator_bits));
+  ff::mpc::CompareInfo<Identity, LargeNum, SmallNum> const compare_info(
+      p, &revealer);
+  ff::mpc::DivideInfo<Identity, LargeNum, SmallNum> const divide_info(
+      &revealer,
+      p,
+      compare_info.ell,
+      compare_info.lambda,
+      compare_info.lagrangePolynomialSet,
+      &compare_info);
+  SharedDivideInfo const info(
+      &revealer, p, numerator_bits, &divide_info);
+
+  /* Beaver triples and truncation pairs, as the dealer would send. */
+  ff::mpc::BeaverInfo<LargeNum> beaver_info(p);
+  std::vector<std::unique_ptr<SharedDivide::BeaverDispenser>> beavers;
+  std::vector<std::unique_ptr<SharedDivide::TruncationDispenser>>
+      truncations;
+  for (size_t j = 0; j < num_parties; j++) {
+    beavers.emplace_back(
+        new SharedDivide::BeaverDispenser(beaver_info));
+    truncations.emplace_back(
+        new SharedDivide::TruncationDispenser(info.truncationInfo));
+  }
+  for (size_t i = 0; i < n; i++) {
+    std::vector<ff::mpc::BeaverTriple<LargeNum>> triples;
+    beaver_info.generate(num_parties, 1, triples);
+    std::vector<dealer::TruncationPair<LargeNum>> pairs;
+    info.truncationInfo.generate(num_parties, 1, pairs);
+    for (size_t j = 0; j < num_parties; j++) {
+      beavers[j]->insert(triples[j]);
+      truncations[j]->insert(pairs[j]);
+    }
+  }
+
+  std::vector<std::vector<LargeNum>> numerator_shares(
+      num_parties, std::vector<LargeNum>(n));
+  for (size_t i = 0; i < n; i++) {
+    numerator_shares[1][i] = ff::mpc::randomModP<LargeNum>(p);
+    numerator_shares[0][i] =
+        ff::mpc::modSub(magnitudes[i], numerator_shares[1][i], p);
+  }
+  std::vector<LargeNum> denominator_shares(num_parties);
+  denominator_shares[1] = ff::mpc::randomModP<LargeNum>(p);
+  denominator_shares[0] =
+      ff::mpc::modSub(denominator, denominator_shares[1], p);
+
+  std::map<Identity, std::unique_ptr<Fronctocol>> test;
+  test[dealer] = std::unique_ptr<Fronctocol>(new Tester(
+      [&](Fronctocol * self) {
+        std::unique_ptr<Fronctocol> house(
+            new ff::mpc::
+                DivideRandomnessHouse<SAFRN_TYPES, LargeNum, SmallNum>(
+                    &divide_info));
+        self->invoke(std::move(house), self->getPeers());
+      },
+      finishTestOnComplete));
+
+  std::vector<std::vector<LargeNum>> outputs(num_parties);
+  std::vector<bool> patron_done(num_parties, false);
+  for (size_t j = 0; j < num_parties; j++) {
+    test[parties[j]] = std::unique_ptr<Fronctocol>(new Tester(
+        [&, j](Fronctocol * self) {
+          std::unique_ptr<Fronctocol> patron(
+              new ff::mpc::DivideRandomnessPatron<
+                  SAFRN_TYPES,
+                  LargeNum,
+                  SmallNum>(&divide_info, &dealer, 1));
+          self->invoke(std::move(patron), self->getPeers());
+        },
+        [&, j](Fronctocol & f, Fronctocol * self) {
+          if (patron_done[j]) {
+            outputs[j] = static_cast<SharedDivide &>(f).outputs;
+            self->complete();
+            return;
+          }
+          patron_done[j] = true;
+
+          std::unique_ptr<Fronctocol> divide(new SharedDivide(
+              std::move(numerator_shares[j]),
+              denominator_shares[j],
+              &info,
+              std::move(static_cast<ff::mpc::DivideRandomnessPatron<
+                            SAFRN_TYPES,
+                            LargeNum,
+                            SmallNum> &>(f)
+                            .divideDispenser->get()),
+              *beavers[j],
+              *truncations[j]));
+          PeerSet ps(self->getPeers());
+          ps.removeDealer();
+          self->invoke(std::move(divide), ps);
+        }));
+  }
+
+  EXPECT_TRUE(runTests(test));
+
+  for (size_t i = 0; i < n; i++) {
+    LargeNum quotient(0);
+    for (size_t j = 0; j < num_parties; j++) {
+      ASSERT_EQ(n, outputs[j].size());
+      LargeNum const share = negative[i] ?
+          ff::mpc::modSub(LargeNum(0), outputs[j][i], p) :
+          outputs[j][i];
+      quotient = ff::mpc::modAdd(quotient, share, p);
+    }
+
+    /* Both the reciprocal and the shift may round down, by one each. */
+    LargeNum const exact = magnitudes[i] / denominator;
+    LargeNum const expected =
+        negative[i] ? ff::mpc::modSub(LargeNum(0), exact, p) : exact;
+    LargeNum const slack = negative[i] ?
+        ff::mpc::modSub(quotient, expected, p) :
+        ff::mpc::modSub(expected, quotient, p);
+    EXPECT_LE(slack, LargeNum(2)) << "i: " << i;
+  }
+}
+
+TEST(SharedDivide, several_numerators) {
+  std::vector<LargeNum> const magnitudes = {
+      0, 1, 6, 7, 8, 1000, 65535, 12345};
+  checkSharedDivide(
+      magnitudes, std::vector<bool>(magnitudes.size(), false), 7, 16);
+}
+
+TEST(SharedDivide, negative_numerators) {
+  std::vector<LargeNum> const magnitudes = {1, 100, 4096, 65535};
+  std::vector<bool> const negative = {true, false, true, true};
+  checkSharedDivide(magnitudes, negative, 3, 16);
+}
+
+TEST(SharedDivide, wide_numerators) {
+  /**
+   * A regression's determinant width, for 8 IVs, 16 bits of precision
+   * and 2^20 rows: 8 * (3 + 2 * 16 + 2 + 20) bits.
+   */
+  size_t const numerator_bits = 456;
+  LargeNum const top = LargeNum(1) << numerator_bits;
+  std::vector<LargeNum> const magnitudes = {
+      top - 1,
+      top / 3,
+      ff::mpc::randomModP<LargeNum>(top),
+      ff::mpc::randomModP<LargeNum>(top),
+      LargeNum(5)};
+  LargeNum const denominator =
+      ff::mpc::randomModP<LargeNum>(LargeNum(1) << 200) + 1;
+  checkSharedDivide(
+      magnitudes,
+      std::vector<bool>(magnitudes.size(), false),
+      denominator,
+      numerator_bits);
+}
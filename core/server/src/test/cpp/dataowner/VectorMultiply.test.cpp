@@ -0,0 +1,112 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <map>
+#include <memory>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+#include <mpc/ModUtils.h>
+
+/* SAFRN Headers */
+#include <dataowner/VectorMultiply.h>
+#include <framework/Framework.h>
+#include <framework/TestRunner.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+using namespace safrn::dataowner;
+
+using BeaverDispenser = ff::mpc::RandomnessDispenser<
+    ff::mpc::BeaverTriple<LargeNum>,
+    ff::mpc::BeaverInfo<LargeNum>>;
+
+static void checkVectorMultiply(LargeNum const & p) {
+  size_t const num_parties = 3;
+  size_t const n = 50;
+  std::vector<Identity> const parties = {
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE01", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE02", ROLE_DATAOWNER, 0),
+      Identity("EEEEEEEEEEEEEEEEEEEEEEEEEEEEEE03", ROLE_DATAOWNER, 1)};
+  Identity const & revealer = parties[0];
+
+  ff::mpc::BeaverInfo<LargeNum> info(p);
+  std::vector<std::unique_ptr<BeaverDispenser>> dispensers;
+  for (size_t i = 0; i < num_parties; i++) {
+    dispensers.emplace_back(new BeaverDispenser(info));
+  }
+  for (size_t i = 0; i < n; i++) {
+    std::vector<ff::mpc::BeaverTriple<LargeNum>> beavers;
+    info.generate(num_parties, 1, beavers);
+    for (size_t j = 0; j < num_parties; j++) {
+      dispensers[j]->insert(beavers[j]);
+    }
+  }
+
+  /* Values, some at the edges of the field, and their shares. */
+  std::vector<LargeNum> xs(n);
+  std::vector<LargeNum> ys(n);
+  std::vector<std::vector<LargeNum>> x_shares(
+      num_parties, std::vector<LargeNum>(n));
+  std::vector<std::vector<LargeNum>> y_shares(
+      num_parties, std::vector<LargeNum>(n));
+  for (size_t i = 0; i < n; i++) {
+    xs[i] = i < 2 ? p - 1 - i : ff::mpc::randomModP<LargeNum>(p);
+    ys[i] = i == 0 ? LargeNum(0) : ff::mpc::randomModP<LargeNum>(p);
+    LargeNum x_rest = xs[i];
+    LargeNum y_rest = ys[i];
+    for (size_t j = 1; j < num_parties; j++) {
+      x_shares[j][i] = ff::mpc::randomModP<LargeNum>(p);
+      y_shares[j][i] = ff::mpc::randomModP<LargeNum>(p);
+      x_rest = ff::mpc::modSub(x_rest, x_shares[j][i], p);
+      y_rest = ff::mpc::modSub(y_rest, y_shares[j][i], p);
+    }
+    x_shares[0][i] = x_rest;
+    y_shares[0][i] = y_rest;
+  }
+
+  std::vector<std::vector<LargeNum>> outputs(num_parties);
+  std::map<Identity, std::unique_ptr<Fronctocol>> test;
+  for (size_t j = 0; j < num_parties; j++) {
+    test[parties[j]] = std::unique_ptr<Fronctocol>(new Tester(
+        [&, j](Fronctocol * self) {
+          std::unique_ptr<Fronctocol> multiply(new VectorMultiply(
+              std::move(x_shares[j]),
+              std::move(y_shares[j]),
+              *dispensers[j],
+              p,
+              revealer));
+          self->invoke(std::move(multiply), self->getPeers());
+        },
+        [&, j](Fronctocol & f, Fronctocol * self) {
+          outputs[j] = static_cast<VectorMultiply &>(f).outputs;
+          self->complete();
+        }));
+  }
+
+  EXPECT_TRUE(runTests(test));
+
+  for (size_t i = 0; i < n; i++) {
+    LargeNum product(0);
+    for (size_t j = 0; j < num_parties; j++) {
+      ASSERT_EQ(n, outputs[j].size());
+      product = ff::mpc::modAdd(product, outputs[j][i], p);
+    }
+    EXPECT_EQ(ff::mpc::modMul(xs[i], ys[i], p), product) << "i: " << i;
+  }
+}
+
+TEST(VectorMultiply, word_modulus) {
+  checkVectorMultiply((LargeNum(1) << 61) - 1);
+}
+
+TEST(VectorMultiply, large_modulus) {
+  checkVectorMultiply(ff::mpc::nextPrime(LargeNum(1) << 160));
+}
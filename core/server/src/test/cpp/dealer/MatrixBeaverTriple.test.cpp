@@ -0,0 +1,78 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+
+/* SAFRN Headers */
+#include <dealer/MatrixBeaverTriple.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn::dealer;
+
+static ff::mpc::Matrix<uint32_t> sumShares(
+    std::vector<ff::mpc::Matrix<uint32_t>> const & shares,
+    size_t const rows,
+    size_t const cols,
+    uint32_t const p) {
+  ff::mpc::Matrix<uint32_t> sum(rows, cols);
+  for (size_t row = 0; row < rows; ++row) {
+    for (size_t col = 0; col < cols; ++col) {
+      sum.at(row, col) = 0;
+      for (ff::mpc::Matrix<uint32_t> const & share : shares) {
+        sum.at(row, col) = (sum.at(row, col) + share.at(row, col)) % p;
+      }
+    }
+  }
+  return sum;
+}
+
+TEST(MatrixBeaverTriple, DealerGenerate) {
+  uint32_t const p = 97;
+  size_t const rows = 3;
+  size_t const inner = 3;
+  size_t const cols = 4;
+  MatrixBeaverTripleInfo<uint32_t, uint32_t> info(rows, inner, cols, p);
+
+  for (size_t n_parties = 2; n_parties <= 4; n_parties++) {
+    std::vector<MatrixBeaverTriple<uint32_t>> vals;
+    info.generate(n_parties, 1, vals);
+    ASSERT_EQ(n_parties, vals.size());
+
+    std::vector<ff::mpc::Matrix<uint32_t>> us;
+    std::vector<ff::mpc::Matrix<uint32_t>> vs;
+    std::vector<ff::mpc::Matrix<uint32_t>> ws;
+    for (MatrixBeaverTriple<uint32_t> const & val : vals) {
+      us.push_back(val.u_);
+      vs.push_back(val.v_);
+      ws.push_back(val.w_);
+    }
+    ff::mpc::Matrix<uint32_t> u = sumShares(us, rows, inner, p);
+    ff::mpc::Matrix<uint32_t> v = sumShares(vs, inner, cols, p);
+    ff::mpc::Matrix<uint32_t> w = sumShares(ws, rows, cols, p);
+
+    ff::mpc::Matrix<uint32_t> uv(rows, cols);
+    for (size_t row = 0; row < rows; ++row) {
+      for (size_t col = 0; col < cols; ++col) {
+        uv.at(row, col) = 0;
+      }
+    }
+    modMatrixProductAdd(u, v, uv, rows, inner, cols, p);
+
+    for (size_t row = 0; row < rows; ++row) {
+      for (size_t col = 0; col < cols; ++col) {
+        EXPECT_EQ(uv.at(row, col), w.at(row, col))
+            << "row: " << row << " col: " << col;
+      }
+    }
+  }
+}
@@ -0,0 +1,46 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+
+/* SAFRN Headers */
+#include <dealer/TruncationPair.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn::dealer;
+
+TEST(TruncationPair, DealerGenerate) {
+  uint64_t const p = 2305843009213693951ULL; // 2^61 - 1
+  size_t const shift_bits = 12;
+  size_t const mask_bits = 40;
+  TruncationPairInfo<uint64_t, uint64_t> info(
+      shift_bits, mask_bits, p);
+
+  for (size_t n_parties = 2; n_parties <= 4; n_parties++) {
+    for (size_t trial = 0; trial < 16; trial++) {
+      std::vector<TruncationPair<uint64_t>> vals;
+      info.generate(n_parties, 1, vals);
+      ASSERT_EQ(n_parties, vals.size());
+
+      uint64_t r = 0;
+      uint64_t shifted = 0;
+      for (TruncationPair<uint64_t> const & val : vals) {
+        r = (r + val.r_) % p;
+        shifted = (shifted + val.shifted_) % p;
+      }
+      EXPECT_LT(r, uint64_t(1) << mask_bits);
+      EXPECT_EQ(r >> shift_bits, shifted)
+          << "n_parties: " << n_parties << " trial: " << trial;
+    }
+  }
+}
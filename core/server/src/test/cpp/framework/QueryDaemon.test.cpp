@@ -0,0 +1,123 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+#include <stdlib.h>
+#include <unistd.h>
+
+/* C++ Headers */
+#include <cstddef>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+/* SAFRN Headers */
+#include <QueryTester.h>
+#include <framework/QueryDaemon.h>
+#include <framework/SpoolWatcher.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+
+static std::string const DATA_DIRECTORY =
+    "../../../../../server/src/test/data/";
+
+static void copyFile(std::string const & from, std::string const & to) {
+  std::ifstream in(from);
+  std::ofstream out(to);
+  out << in.rdbuf();
+}
+
+static bool exists(std::string const & file) {
+  return access(file.c_str(), F_OK) == 0;
+}
+
+/**
+ * Spools two queries, an invalid one and a stop file for the daemons
+ * of the two party study, then runs a daemon on every party, with the
+ * recipient coordinating. The coordinator runs one query at a time,
+ * so the second is admitted only once the first completes. The queries
+ * can only complete if every daemon was forwarded them.
+ */
+TEST(QueryDaemon, runs_spooled_queries_then_stops) {
+  char spool_template[] = "/tmp/safrn_spool_XXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(spool_template));
+  std::string const spool(spool_template);
+
+  copyFile(DATA_DIRECTORY + "moments_query.json", spool + "/a.json");
+  copyFile(
+      DATA_DIRECTORY + "regression_intercept.json", spool + "/b.json");
+  std::ofstream(spool + "/c.json") << "{";
+  std::ofstream(spool + "/stop");
+
+  std::ifstream study_stream(TEST_2_PARTY.studyFile);
+  StudyConfig const scfg =
+      readStudyFromJson(nlohmann::json::parse(study_stream));
+
+  std::map<Identity, std::unique_ptr<Fronctocol>> tests;
+  for (size_t i = 0; i < TEST_2_PARTY.participants.size(); i++) {
+    DaemonConfig config;
+    config.dataFile = TEST_2_PARTY.dataFiles[i];
+    config.lookupTableDirectory = DATA_DIRECTORY;
+    if (TEST_2_PARTY.participants[i].role == ROLE_RECIPIENT) {
+      config.spoolDirectory = spool;
+      config.maxConcurrentQueries = 1;
+    }
+    tests[TEST_2_PARTY.participants[i]] =
+        std::unique_ptr<Fronctocol>(new QueryDaemon(scfg, config));
+  }
+
+  EXPECT_TRUE(runTests(tests));
+
+  EXPECT_TRUE(exists(spool + "/a.json.done"));
+  EXPECT_TRUE(exists(spool + "/b.json.done"));
+  EXPECT_TRUE(exists(spool + "/c.json.failed"));
+  EXPECT_TRUE(exists(spool + "/stop.done"));
+  for (std::string const name : {"/a.json", "/b.json", "/c.json"}) {
+    EXPECT_FALSE(exists(spool + name)) << name;
+    EXPECT_FALSE(exists(spool + name + ".running")) << name;
+  }
+  EXPECT_FALSE(exists(spool + "/stop"));
+
+  SpoolWatcher const watcher(spool);
+  EXPECT_TRUE(watcher.queries().empty());
+  EXPECT_FALSE(watcher.stopRequested());
+}
+
+/**
+ * A file spooled after a scan wakes the watcher, rather than waiting
+ * for a rescan.
+ */
+TEST(QueryDaemon, spool_watcher_sees_new_files) {
+  char spool_template[] = "/tmp/safrn_spool_XXXXXX";
+  ASSERT_NE(nullptr, mkdtemp(spool_template));
+  std::string const spool(spool_template);
+
+  SpoolWatcher watcher(spool);
+  EXPECT_TRUE(watcher.queries().empty());
+
+  std::ofstream(spool + "/b.json") << "{}";
+  std::ofstream(spool + "/a.json") << "{}";
+  std::ofstream(spool + "/a.json.running") << "{}";
+  watcher.wait();
+
+  std::vector<std::string> const expected = {
+      spool + "/a.json", spool + "/b.json"};
+  EXPECT_EQ(expected, watcher.queries());
+  EXPECT_FALSE(watcher.stopRequested());
+
+  std::ofstream(spool + "/stop");
+  EXPECT_TRUE(watcher.stopRequested());
+  watcher.markStopped();
+  EXPECT_FALSE(watcher.stopRequested());
+  EXPECT_TRUE(exists(spool + "/stop.done"));
+}
@@ -0,0 +1,55 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <map>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+
+/* SAFRN Headers */
+#include <framework/QueryId.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+
+static QueryId
+makeQueryId(uint8_t const study, uint8_t const analyst, uint64_t id) {
+  QueryId qid;
+  qid.studyId.fill(study);
+  qid.analyst.fill(analyst);
+  qid.queryId = id;
+  return qid;
+}
+
+TEST(QueryId, ordering) {
+  QueryId const a = makeQueryId(1, 1, 5);
+  QueryId const b = makeQueryId(1, 2, 0);
+  QueryId const c = makeQueryId(2, 0, 0);
+
+  EXPECT_TRUE(a < b);
+  EXPECT_TRUE(b < c);
+  EXPECT_TRUE(a < c);
+  EXPECT_TRUE(makeQueryId(1, 1, 4) < a);
+  EXPECT_FALSE(a < a);
+  EXPECT_TRUE(a <= a);
+  EXPECT_TRUE(c > a);
+  EXPECT_TRUE(a == makeQueryId(1, 1, 5));
+  EXPECT_TRUE(a != b);
+}
+
+TEST(QueryId, map_key) {
+  std::map<QueryId, int> queries;
+  for (uint64_t i = 0; i < 10; i++) {
+    queries[makeQueryId(1, 2, i)] = static_cast<int>(i);
+    queries[makeQueryId(1, 3, i)] = static_cast<int>(i);
+  }
+  EXPECT_EQ(20, queries.size());
+  EXPECT_EQ(7, queries[makeQueryId(1, 3, 7)]);
+}
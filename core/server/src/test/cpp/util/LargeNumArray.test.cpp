@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+
+/* SAFRN Headers */
+#include <dataowner/fortissimo.h>
+#include <util/LargeNumArray.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+
+TEST(LargeNumArray, fixed_width_bytes) {
+  EXPECT_EQ(1, fixedWidthBytes(dataowner::LargeNum(2)));
+  EXPECT_EQ(1, fixedWidthBytes(dataowner::LargeNum(256)));
+  EXPECT_EQ(2, fixedWidthBytes(dataowner::LargeNum(257)));
+  EXPECT_EQ(8, fixedWidthBytes((dataowner::LargeNum(1) << 61) - 1));
+  EXPECT_EQ(12, fixedWidthBytes((dataowner::LargeNum(1) << 89) - 1));
+}
+
+TEST(LargeNumArray, encode_decode) {
+  dataowner::LargeNum const moduli[] = {
+      dataowner::LargeNum(65521),
+      (dataowner::LargeNum(1) << 61) - 1,
+      (dataowner::LargeNum(1) << 89) - 1,
+      (dataowner::LargeNum(1) << 200) + 235};
+
+  for (dataowner::LargeNum const & p : moduli) {
+    size_t const width = fixedWidthBytes(p);
+    std::vector<uint8_t> bytes(width);
+
+    dataowner::LargeNum const vals[] = {
+        dataowner::LargeNum(0), dataowner::LargeNum(1), p / 3, p - 1};
+    for (dataowner::LargeNum const & val : vals) {
+      encodeFixedWidth(val, bytes.data(), width);
+      dataowner::LargeNum decoded = 1;
+      decodeFixedWidth(bytes.data(), width, decoded);
+      EXPECT_EQ(val, decoded);
+    }
+  }
+
+  /* Little-endian. */
+  std::vector<uint8_t> bytes(3);
+  encodeFixedWidth(dataowner::LargeNum(0x010203), bytes.data(), 3);
+  EXPECT_EQ(0x03, bytes[0]);
+  EXPECT_EQ(0x02, bytes[1]);
+  EXPECT_EQ(0x01, bytes[2]);
+}
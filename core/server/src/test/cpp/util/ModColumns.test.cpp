@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+#include <mpc/ModUtils.h>
+
+/* SAFRN Headers */
+#include <dataowner/fortissimo.h>
+#include <util/ModColumns.h>
+#include <util/SeedPrg.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+
+/**
+ * Checks the column kernels against fortissimo's per-element
+ * operations, including the extreme values.
+ */
+static void checkAgainstFortissimo(dataowner::LargeNum const & p) {
+  size_t const n = 2000;
+  SeedPrg prg(SeedPrg::newSeed());
+
+  std::vector<dataowner::LargeNum> a(n);
+  std::vector<dataowner::LargeNum> b(n);
+  randomModPColumn(prg, p, a.data(), n);
+  randomModPColumn(prg, p, b.data(), n);
+  for (size_t i = 0; i < n; i++) {
+    EXPECT_LT(a[i], p);
+    EXPECT_LT(b[i], p);
+  }
+  a[0] = p - 1;
+  b[0] = p - 1;
+  a[1] = 0;
+  b[1] = p - 1;
+
+  std::vector<dataowner::LargeNum> sum(n);
+  std::vector<dataowner::LargeNum> diff(n);
+  std::vector<dataowner::LargeNum> prod(n);
+  modAddColumn(a.data(), b.data(), sum.data(), n, p);
+  modSubColumn(a.data(), b.data(), diff.data(), n, p);
+  modMulColumn(a.data(), b.data(), prod.data(), n, p);
+  for (size_t i = 0; i < n; i++) {
+    EXPECT_EQ(ff::mpc::modAdd(a[i], b[i], p), sum[i]);
+    EXPECT_EQ(ff::mpc::modSub(a[i], b[i], p), diff[i]);
+    EXPECT_EQ(ff::mpc::modMul(a[i], b[i], p), prod[i]);
+  }
+}
+
+TEST(ModColumns, one_word_modulus) {
+  checkAgainstFortissimo(dataowner::LargeNum(65521));
+  checkAgainstFortissimo((dataowner::LargeNum(1) << 61) - 1);
+}
+
+TEST(ModColumns, two_word_modulus) {
+  /* 2^89 - 1 and 2^127 - 1 are prime. */
+  checkAgainstFortissimo((dataowner::LargeNum(1) << 89) - 1);
+  checkAgainstFortissimo((dataowner::LargeNum(1) << 127) - 1);
+}
+
+TEST(ModColumns, large_modulus) {
+  checkAgainstFortissimo(
+      ff::mpc::nextPrime(dataowner::LargeNum(1) << 160));
+}
@@ -0,0 +1,60 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+#include <mpc/ModUtils.h>
+
+/* SAFRN Headers */
+#include <dataowner/fortissimo.h>
+#include <util/PrimeCatalogue.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+
+TEST(PrimeCatalogue, known_primes) {
+  dataowner::LargeNum const one(1);
+  EXPECT_EQ(dataowner::LargeNum(5), nextPrimeAbovePowerOfTwo(2));
+  EXPECT_EQ(dataowner::LargeNum(65537), nextPrimeAbovePowerOfTwo(16));
+  EXPECT_EQ((one << 64) + 13, nextPrimeAbovePowerOfTwo(64));
+  EXPECT_EQ((one << 128) + 51, nextPrimeAbovePowerOfTwo(128));
+  EXPECT_EQ((one << 256) + 297, nextPrimeAbovePowerOfTwo(256));
+}
+
+TEST(PrimeCatalogue, matches_search) {
+  dataowner::LargeNum const one(1);
+  for (size_t bits = 2; bits <= 160; bits++) {
+    EXPECT_EQ(
+        ff::mpc::nextPrime(one << bits), nextPrimeAbovePowerOfTwo(bits))
+        << "bits: " << bits;
+  }
+
+  size_t const sampled[] = {
+      255, 256, 521, 607, 1024, PRIME_CATALOGUE_MAX_BITS};
+  for (size_t const bits : sampled) {
+    EXPECT_EQ(
+        ff::mpc::nextPrime(one << bits), nextPrimeAbovePowerOfTwo(bits))
+        << "bits: " << bits;
+  }
+}
+
+TEST(PrimeCatalogue, cached_search) {
+  dataowner::LargeNum const one(1);
+  EXPECT_EQ(nextPrimeAbovePowerOfTwo(100), cachedNextPrime(one << 100));
+
+  dataowner::LargeNum const n = (one << 100) + 12345;
+  dataowner::LargeNum const prime = ff::mpc::nextPrime(n);
+  EXPECT_EQ(prime, cachedNextPrime(n));
+  EXPECT_EQ(prime, cachedNextPrime(n));
+  EXPECT_EQ(
+      ff::mpc::nextPrime(dataowner::LargeNum(1000)),
+      cachedNextPrime(dataowner::LargeNum(1000)));
+}
@@ -0,0 +1,117 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+#include <stdlib.h>
+
+/* C++ Headers */
+#include <string>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+
+/* SAFRN Headers */
+#include <dealer/RandomSquareMatrix.h>
+#include <dealer/RandomTableLookup.h>
+#include <util/RandomnessStore.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+using namespace safrn::dealer;
+
+static std::string makeTempDirectory() {
+  char path[] = "/tmp/safrn_randomness_XXXXXX";
+  char * dir = mkdtemp(path);
+  EXPECT_FALSE(dir == nullptr);
+  return std::string(dir == nullptr ? "" : dir);
+}
+
+TEST(RandomnessStore, table_lookup_round_trip) {
+  std::string const dir = makeTempDirectory();
+  std::vector<RandomnessStore> shards;
+  shards.emplace_back(dir, "study", "alice");
+  shards.emplace_back(dir, "study", "bob");
+
+  dataowner::LargeNum const modulus =
+      (dataowner::LargeNum(1) << 61) - 1;
+  RandomTableLookupInfo const info(modulus, 100);
+  std::string const key = shards[0].key("test", {modulus, 100});
+
+  EXPECT_EQ(RandomnessStore::NO_BATCH, shards[0].nextBatch(key));
+  EXPECT_TRUE(pregenerate<RandomTableLookup>(
+      shards, key, 0, "table_lookup", info, 3));
+  EXPECT_EQ(0UL, shards[0].nextBatch(key));
+  EXPECT_EQ(1UL, shards[1].endBatch(key));
+
+  std::vector<RandomTableLookup> alice;
+  std::vector<RandomTableLookup> bob;
+  EXPECT_TRUE(shards[0].read(key, 0, "table_lookup", info, alice));
+  EXPECT_TRUE(shards[1].read(key, 0, "table_lookup", info, bob));
+  ASSERT_EQ(3UL, alice.size());
+  ASSERT_EQ(3UL, bob.size());
+
+  /** The shares must recombine to a one-hot vector at r. */
+  for (size_t i = 0; i < alice.size(); i++) {
+    ASSERT_EQ(2UL, alice[i].u_.size());
+    ASSERT_EQ(2UL, bob[i].u_.size());
+    size_t const r = static_cast<size_t>(
+        ff::mpc::modAdd(alice[i].r_, bob[i].r_, modulus));
+    for (size_t j = 0; j < 100; j++) {
+      EXPECT_EQ(j == r, alice[i].bit(j) != bob[i].bit(j));
+    }
+  }
+
+  EXPECT_TRUE(shards[0].consume(key, 0));
+  EXPECT_EQ(RandomnessStore::NO_BATCH, shards[0].nextBatch(key));
+  EXPECT_FALSE(shards[0].read(key, 0, "table_lookup", info, alice));
+}
+
+TEST(RandomnessStore, square_matrix_round_trip) {
+  std::string const dir = makeTempDirectory();
+  std::vector<RandomnessStore> shards;
+  shards.emplace_back(dir, "study", "alice");
+  shards.emplace_back(dir, "study", "bob");
+
+  dataowner::LargeNum const modulus = 97;
+  RandomSquareMatrixInfo<dataowner::LargeNum, dataowner::LargeNum> const
+      info(3, modulus);
+  std::string const key = shards[0].key("test", {modulus, 3});
+
+  EXPECT_TRUE(pregenerate<RandomSquareMatrix<dataowner::LargeNum>>(
+      shards, key, 4, "square_matrix", info, 2));
+  EXPECT_EQ(4UL, shards[1].nextBatch(key));
+  EXPECT_EQ(5UL, shards[1].endBatch(key));
+
+  std::vector<RandomSquareMatrix<dataowner::LargeNum>> alice;
+  std::vector<RandomSquareMatrix<dataowner::LargeNum>> bob;
+  EXPECT_TRUE(shards[0].read(key, 4, "square_matrix", info, alice));
+  EXPECT_TRUE(shards[1].read(key, 4, "square_matrix", info, bob));
+  ASSERT_EQ(2UL, alice.size());
+  ASSERT_EQ(2UL, bob.size());
+
+  /** det(M) * det(M^-1) must be one for the recombined matrix. */
+  for (size_t i = 0; i < alice.size(); i++) {
+    ff::mpc::Matrix<dataowner::LargeNum> m(3, 3);
+    for (size_t row = 0; row < 3; row++) {
+      for (size_t col = 0; col < 3; col++) {
+        m.at(row, col) = ff::mpc::modAdd(
+            alice[i].values_.at(row, col),
+            bob[i].values_.at(row, col),
+            modulus);
+      }
+    }
+    dataowner::LargeNum const det_of_inverse = ff::mpc::modAdd(
+        alice[i].det_of_inverse_, bob[i].det_of_inverse_, modulus);
+    EXPECT_EQ(
+        dataowner::LargeNum(1),
+        ff::mpc::modMul(m.Det(modulus), det_of_inverse, modulus));
+  }
+
+  /** A different key must not find this batch. */
+  std::string const other = shards[0].key("test", {modulus, 4});
+  EXPECT_EQ(RandomnessStore::NO_BATCH, shards[0].nextBatch(other));
+}
@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstdint>
+#include <vector>
+
+/* 3rd Party Headers */
+#include <gtest/gtest.h>
+
+/* SAFRN Headers */
+#include <dealer/RandomTableLookup.h>
+#include <util/SeedPrg.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+using namespace safrn;
+using namespace safrn::dealer;
+
+TEST(SeedPrg, same_seed_same_stream) {
+  SeedPrg::Seed const seed = SeedPrg::newSeed();
+  SeedPrg prg1(seed);
+  SeedPrg prg2(seed);
+
+  /* Larger than the internal buffer, to cross a refill. */
+  std::vector<uint8_t> out1(10000);
+  std::vector<uint8_t> out2(10000);
+  prg1.bytes(out1.data(), out1.size());
+  prg2.bytes(out2.data(), 10);
+  prg2.bytes(out2.data() + 10, out2.size() - 10);
+  EXPECT_EQ(out1, out2);
+
+  for (size_t i = 0; i < 1000; i++) {
+    EXPECT_LT(prg1.randomModP<uint32_t>(1009), 1009U);
+  }
+}
+
+TEST(SeedPrg, seeded_table_lookup_reconstructs) {
+  dataowner::LargeNum const modulus = 1009;
+  RandomTableLookupInfo const info(modulus, 17);
+
+  /* Expand two parties' shares the way the dealer and they do. */
+  SeedPrg::Seed const seed1 = SeedPrg::newSeed();
+  SeedPrg::Seed const seed2 = SeedPrg::newSeed();
+  SeedPrg dealer_prg1(seed1);
+  SeedPrg dealer_prg2(seed2);
+
+  std::vector<RandomTableLookup> vals(3);
+  info.expandShare(dealer_prg1, vals[1]);
+  info.expandShare(dealer_prg2, vals[2]);
+  info.generateCorrection(vals);
+
+  RandomTableLookup party1;
+  SeedPrg party_prg1(seed1);
+  info.expandShare(party_prg1, party1);
+  EXPECT_EQ(vals[1].r_, party1.r_);
+  EXPECT_EQ(vals[1].u_, party1.u_);
+
+  dataowner::LargeNum r = 0;
+  uint64_t u = 0;
+  for (RandomTableLookup const & share : vals) {
+    r = ff::mpc::modAdd(r, share.r_, modulus);
+    ASSERT_EQ(1UL, share.u_.size());
+    u ^= share.u_[0];
+  }
+
+  ASSERT_LT(r, dataowner::LargeNum(17));
+  EXPECT_EQ(uint64_t(1) << static_cast<size_t>(r), u);
+}
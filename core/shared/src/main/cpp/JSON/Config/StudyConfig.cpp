@@ -67,6 +67,11 @@ configFromJson(json const & sjs, json const & pjs, StudyConfig & cfg) {
   } else {
     cfg.maxListSize = 100;
   }
+  if (json_contains(sjs, "workingSetRows")) {
+    cfg.workingSetRows = sjs["workingSetRows"];
+  } else {
+    cfg.workingSetRows = 0;
+  }
 
   /* Read out the list of lexicons */
   VerticalIndex_t current_vertical_index = 0;
@@ -84,6 +89,15 @@ configFromJson(json const & sjs, json const & pjs, StudyConfig & cfg) {
     }
     ++current_vertical_index;
 
+    if (json_contains(vertical, "maxListSize")) {
+      vert.maxListSize = vertical["maxListSize"];
+      if (vert.maxListSize > cfg.maxListSize) {
+        throw std::runtime_error("Vertical exceeds the maxListSize.");
+      }
+    } else {
+      vert.maxListSize = cfg.maxListSize;
+    }
+
     ColumnIndex_t current_col_index = 0;
     for (json const & column : vertical["columns"]) {
       vert.columns.emplace_back(ColumnFactory::createColumn(column));
@@ -157,6 +171,11 @@ static void configFromJson(json const & sjs, StudyConfig & cfg) {
   } else {
     cfg.maxListSize = 100;
   }
+  if (json_contains(sjs, "workingSetRows")) {
+    cfg.workingSetRows = sjs["workingSetRows"];
+  } else {
+    cfg.workingSetRows = 0;
+  }
 
   /* Read out the list of lexicons */
   VerticalIndex_t current_vertical_index = 0;
@@ -174,6 +193,15 @@ static void configFromJson(json const & sjs, StudyConfig & cfg) {
     }
     ++current_vertical_index;
 
+    if (json_contains(vertical, "maxListSize")) {
+      vert.maxListSize = vertical["maxListSize"];
+      if (vert.maxListSize > cfg.maxListSize) {
+        throw std::runtime_error("Vertical exceeds the maxListSize.");
+      }
+    } else {
+      vert.maxListSize = cfg.maxListSize;
+    }
+
     ColumnIndex_t current_col_index = 0;
     for (json const & column : vertical["columns"]) {
       vert.columns.emplace_back(ColumnFactory::createColumn(column));
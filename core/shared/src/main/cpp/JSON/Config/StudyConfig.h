@@ -44,6 +44,12 @@ struct Vertical {
      * The list of columns in this vertical.
      */
   std::vector<std::unique_ptr<ColumnBase>> columns;
+
+  /**
+     * The maximum number of rows any dataowner of this vertical may
+     * provide. Zero, as when unset, defers to the study's maxListSize.
+     */
+  size_t maxListSize = 0;
 };
 
 struct Peer {
@@ -129,6 +135,12 @@ struct StudyConfig {
    */
   size_t maxListSize;
 
+  /** The number of rows a dataowner works on at a time, where it can
+   *  (e.g. shares are generated and sent this many rows at a time),
+   *  to bound its memory. Zero works on whole lists at once.
+   */
+  size_t workingSetRows = 0;
+
   /** Specify the permissible functions to be run as part of this study.
    *  WARNING: This field not fully supported yet. Indeed, it only
    *  supports checking whether Moment queries allow returning of Count.
@@ -49,14 +49,16 @@ std::vector<safrn::QueryFilter> safrn::Query::createPrefilters(
 safrn::Query::Query(const nlohmann::json & json) :
     prefilters(createPrefilters(json["prefilters"])),
     joinStatement(createJoinStatementIfExists(json)),
-    function(FunctionFactory(json["function"])) {
+    function(createFunction(json)),
+    batchedFunctions(createBatchedFunctions(json)) {
 }
 
 safrn::Query::Query(
     const safrn::StudyConfig & study, const nlohmann::json & json) :
     prefilters(createPrefilters(study, json["prefilters"])),
     joinStatement(createJoinStatementIfExists(study, json)),
-    function(FunctionFactory(study, json["function"])) {
+    function(createFunction(study, json)),
+    batchedFunctions(createBatchedFunctions(study, json)) {
 }
 
 std::unique_ptr<safrn::JoinStatement>
@@ -88,3 +90,61 @@ safrn::Query::createJoinStatementIfExists(
     return std::unique_ptr<JoinStatement>();
   }
 }
+
+std::unique_ptr<safrn::SafrnFunction>
+safrn::Query::createFunction(const nlohmann::json & topJson) {
+  constexpr auto FUNCTIONS_KEY = "functions";
+
+  if (json_contains(topJson, FUNCTIONS_KEY)) {
+    if (topJson[FUNCTIONS_KEY].empty()) {
+      throw EmptyFunctions();
+    }
+    return FunctionFactory(topJson[FUNCTIONS_KEY][0]);
+  }
+  return FunctionFactory(topJson["function"]);
+}
+
+std::unique_ptr<safrn::SafrnFunction> safrn::Query::createFunction(
+    const safrn::StudyConfig & study, const nlohmann::json & topJson) {
+  constexpr auto FUNCTIONS_KEY = "functions";
+
+  if (json_contains(topJson, FUNCTIONS_KEY)) {
+    if (topJson[FUNCTIONS_KEY].empty()) {
+      throw EmptyFunctions();
+    }
+    return FunctionFactory(study, topJson[FUNCTIONS_KEY][0]);
+  }
+  return FunctionFactory(study, topJson["function"]);
+}
+
+std::vector<std::unique_ptr<safrn::SafrnFunction>>
+safrn::Query::createBatchedFunctions(const nlohmann::json & topJson) {
+  constexpr auto FUNCTIONS_KEY = "functions";
+
+  std::vector<std::unique_ptr<SafrnFunction>> result;
+
+  if (json_contains(topJson, FUNCTIONS_KEY)) {
+    for (size_t i = 1; i < topJson[FUNCTIONS_KEY].size(); i++) {
+      result.push_back(FunctionFactory(topJson[FUNCTIONS_KEY][i]));
+    }
+  }
+
+  return result;
+}
+
+std::vector<std::unique_ptr<safrn::SafrnFunction>>
+safrn::Query::createBatchedFunctions(
+    const safrn::StudyConfig & study, const nlohmann::json & topJson) {
+  constexpr auto FUNCTIONS_KEY = "functions";
+
+  std::vector<std::unique_ptr<SafrnFunction>> result;
+
+  if (json_contains(topJson, FUNCTIONS_KEY)) {
+    for (size_t i = 1; i < topJson[FUNCTIONS_KEY].size(); i++) {
+      result.push_back(
+          FunctionFactory(study, topJson[FUNCTIONS_KEY][i]));
+    }
+  }
+
+  return result;
+}
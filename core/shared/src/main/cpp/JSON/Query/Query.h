@@ -57,6 +57,11 @@ public:
   // The computation to perform.
   const std::unique_ptr<SafrnFunction> function;
 
+  // Further computations over the same join, for a batch query. A batch
+  // query gives a "functions" array in place of "function", its first
+  // entry becomes function and the rest are kept here, in order.
+  const std::vector<std::unique_ptr<SafrnFunction>> batchedFunctions;
+
   // TODO: Add postFilters
 
   class TooManyPrefilters : std::exception {
@@ -65,6 +70,12 @@ public:
     }
   };
 
+  class EmptyFunctions : std::exception {
+    const char * what() const noexcept override {
+      return "A batch query needs at least one function.";
+    }
+  };
+
 private:
   static std::vector<QueryFilter>
   createPrefilters(const nlohmann::json & json);
@@ -75,6 +86,19 @@ private:
   static std::unique_ptr<JoinStatement>
   createJoinStatementIfExists(const nlohmann::json & topJson);
 
+  static std::unique_ptr<SafrnFunction>
+  createFunction(const nlohmann::json & topJson);
+
+  static std::unique_ptr<SafrnFunction> createFunction(
+      const safrn::StudyConfig & study, const nlohmann::json & topJson);
+
+  static std::vector<std::unique_ptr<SafrnFunction>>
+  createBatchedFunctions(const nlohmann::json & topJson);
+
+  static std::vector<std::unique_ptr<SafrnFunction>>
+  createBatchedFunctions(
+      const safrn::StudyConfig & study, const nlohmann::json & topJson);
+
   static std::unique_ptr<JoinStatement> createJoinStatementIfExists(
       const safrn::StudyConfig & study, const nlohmann::json & topJson);
 };
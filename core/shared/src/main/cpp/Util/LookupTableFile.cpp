@@ -0,0 +1,357 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* C and POSIX Headers */
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* C++ Headers */
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <vector>
+
+/* SAFRN Headers */
+#include <Util/LookupTableFile.h>
+#include <Util/read_file_utils.h>
+#include <Util/string_utils.h>
+
+/* Logging Configuration */
+#include <ff/logging.h>
+
+namespace safrn {
+
+const uint64_t LookupTableHeader::FORMAT_VERSION;
+
+static char const LOOKUP_TABLE_MAGIC[8] = {
+    'S', 'A', 'F', 'R', 'N', 'T', 'B', 'L'};
+
+static size_t const LOOKUP_TABLE_HEADER_SIZE =
+    sizeof(LOOKUP_TABLE_MAGIC) + 6 * sizeof(uint64_t);
+
+static void writeUint64(std::ostream & os, uint64_t const val) {
+  char bytes[sizeof(uint64_t)];
+  for (size_t i = 0; i < sizeof(uint64_t); i++) {
+    bytes[i] = static_cast<char>((val >> (8 * i)) & 0xFF);
+  }
+  os.write(bytes, sizeof(bytes));
+}
+
+static uint64_t readUint64(uint8_t const * bytes) {
+  uint64_t val = 0;
+  for (size_t i = 0; i < sizeof(uint64_t); i++) {
+    val |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+  }
+  return val;
+}
+
+bool convertLookupTableCsv(
+    std::string const & csv_file,
+    std::string const & binary_file,
+    size_t const cell_bytes) {
+  std::ifstream input_stream(csv_file.c_str());
+  if (!input_stream.is_open()) {
+    log_error("Error opening file %s", csv_file.c_str());
+    return false;
+  }
+  if (cell_bytes == 0 || cell_bytes > sizeof(uint64_t)) {
+    log_error("Unsupported lookup table cell size %zu", cell_bytes);
+    return false;
+  }
+
+  LookupTableHeader header;
+  header.bits_of_precision = 5;
+  header.step_size = 1;
+  header.cell_bytes = cell_bytes;
+
+  std::vector<uint64_t> row_ids;
+  std::vector<uint64_t> cells;
+  double const scale = pow(2, 8 * cell_bytes);
+
+  std::string line;
+  while (getline(input_stream, line)) {
+    file_reader_utils::RemoveWindowsTrailingCharacters(&line);
+    line = string_utils::RemoveAllWhitespace(line);
+    if (line.empty()) {
+      continue;
+    }
+    if (string_utils::HasPrefixString(line, "#")) {
+      std::string suffix;
+      if (string_utils::StripPrefixString(
+              line, "#bits_of_precision=", &suffix)) {
+        header.bits_of_precision =
+            strtoull(suffix.c_str(), nullptr, 10);
+      } else if (string_utils::StripPrefixString(
+                     line, "#step_size=", &suffix)) {
+        header.step_size = strtoull(suffix.c_str(), nullptr, 10);
+      }
+      continue;
+    }
+
+    std::vector<std::string> split_line;
+    string_utils::Split(line, ",", &split_line);
+    if (split_line.empty()) {
+      continue;
+    }
+    if (row_ids.empty()) {
+      header.num_cols = split_line.size() - 1;
+    } else if (split_line.size() - 1 != header.num_cols) {
+      log_error(
+          "Ragged row %zu in %s", row_ids.size(), csv_file.c_str());
+      return false;
+    }
+
+    row_ids.push_back(
+        static_cast<uint64_t>(atoi(split_line.front().c_str())));
+    for (size_t i = 1; i < split_line.size(); i++) {
+      cells.push_back(static_cast<uint64_t>(
+          floor(scale * atof(split_line[i].c_str()))));
+    }
+  }
+  header.num_rows = row_ids.size();
+
+  std::ofstream os(
+      binary_file.c_str(), std::ios::out | std::ios::binary);
+  if (!os.is_open()) {
+    log_error("Error opening file %s", binary_file.c_str());
+    return false;
+  }
+  os.write(LOOKUP_TABLE_MAGIC, sizeof(LOOKUP_TABLE_MAGIC));
+  writeUint64(os, LookupTableHeader::FORMAT_VERSION);
+  writeUint64(os, header.bits_of_precision);
+  writeUint64(os, header.step_size);
+  writeUint64(os, header.num_cols);
+  writeUint64(os, header.num_rows);
+  writeUint64(os, header.cell_bytes);
+  for (uint64_t const row_id : row_ids) {
+    writeUint64(os, row_id);
+  }
+
+  std::vector<char> plane(cells.size());
+  for (size_t j = 0; j < cell_bytes; j++) {
+    for (size_t i = 0; i < cells.size(); i++) {
+      plane[i] = static_cast<char>((cells[i] >> (8 * j)) & 0xFF);
+    }
+    os.write(plane.data(), static_cast<std::streamsize>(plane.size()));
+  }
+  os.flush();
+  return os.good();
+}
+
+std::string lookupTableBinaryFile(std::string const & csv_file) {
+  std::string const csv_suffix = ".csv";
+  if (csv_file.size() >= csv_suffix.size() &&
+      0 ==
+          csv_file.compare(
+              csv_file.size() - csv_suffix.size(),
+              csv_suffix.size(),
+              csv_suffix)) {
+    return csv_file.substr(0, csv_file.size() - csv_suffix.size()) +
+        ".bin";
+  }
+  return csv_file + ".bin";
+}
+
+bool lookupTableIsCurrent(
+    std::string const & csv_file, std::string const & params_line) {
+  if (!file_reader_utils::FileExists(csv_file) ||
+      !file_reader_utils::FileExists(lookupTableBinaryFile(csv_file))) {
+    return false;
+  }
+  std::ifstream input_stream(csv_file.c_str());
+  std::string line;
+  while (getline(input_stream, line) &&
+         string_utils::HasPrefixString(line, "#")) {
+    file_reader_utils::RemoveWindowsTrailingCharacters(&line);
+    if (line == params_line) {
+      return true;
+    }
+  }
+  return false;
+}
+
+static std::string printTableRow(
+    std::vector<double> const & row, size_t const num_digits) {
+  std::string ret = string_utils::Itoa(row.front());
+  for (size_t i = 1; i < row.size(); i++) {
+    ret += ",";
+    ret += string_utils::Itoa(row[i], static_cast<int>(num_digits));
+  }
+  return ret;
+}
+
+/* The first cell of each row is nu_2, so is not compared. */
+static bool tableRowsDiffer(
+    std::vector<double> const & row1,
+    std::vector<double> const & row2,
+    double const pct_error_tol,
+    size_t const num_digits) {
+  double const min_cell =
+      std::pow(0.1, static_cast<double>(num_digits));
+  for (size_t i = 1; i < row1.size(); i++) {
+    if (row1[i] > min_cell || row2[i] > min_cell) {
+      if (row1[i] / row2[i] - 1 > pct_error_tol ||
+          row2[i] / row1[i] - 1 > pct_error_tol) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+void appendDistinctTableRows(
+    size_t const max_nu_2,
+    double const pct_error_tol,
+    size_t const num_digits,
+    std::function<void(size_t, std::vector<double> &)> const &
+        compute_row,
+    std::vector<std::string> & csv_lines) {
+  if (max_nu_2 <= 1) {
+    return;
+  }
+  std::vector<double> prev;
+  std::vector<double> current;
+  std::vector<double> next;
+  compute_row(1, prev);
+  csv_lines.push_back(printTableRow(prev, num_digits));
+
+  size_t last = 1;
+  while (true) {
+    /* Gallop: rows in (last, lo] are known not to differ from prev. */
+    size_t lo = last;
+    size_t hi = 0;
+    for (size_t step = 1; last + step < max_nu_2; step *= 2) {
+      compute_row(last + step, current);
+      if (tableRowsDiffer(current, prev, pct_error_tol, num_digits)) {
+        hi = last + step;
+        next.swap(current);
+        break;
+      }
+      lo = last + step;
+    }
+    if (hi == 0 && lo < max_nu_2 - 1) {
+      compute_row(max_nu_2 - 1, current);
+      if (tableRowsDiffer(current, prev, pct_error_tol, num_digits)) {
+        hi = max_nu_2 - 1;
+        next.swap(current);
+      }
+    }
+    if (hi == 0) {
+      return;
+    }
+
+    /* Bisect (lo, hi] for the first row which differs. */
+    while (hi - lo > 1) {
+      size_t const mid = lo + (hi - lo) / 2;
+      compute_row(mid, current);
+      if (tableRowsDiffer(current, prev, pct_error_tol, num_digits)) {
+        hi = mid;
+        next.swap(current);
+      } else {
+        lo = mid;
+      }
+    }
+
+    csv_lines.push_back(printTableRow(next, num_digits));
+    prev.swap(next);
+    last = hi;
+  }
+}
+
+std::shared_ptr<MappedLookupTable const>
+MappedLookupTable::open(std::string const & file) {
+  int const fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    return nullptr;
+  }
+  struct stat st;
+  if (0 != fstat(fd, &st) ||
+      static_cast<size_t>(st.st_size) < LOOKUP_TABLE_HEADER_SIZE) {
+    log_error("Lookup table %s is truncated", file.c_str());
+    close(fd);
+    return nullptr;
+  }
+
+  std::shared_ptr<MappedLookupTable> ret(new MappedLookupTable());
+  ret->length_ = static_cast<size_t>(st.st_size);
+  ret->base_ =
+      mmap(nullptr, ret->length_, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if (ret->base_ == MAP_FAILED) {
+    log_error("Could not map lookup table %s", file.c_str());
+    ret->base_ = nullptr;
+    return nullptr;
+  }
+
+  uint8_t const * bytes = static_cast<uint8_t const *>(ret->base_);
+  if (0 !=
+      memcmp(bytes, LOOKUP_TABLE_MAGIC, sizeof(LOOKUP_TABLE_MAGIC))) {
+    log_error("%s is not a lookup table", file.c_str());
+    return nullptr;
+  }
+  bytes += sizeof(LOOKUP_TABLE_MAGIC);
+  uint64_t const version = readUint64(bytes);
+  if (version != LookupTableHeader::FORMAT_VERSION) {
+    log_error(
+        "Lookup table %s has version %lu, expected %lu",
+        file.c_str(),
+        (unsigned long)version,
+        (unsigned long)LookupTableHeader::FORMAT_VERSION);
+    return nullptr;
+  }
+  LookupTableHeader & header = ret->header_;
+  header.bits_of_precision = readUint64(bytes + 8);
+  header.step_size = readUint64(bytes + 16);
+  header.num_cols = readUint64(bytes + 24);
+  header.num_rows = readUint64(bytes + 32);
+  header.cell_bytes = readUint64(bytes + 40);
+
+  size_t const expected_length = LOOKUP_TABLE_HEADER_SIZE +
+      header.num_rows * sizeof(uint64_t) +
+      header.numCells() * header.cell_bytes;
+  if (ret->length_ != expected_length) {
+    log_error("Lookup table %s has the wrong length", file.c_str());
+    return nullptr;
+  }
+  ret->rowIds_ = static_cast<uint8_t const *>(ret->base_) +
+      LOOKUP_TABLE_HEADER_SIZE;
+  ret->cells_ = ret->rowIds_ + header.num_rows * sizeof(uint64_t);
+  return ret;
+}
+
+std::shared_ptr<MappedLookupTable const>
+MappedLookupTable::openShared(std::string const & file) {
+  static std::mutex cache_mutex;
+  static std::map<std::string, std::weak_ptr<MappedLookupTable const>>
+      cache;
+
+  std::lock_guard<std::mutex> lock(cache_mutex);
+  std::shared_ptr<MappedLookupTable const> ret = cache[file].lock();
+  if (ret == nullptr) {
+    ret = MappedLookupTable::open(file);
+    if (ret != nullptr) {
+      cache[file] = ret;
+    } else {
+      cache.erase(file);
+    }
+  }
+  return ret;
+}
+
+MappedLookupTable::~MappedLookupTable() {
+  if (this->base_ != nullptr) {
+    munmap(this->base_, this->length_);
+  }
+}
+
+uint64_t MappedLookupTable::rowId(size_t const row) const {
+  return readUint64(this->rowIds_ + row * sizeof(uint64_t));
+}
+
+} // namespace safrn
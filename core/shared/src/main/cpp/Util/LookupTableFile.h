@@ -0,0 +1,135 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+#ifndef SAFRN_LOOKUP_TABLE_FILE_H_
+#define SAFRN_LOOKUP_TABLE_FILE_H_
+
+/* C and POSIX Headers */
+
+/* C++ Headers */
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* SAFRN Headers */
+
+namespace safrn {
+
+/**
+ * Binary form of an F or t lookup table, so that tables can be mapped
+ * into memory instead of being parsed from CSV for every query.
+ *
+ * All integers are 64-bit little-endian:
+ *
+ *   "SAFRNTBL" version bits_of_precision step_size num_cols num_rows
+ *   cell_bytes row_ids[num_rows] cells[cell_bytes][num_rows * num_cols]
+ *
+ * Cells are quantized exactly as read_table_csv_file does, and stored
+ * column-major: plane j holds byte j of every cell, in row-major cell
+ * order. This is the layout used by dataowner::LookupTable.
+ */
+struct LookupTableHeader {
+  static const uint64_t FORMAT_VERSION = 1;
+
+  uint64_t bits_of_precision = 0;
+  uint64_t step_size = 0;
+  uint64_t num_cols = 0;
+  uint64_t num_rows = 0;
+  uint64_t cell_bytes = 0;
+
+  uint64_t numCells() const {
+    return this->num_rows * this->num_cols;
+  }
+};
+
+/**
+ * Converts a CSV table, as written by regression_F_T_table_gen, into
+ * the binary format with cells of cell_bytes bytes.
+ */
+bool convertLookupTableCsv(
+    std::string const & csv_file,
+    std::string const & binary_file,
+    size_t const cell_bytes);
+
+/**
+ * Returns the name of the binary table next to a CSV table.
+ */
+std::string lookupTableBinaryFile(std::string const & csv_file);
+
+/**
+ * Returns true if a CSV table, and its binary form, were generated with
+ * the given "#generated_by=" parameters line, so that they need not be
+ * regenerated.
+ */
+bool lookupTableIsCurrent(
+    std::string const & csv_file, std::string const & params_line);
+
+/**
+ * Appends the CSV rows of a table for nu_2 in [1, max_nu_2), keeping
+ * only the first row and each row with a cell above 10^-num_digits
+ * which differs by more than pct_error_tol from the last row kept.
+ * compute_row fills in the row for a nu_2, which is its first cell.
+ *
+ * The cells move monotonically in nu_2, so this gallops forward from
+ * the last row kept to bracket the next row to keep, then bisects the
+ * bracket, computing O(log(gap)) rows per row kept instead of gap rows.
+ */
+void appendDistinctTableRows(
+    size_t const max_nu_2,
+    double const pct_error_tol,
+    size_t const num_digits,
+    std::function<void(size_t, std::vector<double> &)> const &
+        compute_row,
+    std::vector<std::string> & csv_lines);
+
+/**
+ * A read-only memory mapping of a binary table file.
+ */
+class MappedLookupTable {
+public:
+  /**
+   * Maps a binary table file, returning nullptr if it is missing or
+   * malformed.
+   */
+  static std::shared_ptr<MappedLookupTable const>
+  open(std::string const & file);
+
+  /**
+   * As open, but shares one mapping of each file between every caller
+   * in the process, for as long as any of them holds it.
+   */
+  static std::shared_ptr<MappedLookupTable const>
+  openShared(std::string const & file);
+
+  ~MappedLookupTable();
+  MappedLookupTable(MappedLookupTable const &) = delete;
+  MappedLookupTable & operator=(MappedLookupTable const &) = delete;
+
+  LookupTableHeader const & header() const {
+    return this->header_;
+  }
+
+  uint64_t rowId(size_t const row) const;
+
+  /** The cell planes, see LookupTableHeader. */
+  uint8_t const * cells() const {
+    return this->cells_;
+  }
+
+private:
+  MappedLookupTable() = default;
+
+  void * base_ = nullptr;
+  size_t length_ = 0;
+  LookupTableHeader header_;
+  uint8_t const * rowIds_ = nullptr;
+  uint8_t const * cells_ = nullptr;
+};
+
+} // namespace safrn
+
+#endif // SAFRN_LOOKUP_TABLE_FILE_H_
@@ -5,8 +5,12 @@
  */
 
 /* c/c++ standard includes */
+#include <algorithm>
+#include <atomic>
 #include <fstream>
+#include <functional>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
@@ -19,10 +23,11 @@
 #include "init_utils.h"
 #include "map_utils.h"
 #include "random_utils.h" // For Random32BitInt().
-#include "read_file_utils.h" // For RemoveWindowsTrailingCharacters().
+#include "read_file_utils.h" // For WriteLines().
 #include <JSON/Config/StudyConfig.h>
 #include <JSON/Query/LinearRegressionFunction.h>
 #include <JSON/Query/SafrnFunction.h>
+#include <Util/LookupTableFile.h>
 
 /* Logging Configuration */
 #include <ff/logging.h>
@@ -44,6 +49,9 @@ string kSingleQuote = "";
 //string kSingleQuote = "'";
 bool kPrintOrgId = false;
 bool kPrintUserId = false;
+// Bytes per cell of the binary tables, the same as
+// GlobalInfo::BYTES_IN_LOOKUP_TABLE_CELLS_DEFAULT_VALUE.
+const size_t kLookupTableCellBytes = 4;
 
 // Converts an int in [0-99] into a string of length exactly two.
 string AsString(const int input) {
@@ -206,39 +214,35 @@ int NumBlocks(
 
 } // namespace
 
-std::string
-printRow(const std::vector<double> & row, const size_t num_digits) {
-  std::string ret = Itoa(row.front());
-
-  // Generate data for the rest of the columns.
-  for (size_t column_i = 1; column_i < row.size(); ++column_i) {
-    ret += ",";
-    ret += Itoa(row[column_i], num_digits);
+// Writes the binary form of a CSV table next to it, for the dataowners
+// to map instead of parsing the CSV.
+void WriteBinaryTable(const string & csv_filename) {
+  const string filename = safrn::lookupTableBinaryFile(csv_filename);
+  if (!safrn::convertLookupTableCsv(
+          csv_filename, filename, kLookupTableCellBytes)) {
+    log_fatal("Unable to write '%s'", filename.c_str());
   }
-  return ret;
 }
 
-bool compareAdjacentRows(
-    const std::vector<double> & row1,
-    const std::vector<double> & row2,
-    const double pct_error_tol,
-    const size_t num_digits) {
-  // i starts at 1 to avoid column for num_observations
-  double ten_to_pow = 1.0;
-  for (size_t i = 0; i < num_digits; i++) {
-    ten_to_pow *= 0.1;
-  }
-  for (size_t i = 1; i < row1.size(); i++) {
-    if (row1[i] > ten_to_pow || row2[i] > ten_to_pow) {
-      if (row1[i] / row2[i] - 1 > pct_error_tol) {
-        return true;
+// Runs the tasks across all cores.
+void RunInParallel(const std::vector<std::function<void()>> & tasks) {
+  size_t num_threads = std::thread::hardware_concurrency();
+  num_threads =
+      std::max<size_t>(1, std::min(num_threads, tasks.size()));
+
+  std::atomic<size_t> next_task(0);
+  std::vector<std::thread> workers;
+  for (size_t i = 0; i < num_threads; i++) {
+    workers.emplace_back([&tasks, &next_task]() {
+      for (size_t task = next_task++; task < tasks.size();
+           task = next_task++) {
+        tasks[task]();
       }
-      if (row2[i] / row1[i] - 1 > pct_error_tol) {
-        return true;
-      }
-    }
+    });
+  }
+  for (std::thread & worker : workers) {
+    worker.join();
   }
-  return false;
 }
 
 void GenerateFTable(
@@ -250,42 +254,48 @@ void GenerateFTable(
     const double f_max,
     const double pct_error_tol,
     const size_t num_digits) {
+  const string filename =
+      output_dir + "/f_table_num_ivs_" + Itoa(nu_1) + ".csv";
+  const string params_line = "#generated_by=F,nu_1=" + Itoa(nu_1) +
+      ",max_nu_2=" + Itoa(max_nu_2) + ",bits=" + Itoa(F_bits) +
+      ",step_size=" + Itoa(F_step_size) + ",max=" + Itoa(f_max, 4) +
+      ",tol=" + Itoa(pct_error_tol, 6) + ",digits=" + Itoa(num_digits);
+  if (safrn::lookupTableIsCurrent(filename, params_line)) {
+    log_info("'%s' is up to date", filename.c_str());
+    return;
+  }
+
   std::vector<string> csv_lines;
-  std::vector<double> prev;
-  std::vector<double> current;
 
   // Add header lines.
   csv_lines.push_back("#bits_of_precision=" + Itoa(F_bits));
   csv_lines.push_back("#step_size=" + Itoa(F_step_size));
+  csv_lines.push_back(params_line);
 
   double f_diff = pow(0.5, F_bits) * F_step_size;
   size_t num_cols = static_cast<size_t>(ceil(f_max / f_diff));
-  current.resize(num_cols + 1);
-  for (size_t row_i = 1; row_i < max_nu_2; row_i++) {
-    current.front() = row_i;
-    for (size_t col_j = 0; col_j < num_cols; col_j++) {
-      auto result = gsl_cdf_fdist_Q((1 + col_j) * f_diff, nu_1, row_i);
-      current[col_j + 1] = result;
-    }
-    if (row_i == 1) {
-      csv_lines.push_back(printRow(current, num_digits));
-      prev = current;
-    } else {
-      if (compareAdjacentRows(
-              current, prev, pct_error_tol, num_digits)) {
-        csv_lines.push_back(printRow(current, num_digits));
-        prev = current;
-      }
-    }
-  }
+  safrn::appendDistinctTableRows(
+      max_nu_2,
+      pct_error_tol,
+      num_digits,
+      [&](size_t row_i, std::vector<double> & current) {
+        current.resize(num_cols + 1);
+        current.front() = row_i;
+        for (size_t col_j = 0; col_j < num_cols; col_j++) {
+          auto result =
+              gsl_cdf_fdist_Q((1 + col_j) * f_diff, nu_1, row_i);
+          current[col_j + 1] = result;
+        }
+      },
+      csv_lines);
 
-  printf("Num lines: csv_lines.size() = %zu", csv_lines.size());
+  log_info(
+      "Num lines in '%s': %zu", filename.c_str(), csv_lines.size());
   // Print data for this party.
-  const string filename =
-      output_dir + "/f_table_num_ivs_" + Itoa(nu_1) + ".csv";
   if (!WriteLines(filename, csv_lines)) {
     log_fatal("Unable to write '%s'", filename.c_str());
   }
+  WriteBinaryTable(filename);
 }
 
 void GenerateTTable(
@@ -296,46 +306,67 @@ void GenerateTTable(
     const double t_max,
     const double pct_error_tol,
     const size_t num_digits) {
+  const string filename = output_dir + "/t_table.csv";
+  const string params_line = "#generated_by=t,max_nu_2=" +
+      Itoa(max_nu_2) + ",bits=" + Itoa(t_bits) +
+      ",step_size=" + Itoa(t_step_size) + ",max=" + Itoa(t_max, 4) +
+      ",tol=" + Itoa(pct_error_tol, 6) + ",digits=" + Itoa(num_digits);
+  if (safrn::lookupTableIsCurrent(filename, params_line)) {
+    log_info("'%s' is up to date", filename.c_str());
+    return;
+  }
 
   double t_diff = pow(0.5, t_bits);
   // Generate data for this party.
   std::vector<string> csv_lines;
-  std::vector<double> prev;
-  std::vector<double> current;
   size_t num_cols =
       static_cast<size_t>(ceil(t_max * t_max / (t_diff * t_diff)));
-  current.resize((num_cols / t_step_size) + 1);
 
   // Add header lines.
   csv_lines.push_back("#bits_of_precision=" + Itoa(t_bits));
   csv_lines.push_back("#step_size=" + Itoa(t_step_size));
-  for (size_t row_i = 1; row_i < max_nu_2; ++row_i) {
-    current.front() = row_i;
-    for (size_t col_j = 0; col_j < num_cols; col_j += t_step_size) {
-      auto result = gsl_cdf_tdist_Q(sqrt((1 + col_j) * t_diff), row_i);
-      current[(col_j) / t_step_size + 1] = result;
-    }
+  csv_lines.push_back(params_line);
+  safrn::appendDistinctTableRows(
+      max_nu_2,
+      pct_error_tol,
+      num_digits,
+      [&](size_t row_i, std::vector<double> & current) {
+        current.resize((num_cols + t_step_size - 1) / t_step_size + 1);
+        current.front() = row_i;
+        for (size_t col_j = 0; col_j < num_cols; col_j += t_step_size) {
+          auto result =
+              gsl_cdf_tdist_Q(sqrt((1 + col_j) * t_diff), row_i);
+          current[(col_j) / t_step_size + 1] = result;
+        }
+      },
+      csv_lines);
 
-    if (row_i == 1) {
-      csv_lines.push_back(printRow(current, num_digits));
-      prev = current;
-    } else {
-      if (compareAdjacentRows(
-              current, prev, pct_error_tol, num_digits)) {
-        csv_lines.push_back(printRow(current, num_digits));
-        prev = current;
-      }
-    }
-  }
   // Print data for this party.
-  const string filename = output_dir + "/t_table.csv";
   if (!WriteLines(filename, csv_lines))
     log_fatal("Unable to write '%s'", filename.c_str());
+  WriteBinaryTable(filename);
 }
 
 int main(int argc, char * argv[]) {
   InitMain();
 
+  // Convert an existing CSV table, rather than generating tables.
+  if (argc > 1 && string(argv[1]) == "--convert") {
+    if (argc < 4) {
+      log_error(
+          "Usage: %s --convert in.csv out.bin [cell_bytes]", argv[0]);
+      return 1;
+    }
+    const size_t cell_bytes = (argc > 4)
+        ? static_cast<size_t>(atoi(argv[4]))
+        : kLookupTableCellBytes;
+    if (!safrn::convertLookupTableCsv(argv[2], argv[3], cell_bytes)) {
+      return 1;
+    }
+    log_info("Success! Output in: %s", argv[3]);
+    return 0;
+  }
+
   // Parse name of config file.
   size_t max_num_obs = 1000;
   if (argc > 1) {
@@ -376,29 +407,37 @@ int main(int argc, char * argv[]) {
   size_t F_bits = 5;
   size_t F_step_size = 1;
 
+  // Each table is independent, so they are generated in parallel.
+  std::vector<std::function<void()>> tasks;
   for (size_t i = 1; i < 17; i++) {
-    GenerateFTable(
-        output_dir,
-        i, // num_IVs
-        max_num_obs,
-        F_bits,
-        F_step_size,
-        40.0, // F_max
-        0.01, // drop if % difference less than 1%
-        8); // OR if absolute number less than 10^(-8)
+    tasks.push_back([=]() {
+      GenerateFTable(
+          output_dir,
+          i, // num_IVs
+          max_num_obs,
+          F_bits,
+          F_step_size,
+          40.0, // F_max
+          0.01, // drop if % difference less than 1%
+          8); // OR if absolute number less than 10^(-8)
+    });
   }
 
   size_t t_bits = 5;
   size_t t_step_size = 4;
 
-  GenerateTTable(
-      output_dir,
-      max_num_obs,
-      t_bits,
-      t_step_size,
-      10.0, // t_max
-      0.01,
-      8);
+  tasks.push_back([=]() {
+    GenerateTTable(
+        output_dir,
+        max_num_obs,
+        t_bits,
+        t_step_size,
+        10.0, // t_max
+        0.01,
+        8);
+  });
+
+  RunInParallel(tasks);
 
   log_info("Success! Outputs in: %s/F_t_table.csv", output_dir.c_str());
   return 0;
@@ -72,6 +72,8 @@ TEST(StudyConfig, Initialization) {
   safrn::dbuid_t tmp;
   safrn::strToDbuid("ffffffffffffffffffffffffffffffff", tmp);
   EXPECT_EQ(target.studyId, tmp);
+  EXPECT_EQ(target.maxListSize, 100);
+  EXPECT_EQ(target.workingSetRows, 25);
   EXPECT_EQ(target.lexicon.size(), 2);
   EXPECT_EQ(target.allowedQueries.size(), 2);
   EXPECT_EQ(target.peers.size(), 6);
@@ -92,6 +94,8 @@ TEST(StudyConfig, Initialization) {
   EXPECT_EQ(vert1.verticalIndex, 1);
   EXPECT_EQ(vert0.columns.size(), 6);
   EXPECT_EQ(vert1.columns.size(), 3);
+  EXPECT_EQ(vert0.maxListSize, 100);
+  EXPECT_EQ(vert1.maxListSize, 60);
   //   - Test nested fields: columns of first vertical.
   //       - Vertical: 0, Column: 0
   const safrn::ColumnBase & col00 = *(vert0.columns[0]);
@@ -222,3 +222,66 @@ TEST(Query, TooManyPrefilters) {
   EXPECT_THROW(
       safrn::Query target(initJson), safrn::Query::TooManyPrefilters);
 }
+
+TEST(Query, BatchedFunctions) {
+  const std::string initString =
+      R"({
+    "prefilters": [],
+    "functions": [
+      {
+        "type": "OrderFunction",
+        "col": {
+          "vertical": 0,
+          "columnIndex": 1
+        },
+        "is_percentile": true,
+        "lowest_first": true,
+        "value": 50
+      },
+      {
+        "type": "MomentFunction",
+        "bits_of_precision": 5,
+        "col": {
+          "vertical": 1,
+          "columnIndex": 2
+        },
+        "momentType": "MEAN",
+        "revealCount": false
+      },
+      {
+        "type": "MomentFunction",
+        "bits_of_precision": 5,
+        "col": {
+          "vertical": 1,
+          "columnIndex": 3
+        },
+        "momentType": "SKEW",
+        "revealCount": false
+      }
+    ]
+  })";
+
+  const nlohmann::json initJson = nlohmann::json::parse(initString);
+
+  safrn::Query target(initJson);
+
+  EXPECT_EQ(target.function->type, safrn::FunctionType::ORDER);
+  ASSERT_EQ(target.batchedFunctions.size(), 2u);
+  EXPECT_EQ(
+      target.batchedFunctions[0]->type, safrn::FunctionType::MOMENT);
+  EXPECT_EQ(
+      target.batchedFunctions[1]->type, safrn::FunctionType::MOMENT);
+}
+
+TEST(Query, EmptyFunctions) {
+  const std::string initString =
+      R"({
+    "prefilters": [],
+    "functions": []
+  })";
+
+  const nlohmann::json initJson = nlohmann::json::parse(initString);
+
+  EXPECT_THROW(
+      safrn::Query target(initJson), safrn::Query::EmptyFunctions);
+}
@@ -0,0 +1,131 @@
+/**
+ * Copyright (C) 2020 Stealth Software Technologies Commercial, Inc.
+ */
+
+/* platform-specific includes */
+#include <stdlib.h>
+#include <unistd.h>
+
+/* c/c++ standard includes */
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+/* third-party library includes */
+#include <gtest/gtest.h>
+
+/* project-specific includes */
+#include <Util/LookupTableFile.h>
+
+/* same module include */
+
+using namespace safrn;
+
+TEST(LookupTableFile, generated_table_is_current) {
+  char dir_template[] = "/tmp/safrn_table_XXXXXX";
+  char * dir = mkdtemp(dir_template);
+  ASSERT_FALSE(dir == nullptr);
+  std::string const csv_file = std::string(dir) + "/t_table.csv";
+  std::string const bin_file = lookupTableBinaryFile(csv_file);
+  std::string const params_line = "#generated_by=t,max_nu_2=8,bits=5";
+
+  EXPECT_FALSE(lookupTableIsCurrent(csv_file, params_line));
+  {
+    std::ofstream csv(csv_file.c_str());
+    csv << "#bits_of_precision=5\r\n#step_size=4\r\n";
+    csv << params_line << "\r\n";
+    csv << "1,0.5,0.25\r\n";
+    csv << "7,0.9,0.3\r\n";
+  }
+  /* Not without its binary form. */
+  EXPECT_FALSE(lookupTableIsCurrent(csv_file, params_line));
+
+  size_t const num_bytes = 2;
+  ASSERT_TRUE(convertLookupTableCsv(csv_file, bin_file, num_bytes));
+  EXPECT_TRUE(lookupTableIsCurrent(csv_file, params_line));
+  EXPECT_FALSE(lookupTableIsCurrent(
+      csv_file, "#generated_by=t,max_nu_2=9,bits=5"));
+
+  /* The parameters line is read past as a comment. */
+  std::shared_ptr<MappedLookupTable const> const table =
+      MappedLookupTable::open(bin_file);
+  ASSERT_FALSE(table == nullptr);
+  EXPECT_EQ(5UL, table->header().bits_of_precision);
+  EXPECT_EQ(4UL, table->header().step_size);
+  EXPECT_EQ(2UL, table->header().num_cols);
+  ASSERT_EQ(2UL, table->header().num_rows);
+  EXPECT_EQ(1UL, table->rowId(0));
+  EXPECT_EQ(7UL, table->rowId(1));
+
+  unlink(csv_file.c_str());
+  unlink(bin_file.c_str());
+  rmdir(dir);
+}
+
+TEST(LookupTableFile, distinct_rows_match_a_linear_scan) {
+  double const pct_error_tol = 0.1;
+  size_t const num_digits = 8;
+  size_t num_computed = 0;
+  auto const compute_row = [&num_computed](
+                               size_t nu_2, std::vector<double> & row) {
+    num_computed++;
+    double const nu = static_cast<double>(nu_2);
+    row = {nu, 1.0 / nu, 1.0 / std::sqrt(nu), std::exp(-nu)};
+  };
+
+  for (size_t max_nu_2 : {0UL, 1UL, 2UL, 3UL, 17UL, 1000UL}) {
+    /* Each row is kept if it differs from the last row kept. */
+    std::vector<size_t> expected;
+    std::vector<double> kept;
+    std::vector<double> row;
+    for (size_t nu_2 = 1; nu_2 < max_nu_2; nu_2++) {
+      compute_row(nu_2, row);
+      bool differs = kept.empty();
+      for (size_t i = 1; !differs && i < row.size(); i++) {
+        if (row[i] > std::pow(0.1, num_digits) ||
+            kept[i] > std::pow(0.1, num_digits)) {
+          differs = row[i] / kept[i] - 1 > pct_error_tol ||
+              kept[i] / row[i] - 1 > pct_error_tol;
+        }
+      }
+      if (differs) {
+        expected.push_back(nu_2);
+        kept = row;
+      }
+    }
+
+    num_computed = 0;
+    std::vector<std::string> csv_lines;
+    appendDistinctTableRows(
+        max_nu_2, pct_error_tol, num_digits, compute_row, csv_lines);
+    std::vector<size_t> actual;
+    for (std::string const & line : csv_lines) {
+      actual.push_back(strtoul(line.c_str(), nullptr, 10));
+    }
+    EXPECT_EQ(expected, actual) << "max_nu_2: " << max_nu_2;
+    if (max_nu_2 == 1000) {
+      EXPECT_LT(num_computed, max_nu_2 / 2);
+    }
+  }
+}
+
+TEST(LookupTableFile, distinct_rows_of_a_constant_table) {
+  size_t num_computed = 0;
+  std::vector<std::string> csv_lines;
+  appendDistinctTableRows(
+      1000,
+      0.01,
+      8,
+      [&num_computed](size_t nu_2, std::vector<double> & row) {
+        num_computed++;
+        row = {static_cast<double>(nu_2), 0.5, 0.25};
+      },
+      csv_lines);
+  ASSERT_EQ(1UL, csv_lines.size());
+  EXPECT_EQ(0UL, csv_lines[0].find("1,0.5"));
+  /* The first row, a gallop to the end, and the last row. */
+  EXPECT_LE(num_computed, 12UL);
+}